@@ -71,6 +71,7 @@
 #define LOG_BREAK_IF_WARNING 0         // Break on warnings (debug only)
 #define LOG_BREAK_IF_ERROR 0           // Break on errors (debug only)
 #define LOG_FORCE_PRINT_IMMEDIATELY 0  // Bypass async logging, print immediately
+#define HBE_LOG_MIN_LEVEL 0            // Logs below this ELogLevel are compiled out (0: Verbose, 3: Warning)
 
 // =============================================================================
 // Profiling
@@ -38,6 +38,9 @@ namespace hbe
 		// 16 Bytes Alignment
 		static constexpr size_t DefaultAlign = 16;
 
+		// Padding unit to keep independently written atomics off the same cache line
+		static constexpr size_t CacheLineSize = 64;
+
 		// String
 		static constexpr int MaxPathLength = 512;
 		static constexpr int StaticStringBufferSize = 8 * 1024 * 1024;
@@ -48,11 +51,18 @@ namespace hbe
 		static constexpr int LogOutputBuffer = LogLineLength * 128;
 		static constexpr int LogMemoryBlockSize = LogLineLength * 256;
 		static constexpr int LogNumMemoryBlocks = 1024 * 12;
-		static constexpr int LogForceFlushThreshold = 1024 * 8;
+		static constexpr int LogRingBufferSize = 512 * 1024;
+		static constexpr int MaxLogRings = 64;
+		static constexpr int MaxLogCategories = 1024;
 
 		// TaskSystem
 		static constexpr int MaxConcurrentTasks = 32;
 
+		// Capacity of each priority lane of a TaskStream's work-stealing queue. (power of two)
+		static constexpr size_t TaskStreamStealQueueSize = 256;
+		// Capacity of a TaskStream's inbox, which other threads enqueue into without a lock. (power of two)
+		static constexpr size_t TaskStreamInboxSize = 256;
+
 		// Profile
 		static constexpr float DebugTimeOutMultiplier = 2.0f;
 
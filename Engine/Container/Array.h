@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <initializer_list>
+#include <limits>
 #include "Core/Debug.h"
 #include "Memory/DefaultAllocator.h"
 #include "Memory/Memory.h"
@@ -16,10 +18,12 @@ namespace hbe
 	class Array final
 	{
 	public:
-		using TIndex = int;
+		using TIndex = size_t;
 		using Iterator = Element*;
 		using ConstIterator = const Element*;
 
+		static constexpr TIndex InvalidIndex = std::numeric_limits<TIndex>::max();
+
 	private:
 		TIndex length;
 		Element* data;
@@ -112,7 +116,7 @@ namespace hbe
 
 		[[nodiscard]] TIndex Size() const noexcept { return length; }
 
-		[[nodiscard]] bool IsValidIndex(TIndex index) const noexcept { return index >= 0 && index < length; }
+		[[nodiscard]] bool IsValidIndex(TIndex index) const noexcept { return index < length; }
 
 		void Clear() noexcept { Swap(Array()); }
 
@@ -132,12 +136,13 @@ namespace hbe
 		{
 			if (unlikely(data == nullptr))
 			{
-				return -1;
+				return InvalidIndex;
 			}
 
+			// An element before the data wraps around to a huge index, which isn't valid either.
 			auto delta = static_cast<TIndex>(&element - &data[0]);
 
-			return IsValidIndex(delta) ? delta : -1;
+			return IsValidIndex(delta) ? delta : InvalidIndex;
 		}
 	};
 
@@ -0,0 +1,374 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "AtomicRingQueue.h"
+
+#ifdef __UNIT_TEST__
+#include <atomic>
+#include <barrier>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Container/BoundedPriorityQueue.h"
+#include "Core/ScopedTime.h"
+#include "HSTL/HVector.h"
+
+
+namespace hbe
+{
+
+	namespace
+	{
+		struct Message final
+		{
+			uint8_t priority;
+			uint64_t value;
+		};
+
+		// How the task streams pass work items now, for the benchmarks.
+		struct LockedQueue final
+		{
+			std::mutex lock;
+			BoundedPriorityQueue<Message> queue;
+
+			explicit LockedQueue(size_t) {}
+
+			bool Push(const Message& message)
+			{
+				std::lock_guard guard(lock);
+				queue.Push(message);
+				return true;
+			}
+
+			bool Pop(std::optional<Message>& outMessage)
+			{
+				std::lock_guard guard(lock);
+				returnValueIf(false, queue.IsEmpty());
+
+				outMessage = queue.Pop();
+				return true;
+			}
+		};
+
+		template<typename TQueue>
+		void PushOrWait(TQueue& queue, const Message& message)
+		{
+			while (!queue.Push(message))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		template<typename TQueue>
+		Message PopOrWait(TQueue& queue)
+		{
+			std::optional<Message> message;
+			while (!queue.Pop(message))
+			{
+				std::this_thread::yield();
+			}
+
+			return *message;
+		}
+
+		// A message goes to the other thread and back. Returns nanoseconds per round trip.
+		template<typename TQueue>
+		double MeasurePingPong(size_t numRoundTrips)
+		{
+			TQueue ping(64);
+			TQueue pong(64);
+
+			std::thread responder([&]()
+			{
+				for (size_t i = 0; i < numRoundTrips; ++i)
+				{
+					PushOrWait(pong, PopOrWait(ping));
+				}
+			});
+
+			time::TDuration duration;
+			{
+				time::ScopedTime timer(duration);
+
+				for (size_t i = 0; i < numRoundTrips; ++i)
+				{
+					PushOrWait(ping, Message{0, i});
+					FatalAssert(PopOrWait(pong).value == i);
+				}
+			}
+
+			responder.join();
+
+			return time::ToFloat(duration) * 1e9 / double(numRoundTrips);
+		}
+
+		// The producers push their shares, and this thread pops them all. Returns nanoseconds per item.
+		template<typename TQueue>
+		double MeasureMultiProducer(int numProducers, size_t numItems)
+		{
+			TQueue queue(1024);
+			std::barrier sync(numProducers + 1);
+			const size_t numItemsPerProducer = numItems / numProducers;
+
+			HVector<std::thread> producers;
+			for (int p = 0; p < numProducers; ++p)
+			{
+				producers.emplace_back([&, p]()
+				{
+					sync.arrive_and_wait();
+					for (size_t i = 0; i < numItemsPerProducer; ++i)
+					{
+						PushOrWait(queue, Message{0, p * numItemsPerProducer + i});
+					}
+				});
+			}
+
+			const size_t total = numItemsPerProducer * numProducers;
+			uint64_t sum = 0;
+
+			time::TDuration duration;
+			{
+				sync.arrive_and_wait();
+				time::ScopedTime timer(duration);
+
+				for (size_t i = 0; i < total; ++i)
+				{
+					sum += PopOrWait(queue).value;
+				}
+			}
+
+			for (auto& producer : producers)
+			{
+				producer.join();
+			}
+
+			FatalAssert(sum == uint64_t(total) * (total - 1) / 2);
+
+			return time::ToFloat(duration) * 1e9 / double(total);
+		}
+
+	} // anonymous namespace
+
+	void AtomicRingQueueTest::Prepare()
+	{
+		AddTest("Push and Pop", [this](auto& ls)
+		{
+			AtomicRingQueue<int> q(5);
+			SPSCRingQueue<int> spsc(5);
+			std::optional<int> item;
+
+			if (q.Capacity() != 8 || spsc.Capacity() != 8 || !q.IsEmpty() || q.Pop(item) || spsc.Pop(item))
+			{
+				ls << "Initial state failed, capacity " << q.Capacity() << lferr;
+				return;
+			}
+
+			// Around the ring many times, filling it up on each.
+			for (int round = 0; round < 100; ++round)
+			{
+				for (int i = 0; i < 8; ++i)
+				{
+					FatalAssert(q.Push(round * 8 + i) && spsc.Push(round * 8 + i));
+				}
+
+				if (q.Push(-1) || spsc.Push(-1) || q.Size() != 8 || spsc.Size() != 8)
+				{
+					ls << "Push to a full queue succeeded at round " << round << lferr;
+					return;
+				}
+
+				for (int i = 0; i < 8; ++i)
+				{
+					FatalAssert(q.Pop(item) && *item == round * 8 + i);
+					FatalAssert(spsc.Pop(item) && *item == round * 8 + i);
+				}
+			}
+
+			if (!q.IsEmpty() || !spsc.IsEmpty())
+			{
+				ls << "Not empty after popping all" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Non-trivial Items", [this](auto& ls)
+		{
+			// The ones left in the queues are destroyed with them.
+			AtomicRingQueue<std::string> q(16);
+			SPSCRingQueue<std::string> spsc(16);
+
+			for (int i = 0; i < 10; ++i)
+			{
+				q.Push(std::to_string(i) + " is long enough to be on the heap");
+				spsc.Push(std::to_string(i) + " is long enough to be on the heap");
+			}
+
+			std::optional<std::string> item;
+			if (!q.Pop(item) || *item != "0 is long enough to be on the heap"
+				|| !spsc.Pop(item) || *item != "0 is long enough to be on the heap")
+			{
+				ls << "Pop failed" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Many Producers and Consumers", [this](auto& ls)
+		{
+			constexpr int NumProducers = 4;
+			constexpr int NumConsumers = 4;
+			constexpr uint64_t NumItemsPerProducer = 50000;
+
+			AtomicRingQueue<uint64_t> q(256);
+			std::atomic<uint64_t> numPopped = 0;
+			std::atomic<uint64_t> sum = 0;
+			std::atomic<uint64_t> numErrors = 0;
+
+			HVector<std::thread> threads;
+			for (int p = 0; p < NumProducers; ++p)
+			{
+				threads.emplace_back([&q, p]()
+				{
+					for (uint64_t i = 0; i < NumItemsPerProducer; ++i)
+					{
+						while (!q.Push((uint64_t(p) << 32) | i))
+						{
+							std::this_thread::yield();
+						}
+					}
+				});
+			}
+
+			// Each consumer should see the items of a producer in the order they were pushed.
+			for (int c = 0; c < NumConsumers; ++c)
+			{
+				threads.emplace_back([&]()
+				{
+					uint64_t lastSeen[NumProducers] = {};
+					bool hasSeen[NumProducers] = {};
+					std::optional<uint64_t> item;
+
+					while (numPopped.load(std::memory_order_relaxed) < NumProducers * NumItemsPerProducer)
+					{
+						if (!q.Pop(item))
+						{
+							std::this_thread::yield();
+							continue;
+						}
+
+						const auto producer = *item >> 32;
+						const auto index = *item & 0xFFFFFFFF;
+						if (hasSeen[producer] && index <= lastSeen[producer])
+						{
+							numErrors.fetch_add(1, std::memory_order_relaxed);
+						}
+
+						hasSeen[producer] = true;
+						lastSeen[producer] = index;
+						sum.fetch_add(index, std::memory_order_relaxed);
+						numPopped.fetch_add(1, std::memory_order_relaxed);
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			const uint64_t expectedSum = NumProducers * NumItemsPerProducer * (NumItemsPerProducer - 1) / 2;
+			if (numErrors > 0 || sum != expectedSum || !q.IsEmpty())
+			{
+				ls << "Errors " << numErrors << ", sum " << sum << ", expected " << expectedSum << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Single Producer and Consumer", [this](auto& ls)
+		{
+			constexpr uint64_t NumItems = 200000;
+
+			SPSCRingQueue<uint64_t> q(64);
+			std::thread producer([&q]()
+			{
+				for (uint64_t i = 0; i < NumItems; ++i)
+				{
+					while (!q.Push(i))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+
+			std::optional<uint64_t> item;
+			for (uint64_t i = 0; i < NumItems; ++i)
+			{
+				while (!q.Pop(item))
+				{
+					std::this_thread::yield();
+				}
+
+				if (*item != i)
+				{
+					producer.join();
+					ls << "Expected " << i << ", got " << *item << lferr;
+					return;
+				}
+			}
+
+			producer.join();
+			ls << "Pass";
+		});
+
+		AddTest("Ping-pong Latency", [this](auto& ls)
+		{
+			// On a single core every round trip waits for the scheduler, so a few are enough.
+			const bool isSingleCore = std::thread::hardware_concurrency() < 2;
+			const size_t numRoundTrips = isSingleCore ? 500 : 20000;
+
+			const auto mpmcNs = MeasurePingPong<AtomicRingQueue<Message>>(numRoundTrips);
+			const auto spscNs = MeasurePingPong<SPSCRingQueue<Message>>(numRoundTrips);
+			const auto lockedNs = MeasurePingPong<LockedQueue>(numRoundTrips);
+
+			ls << "Round trip ns: AtomicRingQueue " << mpmcNs << ", SPSCRingQueue " << spscNs
+			   << ", std::mutex + BoundedPriorityQueue " << lockedNs << lf;
+
+			ls << "Pass";
+		});
+
+		AddTest("Multi-producer Throughput", [this](auto& ls)
+		{
+			constexpr int ProducerCounts[] = {1, 2, 4};
+			constexpr size_t NumItems = 1 << 18;
+			const bool isSingleCore = std::thread::hardware_concurrency() < 2;
+
+			const auto spscNs = MeasureMultiProducer<SPSCRingQueue<Message>>(1, NumItems);
+			ls << "1 producer ns/item: SPSCRingQueue " << spscNs << lf;
+
+			for (auto numProducers : ProducerCounts)
+			{
+				const auto mpmcNs = MeasureMultiProducer<AtomicRingQueue<Message>>(numProducers, NumItems);
+				const auto lockedNs = MeasureMultiProducer<LockedQueue>(numProducers, NumItems);
+
+				ls << numProducers << " producers ns/item: AtomicRingQueue " << mpmcNs
+				   << ", std::mutex + BoundedPriorityQueue " << lockedNs << lf;
+
+				// A bounded queue waits for the consumer's time slice on a single core, the unbounded one doesn't.
+				if (mpmcNs > lockedNs && !isSingleCore)
+				{
+					ls << "AtomicRingQueue is slower than the locked queue with " << numProducers << " producers."
+					   << lfwarn;
+				}
+			}
+
+			ls << "Pass";
+		});
+	}
+
+} // namespace hbe
+
+#endif //__UNIT_TEST__
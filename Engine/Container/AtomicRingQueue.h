@@ -0,0 +1,288 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "Config/EngineConfig.h"
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "Memory/DefaultAllocator.h"
+
+
+namespace hbe
+{
+
+	/// @brief A bounded lock-free queue for any number of producers and consumers.
+	/// @details Every cell has a sequence number, which tells whose turn it is: a producer can write the cell at
+	/// position pos when it's pos, and a consumer can read it when it's pos + 1. Each side claims a position by a CAS
+	/// on its own counter, which is on its own cache line, and then hands the cell over by the sequence. The capacity
+	/// is rounded up to a power of two.
+	template<typename T, class TAllocator = DefaultAllocator<uint8_t>>
+	class AtomicRingQueue final
+	{
+	public:
+		using TIndex = size_t;
+
+	private:
+		struct Cell final
+		{
+			std::atomic<TIndex> sequence;
+			alignas(T) uint8_t storage[sizeof(T)];
+
+			T* Get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+		};
+
+		static_assert(std::atomic<TIndex>::is_always_lock_free, "TIndex should be lock free on this platform.");
+
+		std::atomic<TIndex> enqueuePos;
+		uint8_t enqueuePadding[Config::CacheLineSize - sizeof(std::atomic<TIndex>)];
+		std::atomic<TIndex> dequeuePos;
+		uint8_t dequeuePadding[Config::CacheLineSize - sizeof(std::atomic<TIndex>)];
+		Cell* cells;
+		TIndex mask;
+		TAllocator allocator;
+
+	public:
+		explicit AtomicRingQueue(TIndex capacity)
+			: enqueuePos(0)
+			, dequeuePos(0)
+			, cells(nullptr)
+			, mask(std::bit_ceil(std::max<TIndex>(capacity, 2)) - 1)
+		{
+			cells = reinterpret_cast<Cell*>(allocator.allocate(sizeof(Cell) * Capacity()));
+			for (TIndex i = 0; i < Capacity(); ++i)
+			{
+				new (&cells[i].sequence) std::atomic<TIndex>(i);
+			}
+		}
+
+		AtomicRingQueue(const AtomicRingQueue&) = delete;
+		AtomicRingQueue& operator=(const AtomicRingQueue&) = delete;
+
+		~AtomicRingQueue()
+		{
+			std::optional<T> item;
+			while (Pop(item))
+			{
+			}
+
+			allocator.deallocate(reinterpret_cast<uint8_t*>(cells), sizeof(Cell) * Capacity());
+		}
+
+		// Any thread. Returns false if the queue is full.
+		bool Push(const T& item) noexcept { return PushInternal(item); }
+		bool Push(T&& item) noexcept { return PushInternal(std::move(item)); }
+
+		// Any thread. Takes the oldest item.
+		bool Pop(std::optional<T>& outItem) noexcept
+		{
+			TIndex pos = dequeuePos.load(std::memory_order_relaxed);
+
+			for (;;)
+			{
+				auto& cell = cells[pos & mask];
+				const TIndex sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+				if (diff == 0)
+				{
+					if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						auto* ptr = cell.Get();
+						outItem.emplace(std::move(*ptr));
+						ptr->~T();
+						cell.sequence.store(pos + Capacity(), std::memory_order_release);
+
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = dequeuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// Approximate while others push or pop.
+		[[nodiscard]] TIndex Size() const noexcept
+		{
+			const auto head = dequeuePos.load(std::memory_order_acquire);
+			const auto tail = enqueuePos.load(std::memory_order_acquire);
+			return tail > head ? tail - head : 0;
+		}
+
+		[[nodiscard]] bool IsEmpty() const noexcept { return Size() == 0; }
+		[[nodiscard]] TIndex Capacity() const noexcept { return mask + 1; }
+
+	private:
+		template<typename TItem>
+		bool PushInternal(TItem&& item) noexcept
+		{
+			TIndex pos = enqueuePos.load(std::memory_order_relaxed);
+
+			for (;;)
+			{
+				auto& cell = cells[pos & mask];
+				const TIndex sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+				if (diff == 0)
+				{
+					if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						new (cell.storage) T(std::forward<TItem>(item));
+						cell.sequence.store(pos + 1, std::memory_order_release);
+
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+	};
+
+	/// @brief A bounded lock-free queue for one producer thread and one consumer thread.
+	/// @details The head and the tail are on their own cache lines, each with a copy of the other side's index. The
+	/// copy is refreshed only when the queue looks full or empty, so the sides rarely read each other's line.
+	template<typename T, class TAllocator = DefaultAllocator<uint8_t>>
+	class SPSCRingQueue final
+	{
+	public:
+		using TIndex = size_t;
+
+	private:
+		struct alignas(T) TSlot final
+		{
+			uint8_t bytes[sizeof(T)];
+
+			T* Get() noexcept { return std::launder(reinterpret_cast<T*>(bytes)); }
+		};
+
+		static constexpr size_t IndexPairSize = sizeof(std::atomic<TIndex>) + sizeof(TIndex);
+
+		// Written by the consumer.
+		std::atomic<TIndex> head;
+		TIndex cachedTail;
+		uint8_t headPadding[Config::CacheLineSize - IndexPairSize];
+		// Written by the producer.
+		std::atomic<TIndex> tail;
+		TIndex cachedHead;
+		uint8_t tailPadding[Config::CacheLineSize - IndexPairSize];
+		TSlot* slots;
+		TIndex mask;
+		TAllocator allocator;
+
+	public:
+		explicit SPSCRingQueue(TIndex capacity)
+			: head(0)
+			, cachedTail(0)
+			, tail(0)
+			, cachedHead(0)
+			, slots(nullptr)
+			, mask(std::bit_ceil(std::max<TIndex>(capacity, 1)) - 1)
+		{
+			slots = reinterpret_cast<TSlot*>(allocator.allocate(sizeof(TSlot) * Capacity()));
+		}
+
+		SPSCRingQueue(const SPSCRingQueue&) = delete;
+		SPSCRingQueue& operator=(const SPSCRingQueue&) = delete;
+
+		~SPSCRingQueue()
+		{
+			std::optional<T> item;
+			while (Pop(item))
+			{
+			}
+
+			allocator.deallocate(reinterpret_cast<uint8_t*>(slots), sizeof(TSlot) * Capacity());
+		}
+
+		// Producer only. Returns false if the queue is full.
+		bool Push(const T& item) noexcept { return PushInternal(item); }
+		bool Push(T&& item) noexcept { return PushInternal(std::move(item)); }
+
+		// Consumer only. Takes the oldest item.
+		bool Pop(std::optional<T>& outItem) noexcept
+		{
+			const TIndex h = head.load(std::memory_order_relaxed);
+			if (h == cachedTail)
+			{
+				cachedTail = tail.load(std::memory_order_acquire);
+				returnValueIf(false, h == cachedTail);
+			}
+
+			auto* ptr = slots[h & mask].Get();
+			outItem.emplace(std::move(*ptr));
+			ptr->~T();
+			head.store(h + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		// Approximate while the other side runs.
+		[[nodiscard]] TIndex Size() const noexcept
+		{
+			const auto h = head.load(std::memory_order_acquire);
+			const auto t = tail.load(std::memory_order_acquire);
+			return t > h ? t - h : 0;
+		}
+
+		[[nodiscard]] bool IsEmpty() const noexcept { return Size() == 0; }
+		[[nodiscard]] TIndex Capacity() const noexcept { return mask + 1; }
+
+	private:
+		template<typename TItem>
+		bool PushInternal(TItem&& item) noexcept
+		{
+			const TIndex t = tail.load(std::memory_order_relaxed);
+			if (t - cachedHead >= Capacity())
+			{
+				cachedHead = head.load(std::memory_order_acquire);
+				returnValueIf(false, t - cachedHead >= Capacity());
+			}
+
+			new (slots[t & mask].bytes) T(std::forward<TItem>(item));
+			tail.store(t + 1, std::memory_order_release);
+
+			return true;
+		}
+	};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+	class AtomicRingQueueTest : public TestCollection
+	{
+	public:
+		AtomicRingQueueTest() : TestCollection("AtomicRingQueueTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
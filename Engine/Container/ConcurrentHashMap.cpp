@@ -0,0 +1,356 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "ConcurrentHashMap.h"
+
+#ifdef __UNIT_TEST__
+#include <atomic>
+#include <barrier>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include "Core/ScopedTime.h"
+#include "HSTL/HVector.h"
+
+
+namespace hbe
+{
+
+	namespace
+	{
+		uint64_t SplitMix(uint64_t value) noexcept
+		{
+			value += 0x9E3779B97F4A7C15ULL;
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31);
+		}
+
+		// How shared caches are guarded now, for the benchmarks.
+		template<typename TMutex, template<typename> class TReadLock>
+		struct LockedMap final
+		{
+			mutable TMutex lock;
+			std::unordered_map<uint64_t, uint64_t> map;
+
+			bool Find(uint64_t key, uint64_t& outValue) const
+			{
+				TReadLock<TMutex> guard(lock);
+				auto found = map.find(key);
+				returnValueIf(false, found == map.end());
+
+				outValue = found->second;
+				return true;
+			}
+
+			void InsertOrAssign(uint64_t key, uint64_t value)
+			{
+				std::lock_guard guard(lock);
+				map.insert_or_assign(key, value);
+			}
+
+			void Remove(uint64_t key)
+			{
+				std::lock_guard guard(lock);
+				map.erase(key);
+			}
+		};
+
+		using TMutexMap = LockedMap<std::mutex, std::lock_guard>;
+		using TSharedMutexMap = LockedMap<std::shared_mutex, std::shared_lock>;
+		using TConcurrentMap = ConcurrentHashMap<uint64_t, uint64_t>;
+
+		constexpr size_t NumBenchmarkKeys = 1 << 16;
+		constexpr size_t NumOpsPerThread = 1 << 18;
+
+		// Every thread runs the operations on its own random sequence of the shared keys, and the time per operation
+		// is returned in nanoseconds. A read is chosen unless the random value is under the write ratio of 256.
+		template<typename TMap>
+		double RunMixed(TMap& map, int numThreads, uint32_t writeRatio)
+		{
+			std::barrier sync(numThreads);
+			std::atomic<uint64_t> checksum = 0;
+
+			auto work = [&](int threadIndex)
+			{
+				uint64_t sum = 0;
+				uint64_t seed = SplitMix(threadIndex + 1);
+				sync.arrive_and_wait();
+
+				for (size_t i = 0; i < NumOpsPerThread; ++i)
+				{
+					seed = SplitMix(seed);
+					const uint64_t key = (seed >> 8) & (NumBenchmarkKeys - 1);
+
+					if ((seed & 0xFF) >= writeRatio)
+					{
+						uint64_t value = 0;
+						sum += map.Find(key, value) ? value : 0;
+					}
+					else if (seed & 0x100)
+					{
+						map.InsertOrAssign(key, i);
+					}
+					else
+					{
+						map.Remove(key);
+					}
+				}
+
+				checksum += sum;
+			};
+
+			time::TDuration duration;
+			{
+				time::ScopedTime timer(duration);
+
+				HVector<std::thread> threads;
+				for (int i = 0; i < numThreads; ++i)
+				{
+					threads.emplace_back(work, i);
+				}
+
+				for (auto& thread : threads)
+				{
+					thread.join();
+				}
+			}
+
+			return time::ToFloat(duration) * 1e9 / (double(NumOpsPerThread) * numThreads);
+		}
+
+		template<typename TMap>
+		double Benchmark(int numThreads, uint32_t writeRatio)
+		{
+			TMap map;
+			for (uint64_t key = 0; key < NumBenchmarkKeys; key += 2)
+			{
+				map.InsertOrAssign(key, key);
+			}
+
+			return RunMixed(map, numThreads, writeRatio);
+		}
+
+	} // anonymous namespace
+
+	void ConcurrentHashMapTest::Prepare()
+	{
+		AddTest("Insert, Find and Remove", [this](auto& ls)
+		{
+			ConcurrentHashMap<int, int> m;
+			uint64_t value = 0;
+			int found = 0;
+
+			FatalAssert(!m.Find(1, found) && !m.Remove(1));
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				FatalAssert(m.Insert(i, i * 10));
+			}
+
+			FatalAssert(!m.Insert(5, 0));
+			FatalAssert(!m.InsertOrAssign(6, 66));
+			FatalAssert(m.Remove(7) && !m.Remove(7));
+
+			if (m.Size() != 999 || !m.Find(5, found) || found != 50 || !m.Find(6, found) || found != 66
+				|| m.Contains(7) || m.Contains(1000))
+			{
+				ls << "Size " << m.Size() << ", found " << found << lferr;
+				return;
+			}
+
+			FatalAssert(m.InsertOrAssign(7, 70));
+			if (!m.Find(7, found) || found != 70)
+			{
+				ls << "Insert after Remove failed" << lferr;
+				return;
+			}
+
+			ConcurrentHashMap<uint64_t, uint64_t> wide(100);
+			FatalAssert(wide.Capacity() * 7 / 10 >= 100);
+			wide.Insert(1, 2);
+			FatalAssert(wide.Find(1, value) && value == 2);
+
+			ls << "Pass";
+		});
+
+		AddTest("Clear and Churn", [this](auto& ls)
+		{
+			ConcurrentHashMap<int, int> m;
+			for (int i = 0; i < 100; ++i)
+			{
+				m.Insert(i, i);
+			}
+
+			m.Clear();
+			if (!m.IsEmpty() || m.Contains(1))
+			{
+				ls << "Clear failed" << lferr;
+				return;
+			}
+
+			m.Reserve(1000);
+			const auto capacity = m.Capacity();
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				m.Insert(i, i);
+			}
+
+			for (int i = 0; i < 100000; ++i)
+			{
+				FatalAssert(m.Remove(i));
+				FatalAssert(m.Insert(i + 1000, i));
+			}
+
+			if (m.Capacity() != capacity || m.Size() != 1000 || !m.Contains(100999) || m.Contains(99999))
+			{
+				ls << "Capacity " << capacity << " -> " << m.Capacity() << ", size " << m.Size() << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Concurrent Writers", [this](auto& ls)
+		{
+			constexpr int NumThreads = 4;
+			constexpr int NumKeys = 50000;
+
+			ConcurrentHashMap<int, int> m;
+
+			// Each thread inserts its own keys, and removes every third of them.
+			HVector<std::thread> threads;
+			for (int t = 0; t < NumThreads; ++t)
+			{
+				threads.emplace_back([&m, t]()
+				{
+					for (int i = t; i < NumKeys; i += NumThreads)
+					{
+						m.Insert(i, i * 2);
+					}
+
+					for (int i = t; i < NumKeys; i += NumThreads * 3)
+					{
+						m.Remove(i);
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			size_t numExpected = 0;
+			for (int i = 0; i < NumKeys; ++i)
+			{
+				const bool isRemoved = (i % NumThreads) == (i % (NumThreads * 3));
+				numExpected += isRemoved ? 0 : 1;
+
+				int value = 0;
+				if (m.Find(i, value) == isRemoved || (!isRemoved && value != i * 2))
+				{
+					ls << "Key " << i << " is wrong, value " << value << lferr;
+					return;
+				}
+			}
+
+			if (m.Size() != numExpected)
+			{
+				ls << "Size " << m.Size() << ", expected " << numExpected << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Readers While Growing", [this](auto& ls)
+		{
+			constexpr int NumReaders = 3;
+			constexpr uint64_t NumKeys = 200000;
+
+			ConcurrentHashMap<uint64_t, uint64_t> m;
+			std::atomic<uint64_t> numInserted = 0;
+			std::atomic<uint64_t> numErrors = 0;
+
+			// The keys inserted so far should be found, however many times the table has grown meanwhile.
+			HVector<std::thread> readers;
+			for (int t = 0; t < NumReaders; ++t)
+			{
+				readers.emplace_back([&, t]()
+				{
+					uint64_t seed = SplitMix(t);
+					for (;;)
+					{
+						const auto limit = numInserted.load(std::memory_order_acquire);
+						breakIf(limit >= NumKeys);
+						continueIf(limit == 0);
+
+						seed = SplitMix(seed);
+						const auto key = seed % limit;
+
+						uint64_t value = 0;
+						if (!m.Find(key, value) || value != key + 1)
+						{
+							numErrors.fetch_add(1, std::memory_order_relaxed);
+						}
+					}
+				});
+			}
+
+			for (uint64_t key = 0; key < NumKeys; ++key)
+			{
+				m.Insert(key, key + 1);
+				numInserted.store(key + 1, std::memory_order_release);
+			}
+
+			for (auto& reader : readers)
+			{
+				reader.join();
+			}
+
+			if (numErrors > 0)
+			{
+				ls << numErrors << " reads missed the keys inserted before" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Read-heavy and Write-heavy Benchmarks", [this](auto& ls)
+		{
+			constexpr int ThreadCounts[] = {1, 2, 4};
+			// Out of 256.
+			constexpr uint32_t ReadHeavy = 8;
+			constexpr uint32_t WriteHeavy = 192;
+
+			for (auto numThreads : ThreadCounts)
+			{
+				for (auto writeRatio : {ReadHeavy, WriteHeavy})
+				{
+					const auto concurrentNs = Benchmark<TConcurrentMap>(numThreads, writeRatio);
+					const auto mutexNs = Benchmark<TMutexMap>(numThreads, writeRatio);
+					const auto sharedMutexNs = Benchmark<TSharedMutexMap>(numThreads, writeRatio);
+
+					ls << numThreads << " threads, " << (writeRatio == ReadHeavy ? "read" : "write")
+					   << "-heavy ns/op: ConcurrentHashMap " << concurrentNs << ", std::mutex " << mutexNs
+					   << ", std::shared_mutex " << sharedMutexNs << lf;
+
+					// The writers contend only on a lock of the stripe, which doesn't pay off without the cores.
+					if (writeRatio == ReadHeavy && concurrentNs > mutexNs)
+					{
+						ls << "ConcurrentHashMap is slower than std::unordered_map with std::mutex at " << numThreads
+						   << " threads." << lfwarn;
+					}
+				}
+			}
+
+			ls << "Pass";
+		});
+	}
+
+} // namespace hbe
+
+#endif //__UNIT_TEST__
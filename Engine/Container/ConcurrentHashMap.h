@@ -0,0 +1,545 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#include "Config/EngineConfig.h"
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "Memory/DefaultAllocator.h"
+
+
+namespace hbe
+{
+
+	/// @brief A thread-safe open-addressing hash map, read without locks.
+	/// @details The slots are laid out as in HashMap, probed linearly up to the load factor 0.7. Keys are spread over
+	/// stripes, each a lock for the writers and a sequence number for the readers: a reader copies the entry and
+	/// retries if the sequence of its stripe has changed meanwhile. The keys and values are copied, so they must be
+	/// trivially copyable, and a torn copy is discarded by the sequence check as in WorkStealingDeque.
+	/// Growing takes the locks of all stripes and publishes a new table, while the readers keep probing the old one,
+	/// which doesn't change any more. The old tables are kept until the map is destroyed, as readers may still be
+	/// probing them. That's less than the current table in total, as each is twice as large as the one before.
+	/// Tombstones left by churning keys are dropped in place instead, which the readers wait for.
+	/// The allocator is used by whichever stream grows the table, so it should be thread-safe.
+	template<typename TKey, typename TValue, class THash = std::hash<TKey>, class TKeyEqual = std::equal_to<TKey>,
+		class TAllocator = DefaultAllocator<uint8_t>>
+	class ConcurrentHashMap final
+	{
+		static_assert(std::is_trivially_copyable_v<TKey>, "ConcurrentHashMap requires a trivially copyable key.");
+		static_assert(std::is_trivially_copyable_v<TValue>, "ConcurrentHashMap requires a trivially copyable value.");
+
+	public:
+		using TIndex = size_t;
+
+		static constexpr TIndex MinCapacity = 16;
+		static constexpr TIndex NumStripes = 64;
+		static_assert(std::has_single_bit(NumStripes));
+
+		struct Pair final
+		{
+			TKey key;
+			TValue value;
+		};
+
+	private:
+		enum class EState : uint8_t
+		{
+			Empty,
+			Occupied,
+			Tombstone,
+			// Taken by a writer, which is writing the entry.
+			Claimed
+		};
+
+		struct Table final
+		{
+			TIndex capacity;
+			// Occupied, tombstone and claimed slots allowed, including the ones reserved for the writers.
+			TIndex maxUsed;
+			Table* retired;
+			std::atomic<EState>* states;
+			Pair* entries;
+		};
+
+		struct alignas(Config::CacheLineSize) Stripe final
+		{
+			std::mutex lock;
+			// Odd while a writer is changing an entry of the stripe.
+			std::atomic<uint32_t> sequence;
+		};
+
+		static constexpr TIndex NotFound = static_cast<TIndex>(-1);
+		static constexpr int StripeShift = static_cast<int>(sizeof(size_t) * 8) - std::countr_zero(NumStripes);
+
+		Stripe stripes[NumStripes];
+		std::atomic<Table*> current;
+		std::atomic<TIndex> count;
+		std::atomic<TIndex> used;
+		THash hash;
+		TKeyEqual keyEqual;
+		TAllocator allocator;
+
+	public:
+		ConcurrentHashMap() noexcept
+			: current(nullptr)
+			, count(0)
+			, used(0)
+		{
+			for (auto& stripe : stripes)
+			{
+				stripe.sequence.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		explicit ConcurrentHashMap(TIndex numEntries)
+			: ConcurrentHashMap()
+		{
+			Reserve(numEntries);
+		}
+
+		ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+		ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+		~ConcurrentHashMap() noexcept
+		{
+			auto* table = current.load(std::memory_order_acquire);
+			while (table != nullptr)
+			{
+				auto* retired = table->retired;
+				allocator.deallocate(reinterpret_cast<uint8_t*>(table), GetAllocSize(table->capacity));
+				table = retired;
+			}
+		}
+
+		// Copy the value of the key. Return false if there's no such key.
+		bool Find(const TKey& key, TValue& outValue) const noexcept { return FindValue(key, &outValue); }
+
+		[[nodiscard]] bool Contains(const TKey& key) const noexcept { return FindValue(key, nullptr); }
+
+		// Return false if the key exists, leaving its value.
+		bool Insert(const TKey& key, const TValue& value) { return InsertInternal(key, value, false); }
+
+		// Return false if the key exists, replacing its value.
+		bool InsertOrAssign(const TKey& key, const TValue& value) { return InsertInternal(key, value, true); }
+
+		bool Remove(const TKey& key)
+		{
+			const auto hashCode = Mix(hash(key));
+			auto& stripe = GetStripe(hashCode);
+			std::lock_guard guard(stripe.lock);
+
+			auto* table = current.load(std::memory_order_relaxed);
+			returnValueIf(false, table == nullptr);
+
+			const auto index = FindSlot(*table, key, hashCode);
+			returnValueIf(false, index == NotFound);
+
+			BeginWrite(stripe);
+			table->states[index].store(EState::Tombstone, std::memory_order_release);
+			EndWrite(stripe);
+
+			count.fetch_sub(1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		[[nodiscard]] TIndex Size() const noexcept { return count.load(std::memory_order_relaxed); }
+		[[nodiscard]] bool IsEmpty() const noexcept { return Size() == 0; }
+
+		[[nodiscard]] TIndex Capacity() const noexcept
+		{
+			const auto* table = current.load(std::memory_order_acquire);
+			return table == nullptr ? 0 : table->capacity;
+		}
+
+		// The readers wait until it's cleared.
+		void Clear() noexcept
+		{
+			LockAll();
+
+			if (auto* table = current.load(std::memory_order_relaxed))
+			{
+				BeginWriteAll();
+
+				for (TIndex i = 0; i < table->capacity; ++i)
+				{
+					table->states[i].store(EState::Empty, std::memory_order_relaxed);
+				}
+
+				count.store(0, std::memory_order_relaxed);
+				used.store(0, std::memory_order_relaxed);
+
+				EndWriteAll();
+			}
+
+			UnlockAll();
+		}
+
+		// Reserve the slots to hold the entries without growing.
+		void Reserve(TIndex numEntries)
+		{
+			LockAll();
+
+			auto* table = current.load(std::memory_order_relaxed);
+			TIndex capacity = table == nullptr ? MinCapacity : table->capacity;
+			while (GetMaxUsed(capacity) < numEntries)
+			{
+				capacity *= 2;
+			}
+
+			if (table == nullptr || capacity > table->capacity)
+			{
+				Rehash(table, capacity);
+			}
+
+			UnlockAll();
+		}
+
+	private:
+		// Copy the value into the output if it's given.
+		bool FindValue(const TKey& key, TValue* outValue) const noexcept
+		{
+			const auto hashCode = Mix(hash(key));
+			const auto& stripe = GetStripe(hashCode);
+
+			alignas(TValue) uint8_t value[sizeof(TValue)] = {};
+
+			for (;;)
+			{
+				const auto sequence = stripe.sequence.load(std::memory_order_acquire);
+				if (unlikely(sequence & 1))
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				bool isFound = false;
+				const auto* table = current.load(std::memory_order_acquire);
+				if (likely(table != nullptr))
+				{
+					const auto index = FindSlot(*table, key, hashCode);
+					isFound = index != NotFound;
+
+					if (isFound && outValue != nullptr)
+					{
+						std::memcpy(value, &table->entries[index].value, sizeof(TValue));
+					}
+				}
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				continueIf(stripe.sequence.load(std::memory_order_relaxed) != sequence);
+
+				if (isFound && outValue != nullptr)
+				{
+					std::memcpy(outValue, value, sizeof(TValue));
+				}
+
+				return isFound;
+			}
+		}
+
+		// std::hash of integers is the identity, so the bits are mixed. The high bits select the stripe.
+		[[nodiscard]] static size_t Mix(size_t hashCode) noexcept
+		{
+			const uint64_t product = static_cast<uint64_t>(hashCode) * 0x9E3779B97F4A7C15ULL;
+			return static_cast<size_t>(product ^ (product >> 32));
+		}
+
+		[[nodiscard]] static TIndex GetMaxUsed(TIndex capacity) noexcept { return capacity * 7 / 10; }
+
+		[[nodiscard]] static size_t GetStatesOffset() noexcept
+		{
+			return (sizeof(Table) + alignof(std::atomic<EState>) - 1) / alignof(std::atomic<EState>)
+				* alignof(std::atomic<EState>);
+		}
+
+		[[nodiscard]] static size_t GetEntriesOffset(TIndex capacity) noexcept
+		{
+			const size_t statesEnd = GetStatesOffset() + sizeof(std::atomic<EState>) * capacity;
+			return (statesEnd + alignof(Pair) - 1) / alignof(Pair) * alignof(Pair);
+		}
+
+		[[nodiscard]] static size_t GetAllocSize(TIndex capacity) noexcept
+		{
+			return GetEntriesOffset(capacity) + sizeof(Pair) * capacity;
+		}
+
+		[[nodiscard]] Stripe& GetStripe(size_t hashCode) noexcept { return stripes[hashCode >> StripeShift]; }
+
+		[[nodiscard]] const Stripe& GetStripe(size_t hashCode) const noexcept
+		{
+			return stripes[hashCode >> StripeShift];
+		}
+
+		static void BeginWrite(Stripe& stripe) noexcept
+		{
+			const auto sequence = stripe.sequence.load(std::memory_order_relaxed);
+			stripe.sequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+
+		static void EndWrite(Stripe& stripe) noexcept
+		{
+			const auto sequence = stripe.sequence.load(std::memory_order_relaxed);
+			stripe.sequence.store(sequence + 1, std::memory_order_release);
+		}
+
+		void BeginWriteAll() noexcept
+		{
+			for (auto& stripe : stripes)
+			{
+				BeginWrite(stripe);
+			}
+		}
+
+		void EndWriteAll() noexcept
+		{
+			for (auto& stripe : stripes)
+			{
+				EndWrite(stripe);
+			}
+		}
+
+		void LockAll() noexcept
+		{
+			for (auto& stripe : stripes)
+			{
+				stripe.lock.lock();
+			}
+		}
+
+		void UnlockAll() noexcept
+		{
+			for (auto& stripe : stripes)
+			{
+				stripe.lock.unlock();
+			}
+		}
+
+		// The key of an occupied slot is written only with all the stripes locked, but it's still copied before
+		// compared, so a torn copy during DropTombstones is discarded by the sequence check.
+		[[nodiscard]] TIndex FindSlot(const Table& table, const TKey& key, size_t hashCode) const noexcept
+		{
+			const auto mask = table.capacity - 1;
+			alignas(TKey) uint8_t candidate[sizeof(TKey)];
+
+			for (TIndex probe = 0; probe < table.capacity; ++probe)
+			{
+				const auto slot = (hashCode + probe) & mask;
+				const auto state = table.states[slot].load(std::memory_order_acquire);
+
+				returnValueIf(NotFound, state == EState::Empty);
+				continueIf(state != EState::Occupied);
+
+				std::memcpy(candidate, &table.entries[slot].key, sizeof(TKey));
+				if (keyEqual(*reinterpret_cast<const TKey*>(candidate), key))
+				{
+					return slot;
+				}
+			}
+
+			return NotFound;
+		}
+
+		// Take the first empty slot on the probe sequence, racing with the writers of the other stripes.
+		// A slot has been reserved in the used count, so there's always an empty one. Tombstones aren't reused, as a
+		// reader of another stripe may be probing through one, and only its own stripe is checked. They're dropped
+		// with all the stripes locked when the table is full.
+		[[nodiscard]] TIndex ClaimSlot(Table& table, size_t hashCode) noexcept
+		{
+			const auto mask = table.capacity - 1;
+
+			for (TIndex probe = 0;; ++probe)
+			{
+				const auto slot = (hashCode + probe) & mask;
+				auto state = table.states[slot].load(std::memory_order_relaxed);
+				continueIf(state != EState::Empty);
+
+				if (table.states[slot].compare_exchange_strong(state, EState::Claimed, std::memory_order_acquire))
+				{
+					return slot;
+				}
+			}
+		}
+
+		bool InsertInternal(const TKey& key, const TValue& value, bool shouldAssign)
+		{
+			const auto hashCode = Mix(hash(key));
+			auto& stripe = GetStripe(hashCode);
+
+			for (;;)
+			{
+				Table* table = nullptr;
+
+				{
+					std::lock_guard guard(stripe.lock);
+
+					// Replaced only with all the stripes locked.
+					table = current.load(std::memory_order_relaxed);
+					if (likely(table != nullptr))
+					{
+						auto index = FindSlot(*table, key, hashCode);
+						if (index != NotFound)
+						{
+							returnValueIf(false, !shouldAssign);
+
+							BeginWrite(stripe);
+							std::memcpy(&table->entries[index].value, &value, sizeof(TValue));
+							EndWrite(stripe);
+
+							return false;
+						}
+
+						if (used.fetch_add(1, std::memory_order_relaxed) < table->maxUsed)
+						{
+							index = ClaimSlot(*table, hashCode);
+
+							BeginWrite(stripe);
+							std::memcpy(&table->entries[index].key, &key, sizeof(TKey));
+							std::memcpy(&table->entries[index].value, &value, sizeof(TValue));
+							table->states[index].store(EState::Occupied, std::memory_order_release);
+							EndWrite(stripe);
+
+							count.fetch_add(1, std::memory_order_relaxed);
+
+							return true;
+						}
+
+						used.fetch_sub(1, std::memory_order_relaxed);
+					}
+				}
+
+				Grow(table);
+			}
+		}
+
+		void Grow(Table* full)
+		{
+			LockAll();
+
+			// Unless another writer has made room already.
+			auto* table = current.load(std::memory_order_relaxed);
+			if (table == full && (table == nullptr || used.load(std::memory_order_relaxed) >= table->maxUsed))
+			{
+				if (table != nullptr && count.load(std::memory_order_relaxed) * 4 <= table->maxUsed * 3)
+				{
+					DropTombstones(*table);
+				}
+				else
+				{
+					Rehash(table, table == nullptr ? MinCapacity : table->capacity * 2);
+				}
+			}
+
+			UnlockAll();
+		}
+
+		// Tombstones take enough of the slots, so the entries are inserted again at the same capacity. It's done in
+		// place, so the readers wait, rather than retiring a table of the same size every time the keys have churned.
+		void DropTombstones(Table& table)
+		{
+			const auto numEntries = count.load(std::memory_order_relaxed);
+			auto* entries = reinterpret_cast<Pair*>(allocator.allocate(sizeof(Pair) * std::max<TIndex>(numEntries, 1)));
+
+			TIndex numCopied = 0;
+			for (TIndex i = 0; i < table.capacity; ++i)
+			{
+				continueIf(table.states[i].load(std::memory_order_relaxed) != EState::Occupied);
+				std::memcpy(&entries[numCopied++], &table.entries[i], sizeof(Pair));
+			}
+
+			FatalAssert(numCopied == numEntries);
+
+			BeginWriteAll();
+
+			for (TIndex i = 0; i < table.capacity; ++i)
+			{
+				table.states[i].store(EState::Empty, std::memory_order_relaxed);
+			}
+
+			for (TIndex i = 0; i < numEntries; ++i)
+			{
+				InsertUnsafe(table, entries[i]);
+			}
+
+			used.store(numEntries, std::memory_order_relaxed);
+			EndWriteAll();
+
+			allocator.deallocate(reinterpret_cast<uint8_t*>(entries), sizeof(Pair) * std::max<TIndex>(numEntries, 1));
+		}
+
+		// Insert a new entry with all the stripes locked.
+		void InsertUnsafe(Table& table, const Pair& entry) noexcept
+		{
+			const auto mask = table.capacity - 1;
+			auto slot = Mix(hash(entry.key)) & mask;
+			while (table.states[slot].load(std::memory_order_relaxed) != EState::Empty)
+			{
+				slot = (slot + 1) & mask;
+			}
+
+			std::memcpy(&table.entries[slot], &entry, sizeof(Pair));
+			table.states[slot].store(EState::Occupied, std::memory_order_relaxed);
+		}
+
+		// With all the stripes locked, so the table doesn't change while copied. The readers keep probing the old
+		// table meanwhile.
+		void Rehash(Table* table, TIndex capacity)
+		{
+			auto* raw = allocator.allocate(GetAllocSize(capacity));
+
+			auto* newTable = new (raw) Table{capacity, GetMaxUsed(capacity), table, nullptr, nullptr};
+			newTable->states = reinterpret_cast<std::atomic<EState>*>(raw + GetStatesOffset());
+			newTable->entries = reinterpret_cast<Pair*>(raw + GetEntriesOffset(capacity));
+
+			for (TIndex i = 0; i < capacity; ++i)
+			{
+				new (&newTable->states[i]) std::atomic<EState>(EState::Empty);
+			}
+
+			TIndex numEntries = 0;
+			for (TIndex i = 0; table != nullptr && i < table->capacity; ++i)
+			{
+				continueIf(table->states[i].load(std::memory_order_relaxed) != EState::Occupied);
+
+				InsertUnsafe(*newTable, table->entries[i]);
+				++numEntries;
+			}
+
+			FatalAssert(numEntries == count.load(std::memory_order_relaxed));
+			used.store(numEntries, std::memory_order_relaxed);
+			current.store(newTable, std::memory_order_release);
+		}
+	};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+	class ConcurrentHashMapTest : public TestCollection
+	{
+	public:
+		ConcurrentHashMapTest() : TestCollection("ConcurrentHashMapTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -4,6 +4,7 @@
 
 #ifdef __UNIT_TEST__
 #include <deque>
+#include <string>
 #include "Core/ScopedTime.h"
 
 
@@ -106,7 +107,7 @@ namespace hbe
 				d.PushBack(i);
 			}
 
-			if (d.Size() != count)
+			if (d.Size() != static_cast<size_t>(count))
 			{
 				ls << "Expected size " << count << ", got " << d.Size() << lferr;
 				return;
@@ -232,6 +233,49 @@ namespace hbe
 			ls << "Pass";
 		});
 
+		AddTest("Growth While Wrapped", [this](auto& ls)
+		{
+			// The ints move with the block and the strings one by one, and both keep the order from the head.
+			Deque<int> ints;
+			Deque<std::string> strings;
+			std::deque<int> expected;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				if (i % 3 == 0)
+				{
+					ints.PushFront(i);
+					strings.PushFront(std::to_string(i));
+					expected.push_front(i);
+				}
+				else
+				{
+					ints.PushBack(i);
+					strings.PushBack(std::to_string(i));
+					expected.push_back(i);
+				}
+			}
+
+			for (size_t i = 0; i < expected.size(); ++i)
+			{
+				if (ints[i] != expected[i] || strings[i] != std::to_string(expected[i]))
+				{
+					ls << "Mismatch at " << i << ", " << ints[i] << " vs " << expected[i] << lferr;
+					return;
+				}
+			}
+
+			Deque<int> sized(3);
+			sized.PushBack(1);
+			if (sized.Capacity() != 4 || sized.Front() != 1)
+			{
+				ls << "Initial capacity failed" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
 		AddTest("Performance vs std::deque", [this](auto& ls)
 		{
 			constexpr int NumItems = 50000;
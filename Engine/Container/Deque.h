@@ -3,6 +3,7 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <utility>
 
@@ -19,9 +20,9 @@ namespace hbe
 	class Deque final
 	{
 	public:
-		static constexpr int DefaultCapacity = 4;
+		using TIndex = size_t;
 
-		using TIndex = int;
+		static constexpr TIndex DefaultCapacity = 4;
 		using Iterator = TElement*;
 		using ConstIterator = const TElement*;
 
@@ -204,7 +205,7 @@ namespace hbe
 		[[nodiscard]] TIndex Size() const noexcept { return count; }
 		[[nodiscard]] TIndex Capacity() const noexcept { return mask + 1; }
 		[[nodiscard]] bool IsEmpty() const noexcept { return count == 0; }
-		[[nodiscard]] bool IsValidIndex(TIndex index) const noexcept { return index >= 0 && index < count; }
+		[[nodiscard]] bool IsValidIndex(TIndex index) const noexcept { return index < count; }
 
 		void Clear() noexcept
 		{
@@ -216,34 +217,44 @@ namespace hbe
 
 		void Reserve(TIndex newCapacity) noexcept
 		{
-			if (newCapacity <= Capacity())
-				return;
+			returnIf(newCapacity <= Capacity() && data != nullptr);
 
-			auto newMask = Capacity() - 1;
-			while (newMask + 1 < newCapacity)
+			const TIndex oldCapacity = data != nullptr ? Capacity() : 0;
+			const TIndex newSize = std::bit_ceil(std::max(newCapacity, DefaultCapacity));
+
+			// The elements moving as bytes go with the block, which the allocator might extend in place. Then the
+			// wrapped part moves after the old end, so they are in order from the head.
+			if constexpr (CTriviallyRelocatable<TElement> && CReallocatable<TAllocator>)
 			{
-				newMask = (newMask + 1) * 2 - 1;
+				if (data != nullptr)
+				{
+					auto* newData = allocator.reallocate(data, oldCapacity, newSize);
+					FatalAssert(newData != nullptr, "Deque failed to grow to %zu elements", newSize);
+
+					data = newData;
+					const TIndex numWrapped = head + count > oldCapacity ? head + count - oldCapacity : 0;
+					RelocateObjects(data + oldCapacity, data, numWrapped);
+
+					tail = head + count;
+					mask = newSize - 1;
+					return;
+				}
 			}
 
-			auto newSize = newMask + 1;
 			auto* newData = allocator.allocate(newSize);
 
-			for (TIndex i = 0; i < count; ++i)
-			{
-				auto srcIdx = WrapIndex(head + i);
-				new (&newData[i]) TElement(std::move(data[srcIdx]));
-				data[srcIdx].~TElement();
-			}
-
 			if (data != nullptr)
 			{
-				allocator.deallocate(data, Capacity());
+				const TIndex numFront = std::min(count, oldCapacity - head);
+				RelocateObjects(newData, data + head, numFront);
+				RelocateObjects(newData + numFront, data, count - numFront);
+				allocator.deallocate(data, oldCapacity);
 			}
 
 			data = newData;
 			head = 0;
 			tail = count;
-			mask = static_cast<TIndex>(newMask);
+			mask = newSize - 1;
 		}
 
 		void Swap(Deque& rhs) noexcept
@@ -0,0 +1,363 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "Memory/DefaultAllocator.h"
+#include "Memory/Memory.h"
+
+
+namespace hbe
+{
+
+	/// @brief A sorted map in one array, searched by binary search.
+	/// @details Inserting and removing shift the later entries, so it's for small maps. Map is a B+ tree for the
+	/// larger ones.
+	template<typename TKey, typename TValue, class TCompare = std::less<TKey>, class TAllocator = DefaultAllocator<uint8_t>>
+	class FlatMap final
+	{
+	public:
+		using TIndex = size_t;
+
+		static constexpr TIndex DefaultCapacity = 4;
+		static constexpr TIndex InvalidIndex = std::numeric_limits<TIndex>::max();
+
+		struct Pair final
+		{
+			TKey key;
+			TValue value;
+		};
+
+		class Iterator
+		{
+		public:
+			using TPair = Pair;
+			friend class FlatMap;
+
+		private:
+			Pair* ptr;
+
+		public:
+			explicit Iterator(Pair* ptr) noexcept : ptr(ptr) {}
+
+			Iterator& operator++() noexcept { ++ptr; return *this; }
+			bool operator==(const Iterator& rhs) const noexcept { return ptr == rhs.ptr; }
+			bool operator!=(const Iterator& rhs) const noexcept { return ptr != rhs.ptr; }
+			Pair& operator*() noexcept { return *ptr; }
+			const Pair& operator*() const noexcept { return *ptr; }
+			Pair* operator->() noexcept { return ptr; }
+			const Pair* operator->() const noexcept { return ptr; }
+		};
+
+		using ConstIterator = Iterator;
+
+		FlatMap() noexcept
+			: entries(nullptr)
+			, count(0)
+			, cap(0)
+		{
+		}
+
+		FlatMap(const FlatMap&) = delete;
+
+		FlatMap(FlatMap&& rhs) noexcept
+			: entries(rhs.entries)
+			, count(rhs.count)
+			, cap(rhs.cap)
+		{
+			rhs.entries = nullptr;
+			rhs.count = 0;
+			rhs.cap = 0;
+		}
+
+		~FlatMap()
+		{
+			Release();
+		}
+
+		FlatMap& operator=(const FlatMap&) = delete;
+
+		FlatMap& operator=(FlatMap&& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				Release();
+
+				entries = rhs.entries;
+				count = rhs.count;
+				cap = rhs.cap;
+
+				rhs.entries = nullptr;
+				rhs.count = 0;
+				rhs.cap = 0;
+			}
+
+			return *this;
+		}
+
+		Iterator begin() noexcept { return Iterator(entries); }
+		Iterator end() noexcept { return Iterator(entries + count); }
+		ConstIterator begin() const noexcept { return ConstIterator(entries); }
+		ConstIterator end() const noexcept { return ConstIterator(entries + count); }
+
+		TValue& operator[](const TKey& key)
+		{
+			auto idx = FindIndex(key);
+			if (idx != InvalidIndex)
+			{
+				return entries[idx].value;
+			}
+
+			idx = InsertSorted(key);
+			return entries[idx].value;
+		}
+
+		TValue& operator[](TKey&& key)
+		{
+			auto idx = FindIndex(key);
+			if (idx != InvalidIndex)
+			{
+				return entries[idx].value;
+			}
+
+			idx = InsertSorted(std::move(key));
+			return entries[idx].value;
+		}
+
+		[[nodiscard]] Iterator Find(const TKey& key) noexcept
+		{
+			auto idx = FindIndex(key);
+			if (idx == InvalidIndex)
+				return end();
+
+			return Iterator(entries + idx);
+		}
+
+		[[nodiscard]] ConstIterator Find(const TKey& key) const noexcept
+		{
+			auto idx = FindIndex(key);
+			if (idx == InvalidIndex)
+				return end();
+
+			return ConstIterator(entries + idx);
+		}
+
+		bool Insert(const TKey& key, const TValue& value)
+		{
+			auto idx = FindIndex(key);
+			if (idx != InvalidIndex)
+				return false;
+
+			idx = InsertSorted(key);
+			entries[idx].value = value;
+
+			return true;
+		}
+
+		bool Insert(const TKey& key, TValue&& value)
+		{
+			auto idx = FindIndex(key);
+			if (idx != InvalidIndex)
+				return false;
+
+			idx = InsertSorted(key);
+			entries[idx].value = std::move(value);
+
+			return true;
+		}
+
+		bool Insert(TKey&& key, TValue&& value)
+		{
+			auto idx = FindIndex(key);
+			if (idx != InvalidIndex)
+				return false;
+
+			idx = InsertSorted(std::move(key));
+			entries[idx].value = std::move(value);
+
+			return true;
+		}
+
+		bool Remove(const TKey& key)
+		{
+			auto idx = FindIndex(key);
+			if (idx == InvalidIndex)
+				return false;
+
+			entries[idx].~Pair();
+			RelocateObjects(entries + idx, entries + idx + 1, count - idx - 1);
+
+			--count;
+
+			return true;
+		}
+
+		[[nodiscard]] bool Contains(const TKey& key) const noexcept
+		{
+			return FindIndex(key) != InvalidIndex;
+		}
+
+		[[nodiscard]] TIndex Size() const noexcept { return count; }
+		[[nodiscard]] bool IsEmpty() const noexcept { return count == 0; }
+
+		void Clear() noexcept
+		{
+			for (TIndex i = 0; i < count; ++i)
+			{
+				entries[i].~Pair();
+			}
+
+			count = 0;
+		}
+
+	private:
+		Pair* entries;
+		TIndex count;
+		TIndex cap;
+		TCompare compare;
+		TAllocator allocator;
+
+		[[nodiscard]] TIndex FindIndex(const TKey& key) const noexcept
+		{
+			const auto idx = LowerBound(key);
+			if (idx >= count || compare(key, entries[idx].key))
+				return InvalidIndex;
+
+			return idx;
+		}
+
+		[[nodiscard]] TIndex LowerBound(const TKey& key) const noexcept
+		{
+			TIndex lo = 0;
+			TIndex hi = count;
+
+			while (lo < hi)
+			{
+				TIndex mid = lo + (hi - lo) / 2;
+
+				if (compare(entries[mid].key, key))
+				{
+					lo = mid + 1;
+				}
+				else
+				{
+					hi = mid;
+				}
+			}
+
+			return lo;
+		}
+
+		TIndex InsertSorted(const TKey& key) noexcept
+		{
+			if (count == cap)
+			{
+				Grow();
+			}
+
+			auto idx = LowerBound(key);
+
+			RelocateObjects(entries + idx + 1, entries + idx, count - idx);
+
+			new (&entries[idx]) Pair{key, TValue{}};
+			++count;
+
+			return idx;
+		}
+
+		TIndex InsertSorted(TKey&& key) noexcept
+		{
+			if (count == cap)
+			{
+				Grow();
+			}
+
+			auto idx = LowerBound(key);
+
+			RelocateObjects(entries + idx + 1, entries + idx, count - idx);
+
+			new (&entries[idx]) Pair{std::move(key), TValue{}};
+			++count;
+
+			return idx;
+		}
+
+		void Grow() noexcept
+		{
+			auto newCap = std::max(DefaultCapacity, cap * 2);
+			auto allocSize = sizeof(Pair) * newCap;
+
+			// The entries moving as bytes go with the block, which the allocator might extend in place.
+			if constexpr (CTriviallyRelocatable<Pair> && CReallocatable<TAllocator>)
+			{
+				if (entries != nullptr)
+				{
+					auto* oldRaw = reinterpret_cast<uint8_t*>(entries);
+					auto* raw = allocator.reallocate(oldRaw, sizeof(Pair) * cap, allocSize);
+					FatalAssert(raw != nullptr, "FlatMap failed to grow to %zu entries", newCap);
+
+					entries = reinterpret_cast<Pair*>(raw);
+					cap = newCap;
+					return;
+				}
+			}
+
+			auto* raw = allocator.allocate(allocSize);
+			auto* newEntries = reinterpret_cast<Pair*>(raw);
+			RelocateObjects(newEntries, entries, count);
+
+			if (entries != nullptr)
+			{
+				auto oldSize = sizeof(Pair) * cap;
+				allocator.deallocate(reinterpret_cast<uint8_t*>(entries), oldSize);
+			}
+
+			entries = newEntries;
+			cap = newCap;
+		}
+
+		void Release() noexcept
+		{
+			returnIf(entries == nullptr);
+
+			for (TIndex i = 0; i < count; ++i)
+			{
+				entries[i].~Pair();
+			}
+
+			auto allocSize = sizeof(Pair) * cap;
+			allocator.deallocate(reinterpret_cast<uint8_t*>(entries), allocSize);
+
+			entries = nullptr;
+			count = 0;
+			cap = 0;
+		}
+	};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+	class FlatMapTest : public TestCollection
+	{
+	public:
+		FlatMapTest() : TestCollection("FlatMapTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
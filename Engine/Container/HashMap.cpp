@@ -264,7 +264,7 @@ namespace hbe
 					m[i] = i;
 				}
 
-				volatile int sum = 0;
+				int sum = 0;
 				time::ScopedTime measure(heFindTime);
 				for (int i = 0; i < NumItems; ++i)
 				{
@@ -274,6 +274,10 @@ namespace hbe
 						sum += it->value;
 					}
 				}
+
+				// Keep the lookups from being optimized out.
+				volatile int sink = sum;
+				(void)sink;
 			}
 
 			{
@@ -283,7 +287,7 @@ namespace hbe
 					m[i] = i;
 				}
 
-				volatile int sum = 0;
+				int sum = 0;
 				time::ScopedTime measure(stlFindTime);
 				for (int i = 0; i < NumItems; ++i)
 				{
@@ -293,6 +297,10 @@ namespace hbe
 						sum += it->second;
 					}
 				}
+
+				// Keep the lookups from being optimized out.
+				volatile int sink = sum;
+				(void)sink;
 			}
 
 			ls << "HashMap insert: " << heInsertTime.count() << " us" << lf;
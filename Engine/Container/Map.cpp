@@ -4,12 +4,93 @@
 
 #ifdef __UNIT_TEST__
 #include <map>
+#include <string>
+#include "Container/FlatMap.h"
 #include "Core/ScopedTime.h"
+#include "HSTL/HVector.h"
 
 
 namespace hbe
 {
 
+	namespace
+	{
+		uint64_t SplitMix(uint64_t value) noexcept
+		{
+			value += 0x9E3779B97F4A7C15ULL;
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31);
+		}
+
+		template<typename TMap, typename TStdMap>
+		bool IsSame(const TMap& map, const TStdMap& expected)
+		{
+			returnValueIf(false, map.Size() != expected.size());
+
+			auto it = expected.begin();
+			for (auto& pair : map)
+			{
+				returnValueIf(false, it == expected.end() || pair.key != it->first || pair.value != it->second);
+				++it;
+			}
+
+			return it == expected.end();
+		}
+
+		// Random inserts and removes on both, compared in full every so often.
+		template<typename TKey, typename TMakeKey>
+		bool RunDifferential(int numOps, int keyRange, TMakeKey makeKey)
+		{
+			Map<TKey, int> map;
+			std::map<TKey, int> expected;
+			uint64_t seed = 7;
+
+			for (int i = 0; i < numOps; ++i)
+			{
+				seed = SplitMix(seed);
+				const auto key = makeKey(static_cast<int>(seed % keyRange));
+
+				if ((seed >> 32) % 3 == 0)
+				{
+					returnValueIf(false, map.Remove(key) != (expected.erase(key) > 0));
+				}
+				else
+				{
+					returnValueIf(false, map.Insert(key, i) != expected.emplace(key, i).second);
+				}
+
+				continueIf(i % 1000 != 0);
+				returnValueIf(false, !IsSame(map, expected));
+			}
+
+			returnValueIf(false, !IsSame(map, expected));
+
+			// Down to empty, which collapses the tree level by level.
+			while (!expected.empty())
+			{
+				const auto key = expected.begin()->first;
+				returnValueIf(false, !map.Remove(key));
+				expected.erase(key);
+			}
+
+			return map.IsEmpty() && map.begin() == map.end() && map.GetHeight() == 0;
+		}
+
+		template<typename TFunc>
+		double MeasureNs(size_t numOps, TFunc func)
+		{
+			time::TDuration duration;
+			{
+				time::ScopedTime timer(duration);
+				func();
+			}
+
+			return time::ToFloat(duration) * 1e9 / double(numOps);
+		}
+
+	} // anonymous namespace
+
 	void MapTest::Prepare()
 	{
 		AddTest("Default Construction", [](auto&) { Map<int, int> m; });
@@ -39,11 +120,12 @@ namespace hbe
 		AddTest("Sorted Order", [this](auto& ls)
 		{
 			Map<int, int> m;
-			m[3] = 30;
-			m[1] = 10;
-			m[2] = 20;
+			for (int i = 0; i < 10000; ++i)
+			{
+				m[(i * 7919) % 10000] = i;
+			}
 
-			int expected = 1;
+			int expected = 0;
 			for (auto& pair : m)
 			{
 				if (pair.key != expected)
@@ -55,6 +137,12 @@ namespace hbe
 				++expected;
 			}
 
+			if (expected != 10000 || m.GetHeight() == 0)
+			{
+				ls << "Iterated " << expected << ", height " << m.GetHeight() << lferr;
+				return;
+			}
+
 			ls << "Pass";
 		});
 
@@ -121,28 +209,17 @@ namespace hbe
 			ls << "Pass";
 		});
 
-		AddTest("Contains", [this](auto& ls)
+		AddTest("Clear", [this](auto& ls)
 		{
 			Map<int, int> m;
-			m[5] = 50;
-
-			if (!m.Contains(5) || m.Contains(99))
+			for (int i = 0; i < 1000; ++i)
 			{
-				ls << "Contains check failed" << lferr;
-				return;
+				m[i] = i;
 			}
 
-			ls << "Pass";
-		});
-
-		AddTest("Clear", [this](auto& ls)
-		{
-			Map<int, int> m;
-			m[1] = 10;
-			m[2] = 20;
 			m.Clear();
 
-			if (!m.IsEmpty() || m.Size() != 0)
+			if (!m.IsEmpty() || m.Size() != 0 || m.begin() != m.end())
 			{
 				ls << "Clear failed" << lferr;
 				return;
@@ -161,19 +238,22 @@ namespace hbe
 		AddTest("Move Semantics", [this](auto& ls)
 		{
 			Map<int, int> m1;
-			m1[1] = 10;
-			m1[2] = 20;
+			for (int i = 0; i < 1000; ++i)
+			{
+				m1[i] = i * 10;
+			}
 
 			Map<int, int> m2(std::move(m1));
-			if (m2.Size() != 2 || m2[1] != 10)
+			if (m2.Size() != 1000 || m2[1] != 10 || !m1.IsEmpty())
 			{
 				ls << "Move constructor failed" << lferr;
 				return;
 			}
 
 			Map<int, int> m3;
+			m3[5] = 5;
 			m3 = std::move(m2);
-			if (m3.Size() != 2 || m3[2] != 20)
+			if (m3.Size() != 1000 || m3[2] != 20 || m3[999] != 9990)
 			{
 				ls << "Move assignment failed" << lferr;
 				return;
@@ -182,81 +262,274 @@ namespace hbe
 			ls << "Pass";
 		});
 
-		AddTest("Performance vs std::map", [this](auto& ls)
+		AddTest("Lower and Upper Bounds", [this](auto& ls)
 		{
-			constexpr int NumItems = 10000;
-
-			time::TDuration heInsertTime;
-			time::TDuration stlInsertTime;
-			time::TDuration heFindTime;
-			time::TDuration stlFindTime;
+			Map<int, int> m;
+			for (int i = 0; i < 10000; ++i)
+			{
+				m[i * 2] = i;
+			}
 
+			const auto& constMap = m;
+			for (int key = -1; key < 20001; ++key)
 			{
-				time::ScopedTime measure(heInsertTime);
-				Map<int, int> m;
-				for (int i = 0; i < NumItems; ++i)
+				const int lower = key < 0 ? 0 : (key + 1) / 2 * 2;
+				const int upper = key < 0 ? 0 : key / 2 * 2 + 2;
+				auto lowerIt = m.LowerBound(key);
+				auto upperIt = constMap.UpperBound(key);
+
+				const bool isLowerRight = lower >= 20000 ? lowerIt == m.end()
+					: lowerIt != m.end() && lowerIt->key == lower;
+				const bool isUpperRight = upper >= 20000 ? upperIt == constMap.end()
+					: upperIt != constMap.end() && upperIt->key == upper;
+
+				if (!isLowerRight || !isUpperRight)
 				{
-					m[i] = i * 2;
+					ls << "Bounds of " << key << " are wrong" << lferr;
+					return;
 				}
 			}
 
+			// A range scan crosses the leaves.
+			int sum = 0;
+			for (auto it = m.LowerBound(1001), last = m.UpperBound(3000); it != last; ++it)
+			{
+				sum += it->key;
+			}
+
+			if (sum != (1002 + 3000) * 1000 / 2)
+			{
+				ls << "Range sum " << sum << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Random Operations against std::map", [this](auto& ls)
+		{
+			if (!RunDifferential<int>(200000, 5000, [](int i) { return i; }))
+			{
+				ls << "Integer keys differ from std::map" << lferr;
+				return;
+			}
+
+			// Non-trivial keys, moved around by the constructors.
+			auto makeString = [](int i) { return std::to_string(i) + "_key_long_enough"; };
+			if (!RunDifferential<std::string>(50000, 2000, makeString))
+			{
+				ls << "String keys differ from std::map" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Bulk Load", [this](auto& ls)
+		{
+			constexpr int NumItems = 100000;
+
+			HVector<Map<int, int>::Pair> sorted;
+			for (int i = 0; i < NumItems; ++i)
+			{
+				sorted.push_back({i * 3, i});
+			}
+
+			Map<int, int> m;
+			m[-1] = 1;
+			m.BulkLoad(sorted.begin(), sorted.end());
+
+			if (m.Size() != NumItems || m.Contains(-1) || m.Find(300)->value != 100)
+			{
+				ls << "Bulk load failed, size " << m.Size() << lferr;
+				return;
+			}
+
+			// It stays valid through the changes after.
+			std::map<int, int> expected;
+			for (auto& pair : sorted)
+			{
+				expected.emplace(pair.key, pair.value);
+			}
+
+			for (int i = 0; i < NumItems; ++i)
+			{
+				m.Insert(i * 3 + 1, i);
+				expected.emplace(i * 3 + 1, i);
+
+				m.Remove(i * 6);
+				expected.erase(i * 6);
+			}
+
+			if (!IsSame(m, expected))
+			{
+				ls << "Changes after the bulk load differ from std::map" << lferr;
+				return;
+			}
+
+			m.BulkLoad(sorted.begin(), sorted.begin());
+			if (!m.IsEmpty())
+			{
+				ls << "Empty bulk load failed" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Benchmark against std::map and FlatMap", [this](auto& ls)
+		{
+			constexpr size_t NumItems = 1000000;
+			constexpr size_t NumFlatItems = 10000;
+
+			HVector<int> randomKeys;
+			for (size_t i = 0; i < NumItems; ++i)
+			{
+				randomKeys.push_back(static_cast<int>(SplitMix(i) & 0x3FFFFFFF));
+			}
+
+			HVector<Map<int, int>::Pair> sorted;
+			for (size_t i = 0; i < NumItems; ++i)
 			{
-				time::ScopedTime measure(stlInsertTime);
-				std::map<int, int> m;
-				for (int i = 0; i < NumItems; ++i)
+				sorted.push_back({static_cast<int>(i), static_cast<int>(i)});
+			}
+
+			volatile int sink = 0;
+
+			Map<int, int> map;
+			std::map<int, int> stdMap;
+
+			const auto mapSequentialNs = MeasureNs(NumItems, [&]()
+			{
+				for (size_t i = 0; i < NumItems; ++i)
 				{
-					m[i] = i * 2;
+					map[static_cast<int>(i)] = 0;
 				}
-			}
+			});
 
+			const auto stdSequentialNs = MeasureNs(NumItems, [&]()
 			{
-				Map<int, int> m;
-				for (int i = 0; i < NumItems; ++i)
+				for (size_t i = 0; i < NumItems; ++i)
 				{
-					m[i] = i;
+					stdMap[static_cast<int>(i)] = 0;
 				}
+			});
 
-				volatile int sum = 0;
-				time::ScopedTime measure(heFindTime);
-				for (int i = 0; i < NumItems; ++i)
+			map.Clear();
+			stdMap.clear();
+
+			const auto mapRandomNs = MeasureNs(NumItems, [&]()
+			{
+				for (auto key : randomKeys)
 				{
-					auto it = m.Find(i);
-					if (it != m.end())
-					{
-						sum += it->value;
-					}
+					map[key] = key;
 				}
-			}
+			});
 
+			const auto stdRandomNs = MeasureNs(NumItems, [&]()
 			{
-				std::map<int, int> m;
-				for (int i = 0; i < NumItems; ++i)
+				for (auto key : randomKeys)
 				{
-					m[i] = i;
+					stdMap[key] = key;
 				}
+			});
 
-				volatile int sum = 0;
-				time::ScopedTime measure(stlFindTime);
-				for (int i = 0; i < NumItems; ++i)
+			const auto mapFindNs = MeasureNs(NumItems, [&]()
+			{
+				int sum = 0;
+				for (auto key : randomKeys)
 				{
-					auto it = m.find(i);
-					if (it != m.end())
-					{
-						sum += it->second;
-					}
+					sum += map.Find(key)->value;
 				}
-			}
+				sink = sum;
+			});
+
+			const auto stdFindNs = MeasureNs(NumItems, [&]()
+			{
+				int sum = 0;
+				for (auto key : randomKeys)
+				{
+					sum += stdMap.find(key)->second;
+				}
+				sink = sum;
+			});
 
-			ls << "Map insert (sorted vector): " << heInsertTime.count() << " us" << lf;
-			ls << "std::map insert (RB tree): " << stlInsertTime.count() << " us" << lf;
-			ls << "Map find (binary search): " << heFindTime.count() << " us" << lf;
-			ls << "std::map find (RB tree): " << stlFindTime.count() << " us" << lf;
+			const auto mapIterationNs = MeasureNs(map.Size(), [&]()
+			{
+				int sum = 0;
+				for (auto& pair : map)
+				{
+					sum += pair.value;
+				}
+				sink = sum;
+			});
 
-			if (heInsertTime > stlInsertTime * 3)
+			const auto stdIterationNs = MeasureNs(stdMap.size(), [&]()
 			{
-				ls << "Map insert is slower than 3x std::map (expected for sorted vector)" << lfwarn;
+				int sum = 0;
+				for (auto& pair : stdMap)
+				{
+					sum += pair.second;
+				}
+				sink = sum;
+			});
+
+			const auto bulkLoadNs = MeasureNs(NumItems, [&]() { map.BulkLoad(sorted.begin(), sorted.end()); });
+
+			ls << NumItems << " entries, Map vs std::map ns/op:" << lf;
+			ls << "  sequential insert " << mapSequentialNs << " vs " << stdSequentialNs << lf;
+			ls << "  random insert " << mapRandomNs << " vs " << stdRandomNs << lf;
+			ls << "  random find " << mapFindNs << " vs " << stdFindNs << lf;
+			ls << "  ordered iteration " << mapIterationNs << " vs " << stdIterationNs << lf;
+			ls << "  bulk load " << bulkLoadNs << lf;
+
+			if (mapFindNs > stdFindNs || mapIterationNs > stdIterationNs)
+			{
+				ls << "Map is slower than std::map at " << NumItems << " entries." << lfwarn;
 			}
 
+			Map<int, int> smallMap;
+			FlatMap<int, int> flatMap;
+
+			const auto smallInsertNs = MeasureNs(NumFlatItems, [&]()
+			{
+				for (size_t i = 0; i < NumFlatItems; ++i)
+				{
+					smallMap[randomKeys[i]] = 0;
+				}
+			});
+
+			const auto flatInsertNs = MeasureNs(NumFlatItems, [&]()
+			{
+				for (size_t i = 0; i < NumFlatItems; ++i)
+				{
+					flatMap[randomKeys[i]] = 0;
+				}
+			});
+
+			const auto smallFindNs = MeasureNs(NumFlatItems, [&]()
+			{
+				int sum = 0;
+				for (size_t i = 0; i < NumFlatItems; ++i)
+				{
+					sum += smallMap.Find(randomKeys[i])->value;
+				}
+				sink = sum;
+			});
+
+			const auto flatFindNs = MeasureNs(NumFlatItems, [&]()
+			{
+				int sum = 0;
+				for (size_t i = 0; i < NumFlatItems; ++i)
+				{
+					sum += flatMap.Find(randomKeys[i])->value;
+				}
+				sink = sum;
+			});
+
+			ls << NumFlatItems << " entries, Map vs FlatMap ns/op: random insert " << smallInsertNs << " vs "
+			   << flatInsertNs << ", random find " << smallFindNs << " vs " << flatFindNs << lf;
+
 			ls << "Pass";
 		});
 	}
@@ -3,9 +3,15 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <iterator>
+#include <new>
 #include <utility>
 
+#include "Config/EngineConfig.h"
 #include "Core/CommonMacros.h"
 #include "Core/Debug.h"
 #include "Memory/DefaultAllocator.h"
@@ -15,11 +21,17 @@
 namespace hbe
 {
 
+	/// @brief A sorted map in a B+ tree.
+	/// @details The entries are in the leaves, linked in order, and the inner nodes hold the separator keys only.
+	/// A node is about four cache lines, so a lookup touches a few lines per level, and the ordered iteration walks the
+	/// leaves one after another. Inserting and removing are O(log n), splitting a full node or merging with a sibling.
+	/// A split at the end of the last leaf keeps the left one full, so sequential keys pack the leaves. BulkLoad builds
+	/// the tree from sorted entries in O(n). FlatMap is smaller and faster for a few entries.
 	template<typename TKey, typename TValue, class TCompare = std::less<TKey>, class TAllocator = DefaultAllocator<uint8_t>>
 	class Map final
 	{
 	public:
-		static constexpr int DefaultCapacity = 4;
+		using TIndex = size_t;
 
 		struct Pair final
 		{
@@ -27,54 +39,159 @@ namespace hbe
 			TValue value;
 		};
 
-		using TIndex = int;
+		static constexpr size_t NodeSize = Config::CacheLineSize * 4;
+		static constexpr TIndex LeafCapacity = std::max<size_t>(4, NodeSize / sizeof(Pair));
+		static constexpr TIndex InnerCapacity = std::max<size_t>(4, NodeSize / (sizeof(TKey) + sizeof(void*)));
+		static_assert(LeafCapacity <= UINT16_MAX && InnerCapacity <= UINT16_MAX);
 
+	private:
+		static constexpr TIndex MinLeafCount = LeafCapacity / 2;
+		static constexpr TIndex MinInnerCount = InnerCapacity / 2;
+		// Every inner node has 3 children at least, so it's deeper than any tree in memory.
+		static constexpr int MaxHeight = 48;
+
+		struct Node
+		{
+			uint16_t count;
+			bool isLeaf;
+		};
+
+		struct Leaf final : Node
+		{
+			Leaf* prev;
+			Leaf* next;
+			alignas(Pair) uint8_t storage[sizeof(Pair) * LeafCapacity];
+
+			Pair* GetEntries() noexcept { return reinterpret_cast<Pair*>(storage); }
+			const Pair* GetEntries() const noexcept { return reinterpret_cast<const Pair*>(storage); }
+		};
+
+		// The keys separate the children: every key of children[i] is less than keys[i], and not less than keys[i - 1].
+		struct Inner final : Node
+		{
+			Node* children[InnerCapacity + 1];
+			alignas(TKey) uint8_t storage[sizeof(TKey) * InnerCapacity];
+
+			TKey* GetKeys() noexcept { return reinterpret_cast<TKey*>(storage); }
+			const TKey* GetKeys() const noexcept { return reinterpret_cast<const TKey*>(storage); }
+		};
+
+		// The inner nodes down from the root to a leaf, and the child taken from each.
+		struct Path final
+		{
+			Inner* nodes[MaxHeight];
+			TIndex indices[MaxHeight];
+			int depth = 0;
+		};
+
+	public:
 		class Iterator
 		{
 		public:
-			using TPair = Pair;
 			friend class Map;
 
 		private:
-			Pair* ptr;
+			Leaf* leaf;
+			TIndex index;
 
 		public:
-			explicit Iterator(Pair* ptr) noexcept : ptr(ptr) {}
-
-			Iterator& operator++() noexcept { ++ptr; return *this; }
-			bool operator==(const Iterator& rhs) const noexcept { return ptr == rhs.ptr; }
-			bool operator!=(const Iterator& rhs) const noexcept { return ptr != rhs.ptr; }
-			Pair& operator*() noexcept { return *ptr; }
-			const Pair& operator*() const noexcept { return *ptr; }
-			Pair* operator->() noexcept { return ptr; }
-			const Pair* operator->() const noexcept { return ptr; }
+			explicit Iterator(Leaf* leaf, TIndex index) noexcept
+				: leaf(leaf)
+				, index(index)
+			{
+			}
+
+			Iterator& operator++() noexcept
+			{
+				FatalAssert(leaf != nullptr);
+				if (++index >= leaf->count)
+				{
+					leaf = leaf->next;
+					index = 0;
+				}
+
+				return *this;
+			}
+
+			bool operator==(const Iterator& rhs) const noexcept { return leaf == rhs.leaf && index == rhs.index; }
+			bool operator!=(const Iterator& rhs) const noexcept { return !(*this == rhs); }
+
+			Pair& operator*() const noexcept
+			{
+				FatalAssert(leaf != nullptr && index < leaf->count);
+				return leaf->GetEntries()[index];
+			}
+
+			Pair* operator->() const noexcept { return &(**this); }
 		};
 
-		using ConstIterator = Iterator;
+		class ConstIterator
+		{
+		public:
+			friend class Map;
+
+		private:
+			const Leaf* leaf;
+			TIndex index;
+
+		public:
+			explicit ConstIterator(const Leaf* leaf, TIndex index) noexcept
+				: leaf(leaf)
+				, index(index)
+			{
+			}
+
+			ConstIterator& operator++() noexcept
+			{
+				FatalAssert(leaf != nullptr);
+				if (++index >= leaf->count)
+				{
+					leaf = leaf->next;
+					index = 0;
+				}
+
+				return *this;
+			}
+
+			bool operator==(const ConstIterator& rhs) const noexcept
+			{
+				return leaf == rhs.leaf && index == rhs.index;
+			}
+
+			bool operator!=(const ConstIterator& rhs) const noexcept { return !(*this == rhs); }
+
+			const Pair& operator*() const noexcept
+			{
+				FatalAssert(leaf != nullptr && index < leaf->count);
+				return leaf->GetEntries()[index];
+			}
+
+			const Pair* operator->() const noexcept { return &(**this); }
+		};
 
 		Map() noexcept
-			: entries(nullptr)
+			: root(nullptr)
+			, firstLeaf(nullptr)
 			, count(0)
-			, cap(0)
+			, height(0)
 		{
 		}
 
 		Map(const Map&) = delete;
 
 		Map(Map&& rhs) noexcept
-			: entries(rhs.entries)
+			: root(rhs.root)
+			, firstLeaf(rhs.firstLeaf)
 			, count(rhs.count)
-			, cap(rhs.cap)
+			, height(rhs.height)
 		{
-			rhs.entries = nullptr;
+			rhs.root = nullptr;
+			rhs.firstLeaf = nullptr;
 			rhs.count = 0;
-			rhs.cap = 0;
+			rhs.height = 0;
 		}
 
-		~Map()
-		{
-			Release();
-		}
+		~Map() { Clear(); }
 
 		Map& operator=(const Map&) = delete;
 
@@ -82,278 +199,638 @@ namespace hbe
 		{
 			if (this != &rhs)
 			{
-				Release();
+				Clear();
 
-				entries = rhs.entries;
+				root = rhs.root;
+				firstLeaf = rhs.firstLeaf;
 				count = rhs.count;
-				cap = rhs.cap;
+				height = rhs.height;
 
-				rhs.entries = nullptr;
+				rhs.root = nullptr;
+				rhs.firstLeaf = nullptr;
 				rhs.count = 0;
-				rhs.cap = 0;
+				rhs.height = 0;
 			}
 
 			return *this;
 		}
 
-		Iterator begin() noexcept { return Iterator(entries); }
-		Iterator end() noexcept { return Iterator(entries + count); }
-		ConstIterator begin() const noexcept { return ConstIterator(entries); }
-		ConstIterator end() const noexcept { return ConstIterator(entries + count); }
+		Iterator begin() noexcept { return Iterator(firstLeaf, 0); }
+		Iterator end() noexcept { return Iterator(nullptr, 0); }
+		ConstIterator begin() const noexcept { return ConstIterator(firstLeaf, 0); }
+		ConstIterator end() const noexcept { return ConstIterator(nullptr, 0); }
+
+		TValue& operator[](const TKey& key) { return InsertInternal(key).second->value; }
+		TValue& operator[](TKey&& key) { return InsertInternal(std::move(key)).second->value; }
 
-		TValue& operator[](const TKey& key)
+		[[nodiscard]] Iterator Find(const TKey& key) noexcept
 		{
-			auto idx = FindIndex(key);
-			if (idx >= 0)
-			{
-				return entries[idx].value;
-			}
+			auto it = LowerBound(key);
+			return it == end() || compare(key, it->key) ? end() : it;
+		}
 
-			idx = InsertSorted(key);
-			return entries[idx].value;
+		[[nodiscard]] ConstIterator Find(const TKey& key) const noexcept
+		{
+			auto it = LowerBound(key);
+			return it == end() || compare(key, it->key) ? end() : it;
 		}
 
-		TValue& operator[](TKey&& key)
+		// The first entry whose key is not less than the key.
+		[[nodiscard]] Iterator LowerBound(const TKey& key) noexcept
 		{
-			auto idx = FindIndex(key);
-			if (idx >= 0)
-			{
-				return entries[idx].value;
-			}
+			returnValueIf(end(), root == nullptr);
 
-			idx = InsertSorted(std::move(key));
-			return entries[idx].value;
+			auto* leaf = FindLeaf(key);
+			return MakeIterator(leaf, LowerBoundIn(*leaf, key));
 		}
 
-		[[nodiscard]] Iterator Find(const TKey& key) noexcept
+		[[nodiscard]] ConstIterator LowerBound(const TKey& key) const noexcept
 		{
-			auto idx = FindIndex(key);
-			if (idx < 0)
-				return end();
-
-			return Iterator(entries + idx);
+			auto it = const_cast<Map*>(this)->LowerBound(key);
+			return ConstIterator(it.leaf, it.index);
 		}
 
-		[[nodiscard]] ConstIterator Find(const TKey& key) const noexcept
+		// The first entry whose key is greater than the key.
+		[[nodiscard]] Iterator UpperBound(const TKey& key) noexcept
 		{
-			auto idx = FindIndex(key);
-			if (idx < 0)
-				return end();
+			returnValueIf(end(), root == nullptr);
+
+			auto* leaf = FindLeaf(key);
+			const auto* entries = leaf->GetEntries();
+			const auto found = std::upper_bound(entries, entries + leaf->count, key,
+				[this](const TKey& lhs, const Pair& rhs) { return compare(lhs, rhs.key); });
 
-			return ConstIterator(entries + idx);
+			return MakeIterator(leaf, static_cast<TIndex>(found - entries));
 		}
 
-		bool Insert(const TKey& key, const TValue& value)
+		[[nodiscard]] ConstIterator UpperBound(const TKey& key) const noexcept
 		{
-			auto idx = FindIndex(key);
-			if (idx >= 0)
-				return false;
+			auto it = const_cast<Map*>(this)->UpperBound(key);
+			return ConstIterator(it.leaf, it.index);
+		}
 
-			idx = InsertSorted(key);
-			entries[idx].value = value;
+		bool Insert(const TKey& key, const TValue& value)
+		{
+			auto [inserted, it] = InsertInternal(key);
+			if (inserted)
+			{
+				it->value = value;
+			}
 
-			return true;
+			return inserted;
 		}
 
 		bool Insert(const TKey& key, TValue&& value)
 		{
-			auto idx = FindIndex(key);
-			if (idx >= 0)
-				return false;
-
-			idx = InsertSorted(key);
-			entries[idx].value = std::move(value);
+			auto [inserted, it] = InsertInternal(key);
+			if (inserted)
+			{
+				it->value = std::move(value);
+			}
 
-			return true;
+			return inserted;
 		}
 
 		bool Insert(TKey&& key, TValue&& value)
 		{
-			auto idx = FindIndex(key);
-			if (idx >= 0)
-				return false;
-
-			idx = InsertSorted(std::move(key));
-			entries[idx].value = std::move(value);
+			auto [inserted, it] = InsertInternal(std::move(key));
+			if (inserted)
+			{
+				it->value = std::move(value);
+			}
 
-			return true;
+			return inserted;
 		}
 
 		bool Remove(const TKey& key)
 		{
-			auto idx = FindIndex(key);
-			if (idx < 0)
-				return false;
+			returnValueIf(false, root == nullptr);
+
+			Path path;
+			auto* leaf = FindLeaf(key, &path);
+			const auto pos = LowerBoundIn(*leaf, key);
+			returnValueIf(false, pos >= leaf->count || compare(key, leaf->GetEntries()[pos].key));
+
+			leaf->GetEntries()[pos].~Pair();
+			RelocateObjects(leaf->GetEntries() + pos, leaf->GetEntries() + pos + 1, leaf->count - pos - 1);
+			--leaf->count;
+			--count;
+
+			if (path.depth == 0)
+			{
+				if (leaf->count == 0)
+				{
+					FreeNode(leaf);
+					root = nullptr;
+					firstLeaf = nullptr;
+				}
+
+				return true;
+			}
 
-			entries[idx].~Pair();
+			returnValueIf(true, leaf->count >= MinLeafCount);
 
-			for (TIndex i = idx + 1; i < count; ++i)
+			// Each merge takes a key from the parent, which could be too few then.
+			bool isMerged = RebalanceLeaf(*leaf, *path.nodes[path.depth - 1], path.indices[path.depth - 1]);
+			for (int d = path.depth - 1; isMerged && d > 0 && path.nodes[d]->count < MinInnerCount; --d)
 			{
-				new (&entries[i - 1]) Pair(std::move(entries[i]));
-				entries[i].~Pair();
+				isMerged = RebalanceInner(*path.nodes[d], *path.nodes[d - 1], path.indices[d - 1]);
 			}
 
-			--count;
+			if (!root->isLeaf && root->count == 0)
+			{
+				auto* oldRoot = static_cast<Inner*>(root);
+				root = oldRoot->children[0];
+				FreeNode(oldRoot);
+				--height;
+			}
 
 			return true;
 		}
 
-		[[nodiscard]] bool Contains(const TKey& key) const noexcept
-		{
-			return FindIndex(key) >= 0;
-		}
+		[[nodiscard]] bool Contains(const TKey& key) const noexcept { return Find(key) != end(); }
 
 		[[nodiscard]] TIndex Size() const noexcept { return count; }
 		[[nodiscard]] bool IsEmpty() const noexcept { return count == 0; }
+		// The levels of the inner nodes.
+		[[nodiscard]] TIndex GetHeight() const noexcept { return height; }
 
 		void Clear() noexcept
 		{
-			for (TIndex i = 0; i < count; ++i)
+			if (root != nullptr)
 			{
-				entries[i].~Pair();
+				DestroyNode(root);
 			}
 
+			root = nullptr;
+			firstLeaf = nullptr;
 			count = 0;
+			height = 0;
 		}
 
-	private:
-		Pair* entries;
-		TIndex count;
-		TIndex cap;
-		TCompare compare;
-		TAllocator allocator;
-
-		[[nodiscard]] TIndex FindIndex(const TKey& key) const noexcept
+		// Replace the entries with the sorted ones, which must be in strictly ascending order of the keys. The leaves
+		// are filled up, and evenly, so every node has enough entries.
+		template<typename TIterator>
+		void BulkLoad(TIterator first, TIterator last)
 		{
-			if (count == 0)
-				return -1;
+			Clear();
 
-			TIndex lo = 0;
-			TIndex hi = count - 1;
+			const auto numEntries = static_cast<TIndex>(std::distance(first, last));
+			returnIf(numEntries == 0);
 
-			while (lo <= hi)
+			// The nodes of a level, and the first key in each of them.
+			const TIndex numLeaves = (numEntries + LeafCapacity - 1) / LeafCapacity;
+			const size_t bufferSize = (sizeof(Node*) + sizeof(const TKey*)) * numLeaves;
+			auto* buffer = allocator.allocate(bufferSize);
+			auto** nodes = reinterpret_cast<Node**>(buffer);
+			auto** minKeys = reinterpret_cast<const TKey**>(buffer + sizeof(Node*) * numLeaves);
+
+			Leaf* prevLeaf = nullptr;
+			for (TIndex i = 0; i < numLeaves; ++i)
 			{
-				TIndex mid = lo + (hi - lo) / 2;
+				auto* leaf = NewLeaf();
+				const TIndex numLeafEntries = GetShare(numEntries, numLeaves, i);
 
-				if (compare(entries[mid].key, key))
+				for (TIndex j = 0; j < numLeafEntries; ++j, ++first)
 				{
-					lo = mid + 1;
+					new (&leaf->GetEntries()[j]) Pair(*first);
+					Assert((prevLeaf == nullptr && j == 0)
+							|| compare(GetPrevKey(leaf, prevLeaf, j), leaf->GetEntries()[j].key),
+						"BulkLoad requires the keys in strictly ascending order.");
 				}
-				else if (compare(key, entries[mid].key))
+
+				leaf->count = static_cast<uint16_t>(numLeafEntries);
+				leaf->prev = prevLeaf;
+
+				if (prevLeaf != nullptr)
 				{
-					hi = mid - 1;
+					prevLeaf->next = leaf;
 				}
-				else
+
+				prevLeaf = leaf;
+				nodes[i] = leaf;
+				minKeys[i] = &leaf->GetEntries()[0].key;
+			}
+
+			firstLeaf = static_cast<Leaf*>(nodes[0]);
+			count = numEntries;
+
+			for (TIndex levelCount = numLeaves; levelCount > 1; ++height)
+			{
+				const TIndex numParents = (levelCount + InnerCapacity) / (InnerCapacity + 1);
+				TIndex child = 0;
+
+				for (TIndex i = 0; i < numParents; ++i)
 				{
-					return mid;
+					auto* inner = NewInner();
+					const TIndex numChildren = GetShare(levelCount, numParents, i);
+
+					inner->children[0] = nodes[child];
+					for (TIndex j = 1; j < numChildren; ++j)
+					{
+						new (&inner->GetKeys()[j - 1]) TKey(*minKeys[child + j]);
+						inner->children[j] = nodes[child + j];
+					}
+
+					inner->count = static_cast<uint16_t>(numChildren - 1);
+					nodes[i] = inner;
+					minKeys[i] = minKeys[child];
+					child += numChildren;
 				}
+
+				levelCount = numParents;
 			}
 
-			return -1;
+			root = nodes[0];
+			allocator.deallocate(buffer, bufferSize);
 		}
 
-		[[nodiscard]] TIndex LowerBound(const TKey& key) const noexcept
+	private:
+		Node* root;
+		Leaf* firstLeaf;
+		TIndex count;
+		TIndex height;
+		TCompare compare;
+		TAllocator allocator;
+
+		static void MoveChildren(Node** dst, Node** src, TIndex n) noexcept
 		{
-			TIndex lo = 0;
-			TIndex hi = count;
+			std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(Node*) * n);
+		}
 
-			while (lo < hi)
+		// The i-th of n parts of the total, as even as possible.
+		[[nodiscard]] static TIndex GetShare(TIndex total, TIndex n, TIndex i) noexcept
+		{
+			return total / n + (i < total % n ? 1 : 0);
+		}
+
+		[[nodiscard]] static const TKey& GetPrevKey(const Leaf* leaf, const Leaf* prevLeaf, TIndex index) noexcept
+		{
+			return index > 0 ? leaf->GetEntries()[index - 1].key : prevLeaf->GetEntries()[prevLeaf->count - 1].key;
+		}
+
+		[[nodiscard]] Iterator MakeIterator(Leaf* leaf, TIndex index) noexcept
+		{
+			// The keys of the next leaf are not less than the separator above it, which the key is less than.
+			return index < leaf->count ? Iterator(leaf, index) : Iterator(leaf->next, 0);
+		}
+
+		[[nodiscard]] TIndex LowerBoundIn(const Leaf& leaf, const TKey& key) const noexcept
+		{
+			const auto* entries = leaf.GetEntries();
+			const auto found = std::lower_bound(entries, entries + leaf.count, key,
+				[this](const Pair& lhs, const TKey& rhs) { return compare(lhs.key, rhs); });
+
+			return static_cast<TIndex>(found - entries);
+		}
+
+		// The child whose keys could include the key.
+		[[nodiscard]] TIndex GetChildIndex(const Inner& inner, const TKey& key) const noexcept
+		{
+			const auto* keys = inner.GetKeys();
+			const auto found = std::upper_bound(keys, keys + inner.count, key,
+				[this](const TKey& lhs, const TKey& rhs) { return compare(lhs, rhs); });
+
+			return static_cast<TIndex>(found - keys);
+		}
+
+		[[nodiscard]] Leaf* FindLeaf(const TKey& key, Path* outPath = nullptr) const noexcept
+		{
+			Node* node = root;
+			while (!node->isLeaf)
 			{
-				TIndex mid = lo + (hi - lo) / 2;
+				auto* inner = static_cast<Inner*>(node);
+				const auto index = GetChildIndex(*inner, key);
 
-				if (compare(entries[mid].key, key))
+				if (outPath != nullptr)
 				{
-					lo = mid + 1;
-				}
-				else
-				{
-					hi = mid;
+					outPath->nodes[outPath->depth] = inner;
+					outPath->indices[outPath->depth] = index;
+					++outPath->depth;
 				}
+
+				node = inner->children[index];
 			}
 
-			return lo;
+			return static_cast<Leaf*>(node);
 		}
 
-		TIndex InsertSorted(const TKey& key) noexcept
+		template<typename TKeyArg>
+		std::pair<bool, Iterator> InsertInternal(TKeyArg&& key)
 		{
-			if (count == cap)
+			if (unlikely(root == nullptr))
 			{
-				Grow();
+				firstLeaf = NewLeaf();
+				root = firstLeaf;
 			}
 
-			auto idx = LowerBound(key);
-
-			for (TIndex i = count; i > idx; --i)
+			Path path;
+			auto* leaf = FindLeaf(key, &path);
+			const auto pos = LowerBoundIn(*leaf, key);
+			if (pos < leaf->count && !compare(key, leaf->GetEntries()[pos].key))
 			{
-				new (&entries[i]) Pair(std::move(entries[i - 1]));
-				entries[i - 1].~Pair();
+				return {false, Iterator(leaf, pos)};
 			}
 
-			new (&entries[idx]) Pair{key, TValue{}};
 			++count;
 
-			return idx;
+			if (leaf->count < LeafCapacity)
+			{
+				InsertEntry(*leaf, pos, std::forward<TKeyArg>(key));
+				return {true, Iterator(leaf, pos)};
+			}
+
+			const bool isAppending = pos == leaf->count && leaf->next == nullptr;
+			const TIndex mid = isAppending ? leaf->count : leaf->count / 2;
+
+			auto* right = NewLeaf();
+			RelocateObjects(right->GetEntries(), leaf->GetEntries() + mid, leaf->count - mid);
+			right->count = static_cast<uint16_t>(leaf->count - mid);
+			leaf->count = static_cast<uint16_t>(mid);
+
+			right->prev = leaf;
+			right->next = leaf->next;
+			if (leaf->next != nullptr)
+			{
+				leaf->next->prev = right;
+			}
+			leaf->next = right;
+
+			auto* target = pos >= mid ? right : leaf;
+			const auto targetPos = pos >= mid ? pos - mid : pos;
+			InsertEntry(*target, targetPos, std::forward<TKeyArg>(key));
+
+			InsertSeparator(path, right->GetEntries()[0].key, right, isAppending);
+
+			return {true, Iterator(target, targetPos)};
+		}
+
+		template<typename TKeyArg>
+		void InsertEntry(Leaf& leaf, TIndex pos, TKeyArg&& key)
+		{
+			auto* entries = leaf.GetEntries();
+			RelocateObjects(entries + pos + 1, entries + pos, leaf.count - pos);
+			new (&entries[pos]) Pair{std::forward<TKeyArg>(key), TValue{}};
+			++leaf.count;
+		}
+
+		// Insert the separator and the new child on its right into the parents, splitting the full ones up.
+		void InsertSeparator(Path& path, const TKey& separator, Node* child, bool isAppending)
+		{
+			TKey key(separator);
+
+			for (int d = path.depth - 1; d >= 0; --d)
+			{
+				auto& inner = *path.nodes[d];
+				const auto index = path.indices[d];
+
+				if (inner.count < InnerCapacity)
+				{
+					InsertKey(inner, index, std::move(key), child);
+					return;
+				}
+
+				// The middle key goes up, or the new one if it's in the middle.
+				const TIndex numKeys = inner.count;
+				const TIndex mid = isAppending ? numKeys - 1 : numKeys / 2;
+				auto* keys = inner.GetKeys();
+				auto* right = NewInner();
+
+				if (index == mid)
+				{
+					RelocateObjects(right->GetKeys(), keys + mid, numKeys - mid);
+					right->children[0] = child;
+					MoveChildren(right->children + 1, inner.children + mid + 1, numKeys - mid);
+					right->count = static_cast<uint16_t>(numKeys - mid);
+					inner.count = static_cast<uint16_t>(mid);
+				}
+				else
+				{
+					TKey promoted(std::move(keys[mid]));
+					keys[mid].~TKey();
+
+					RelocateObjects(right->GetKeys(), keys + mid + 1, numKeys - mid - 1);
+					MoveChildren(right->children, inner.children + mid + 1, numKeys - mid);
+					right->count = static_cast<uint16_t>(numKeys - mid - 1);
+					inner.count = static_cast<uint16_t>(mid);
+
+					if (index < mid)
+					{
+						InsertKey(inner, index, std::move(key), child);
+					}
+					else
+					{
+						InsertKey(*right, index - mid - 1, std::move(key), child);
+					}
+
+					key = std::move(promoted);
+				}
+
+				child = right;
+			}
+
+			auto* newRoot = NewInner();
+			new (&newRoot->GetKeys()[0]) TKey(std::move(key));
+			newRoot->children[0] = root;
+			newRoot->children[1] = child;
+			newRoot->count = 1;
+
+			root = newRoot;
+			++height;
 		}
 
-		TIndex InsertSorted(TKey&& key) noexcept
+		void InsertKey(Inner& inner, TIndex index, TKey&& key, Node* child)
 		{
-			if (count == cap)
+			auto* keys = inner.GetKeys();
+			RelocateObjects(keys + index + 1, keys + index, inner.count - index);
+			new (&keys[index]) TKey(std::move(key));
+
+			MoveChildren(inner.children + index + 2, inner.children + index + 1, inner.count - index);
+			inner.children[index + 1] = child;
+			++inner.count;
+		}
+
+		// Remove the key and the child on its right.
+		void RemoveKey(Inner& inner, TIndex index) noexcept
+		{
+			auto* keys = inner.GetKeys();
+			keys[index].~TKey();
+			RelocateObjects(keys + index, keys + index + 1, inner.count - index - 1);
+
+			MoveChildren(inner.children + index + 1, inner.children + index + 2, inner.count - index - 1);
+			--inner.count;
+		}
+
+		// Borrow an entry from a sibling, or merge with it. Return true if merged, taking a key from the parent.
+		bool RebalanceLeaf(Leaf& leaf, Inner& parent, TIndex index)
+		{
+			auto* keys = parent.GetKeys();
+			auto* entries = leaf.GetEntries();
+			auto* left = index > 0 ? static_cast<Leaf*>(parent.children[index - 1]) : nullptr;
+			auto* right = index < parent.count ? static_cast<Leaf*>(parent.children[index + 1]) : nullptr;
+
+			if (left != nullptr && left->count > MinLeafCount)
 			{
-				Grow();
+				RelocateObjects(entries + 1, entries, leaf.count);
+				RelocateObjects(entries, left->GetEntries() + left->count - 1, 1);
+				++leaf.count;
+				--left->count;
+
+				keys[index - 1] = entries[0].key;
+				return false;
 			}
 
-			auto idx = LowerBound(key);
+			if (right != nullptr && right->count > MinLeafCount)
+			{
+				auto* rightEntries = right->GetEntries();
+				RelocateObjects(entries + leaf.count, rightEntries, 1);
+				RelocateObjects(rightEntries, rightEntries + 1, right->count - 1);
+				++leaf.count;
+				--right->count;
+
+				keys[index] = rightEntries[0].key;
+				return false;
+			}
 
-			for (TIndex i = count; i > idx; --i)
+			if (left != nullptr)
+			{
+				MergeLeaves(*left, leaf);
+				RemoveKey(parent, index - 1);
+			}
+			else
 			{
-				new (&entries[i]) Pair(std::move(entries[i - 1]));
-				entries[i - 1].~Pair();
+				MergeLeaves(leaf, *right);
+				RemoveKey(parent, index);
 			}
 
-			new (&entries[idx]) Pair{std::move(key), TValue{}};
-			++count;
+			return true;
+		}
 
-			return idx;
+		void MergeLeaves(Leaf& left, Leaf& right) noexcept
+		{
+			RelocateObjects(left.GetEntries() + left.count, right.GetEntries(), right.count);
+			left.count = static_cast<uint16_t>(left.count + right.count);
+			right.count = 0;
+
+			left.next = right.next;
+			if (right.next != nullptr)
+			{
+				right.next->prev = &left;
+			}
+
+			FreeNode(&right);
 		}
 
-		void Grow() noexcept
+		// Rotate a key through the parent from a sibling, or merge with it. Return true if merged.
+		bool RebalanceInner(Inner& inner, Inner& parent, TIndex index)
 		{
-			auto newCap = std::max(DefaultCapacity, cap * 2);
-			auto allocSize = sizeof(Pair) * newCap;
-			auto* raw = allocator.allocate(allocSize);
-			auto* newEntries = reinterpret_cast<Pair*>(raw);
+			auto* parentKeys = parent.GetKeys();
+			auto* keys = inner.GetKeys();
+			auto* left = index > 0 ? static_cast<Inner*>(parent.children[index - 1]) : nullptr;
+			auto* right = index < parent.count ? static_cast<Inner*>(parent.children[index + 1]) : nullptr;
+
+			if (left != nullptr && left->count > MinInnerCount)
+			{
+				auto* leftKeys = left->GetKeys();
+				RelocateObjects(keys + 1, keys, inner.count);
+				new (&keys[0]) TKey(std::move(parentKeys[index - 1]));
+				MoveChildren(inner.children + 1, inner.children, inner.count + 1);
+				inner.children[0] = left->children[left->count];
+				++inner.count;
+
+				parentKeys[index - 1] = std::move(leftKeys[left->count - 1]);
+				leftKeys[left->count - 1].~TKey();
+				--left->count;
+				return false;
+			}
 
-			for (TIndex i = 0; i < count; ++i)
+			if (right != nullptr && right->count > MinInnerCount)
 			{
-				new (&newEntries[i]) Pair(std::move(entries[i]));
-				entries[i].~Pair();
+				auto* rightKeys = right->GetKeys();
+				new (&keys[inner.count]) TKey(std::move(parentKeys[index]));
+				inner.children[inner.count + 1] = right->children[0];
+				++inner.count;
+
+				parentKeys[index] = std::move(rightKeys[0]);
+				rightKeys[0].~TKey();
+				RelocateObjects(rightKeys, rightKeys + 1, right->count - 1);
+				MoveChildren(right->children, right->children + 1, right->count);
+				--right->count;
+				return false;
 			}
 
-			if (entries != nullptr)
+			if (left != nullptr)
+			{
+				MergeInners(*left, inner, parentKeys[index - 1]);
+				RemoveKey(parent, index - 1);
+			}
+			else
 			{
-				auto oldSize = sizeof(Pair) * cap;
-				allocator.deallocate(reinterpret_cast<uint8_t*>(entries), oldSize);
+				MergeInners(inner, *right, parentKeys[index]);
+				RemoveKey(parent, index);
 			}
 
-			entries = newEntries;
-			cap = newCap;
+			return true;
+		}
+
+		// The separator comes down between them.
+		void MergeInners(Inner& left, Inner& right, TKey& separator) noexcept
+		{
+			auto* keys = left.GetKeys();
+			new (&keys[left.count]) TKey(std::move(separator));
+			RelocateObjects(keys + left.count + 1, right.GetKeys(), right.count);
+			MoveChildren(left.children + left.count + 1, right.children, right.count + 1);
+
+			left.count = static_cast<uint16_t>(left.count + right.count + 1);
+			right.count = 0;
+			FreeNode(&right);
+		}
+
+		[[nodiscard]] Leaf* NewLeaf()
+		{
+			auto* leaf = new (allocator.allocate(sizeof(Leaf))) Leaf;
+			leaf->count = 0;
+			leaf->isLeaf = true;
+			leaf->prev = nullptr;
+			leaf->next = nullptr;
+
+			return leaf;
+		}
+
+		[[nodiscard]] Inner* NewInner()
+		{
+			auto* inner = new (allocator.allocate(sizeof(Inner))) Inner;
+			inner->count = 0;
+			inner->isLeaf = false;
+
+			return inner;
 		}
 
-		void Release() noexcept
+		// The node should be empty.
+		void FreeNode(Leaf* leaf) noexcept { allocator.deallocate(reinterpret_cast<uint8_t*>(leaf), sizeof(Leaf)); }
+		void FreeNode(Inner* inner) noexcept
 		{
-			returnIf(entries == nullptr);
+			allocator.deallocate(reinterpret_cast<uint8_t*>(inner), sizeof(Inner));
+		}
 
-			for (TIndex i = 0; i < count; ++i)
+		void DestroyNode(Node* node) noexcept
+		{
+			if (node->isLeaf)
 			{
-				entries[i].~Pair();
+				auto* leaf = static_cast<Leaf*>(node);
+				std::destroy_n(leaf->GetEntries(), leaf->count);
+				FreeNode(leaf);
+				return;
 			}
 
-			auto allocSize = sizeof(Pair) * cap;
-			allocator.deallocate(reinterpret_cast<uint8_t*>(entries), allocSize);
+			auto* inner = static_cast<Inner*>(node);
+			for (TIndex i = 0; i <= inner->count; ++i)
+			{
+				DestroyNode(inner->children[i]);
+			}
 
-			entries = nullptr;
-			count = 0;
-			cap = 0;
+			std::destroy_n(inner->GetKeys(), inner->count);
+			FreeNode(inner);
 		}
 	};
 
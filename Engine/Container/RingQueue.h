@@ -19,7 +19,7 @@ namespace hbe
 	class RingQueue final
 	{
 	public:
-		using TIndex = int;
+		using TIndex = size_t;
 
 		RingQueue(const RingQueue&) = delete;
 
@@ -33,7 +33,7 @@ namespace hbe
 			FatalAssert(fixedCapacity > 0, "RingQueue capacity must be positive");
 
 			// Round up to power of 2 for efficient bitmasking
-			TIndex pow2Capacity = static_cast<TIndex>(std::bit_ceil(static_cast<unsigned int>(fixedCapacity)));
+			const TIndex pow2Capacity = std::bit_ceil(fixedCapacity);
 
 			TAllocator alloc;
 			data = alloc.allocate(pow2Capacity);
@@ -144,7 +144,7 @@ namespace hbe
 		[[nodiscard]] TIndex Capacity() const noexcept { return cap; }
 		[[nodiscard]] bool IsEmpty() const noexcept { return count == 0; }
 		[[nodiscard]] bool IsFull() const noexcept { return count == cap; }
-		[[nodiscard]] bool IsValidIndex(TIndex index) const noexcept { return index >= 0 && index < Size(); }
+		[[nodiscard]] bool IsValidIndex(TIndex index) const noexcept { return index < Size(); }
 
 		void Clear() noexcept
 		{
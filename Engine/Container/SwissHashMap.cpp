@@ -0,0 +1,458 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "SwissHashMap.h"
+
+#ifdef __UNIT_TEST__
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Core/ScopedTime.h"
+#include "HashMap.h"
+
+
+namespace hbe
+{
+
+	namespace
+	{
+		uint64_t SplitMix(uint64_t value) noexcept
+		{
+			value += 0x9E3779B97F4A7C15ULL;
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31);
+		}
+
+		// std::unordered_map with the API of the engine maps, for the benchmarks.
+		struct StdMap final
+		{
+			std::unordered_map<uint64_t, uint64_t> map;
+
+			void Insert(uint64_t key, uint64_t value) { map.emplace(key, value); }
+			bool Contains(uint64_t key) const { return map.find(key) != map.end(); }
+			void Remove(uint64_t key) { map.erase(key); }
+		};
+
+		template<typename TMap>
+		struct EngineMap final
+		{
+			TMap map;
+
+			void Insert(uint64_t key, uint64_t value) { map.Insert(key, value); }
+			bool Contains(uint64_t key) const { return map.Contains(key); }
+			void Remove(uint64_t key) { map.Remove(key); }
+		};
+
+		struct BenchmarkResult final
+		{
+			double insertNs = 0;
+			double hitNs = 0;
+			double missNs = 0;
+			double churnNs = 0;
+		};
+
+		// Keys of the indices [0, size) are inserted, missed keys are of [size, 2 * size), and the churn removes the
+		// oldest key and inserts a new one, size times.
+		template<typename TBench>
+		BenchmarkResult RunRound(const std::vector<uint64_t>& keys, size_t size)
+		{
+			BenchmarkResult result;
+			auto bench = std::make_unique<TBench>();
+			time::TDuration duration;
+			volatile size_t numFound = 0;
+
+			{
+				time::ScopedTime timer(duration);
+				for (size_t i = 0; i < size; ++i)
+				{
+					bench->Insert(keys[i], i);
+				}
+			}
+			result.insertNs = time::ToFloat(duration) * 1e9 / size;
+
+			{
+				size_t found = 0;
+				time::ScopedTime timer(duration);
+				for (size_t i = 0; i < size; ++i)
+				{
+					found += bench->Contains(keys[i]) ? 1 : 0;
+				}
+				numFound = numFound + found;
+			}
+			result.hitNs = time::ToFloat(duration) * 1e9 / size;
+
+			{
+				size_t found = 0;
+				time::ScopedTime timer(duration);
+				for (size_t i = size; i < size * 2; ++i)
+				{
+					found += bench->Contains(keys[i]) ? 1 : 0;
+				}
+				numFound = numFound + found;
+			}
+			result.missNs = time::ToFloat(duration) * 1e9 / size;
+
+			{
+				time::ScopedTime timer(duration);
+				for (size_t i = 0; i < size; ++i)
+				{
+					bench->Remove(keys[i]);
+					bench->Insert(keys[size + i], i);
+				}
+			}
+			result.churnNs = time::ToFloat(duration) * 1e9 / size;
+
+			return result;
+		}
+
+		template<typename TBench>
+		BenchmarkResult RunBenchmark(const std::vector<uint64_t>& keys, size_t size, int numRounds)
+		{
+			auto best = RunRound<TBench>(keys, size);
+
+			for (int i = 1; i < numRounds; ++i)
+			{
+				const auto result = RunRound<TBench>(keys, size);
+				best.insertNs = std::min(best.insertNs, result.insertNs);
+				best.hitNs = std::min(best.hitNs, result.hitNs);
+				best.missNs = std::min(best.missNs, result.missNs);
+				best.churnNs = std::min(best.churnNs, result.churnNs);
+			}
+
+			return best;
+		}
+
+		struct Tracked final
+		{
+			static inline int numAlive = 0;
+
+			std::unique_ptr<int> value;
+
+			Tracked() : value(std::make_unique<int>(0)) { ++numAlive; }
+			explicit Tracked(int value) : value(std::make_unique<int>(value)) { ++numAlive; }
+			Tracked(const Tracked& rhs) : value(std::make_unique<int>(*rhs.value)) { ++numAlive; }
+			Tracked(Tracked&& rhs) noexcept : value(std::move(rhs.value)) { ++numAlive; }
+			~Tracked() { --numAlive; }
+
+			Tracked& operator=(const Tracked& rhs)
+			{
+				*value = *rhs.value;
+				return *this;
+			}
+
+			Tracked& operator=(Tracked&& rhs) noexcept
+			{
+				value = std::move(rhs.value);
+				return *this;
+			}
+		};
+
+	} // anonymous namespace
+
+	void SwissHashMapTest::Prepare()
+	{
+		AddTest("Default Construction", [](auto&) { SwissHashMap<int, int> m; });
+
+		AddTest("Insert and Access", [this](auto& ls)
+		{
+			SwissHashMap<int, int> m;
+			m[1] = 10;
+			m[2] = 20;
+			m[3] = 30;
+
+			if (m[1] != 10 || m[2] != 20 || m[3] != 30 || m.Size() != 3)
+			{
+				ls << "Insert/Access failed" << lferr;
+				return;
+			}
+
+			FatalAssert(m.Insert(4, 40));
+			FatalAssert(!m.Insert(4, 400));
+
+			if (m[4] != 40)
+			{
+				ls << "Value should remain 40 after failed duplicate insert" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Find and Remove", [this](auto& ls)
+		{
+			SwissHashMap<int, int> m;
+			for (int i = 0; i < 100; ++i)
+			{
+				m[i] = i * 10;
+			}
+
+			auto it = m.Find(10);
+			if (it == m.end() || it->value != 100 || m.Find(999) != m.end())
+			{
+				ls << "Find failed" << lferr;
+				return;
+			}
+
+			for (int i = 0; i < 100; i += 2)
+			{
+				FatalAssert(m.Remove(i));
+			}
+
+			FatalAssert(!m.Remove(0));
+
+			for (int i = 0; i < 100; ++i)
+			{
+				if (m.Contains(i) != (i % 2 == 1))
+				{
+					ls << "Contains(" << i << ") is wrong after Remove" << lferr;
+					return;
+				}
+			}
+
+			if (m.Size() != 50)
+			{
+				ls << "Expected size 50, got " << m.Size() << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Growth and Iteration", [this](auto& ls)
+		{
+			SwissHashMap<int, int> m;
+			constexpr int count = 10000;
+
+			for (int i = 0; i < count; ++i)
+			{
+				m[i] = i * 2;
+			}
+
+			if (m.Size() != count || m.Capacity() - m.Capacity() / 8 < m.Size())
+			{
+				ls << "Size " << m.Size() << ", capacity " << m.Capacity() << lferr;
+				return;
+			}
+
+			int64_t sum = 0;
+			int numVisited = 0;
+			for (auto& pair : m)
+			{
+				if (pair.value != pair.key * 2)
+				{
+					ls << "Mismatch at " << pair.key << lferr;
+					return;
+				}
+
+				sum += pair.key;
+				++numVisited;
+			}
+
+			if (numVisited != count || sum != int64_t(count) * (count - 1) / 2)
+			{
+				ls << "Iteration failed: visited " << numVisited << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Churn Doesn't Grow", [this](auto& ls)
+		{
+			SwissHashMap<int, int> m;
+			m.Reserve(1000);
+			const auto capacity = m.Capacity();
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				m[i] = i;
+			}
+
+			for (int i = 0; i < 100000; ++i)
+			{
+				FatalAssert(m.Remove(i));
+				m[i + 1000] = i;
+			}
+
+			if (m.Capacity() != capacity || m.Size() != 1000)
+			{
+				ls << "Capacity " << capacity << " -> " << m.Capacity() << ", size " << m.Size() << lferr;
+				return;
+			}
+
+			for (int i = 100000; i < 101000; ++i)
+			{
+				if (!m.Contains(i))
+				{
+					ls << "Key " << i << " is lost" << lferr;
+					return;
+				}
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Clear and Move", [this](auto& ls)
+		{
+			SwissHashMap<int, int> m1;
+			m1[1] = 10;
+			m1[2] = 20;
+
+			SwissHashMap<int, int> m2(std::move(m1));
+			if (m2.Size() != 2 || m2[1] != 10 || !m1.IsEmpty())
+			{
+				ls << "Move constructor failed" << lferr;
+				return;
+			}
+
+			SwissHashMap<int, int> m3;
+			m3 = std::move(m2);
+			if (m3.Size() != 2 || m3[2] != 20)
+			{
+				ls << "Move assignment failed" << lferr;
+				return;
+			}
+
+			m3.Clear();
+			m3[3] = 30;
+			if (m3.Size() != 1 || m3[3] != 30 || m3.Contains(1))
+			{
+				ls << "Reuse after Clear failed" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Non-trivial Types", [this](auto& ls)
+		{
+			{
+				SwissHashMap<std::string, Tracked> m;
+				for (int i = 0; i < 1000; ++i)
+				{
+					m.Insert(std::to_string(i), Tracked(i));
+				}
+
+				for (int i = 0; i < 1000; i += 3)
+				{
+					m.Remove(std::to_string(i));
+				}
+
+				if (*m["500"].value != 500 || m.Contains("999"))
+				{
+					ls << "Lookup of string keys failed" << lferr;
+					return;
+				}
+			}
+
+			if (Tracked::numAlive != 0)
+			{
+				ls << Tracked::numAlive << " values are leaked" << lferr;
+				return;
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Random Operations vs std::unordered_map", [this](auto& ls)
+		{
+			SwissHashMap<uint64_t, uint64_t> m;
+			std::unordered_map<uint64_t, uint64_t> expected;
+
+			for (uint64_t i = 0; i < 200000; ++i)
+			{
+				const auto random = SplitMix(i);
+				// A small key range, so the keys are removed and inserted again.
+				const auto key = (random >> 8) % 5000;
+
+				if ((random & 3) == 0)
+				{
+					if (m.Remove(key) != (expected.erase(key) > 0))
+					{
+						ls << "Remove(" << key << ") mismatched at " << i << lferr;
+						return;
+					}
+
+					continue;
+				}
+
+				if (m.Insert(key, i) != expected.emplace(key, i).second)
+				{
+					ls << "Insert(" << key << ") mismatched at " << i << lferr;
+					return;
+				}
+			}
+
+			if (m.Size() != expected.size())
+			{
+				ls << "Size " << m.Size() << ", expected " << expected.size() << lferr;
+				return;
+			}
+
+			for (auto& pair : m)
+			{
+				auto found = expected.find(pair.key);
+				if (found == expected.end() || found->second != pair.value)
+				{
+					ls << "Entry " << pair.key << " mismatched" << lferr;
+					return;
+				}
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Benchmark vs HashMap and std::unordered_map", [this](auto& ls)
+		{
+			// 10M entries take more than a minute on a single core. Raise it to measure them.
+			constexpr size_t MaxSize = 1'000'000;
+
+			std::vector<uint64_t> keys(MaxSize * 2);
+			for (size_t i = 0; i < keys.size(); ++i)
+			{
+				keys[i] = SplitMix(i);
+			}
+
+			ls << "ns/op: insert, hit, miss, churn" << lf;
+
+			for (size_t size = 1000; size <= MaxSize; size *= 10)
+			{
+				// The same keys, so the smaller tables are measured on their own.
+				std::vector<uint64_t> sizedKeys(keys.begin(), keys.begin() + size);
+				sizedKeys.insert(sizedKeys.end(), keys.begin() + MaxSize, keys.begin() + MaxSize + size);
+
+				// The best of a few rounds, as the small ones are easily disturbed.
+				const int numRounds = size < MaxSize ? 3 : 1;
+				using TSwiss = EngineMap<SwissHashMap<uint64_t, uint64_t>>;
+				using THashMap = EngineMap<HashMap<uint64_t, uint64_t>>;
+
+				const auto swiss = RunBenchmark<TSwiss>(sizedKeys, size, numRounds);
+				const auto hashMap = RunBenchmark<THashMap>(sizedKeys, size, numRounds);
+				const auto stl = RunBenchmark<StdMap>(sizedKeys, size, numRounds);
+
+				auto print = [this, &ls](const char* name, const BenchmarkResult& result)
+				{
+					ls << "  " << name << ": " << result.insertNs << ", " << result.hitNs << ", " << result.missNs
+					   << ", " << result.churnNs << lf;
+				};
+
+				ls << size << " entries" << lf;
+				print("SwissHashMap", swiss);
+				print("HashMap", hashMap);
+				print("std::unordered_map", stl);
+
+				if (swiss.hitNs > stl.hitNs || swiss.missNs > stl.missNs)
+				{
+					ls << "SwissHashMap lookups are slower than std::unordered_map at " << size << lfwarn;
+				}
+			}
+
+			ls << "Pass";
+		});
+	}
+
+} // namespace hbe
+
+#endif //__UNIT_TEST__
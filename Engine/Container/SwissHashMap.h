@@ -0,0 +1,635 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "Memory/DefaultAllocator.h"
+#include "Memory/Memory.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HBE_SWISS_TABLE_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define HBE_SWISS_TABLE_NEON 1
+#endif
+
+
+namespace hbe
+{
+
+	namespace SwissTable
+	{
+		/// @details A control byte per slot: Empty, Deleted, or the low 7 bits of the hash (H2) of the full slot.
+		/// The first group of control bytes is cloned after the last one, so a group can be loaded at any slot.
+		using TCtrl = int8_t;
+
+		constexpr TCtrl Empty = -128;
+		constexpr TCtrl Deleted = -2;
+		constexpr TCtrl Sentinel = -1;
+		constexpr size_t GroupWidth = 16;
+
+		// The slots of a group matched, a bit (or a nibble) per slot.
+		template<int Shift>
+		class BitMask final
+		{
+		private:
+			uint64_t bits;
+
+		public:
+			explicit BitMask(uint64_t bits) noexcept : bits(bits) {}
+
+			[[nodiscard]] bool HasAny() const noexcept { return bits != 0; }
+			[[nodiscard]] size_t GetLowest() const noexcept { return std::countr_zero(bits) >> Shift; }
+			void ClearLowest() noexcept { bits &= bits - 1; }
+
+			[[nodiscard]] size_t CountTrailingSlots() const noexcept
+			{
+				return bits == 0 ? GroupWidth : GetLowest();
+			}
+
+			[[nodiscard]] size_t CountLeadingSlots() const noexcept
+			{
+				constexpr int unusedBits = 64 - static_cast<int>(GroupWidth << Shift);
+				return bits == 0 ? GroupWidth : static_cast<size_t>((std::countl_zero(bits) - unusedBits) >> Shift);
+			}
+		};
+
+		/// @brief The control bytes of GroupWidth slots, matched at once.
+		class Group final
+		{
+		public:
+#if HBE_SWISS_TABLE_SSE2
+			using TMask = BitMask<0>;
+
+			explicit Group(const TCtrl* position) noexcept
+				: ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(position)))
+			{
+			}
+
+			[[nodiscard]] TMask Match(TCtrl h2) const noexcept
+			{
+				return TMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+			}
+
+			[[nodiscard]] TMask MatchEmpty() const noexcept { return Match(Empty); }
+
+			[[nodiscard]] TMask MatchEmptyOrDeleted() const noexcept
+			{
+				return TMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(Sentinel), ctrl))));
+			}
+
+		private:
+			__m128i ctrl;
+#elif HBE_SWISS_TABLE_NEON
+			using TMask = BitMask<2>;
+
+			explicit Group(const TCtrl* position) noexcept : ctrl(vld1q_s8(position)) {}
+
+			[[nodiscard]] TMask Match(TCtrl h2) const noexcept { return ToMask(vceqq_s8(vdupq_n_s8(h2), ctrl)); }
+			[[nodiscard]] TMask MatchEmpty() const noexcept { return Match(Empty); }
+
+			[[nodiscard]] TMask MatchEmptyOrDeleted() const noexcept
+			{
+				return ToMask(vcltq_s8(ctrl, vdupq_n_s8(Sentinel)));
+			}
+
+		private:
+			// Narrow the bytes to nibbles, keeping a bit of each.
+			static TMask ToMask(uint8x16_t matched) noexcept
+			{
+				const auto nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matched), 4);
+				return TMask(vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL);
+			}
+
+			int8x16_t ctrl;
+#else
+			using TMask = BitMask<0>;
+
+			explicit Group(const TCtrl* position) noexcept { std::memcpy(ctrl, position, GroupWidth); }
+
+			[[nodiscard]] TMask Match(TCtrl h2) const noexcept
+			{
+				uint64_t bits = 0;
+				for (size_t i = 0; i < GroupWidth; ++i)
+				{
+					bits |= uint64_t(ctrl[i] == h2) << i;
+				}
+
+				return TMask(bits);
+			}
+
+			[[nodiscard]] TMask MatchEmpty() const noexcept { return Match(Empty); }
+
+			[[nodiscard]] TMask MatchEmptyOrDeleted() const noexcept
+			{
+				uint64_t bits = 0;
+				for (size_t i = 0; i < GroupWidth; ++i)
+				{
+					bits |= uint64_t(ctrl[i] < Sentinel) << i;
+				}
+
+				return TMask(bits);
+			}
+
+		private:
+			TCtrl ctrl[GroupWidth];
+#endif
+		};
+
+	} // namespace SwissTable
+
+	/// @brief Open-addressing hash map in the Swiss table layout.
+	/// @details A control byte per slot keeps 7 bits of the hash, so a group of 16 slots is filtered with a SIMD
+	/// compare (SSE2 or NEON), and the keys are compared only where the fragments match. The groups are probed
+	/// quadratically. A removed slot becomes empty again unless a probe could have passed over its group, so tombstones
+	/// don't pile up, and they're dropped without growing when the table is full of them. Load factor 7/8.
+	template<typename TKey, typename TValue, class THash = std::hash<TKey>, class TKeyEqual = std::equal_to<TKey>,
+		class TAllocator = DefaultAllocator<uint8_t>>
+	class SwissHashMap final
+	{
+	public:
+		using TIndex = size_t;
+		using TCtrl = SwissTable::TCtrl;
+		using Group = SwissTable::Group;
+
+		static constexpr TIndex GroupWidth = SwissTable::GroupWidth;
+		static constexpr TIndex MinCapacity = GroupWidth;
+
+		struct Pair final
+		{
+			TKey key;
+			TValue value;
+		};
+
+		class Iterator
+		{
+		public:
+			using TMap = SwissHashMap;
+			friend class SwissHashMap;
+
+		private:
+			TMap* map;
+			TIndex index;
+
+		public:
+			explicit Iterator(TMap* map, TIndex index) noexcept
+				: map(map)
+				, index(index)
+			{
+			}
+
+			Iterator& operator++() noexcept
+			{
+				FatalAssert(map != nullptr);
+				index = map->SkipEmptySlots(index + 1);
+
+				return *this;
+			}
+
+			bool operator==(const Iterator& rhs) const noexcept { return index == rhs.index && map == rhs.map; }
+			bool operator!=(const Iterator& rhs) const noexcept { return !(*this == rhs); }
+
+			Pair& operator*() noexcept
+			{
+				FatalAssert(map != nullptr && map->IsValidSlot(index));
+				return map->slots[index];
+			}
+
+			const Pair& operator*() const noexcept
+			{
+				FatalAssert(map != nullptr && map->IsValidSlot(index));
+				return map->slots[index];
+			}
+
+			Pair* operator->() noexcept { return &(**this); }
+			const Pair* operator->() const noexcept { return &(**this); }
+		};
+
+		class ConstIterator
+		{
+		public:
+			using TMap = SwissHashMap;
+			friend class SwissHashMap;
+
+		private:
+			const TMap* map;
+			TIndex index;
+
+		public:
+			explicit ConstIterator(const TMap* map, TIndex index) noexcept
+				: map(map)
+				, index(index)
+			{
+			}
+
+			ConstIterator& operator++() noexcept
+			{
+				FatalAssert(map != nullptr);
+				index = map->SkipEmptySlots(index + 1);
+
+				return *this;
+			}
+
+			bool operator==(const ConstIterator& rhs) const noexcept { return index == rhs.index && map == rhs.map; }
+			bool operator!=(const ConstIterator& rhs) const noexcept { return !(*this == rhs); }
+
+			const Pair& operator*() const noexcept
+			{
+				FatalAssert(map != nullptr && map->IsValidSlot(index));
+				return map->slots[index];
+			}
+
+			const Pair* operator->() const noexcept { return &(**this); }
+		};
+
+		SwissHashMap() noexcept
+			: cap(0)
+			, count(0)
+			, growthLeft(0)
+			, ctrl(nullptr)
+			, slots(nullptr)
+		{
+		}
+
+		SwissHashMap(const SwissHashMap&) = delete;
+
+		explicit SwissHashMap(TIndex initialCapacity)
+			: SwissHashMap()
+		{
+			Reserve(initialCapacity);
+		}
+
+		SwissHashMap(SwissHashMap&& rhs) noexcept
+			: cap(rhs.cap)
+			, count(rhs.count)
+			, growthLeft(rhs.growthLeft)
+			, ctrl(rhs.ctrl)
+			, slots(rhs.slots)
+			, hash(std::move(rhs.hash))
+			, keyEqual(std::move(rhs.keyEqual))
+		{
+			rhs.cap = 0;
+			rhs.count = 0;
+			rhs.growthLeft = 0;
+			rhs.ctrl = nullptr;
+			rhs.slots = nullptr;
+		}
+
+		~SwissHashMap() noexcept { Release(); }
+
+		SwissHashMap& operator=(const SwissHashMap&) = delete;
+
+		SwissHashMap& operator=(SwissHashMap&& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				Release();
+
+				cap = rhs.cap;
+				count = rhs.count;
+				growthLeft = rhs.growthLeft;
+				ctrl = rhs.ctrl;
+				slots = rhs.slots;
+				hash = std::move(rhs.hash);
+				keyEqual = std::move(rhs.keyEqual);
+
+				rhs.cap = 0;
+				rhs.count = 0;
+				rhs.growthLeft = 0;
+				rhs.ctrl = nullptr;
+				rhs.slots = nullptr;
+			}
+
+			return *this;
+		}
+
+		Iterator begin() noexcept { return Iterator(this, SkipEmptySlots(0)); }
+		Iterator end() noexcept { return Iterator(this, cap); }
+		ConstIterator begin() const noexcept { return ConstIterator(this, SkipEmptySlots(0)); }
+		ConstIterator end() const noexcept { return ConstIterator(this, cap); }
+
+		TValue& operator[](const TKey& key)
+		{
+			// Inserting could reallocate the slots, so it's indexed after.
+			const auto index = InsertInternal(key).second;
+			return slots[index].value;
+		}
+
+		TValue& operator[](TKey&& key)
+		{
+			const auto index = InsertInternal(std::move(key)).second;
+			return slots[index].value;
+		}
+
+		[[nodiscard]] Iterator Find(const TKey& key) noexcept
+		{
+			auto index = FindSlot(key, Mix(hash(key)));
+			return Iterator(this, index == NotFound ? cap : index);
+		}
+
+		[[nodiscard]] ConstIterator Find(const TKey& key) const noexcept
+		{
+			auto index = FindSlot(key, Mix(hash(key)));
+			return ConstIterator(this, index == NotFound ? cap : index);
+		}
+
+		bool Insert(const TKey& key, const TValue& value)
+		{
+			auto [inserted, index] = InsertInternal(key);
+			if (inserted)
+			{
+				slots[index].value = value;
+			}
+
+			return inserted;
+		}
+
+		bool Insert(const TKey& key, TValue&& value)
+		{
+			auto [inserted, index] = InsertInternal(key);
+			if (inserted)
+			{
+				slots[index].value = std::move(value);
+			}
+
+			return inserted;
+		}
+
+		bool Insert(TKey&& key, TValue&& value)
+		{
+			auto [inserted, index] = InsertInternal(std::move(key));
+			if (inserted)
+			{
+				slots[index].value = std::move(value);
+			}
+
+			return inserted;
+		}
+
+		bool Remove(const TKey& key)
+		{
+			auto index = FindSlot(key, Mix(hash(key)));
+			returnValueIf(false, index == NotFound);
+
+			slots[index].~Pair();
+			--count;
+
+			// No probe has passed over the slot if there's an empty one in every group window over it.
+			const auto emptyBefore = Group(ctrl + ((index - GroupWidth) & (cap - 1))).MatchEmpty();
+			const auto emptyAfter = Group(ctrl + index).MatchEmpty();
+			const bool wasNeverFull = emptyBefore.HasAny() && emptyAfter.HasAny()
+				&& emptyAfter.CountTrailingSlots() + emptyBefore.CountLeadingSlots() < GroupWidth;
+
+			SetCtrl(index, wasNeverFull ? SwissTable::Empty : SwissTable::Deleted);
+			growthLeft += wasNeverFull ? 1 : 0;
+
+			return true;
+		}
+
+		[[nodiscard]] bool Contains(const TKey& key) const noexcept
+		{
+			return FindSlot(key, Mix(hash(key))) != NotFound;
+		}
+
+		[[nodiscard]] TIndex Size() const noexcept { return count; }
+		[[nodiscard]] TIndex Capacity() const noexcept { return cap; }
+		[[nodiscard]] bool IsEmpty() const noexcept { return count == 0; }
+
+		void Clear() noexcept
+		{
+			returnIf(cap == 0);
+
+			for (TIndex i = 0; i < cap; ++i)
+			{
+				if (IsFull(ctrl[i]))
+				{
+					slots[i].~Pair();
+				}
+			}
+
+			std::memset(ctrl, static_cast<uint8_t>(SwissTable::Empty), cap + GroupWidth);
+			count = 0;
+			growthLeft = GetMaxLoad(cap);
+		}
+
+		// Reserve the slots to hold the entries without growing.
+		void Reserve(TIndex numEntries)
+		{
+			TIndex newCapacity = MinCapacity;
+			while (GetMaxLoad(newCapacity) < numEntries)
+			{
+				newCapacity *= 2;
+			}
+
+			returnIf(newCapacity <= cap);
+			Rehash(newCapacity);
+		}
+
+	private:
+		static constexpr TIndex NotFound = static_cast<TIndex>(-1);
+
+		TIndex cap;
+		TIndex count;
+		// The empty slots which can be taken before the load factor is reached.
+		TIndex growthLeft;
+		TCtrl* ctrl;
+		Pair* slots;
+		THash hash;
+		TKeyEqual keyEqual;
+		TAllocator allocator;
+
+		// std::hash of integers is the identity, so the bits are mixed before split into H1 and H2.
+		[[nodiscard]] static size_t Mix(size_t hashCode) noexcept
+		{
+			const uint64_t product = static_cast<uint64_t>(hashCode) * 0x9E3779B97F4A7C15ULL;
+			return static_cast<size_t>(product ^ (product >> 32));
+		}
+
+		[[nodiscard]] static TCtrl GetH2(size_t hashCode) noexcept { return static_cast<TCtrl>(hashCode & 0x7F); }
+		[[nodiscard]] static bool IsFull(TCtrl value) noexcept { return value >= 0; }
+		[[nodiscard]] static TIndex GetMaxLoad(TIndex capacity) noexcept { return capacity - capacity / 8; }
+
+		[[nodiscard]] static size_t GetSlotsOffset(TIndex capacity) noexcept
+		{
+			const size_t ctrlSize = capacity + GroupWidth;
+			return (ctrlSize + alignof(Pair) - 1) / alignof(Pair) * alignof(Pair);
+		}
+
+		[[nodiscard]] static size_t GetAllocSize(TIndex capacity) noexcept
+		{
+			return GetSlotsOffset(capacity) + sizeof(Pair) * capacity;
+		}
+
+		[[nodiscard]] bool IsValidSlot(TIndex index) const noexcept { return index < cap && IsFull(ctrl[index]); }
+
+		[[nodiscard]] TIndex SkipEmptySlots(TIndex index) const noexcept
+		{
+			while (index < cap && !IsFull(ctrl[index]))
+			{
+				++index;
+			}
+
+			return index;
+		}
+
+		void SetCtrl(TIndex index, TCtrl value) noexcept
+		{
+			ctrl[index] = value;
+			// The clone of the first group.
+			ctrl[((index - GroupWidth) & (cap - 1)) + GroupWidth] = value;
+		}
+
+		[[nodiscard]] TIndex FindSlot(const TKey& key, size_t hashCode) const noexcept
+		{
+			returnValueIf(NotFound, cap == 0);
+
+			const auto mask = cap - 1;
+			const auto h2 = GetH2(hashCode);
+			TIndex offset = (hashCode >> 7) & mask;
+
+			for (TIndex step = GroupWidth;; step += GroupWidth)
+			{
+				const Group group(ctrl + offset);
+
+				for (auto matched = group.Match(h2); matched.HasAny(); matched.ClearLowest())
+				{
+					const auto index = (offset + matched.GetLowest()) & mask;
+					if (likely(keyEqual(slots[index].key, key)))
+					{
+						return index;
+					}
+				}
+
+				returnValueIf(NotFound, group.MatchEmpty().HasAny());
+
+				offset = (offset + step) & mask;
+			}
+		}
+
+		// The first empty or deleted slot on the probe sequence.
+		[[nodiscard]] TIndex FindInsertSlot(size_t hashCode) const noexcept
+		{
+			const auto mask = cap - 1;
+			TIndex offset = (hashCode >> 7) & mask;
+
+			for (TIndex step = GroupWidth;; step += GroupWidth)
+			{
+				const auto matched = Group(ctrl + offset).MatchEmptyOrDeleted();
+				if (matched.HasAny())
+				{
+					return (offset + matched.GetLowest()) & mask;
+				}
+
+				offset = (offset + step) & mask;
+			}
+		}
+
+		template<typename TKeyArg>
+		std::pair<bool, TIndex> InsertInternal(TKeyArg&& key)
+		{
+			const auto hashCode = Mix(hash(key));
+
+			auto index = FindSlot(key, hashCode);
+			returnValueIf(std::make_pair(false, index), index != NotFound);
+
+			if (unlikely(growthLeft == 0))
+			{
+				// Mostly tombstones, so they're dropped at the same capacity. Only if it leaves enough room to
+				// insert, or churning keys would rehash every few inserts.
+				Rehash(cap > 0 && count * 4 <= GetMaxLoad(cap) * 3 ? cap : std::max(MinCapacity, cap * 2));
+			}
+
+			index = FindInsertSlot(hashCode);
+			growthLeft -= ctrl[index] == SwissTable::Empty ? 1 : 0;
+
+			SetCtrl(index, GetH2(hashCode));
+			new (&slots[index]) Pair{std::forward<TKeyArg>(key), TValue{}};
+			++count;
+
+			return {true, index};
+		}
+
+		void Rehash(TIndex newCapacity)
+		{
+			auto* raw = allocator.allocate(GetAllocSize(newCapacity));
+
+			auto oldCtrl = ctrl;
+			auto oldSlots = slots;
+			auto oldCapacity = cap;
+
+			ctrl = reinterpret_cast<TCtrl*>(raw);
+			slots = reinterpret_cast<Pair*>(raw + GetSlotsOffset(newCapacity));
+			cap = newCapacity;
+			growthLeft = GetMaxLoad(newCapacity) - count;
+
+			std::memset(ctrl, static_cast<uint8_t>(SwissTable::Empty), newCapacity + GroupWidth);
+
+			for (TIndex i = 0; i < oldCapacity; ++i)
+			{
+				continueIf(!IsFull(oldCtrl[i]));
+
+				const auto hashCode = Mix(hash(oldSlots[i].key));
+				const auto index = FindInsertSlot(hashCode);
+
+				SetCtrl(index, GetH2(hashCode));
+				new (&slots[index]) Pair(std::move(oldSlots[i]));
+				oldSlots[i].~Pair();
+			}
+
+			if (oldCtrl != nullptr)
+			{
+				allocator.deallocate(reinterpret_cast<uint8_t*>(oldCtrl), GetAllocSize(oldCapacity));
+			}
+		}
+
+		void Release() noexcept
+		{
+			returnIf(ctrl == nullptr);
+
+			for (TIndex i = 0; i < cap; ++i)
+			{
+				if (IsFull(ctrl[i]))
+				{
+					slots[i].~Pair();
+				}
+			}
+
+			allocator.deallocate(reinterpret_cast<uint8_t*>(ctrl), GetAllocSize(cap));
+
+			ctrl = nullptr;
+			slots = nullptr;
+			cap = 0;
+			count = 0;
+			growthLeft = 0;
+		}
+	};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+	class SwissHashMapTest : public TestCollection
+	{
+	public:
+		SwissHashMapTest() : TestCollection("SwissHashMapTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -3,8 +3,10 @@
 #include "Vector.h"
 
 #ifdef __UNIT_TEST__
+#include <string>
 #include <vector>
 #include "Core/ScopedTime.h"
+#include "Memory/AllocatorScope.h"
 
 
 namespace hbe
@@ -100,7 +102,7 @@ namespace hbe
 				v.PushBack(i);
 			}
 
-			if (v.Size() != count)
+			if (v.Size() != static_cast<size_t>(count))
 			{
 				ls << "Expected size " << count << ", got " << v.Size() << lferr;
 				return;
@@ -220,9 +222,9 @@ namespace hbe
 				return;
 			}
 
-			if (v.FindIndex(99) != -1)
+			if (v.FindIndex(99) != Vector<int>::InvalidIndex)
 			{
-				ls << "FindIndex(99) should be -1" << lferr;
+				ls << "FindIndex(99) should be InvalidIndex" << lferr;
 				return;
 			}
 
@@ -271,6 +273,114 @@ namespace hbe
 
 			ls << "Pass";
 		});
+
+		AddTest("Relocatable Elements", [this](auto& ls)
+		{
+			// The inner vectors move as bytes when the outer one grows, and the strings by their constructors.
+			Vector<Vector<int>> vectors;
+			Vector<std::string> strings;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				auto& inner = vectors.EmplaceBack();
+				inner.PushBack(i);
+				inner.PushBack(i * 2);
+
+				strings.PushBack(std::to_string(i) + " is long enough to be on the heap");
+			}
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				if (vectors[i].Size() != 2 || vectors[i][1] != i * 2
+					|| strings[i] != std::to_string(i) + " is long enough to be on the heap")
+				{
+					ls << "Mismatch at " << i << lferr;
+					return;
+				}
+			}
+
+			ls << "Pass";
+		});
+
+		AddTest("Push and Growth at Scale", [this](auto& ls)
+		{
+			// 100M elements peak over 1GB with the doubled std::vector. Raise it to measure them.
+			constexpr size_t MaxSize = 10'000'000;
+			constexpr int NumRounds = 2;
+
+			// On the system heap as std::vector, where realloc can extend or remap the block.
+			AllocatorScope scope(MemoryManager::SystemAllocatorID);
+
+			for (size_t size = 1'000'000; size <= MaxSize; size *= 10)
+			{
+				double hePushNs = 0.0;
+				double stlPushNs = 0.0;
+				double heGrowMs = 0.0;
+				double stlGrowMs = 0.0;
+
+				// The best of the rounds, as the first one touches the pages.
+				auto keepBest = [](double& best, const time::TDuration& duration, double scale)
+				{
+					const auto value = time::ToFloat(duration) * scale;
+					best = (best == 0.0 || value < best) ? value : best;
+				};
+
+				for (int round = 0; round < NumRounds; ++round)
+				{
+					time::TDuration duration;
+
+					{
+						Vector<uint32_t> v;
+						time::ScopedTime measure(duration);
+						for (size_t i = 0; i < size; ++i)
+						{
+							v.PushBack(static_cast<uint32_t>(i));
+						}
+					}
+
+					keepBest(hePushNs, duration, 1e9 / double(size));
+
+					{
+						std::vector<uint32_t> v;
+						time::ScopedTime measure(duration);
+						for (size_t i = 0; i < size; ++i)
+						{
+							v.push_back(static_cast<uint32_t>(i));
+						}
+					}
+
+					keepBest(stlPushNs, duration, 1e9 / double(size));
+
+					// Doubling a full one, which copies all unless the block is extended or remapped.
+					{
+						Vector<uint32_t> v(size);
+						v.Resize(size);
+						time::ScopedTime measure(duration);
+						v.Reserve(size * 2);
+					}
+
+					keepBest(heGrowMs, duration, 1e3);
+
+					{
+						std::vector<uint32_t> v(size);
+						time::ScopedTime measure(duration);
+						v.reserve(size * 2);
+					}
+
+					keepBest(stlGrowMs, duration, 1e3);
+				}
+
+				ls << size << " elements, Vector vs std::vector: push_back " << hePushNs << " vs " << stlPushNs
+				   << " ns/op, doubling " << heGrowMs << " vs " << stlGrowMs << " ms" << lf;
+
+				if (hePushNs > stlPushNs * 2)
+				{
+					ls << "Vector push_back is slower than 2x std::vector at " << size << " elements" << lfwarn;
+				}
+			}
+
+			ls << "Pass";
+		});
 	}
 
 } // namespace hbe
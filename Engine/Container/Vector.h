@@ -3,7 +3,10 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <initializer_list>
+#include <limits>
+#include <type_traits>
 #include <utility>
 
 #include "Core/CommonMacros.h"
@@ -19,9 +22,10 @@ namespace hbe
 	class Vector final
 	{
 	public:
-		static constexpr int DefaultCapacity = 4;
+		using TIndex = size_t;
 
-		using TIndex = int;
+		static constexpr TIndex DefaultCapacity = 4;
+		static constexpr TIndex InvalidIndex = std::numeric_limits<TIndex>::max();
 		using Iterator = TElement*;
 		using ConstIterator = const TElement*;
 
@@ -205,14 +209,23 @@ namespace hbe
 		{
 			returnIf(newCapacity <= capacity);
 
-			auto* newData = allocator.allocate(newCapacity);
-
-			for (TIndex i = 0; i < count; ++i)
+			// The elements moving as bytes go with the block, which the allocator might extend in place.
+			if constexpr (CTriviallyRelocatable<TElement> && CReallocatable<TAllocator>)
 			{
-				new (&newData[i]) TElement(std::move(data[i]));
-				data[i].~TElement();
+				if (data != nullptr)
+				{
+					auto* newData = allocator.reallocate(data, capacity, newCapacity);
+					FatalAssert(newData != nullptr, "Vector failed to grow to %zu elements", newCapacity);
+
+					data = newData;
+					capacity = newCapacity;
+					return;
+				}
 			}
 
+			auto* newData = allocator.allocate(newCapacity);
+			RelocateObjects(newData, data, count);
+
 			if (data != nullptr)
 			{
 				allocator.deallocate(data, capacity);
@@ -231,7 +244,7 @@ namespace hbe
 		[[nodiscard]] TIndex Size() const noexcept { return count; }
 		[[nodiscard]] TIndex Capacity() const noexcept { return capacity; }
 		[[nodiscard]] bool IsEmpty() const noexcept { return count == 0; }
-		[[nodiscard]] bool IsValidIndex(TIndex index) const noexcept { return index >= 0 && index < count; }
+		[[nodiscard]] bool IsValidIndex(TIndex index) const noexcept { return index < count; }
 
 		[[nodiscard]] TElement* Data() noexcept { return data; }
 		[[nodiscard]] const TElement* Data() const noexcept { return data; }
@@ -253,7 +266,7 @@ namespace hbe
 				}
 			}
 
-			return -1;
+			return InvalidIndex;
 		}
 
 	private:
@@ -277,6 +290,12 @@ namespace hbe
 		}
 	};
 
+	// It owns the elements through a pointer, so it can move as bytes.
+	template<typename TElement, class TAllocator>
+	struct TriviallyRelocatable<Vector<TElement, TAllocator>> : std::bool_constant<CTriviallyRelocatable<TAllocator>>
+	{
+	};
+
 } // namespace hbe
 
 #ifdef __UNIT_TEST__
@@ -0,0 +1,173 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "WorkStealingDeque.h"
+
+#ifdef __UNIT_TEST__
+#include <thread>
+#include "HSTL/HVector.h"
+
+
+namespace hbe
+{
+
+	void WorkStealingDequeTest::Prepare()
+	{
+		AddTest("Owner Push/Pop (LIFO)", [this](auto& ls)
+		{
+			WorkStealingDeque<int, 8> deque;
+
+			for (int i = 0; i < 8; ++i)
+			{
+				if (!deque.Push(i))
+				{
+					ls << "Push failed at " << i << lferr;
+					return;
+				}
+			}
+
+			if (deque.Push(8))
+			{
+				ls << "Push should fail when the deque is full." << lferr;
+			}
+
+			for (int i = 7; i >= 0; --i)
+			{
+				std::optional<int> value;
+				if (!deque.Pop(value) || value != i)
+				{
+					ls << "Pop mismatch: expected " << i << lferr;
+					return;
+				}
+			}
+
+			std::optional<int> value;
+			if (deque.Pop(value) || !deque.IsEmpty())
+			{
+				ls << "The deque should be empty." << lferr;
+			}
+		});
+
+		AddTest("Steal (FIFO)", [this](auto& ls)
+		{
+			WorkStealingDeque<int, 8> deque;
+
+			for (int i = 0; i < 5; ++i)
+			{
+				deque.Push(i);
+			}
+
+			for (int i = 0; i < 5; ++i)
+			{
+				std::optional<int> value;
+				if (!deque.Steal(value) || value != i)
+				{
+					ls << "Steal mismatch: expected " << i << lferr;
+					return;
+				}
+			}
+
+			std::optional<int> value;
+			if (deque.Steal(value))
+			{
+				ls << "Steal should fail on an empty deque." << lferr;
+			}
+		});
+
+		AddTest("Wrap Around", [this](auto& ls)
+		{
+			WorkStealingDeque<int, 4> deque;
+			int expectedSteal = 0;
+
+			for (int i = 0; i < 100; ++i)
+			{
+				deque.Push(i);
+				if (deque.Size() < 3)
+				{
+					continue;
+				}
+
+				std::optional<int> value;
+				if (!deque.Steal(value) || value != expectedSteal)
+				{
+					ls << "Steal mismatch at " << i << ": expected " << expectedSteal << lferr;
+					return;
+				}
+
+				++expectedSteal;
+			}
+
+			ls << "Remaining = " << deque.Size() << lf;
+		});
+
+		AddTest("Thread-Safety", [this](auto& ls)
+		{
+			constexpr int NumItems = 200000;
+			constexpr int NumThieves = 3;
+
+			WorkStealingDeque<int, 1024> deque;
+			hbe::HVector<std::atomic<int>> takenCounts(NumItems);
+			std::atomic<bool> isProducing = true;
+
+			auto stealFunc = [&]()
+			{
+				std::optional<int> value;
+				while (isProducing.load(std::memory_order_relaxed) || !deque.IsEmpty())
+				{
+					if (deque.Steal(value))
+					{
+						takenCounts[*value].fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			};
+
+			hbe::HVector<std::thread> thieves;
+			for (int i = 0; i < NumThieves; ++i)
+			{
+				thieves.emplace_back(stealFunc);
+			}
+
+			std::optional<int> value;
+			for (int i = 0; i < NumItems; ++i)
+			{
+				while (!deque.Push(i))
+				{
+					if (deque.Pop(value))
+					{
+						takenCounts[*value].fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+
+				if ((i % 3) == 0 && deque.Pop(value))
+				{
+					takenCounts[*value].fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			while (deque.Pop(value))
+			{
+				takenCounts[*value].fetch_add(1, std::memory_order_relaxed);
+			}
+
+			isProducing = false;
+
+			for (auto& thread : thieves)
+			{
+				thread.join();
+			}
+
+			for (int i = 0; i < NumItems; ++i)
+			{
+				const int count = takenCounts[i].load(std::memory_order_relaxed);
+				if (count != 1)
+				{
+					ls << "Item " << i << " has been taken " << count << " times." << lferr;
+					return;
+				}
+			}
+
+			ls << NumItems << " items are taken exactly once by the owner and " << NumThieves << " thieves." << lf;
+		});
+	}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
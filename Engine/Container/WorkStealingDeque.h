@@ -0,0 +1,162 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+#include "Config/EngineConfig.h"
+#include "Core/CommonMacros.h"
+
+
+namespace hbe
+{
+
+	/// @brief A bounded lock-free Chase-Lev work-stealing deque.
+	/// @details The owner thread pushes and pops at the bottom (LIFO), and any other thread can steal
+	/// from the top (FIFO). Only the owner may call Push and Pop. Elements are stored by value, so the
+	/// element type must be trivially copyable. A thief may copy a slot while the owner is overwriting it
+	/// after a wrap-around, but that only happens when the top has already moved on, so the thief's CAS
+	/// fails and the torn copy is discarded.
+	/// @tparam T Trivially copyable element type.
+	/// @tparam Capacity Maximum number of elements. Must be a power of two.
+	template<typename T, std::size_t Capacity>
+	class WorkStealingDeque final
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable type.");
+		static_assert(std::has_single_bit(Capacity), "WorkStealingDeque capacity must be a power of two.");
+
+	public:
+		using TIndex = std::int64_t;
+
+	private:
+		struct alignas(T) TSlot final
+		{
+			uint8_t bytes[sizeof(T)];
+		};
+
+		static constexpr TIndex Mask = static_cast<TIndex>(Capacity - 1);
+		static_assert(std::atomic<TIndex>::is_always_lock_free, "TIndex should be lock free on this platform.");
+
+		std::atomic<TIndex> top;
+		uint8_t topPadding[Config::CacheLineSize - sizeof(std::atomic<TIndex>)];
+		std::atomic<TIndex> bottom;
+		uint8_t bottomPadding[Config::CacheLineSize - sizeof(std::atomic<TIndex>)];
+		TSlot slots[Capacity];
+
+	public:
+		WorkStealingDeque() noexcept : top(0), bottom(0) {}
+
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+		~WorkStealingDeque() = default;
+
+		// Owner only. Returns false if the deque is full.
+		bool Push(const T& item) noexcept
+		{
+			const TIndex b = bottom.load(std::memory_order_relaxed);
+			const TIndex t = top.load(std::memory_order_acquire);
+			returnValueIf(false, b - t >= static_cast<TIndex>(Capacity));
+
+			std::memcpy(&slots[b & Mask], &item, sizeof(T));
+			std::atomic_thread_fence(std::memory_order_release);
+			bottom.store(b + 1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		// Owner only. Takes the most recently pushed item.
+		bool Pop(std::optional<T>& outItem) noexcept
+		{
+			const TIndex b = bottom.load(std::memory_order_relaxed) - 1;
+			bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			TIndex t = top.load(std::memory_order_relaxed);
+
+			if (t > b)
+			{
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			if (t == b)
+			{
+				// The last item. Race against thieves for it.
+				const bool isWon = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+															   std::memory_order_relaxed);
+				bottom.store(b + 1, std::memory_order_relaxed);
+				returnValueIf(false, !isWon);
+			}
+
+			outItem.emplace(Load(slots[b & Mask]));
+
+			return true;
+		}
+
+		// Any thread. Takes the oldest item.
+		bool Steal(std::optional<T>& outItem) noexcept
+		{
+			TIndex t = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const TIndex b = bottom.load(std::memory_order_acquire);
+			returnValueIf(false, t >= b);
+
+			TSlot copied;
+			std::memcpy(&copied, &slots[t & Mask], sizeof(T));
+
+			const bool isWon = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+														   std::memory_order_relaxed);
+			returnValueIf(false, !isWon);
+
+			outItem.emplace(Load(copied));
+
+			return true;
+		}
+
+		// Approximate when called from a thread other than the owner.
+		[[nodiscard]] bool IsEmpty() const noexcept
+		{
+			return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+		}
+
+		// Approximate when called from a thread other than the owner.
+		[[nodiscard]] std::size_t Size() const noexcept
+		{
+			const TIndex size = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+			return size > 0 ? static_cast<std::size_t>(size) : 0;
+		}
+
+		[[nodiscard]] static constexpr std::size_t GetCapacity() noexcept { return Capacity; }
+
+	private:
+		[[nodiscard]] static const T& Load(const TSlot& slot) noexcept
+		{
+			return *std::launder(reinterpret_cast<const T*>(&slot));
+		}
+	};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+	class WorkStealingDequeTest : public TestCollection
+	{
+	public:
+		WorkStealingDequeTest() : TestCollection("WorkStealingDequeTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
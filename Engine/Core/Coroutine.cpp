@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "Coroutine.h"
+
+#include "Core/Debug.h"
+#include "Engine/Engine.h"
+#include "TaskStream.h"
+#include "TaskSystem.h"
+
+
+namespace hbe
+{
+
+namespace
+{
+	std::size_t RunNothing(void*, std::size_t startIndex, std::size_t endIndex) { return endIndex - startIndex; }
+
+	void ResumeCoroutine(void* address)
+	{
+		std::coroutine_handle<>::from_address(address).resume();
+	}
+} // namespace
+
+void Coroutine::promise_type::unhandled_exception() noexcept
+{
+	FatalAssert(false, "Unhandled exception in a coroutine.");
+}
+
+void* Coroutine::promise_type::operator new(std::size_t size) noexcept
+{
+	auto& allocator = Engine::Get().GetTaskSystem().GetCoroutineFrameAllocator();
+	return allocator.Allocate(size);
+}
+
+void Coroutine::promise_type::operator delete(void* ptr, std::size_t size) noexcept
+{
+	auto& allocator = Engine::Get().GetTaskSystem().GetCoroutineFrameAllocator();
+	allocator.Deallocate(ptr, size);
+}
+
+TaskAwaiter::TaskAwaiter(Task& task, std::size_t startIndex, std::size_t endIndex, std::size_t grainSize,
+	uint8_t priority) noexcept
+	: task(task)
+	, startIndex(startIndex)
+	, endIndex(endIndex)
+	, grainSize(grainSize)
+	, priority(priority)
+{
+}
+
+void TaskAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+	task.Reset();
+	task.SetCompletionCallback(&ResumeCoroutine, handle.address());
+
+	// The coroutine can be resumed on another stream before ParallelFor returns, so don't touch this afterwards.
+	auto& taskSystem = Engine::Get().GetTaskSystem();
+	taskSystem.ParallelFor(task, startIndex, endIndex, grainSize, priority);
+}
+
+void TaskAwaiter::await_resume() noexcept
+{
+	task.SetCompletionCallback(nullptr, nullptr);
+}
+
+StreamAwaiter::StreamAwaiter(int streamIndex, uint8_t priority) noexcept
+	: resumeTask("ResumeOnStream", &RunNothing, nullptr)
+	, streamIndex(streamIndex)
+	, priority(priority)
+{
+}
+
+bool StreamAwaiter::await_ready() const noexcept
+{
+	const auto* stream = TaskStream::GetCurrent();
+	return stream != nullptr && stream->GetStreamIndex() == streamIndex;
+}
+
+void StreamAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+	// The awaiter lives in the coroutine frame, and the task isn't accessed after its completion callback.
+	resumeTask.SetCompletionCallback(&ResumeCoroutine, handle.address());
+
+	auto& taskSystem = Engine::Get().GetTaskSystem();
+	taskSystem.Enqueue(streamIndex, resumeTask.GenerateSubTask(0, 1, priority));
+}
+
+void MainThreadAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+	auto& taskSystem = Engine::Get().GetTaskSystem();
+	taskSystem.DispatchToMainThread(&ResumeCoroutine, handle.address(), priority);
+}
+
+TaskAwaiter RunAsync(Task& task, std::size_t startIndex, std::size_t endIndex, std::size_t grainSize,
+	uint8_t priority) noexcept
+{
+	return {task, startIndex, endIndex, grainSize, priority};
+}
+
+StreamAwaiter ResumeOnStream(int streamIndex, uint8_t priority) noexcept
+{
+	return {streamIndex, priority};
+}
+
+StreamAwaiter ResumeOnIOStream(uint8_t priority) noexcept
+{
+	return {TaskSystem::GetIOTaskStreamIndex(), priority};
+}
+
+MainThreadAwaiter ResumeOnMainThread(uint8_t priority) noexcept
+{
+	return MainThreadAwaiter(priority);
+}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <atomic>
+#include <thread>
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+namespace
+{
+	struct SequenceContext final
+	{
+		std::atomic<int64_t> sum = 0;
+		int64_t sumAfterTask = -1;
+		int streamIndexOnIO = -2;
+		std::string threadNameOnMain;
+		std::atomic<bool> isDone = false;
+	};
+
+	std::size_t SumRange(void* userData, std::size_t startIndex, std::size_t endIndex)
+	{
+		auto& context = *static_cast<SequenceContext*>(userData);
+
+		int64_t sum = 0;
+		for (auto i = startIndex; i < endIndex; ++i)
+		{
+			sum += static_cast<int64_t>(i);
+		}
+
+		context.sum.fetch_add(sum);
+
+		return endIndex - startIndex;
+	}
+
+	Coroutine RunSequence(SequenceContext& context, Task& task, std::size_t count)
+	{
+		co_await RunAsync(task, 0, count, 256);
+		context.sumAfterTask = context.sum.load();
+
+		co_await ResumeOnIOStream();
+		context.streamIndexOnIO = TaskStream::GetCurrent() != nullptr ? TaskStream::GetCurrent()->GetStreamIndex() : -1;
+
+		co_await ResumeOnMainThread();
+		context.threadNameOnMain = TaskSystem::GetCurrentThreadName().c_str();
+
+		context.isDone = true;
+	}
+
+	Coroutine HopToIOStream(std::atomic<int>& counter)
+	{
+		co_await ResumeOnIOStream();
+		counter.fetch_add(1);
+	}
+
+	bool WaitUntil(const auto& predicate)
+	{
+		for (int i = 0; i < 5000 && !predicate(); ++i)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return predicate();
+	}
+} // namespace
+
+void CoroutineTest::Prepare()
+{
+	AddTest("Sequential Flow", [this](auto& ls)
+	{
+		constexpr std::size_t Count = 1 << 16;
+
+		SequenceContext context;
+		Task task("CoroutineSum", &SumRange, &context);
+		RunSequence(context, task, Count);
+
+		if (!WaitUntil([&context]() { return context.isDone.load(); }))
+		{
+			ls << "The coroutine has not been finished." << lferr;
+			return;
+		}
+
+		const int64_t expected = static_cast<int64_t>(Count) * (Count - 1) / 2;
+		if (context.sumAfterTask != expected)
+		{
+			ls << "It resumed before the task was done. " << context.sumAfterTask << " != " << expected << lferr;
+		}
+
+		if (context.streamIndexOnIO != TaskSystem::GetIOTaskStreamIndex())
+		{
+			ls << "It should resume on the IO stream, but it was " << context.streamIndexOnIO << lferr;
+		}
+
+		if (context.threadNameOnMain != "Base")
+		{
+			ls << "It should resume on the main thread, but it was " << context.threadNameOnMain << lferr;
+		}
+	});
+
+	AddTest("Many Coroutines", [this](auto& ls)
+	{
+		constexpr int NumCoroutines = 1000;
+
+		std::atomic<int> counter = 0;
+		for (int i = 0; i < NumCoroutines; ++i)
+		{
+			HopToIOStream(counter);
+		}
+
+		if (!WaitUntil([&counter]() { return counter.load() == NumCoroutines; }))
+		{
+			ls << "Only " << counter.load() << " / " << NumCoroutines << " coroutines have been finished." << lferr;
+			return;
+		}
+
+		ls << NumCoroutines << " coroutines have been resumed on the IO stream." << lf;
+	});
+}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
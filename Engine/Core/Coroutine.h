@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include "Task.h"
+
+namespace hbe
+{
+
+/// @brief Return type of a fire-and-forget coroutine driven by the TaskSystem.
+/// @details A coroutine runs on the calling thread until its first suspending co_await, and then resumes on
+/// whichever thread completes the awaited work. Its frame is allocated from the TaskSystem's coroutine frame pool
+/// and freed when it returns. It can't be awaited or cancelled, so report its completion through its arguments.
+/// Don't write a capturing lambda as a coroutine, as the captures don't live in the frame.
+class Coroutine final
+{
+public:
+	struct promise_type final
+	{
+		Coroutine get_return_object() noexcept { return {}; }
+		static Coroutine get_return_object_on_allocation_failure() noexcept { return {}; }
+
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() noexcept;
+
+		static void* operator new(std::size_t size) noexcept;
+		static void operator delete(void* ptr, std::size_t size) noexcept;
+	};
+};
+
+/// @brief Runs a Task over [startIndex, endIndex) with TaskSystem::ParallelFor, and resumes the coroutine on the
+/// stream finishing the last sub-task. The Task is reset, so it shouldn't be running.
+class TaskAwaiter final
+{
+	Task& task;
+	std::size_t startIndex;
+	std::size_t endIndex;
+	std::size_t grainSize;
+	uint8_t priority;
+
+public:
+	TaskAwaiter(Task& task, std::size_t startIndex, std::size_t endIndex, std::size_t grainSize,
+		uint8_t priority) noexcept;
+
+	[[nodiscard]] bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> handle) noexcept;
+	void await_resume() noexcept;
+};
+
+/// @brief Resumes the coroutine on the given task stream. It doesn't suspend if it's already on the stream.
+class StreamAwaiter final
+{
+	Task resumeTask;
+	int streamIndex;
+	uint8_t priority;
+
+public:
+	StreamAwaiter(int streamIndex, uint8_t priority) noexcept;
+	StreamAwaiter(const StreamAwaiter&) = delete;
+	StreamAwaiter& operator=(const StreamAwaiter&) = delete;
+
+	[[nodiscard]] bool await_ready() const noexcept;
+	void await_suspend(std::coroutine_handle<> handle) noexcept;
+	void await_resume() noexcept {}
+};
+
+/// @brief Resumes the coroutine on the main thread through the MainThreadTaskQueue.
+class MainThreadAwaiter final
+{
+	uint8_t priority;
+
+public:
+	explicit MainThreadAwaiter(uint8_t priority) noexcept : priority(priority) {}
+
+	[[nodiscard]] bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> handle) noexcept;
+	void await_resume() noexcept {}
+};
+
+[[nodiscard]] TaskAwaiter RunAsync(Task& task, std::size_t startIndex, std::size_t endIndex,
+	std::size_t grainSize = 1, uint8_t priority = 0) noexcept;
+[[nodiscard]] StreamAwaiter ResumeOnStream(int streamIndex, uint8_t priority = 0) noexcept;
+[[nodiscard]] StreamAwaiter ResumeOnIOStream(uint8_t priority = 0) noexcept;
+[[nodiscard]] MainThreadAwaiter ResumeOnMainThread(uint8_t priority = 128) noexcept;
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+class CoroutineTest : public TestCollection
+{
+public:
+	CoroutineTest() : TestCollection("CoroutineTest") {}
+
+protected:
+	void Prepare() override;
+};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -3,39 +3,131 @@
 
 #include "MainThreadTaskQueue.h"
 
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "Memory/AllocatorScope.h"
+#include "Memory/MemoryManager.h"
+
 
 namespace hbe
 {
 
+namespace
+{
+size_t GetPriorityLane(uint8_t priority) noexcept
+{
+	constexpr size_t NumPriorities = 256;
+	constexpr size_t LaneSize = NumPriorities / MainThreadTaskQueue::NumPriorityLanes;
+	static_assert(LaneSize * MainThreadTaskQueue::NumPriorityLanes == NumPriorities);
+
+	return priority / LaneSize;
+}
+} // namespace
+
 MainThreadTaskQueue::MainThreadTaskQueue()
-: isRunning(true)
+: freeItems(0)
+, numPendingTasks(0)
+, isRunning(true)
+, chunks{}
+, numChunks(0)
 {
+for (size_t i = 0; i < NumPriorityLanes; ++i)
+{
+	lanes[i].store(nullptr, std::memory_order_relaxed);
+	takenHeads[i] = nullptr;
+	takenTails[i] = nullptr;
+}
+
+AddChunk();
+}
+
+MainThreadTaskQueue::~MainThreadTaskQueue()
+{
+Assert(!HasPendingTasks(), "MainThreadTaskQueue is destroyed with %zu pending tasks.", NumPendingTasks());
+
+// Pending items which are not from the pool are not freed with the chunks.
+for (size_t lane = 0; lane < NumPriorityLanes; ++lane)
+{
+	TakeLane(lane);
+
+	for (auto* item = takenHeads[lane]; item != nullptr;)
+	{
+		auto* next = item->next;
+		FreeItem(*item);
+		item = next;
+	}
+}
+
+AllocatorScope scope(MemoryManager::SystemAllocatorID);
+auto& mmgr = MemoryManager::GetInstance();
+
+const auto count = numChunks.load(std::memory_order_acquire);
+for (uint32_t i = 0; i < count; ++i)
+{
+	mmgr.DeleteArray(chunks[i], ChunkSize);
+	chunks[i] = nullptr;
+}
 }
 
 void MainThreadTaskQueue::Enqueue(TTaskFunc taskFunc, void* userData, uint8_t priority) noexcept
 {
-TaskItem item(priority, taskFunc, userData);
-queue.Push(item);
+auto* item = AllocateItem();
+item->taskFunc = taskFunc;
+item->userData = userData;
+
+numPendingTasks.fetch_add(1, std::memory_order_relaxed);
+
+auto& lane = lanes[GetPriorityLane(priority)];
+item->next = lane.load(std::memory_order_relaxed);
+
+while (!lane.compare_exchange_weak(item->next, item, std::memory_order_release, std::memory_order_relaxed));
 }
 
-size_t MainThreadTaskQueue::ProcessTasks() noexcept
+size_t MainThreadTaskQueue::ProcessTasks(time::TDuration budget) noexcept
 {
+const auto startTime = time::GetNow();
 size_t processed = 0;
 
-while (!queue.IsEmpty())
+while (true)
 {
-	auto itemOpt = queue.Pop();
-	if (!itemOpt.has_value())
+	TaskItem* item = nullptr;
+
+	// Check the higher priority lanes again after each task, as they may have been pushed meanwhile.
+	for (size_t lane = 0; lane < NumPriorityLanes; ++lane)
 	{
+		if (takenHeads[lane] == nullptr)
+		{
+			TakeLane(lane);
+		}
+
+		item = takenHeads[lane];
+		continueIf(item == nullptr);
+
+		takenHeads[lane] = item->next;
+		if (takenHeads[lane] == nullptr)
+		{
+			takenTails[lane] = nullptr;
+		}
+
 		break;
 	}
 
-	TaskItem& item = *itemOpt;
-	if (item.taskFunc)
+	breakIf(item == nullptr);
+
+	// Recycle the item first, so the task can enqueue another one.
+	const auto taskFunc = item->taskFunc;
+	const auto userData = item->userData;
+	FreeItem(*item);
+
+	if (taskFunc != nullptr)
 	{
-		item.taskFunc(item.userData);
+		taskFunc(userData);
 		++processed;
 	}
+
+	numPendingTasks.fetch_sub(1, std::memory_order_release);
+
+	breakIf(time::GetNow() - startTime >= budget);
 }
 
 return processed;
@@ -43,7 +135,7 @@ return processed;
 
 bool MainThreadTaskQueue::HasPendingTasks() const noexcept
 {
-return !queue.IsEmpty();
+return numPendingTasks.load(std::memory_order_acquire) > 0;
 }
 
 void MainThreadTaskQueue::RequestStop() noexcept
@@ -56,4 +148,346 @@ bool MainThreadTaskQueue::IsRunning() const noexcept
 return isRunning;
 }
 
+MainThreadTaskQueue::TaskItem* MainThreadTaskQueue::AllocateItem() noexcept
+{
+TTaggedId head = freeItems.load(std::memory_order_acquire);
+
+while (true)
+{
+	const auto id = static_cast<uint32_t>(head);
+	if (unlikely(id == 0))
+	{
+		if (unlikely(!AddChunk()))
+		{
+			AllocatorScope scope(MemoryManager::SystemAllocatorID);
+			auto* item = MemoryManager::GetInstance().New<TaskItem>();
+			item->id = 0;
+
+			return item;
+		}
+
+		head = freeItems.load(std::memory_order_acquire);
+		continue;
+	}
+
+	// The item can be taken by another producer meanwhile. Then the tag has changed, and the CAS fails.
+	auto& item = GetItem(id);
+	const TTaggedId tag = (head >> 32) + 1;
+	const TTaggedId next = (tag << 32) | item.nextFree.load(std::memory_order_relaxed);
+
+	if (freeItems.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+	{
+		return &item;
+	}
+}
+}
+
+void MainThreadTaskQueue::FreeItem(TaskItem& item) noexcept
+{
+if (unlikely(item.id == 0))
+{
+	AllocatorScope scope(MemoryManager::SystemAllocatorID);
+	MemoryManager::GetInstance().Delete(&item);
+
+	return;
+}
+
+TTaggedId head = freeItems.load(std::memory_order_relaxed);
+TTaggedId next = 0;
+
+do
+{
+	item.nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+	next = (((head >> 32) + 1) << 32) | item.id;
+} while (!freeItems.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool MainThreadTaskQueue::AddChunk() noexcept
+{
+std::scoped_lock lock(chunkLock);
+
+// Another producer may have added a chunk while this one was waiting for the lock.
+returnValueIf(true, static_cast<uint32_t>(freeItems.load(std::memory_order_acquire)) != 0);
+
+const auto chunkIndex = numChunks.load(std::memory_order_relaxed);
+returnValueIf(false, chunkIndex >= MaxChunks);
+
+TaskItem* chunk = nullptr;
+{
+	AllocatorScope scope(MemoryManager::SystemAllocatorID);
+	chunk = MemoryManager::GetInstance().NewArray<TaskItem>(ChunkSize);
+}
+
+const auto firstId = static_cast<uint32_t>(chunkIndex * ChunkSize + 1);
+for (uint32_t i = 0; i < ChunkSize; ++i)
+{
+	chunk[i].id = firstId + i;
+	chunk[i].nextFree.store(firstId + i + 1, std::memory_order_relaxed);
+}
+
+chunks[chunkIndex] = chunk;
+numChunks.store(chunkIndex + 1, std::memory_order_release);
+
+// Link the whole chunk in front of the free list at once.
+auto& last = chunk[ChunkSize - 1];
+TTaggedId head = freeItems.load(std::memory_order_relaxed);
+TTaggedId next = 0;
+
+do
+{
+	last.nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+	next = (((head >> 32) + 1) << 32) | firstId;
+} while (!freeItems.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+
+return true;
+}
+
+MainThreadTaskQueue::TaskItem& MainThreadTaskQueue::GetItem(uint32_t id) const noexcept
+{
+const auto index = id - 1;
+return chunks[index / ChunkSize][index % ChunkSize];
+}
+
+void MainThreadTaskQueue::TakeLane(size_t lane) noexcept
+{
+auto& head = lanes[lane];
+returnIf(head.load(std::memory_order_relaxed) == nullptr);
+
+TaskItem* item = head.exchange(nullptr, std::memory_order_acquire);
+TaskItem* const newest = item;
+TaskItem* reversed = nullptr;
+
+while (item != nullptr)
+{
+	auto* next = item->next;
+	item->next = reversed;
+	reversed = item;
+	item = next;
+}
+
+if (takenTails[lane] != nullptr)
+{
+	takenTails[lane]->next = reversed;
+}
+else
+{
+	takenHeads[lane] = reversed;
+}
+
+takenTails[lane] = newest;
+}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <thread>
+#include "HSTL/HVector.h"
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+void MainThreadTaskQueueTest::Prepare()
+{
+AddTest("Priority and FIFO Order", [this](auto& ls)
+{
+	struct Record final
+	{
+		HVector<int> order;
+	};
+
+	struct Item final
+	{
+		Record* record;
+		int value;
+	};
+
+	auto func = [](void* userData)
+	{
+		auto& item = *static_cast<Item*>(userData);
+		item.record->order.push_back(item.value);
+	};
+
+	Record record;
+	Item items[] = {{&record, 20}, {&record, 0}, {&record, 21}, {&record, 1}, {&record, 30}, {&record, 2}};
+	const uint8_t priorities[] = {128, 0, 128, 10, 255, 20};
+
+	MainThreadTaskQueue queue;
+	for (size_t i = 0; i < std::size(items); ++i)
+	{
+		queue.Enqueue(func, &items[i], priorities[i]);
+	}
+
+	const auto processed = queue.ProcessTasks();
+	const int expected[] = {0, 1, 2, 20, 21, 30};
+
+	if (processed != std::size(expected) || record.order.size() != std::size(expected))
+	{
+		ls << "Processed " << processed << " tasks, expected " << std::size(expected) << lferr;
+		return;
+	}
+
+	for (size_t i = 0; i < std::size(expected); ++i)
+	{
+		if (record.order[i] != expected[i])
+		{
+			ls << "Order mismatch at " << i << ": " << record.order[i] << " != " << expected[i] << lferr;
+			return;
+		}
+	}
+
+	if (queue.HasPendingTasks())
+	{
+		ls << "The queue should be empty." << lferr;
+	}
+});
+
+AddTest("Multiple Producers", [this](auto& ls)
+{
+	constexpr int NumProducers = 4;
+	constexpr int NumTasksPerProducer = 50000;
+	constexpr int NumTasks = NumProducers * NumTasksPerProducer;
+
+	struct Context final
+	{
+		HVector<uint8_t> counts;
+		explicit Context(size_t count) : counts(count, 0) {}
+	};
+
+	struct Item final
+	{
+		Context* context;
+		int index;
+	};
+
+	auto func = [](void* userData)
+	{
+		auto& item = *static_cast<Item*>(userData);
+		++item.context->counts[item.index];
+	};
+
+	Context context(NumTasks);
+	HVector<Item> items(NumTasks);
+	for (int i = 0; i < NumTasks; ++i)
+	{
+		items[i] = {&context, i};
+	}
+
+	MainThreadTaskQueue queue;
+	std::atomic<int> numDoneProducers = 0;
+
+	auto produce = [&](int producerIndex)
+	{
+		for (int i = 0; i < NumTasksPerProducer; ++i)
+		{
+			const int index = producerIndex * NumTasksPerProducer + i;
+			queue.Enqueue(func, &items[index], static_cast<uint8_t>(index % 256));
+		}
+
+		numDoneProducers.fetch_add(1);
+	};
+
+	HVector<std::thread> producers;
+	for (int i = 0; i < NumProducers; ++i)
+	{
+		producers.emplace_back(produce, i);
+	}
+
+	size_t processed = 0;
+	while (numDoneProducers.load() < NumProducers || queue.HasPendingTasks())
+	{
+		processed += queue.ProcessTasks(std::chrono::microseconds(500));
+	}
+
+	for (auto& producer : producers)
+	{
+		producer.join();
+	}
+
+	for (int i = 0; i < NumTasks; ++i)
+	{
+		if (context.counts[i] != 1)
+		{
+			ls << "Task " << i << " has been run " << static_cast<int>(context.counts[i]) << " times." << lferr;
+			return;
+		}
+	}
+
+	ls << processed << " tasks from " << NumProducers << " producers have been processed." << lf;
+});
+
+AddTest("Beyond the Pool", [this](auto& ls)
+{
+	// None is processed until all are enqueued, so the last ones can't come from the pool.
+	constexpr size_t NumTasks = MainThreadTaskQueue::MaxPooledItems + 1000;
+
+	auto func = [](void* userData) { ++*static_cast<size_t*>(userData); };
+
+	size_t count = 0;
+	MainThreadTaskQueue queue;
+	for (size_t i = 0; i < NumTasks; ++i)
+	{
+		queue.Enqueue(func, &count, static_cast<uint8_t>(i % 256));
+	}
+
+	if (queue.NumPendingTasks() != NumTasks)
+	{
+		ls << queue.NumPendingTasks() << " tasks are pending, expected " << NumTasks << lferr;
+		return;
+	}
+
+	const auto processed = queue.ProcessTasks();
+	if (processed != NumTasks || count != NumTasks || queue.HasPendingTasks())
+	{
+		ls << "Processed " << processed << ", run " << count << " / " << NumTasks << " tasks." << lferr;
+		return;
+	}
+
+	// Again, with the pool reused.
+	for (size_t i = 0; i < NumTasks; ++i)
+	{
+		queue.Enqueue(func, &count);
+	}
+
+	if (queue.ProcessTasks() != NumTasks || count != NumTasks * 2)
+	{
+		ls << "Run " << count << " / " << NumTasks * 2 << " tasks in total." << lferr;
+		return;
+	}
+
+	ls << NumTasks << " tasks have been enqueued without being dropped." << lf;
+});
+
+AddTest("Time Budget", [this](auto& ls)
+{
+	constexpr int NumTasks = 50;
+
+	auto func = [](void*)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	};
+
+	MainThreadTaskQueue queue;
+	for (int i = 0; i < NumTasks; ++i)
+	{
+		queue.Enqueue(func, nullptr);
+	}
+
+	const auto processed = queue.ProcessTasks(std::chrono::milliseconds(5));
+	if (processed == 0 || processed >= NumTasks)
+	{
+		ls << "A 5ms budget processed " << processed << " tasks of 1ms." << lferr;
+	}
+
+	const auto remaining = queue.ProcessTasks();
+	if (processed + remaining != NumTasks || queue.HasPendingTasks())
+	{
+		ls << "Processed " << (processed + remaining) << " / " << NumTasks << " tasks." << lferr;
+	}
+
+	ls << "Processed " << processed << " tasks within a 5ms budget." << lf;
+});
+}
+
 } // namespace hbe
+#endif //__UNIT_TEST__
@@ -3,66 +3,111 @@
 #pragma once
 
 
+#include <array>
 #include <atomic>
-#include <functional>
-#include "Container/BoundedPriorityQueue.h"
+#include <cstdint>
+#include <mutex>
+#include "Time.h"
 
 namespace hbe
 {
 
 /// @brief Thread-safe task queue for the main thread.
-/// @details Workers can enqueue tasks to be executed on the main thread.
-/// Uses BoundedPriorityQueue internally for efficient task management.
+/// @details Workers can enqueue tasks to be executed on the main thread. It's a lock-free multi-producer,
+/// single-consumer queue. Each priority lane is an intrusive stack which producers push into with a CAS, and the
+/// main thread takes as a whole with an exchange, so the consumer side is free from ABA. Items come from chunks of
+/// nodes recycled through a tagged free list. Once the pool is used up, items are allocated one by one and freed
+/// after running, so Enqueue never drops a task. Only the main thread may call ProcessTasks.
 class MainThreadTaskQueue final
 {
 public:
 using TTaskFunc = void (*)(void*);
 
+// Priorities [0, 255] are bucketed into lanes. Lower lanes are processed first, FIFO within a lane.
+static constexpr size_t NumPriorityLanes = 4;
+
+// Items beyond this many pending at once are not recycled, but allocated and freed individually.
+static constexpr size_t MaxPooledItems = 256 * 1024;
+
 private:
-struct TaskItem
+struct TaskItem final
 {
-	uint8_t priority;
-	mutable bool isDone;
 	TTaskFunc taskFunc;
 	void* userData;
-
-	TaskItem(uint8_t p, TTaskFunc t, void* userData)
-		: priority(p)
-		, isDone(false)
-		, taskFunc(t)
-		, userData(userData)
-	{
-	}
-
-	bool operator<(const TaskItem& other) const noexcept
-	{
-		return priority < other.priority;
-	}
-
-	[[nodiscard]] bool HasFinished() const noexcept
-	{
-		return isDone;
-	}
+	TaskItem* next;
+	std::atomic<uint32_t> nextFree;
+	// 0 if it's not from the pool.
+	uint32_t id;
 };
 
-static constexpr size_t MaxQueueSize = 1024;
-using TQueue = BoundedPriorityQueue<TaskItem, 256, MaxQueueSize>;
+// Free list head. The lower 32 bits are the item id (index + 1, 0 if empty), and the upper 32 bits are a tag
+// increased by every push and pop to detect ABA.
+using TTaggedId = uint64_t;
 
-TQueue queue;
+static constexpr size_t ChunkSize = 256;
+static constexpr size_t MaxChunks = MaxPooledItems / ChunkSize;
+
+std::array<std::atomic<TaskItem*>, NumPriorityLanes> lanes;
+std::atomic<TTaggedId> freeItems;
+std::atomic<size_t> numPendingTasks;
 std::atomic<bool> isRunning;
 
+// Consumer only. Items taken from the lanes, in FIFO order.
+std::array<TaskItem*, NumPriorityLanes> takenHeads;
+std::array<TaskItem*, NumPriorityLanes> takenTails;
+
+std::mutex chunkLock;
+std::array<TaskItem*, MaxChunks> chunks;
+std::atomic<uint32_t> numChunks;
+
 public:
 MainThreadTaskQueue();
-~MainThreadTaskQueue() = default;
+~MainThreadTaskQueue();
+
+MainThreadTaskQueue(const MainThreadTaskQueue&) = delete;
+MainThreadTaskQueue& operator=(const MainThreadTaskQueue&) = delete;
 
 /// @brief Enqueue a task to be executed on the main thread.
 /// @param task The task function to execute.
 /// @param priority The priority of the task (0 = highest, 255 = lowest). Default is 128.
 void Enqueue(TTaskFunc taskFunc, void* userData, uint8_t priority = 128) noexcept;
-size_t ProcessTasks() noexcept;
+
+/// @brief Run pending tasks in priority order until the queue is empty or the budget is spent.
+/// @details At least one task is run if there's any, and the budget is checked after each task.
+/// @return Number of processed tasks.
+size_t ProcessTasks(time::TDuration budget = time::TDuration::max()) noexcept;
+
 [[nodiscard]] bool HasPendingTasks() const noexcept;
+[[nodiscard]] size_t NumPendingTasks() const noexcept { return numPendingTasks.load(std::memory_order_relaxed); }
 void RequestStop() noexcept;
 [[nodiscard]] bool IsRunning() const noexcept;
+
+private:
+[[nodiscard]] TaskItem* AllocateItem() noexcept;
+void FreeItem(TaskItem& item) noexcept;
+bool AddChunk() noexcept;
+[[nodiscard]] TaskItem& GetItem(uint32_t id) const noexcept;
+
+// Move the items pushed into the lane to the consumer side, in FIFO order.
+void TakeLane(size_t lane) noexcept;
+};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+class MainThreadTaskQueueTest : public TestCollection
+{
+public:
+	MainThreadTaskQueueTest() : TestCollection("MainThreadTaskQueueTest") {}
+
+protected:
+	void Prepare() override;
 };
 
 } // namespace hbe
+#endif //__UNIT_TEST__
@@ -5,6 +5,10 @@
 
 #include "RangedTask.h"
 
+#include <algorithm>
+
+#include "Core/CommonMacros.h"
+#include "Engine/Engine.h"
 #include "Log/Logger.h"
 #include "TaskSystem.h"
 
@@ -26,8 +30,15 @@ void RangedTask::Run() noexcept
 	}
 
 	auto userData = task.GetUserData();
-	auto delta = runnable(userData, currentIndex, end);
-	currentIndex += delta;
+	if (grainSize > 0)
+	{
+		RunSplittable(runnable, userData);
+	}
+	else
+	{
+		auto delta = runnable(userData, currentIndex, end);
+		currentIndex += delta;
+	}
 
 	if (HasFinished())
 	{
@@ -35,6 +46,36 @@ void RangedTask::Run() noexcept
 	}
 }
 
+void RangedTask::RunSplittable(TRunnable runnable, void* userData) noexcept
+{
+	auto& task = taskRef.get();
+	auto& taskSystem = Engine::Get().GetTaskSystem();
+	auto* stream = TaskStream::GetCurrent();
+
+	while (currentIndex < end)
+	{
+		// Hand off a half only after the previous one has been taken, so idle workers don't cause a burst of splits.
+		const bool canSplit = stream != nullptr && (end - currentIndex) >= grainSize * 2;
+		if (canSplit && taskSystem.HasIdleWorkers() && !stream->HasLocalTasks())
+		{
+			const TIndex middle = currentIndex + (end - currentIndex) / 2;
+
+			auto subTask = task.GenerateSubTask(middle, end, priority);
+			subTask.grainSize = grainSize;
+			end = middle;
+
+			taskSystem.Enqueue(subTask);
+		}
+
+		const TIndex chunkStart = currentIndex;
+		const TIndex chunkEnd = std::min(end, chunkStart + grainSize);
+		currentIndex += runnable(userData, chunkStart, chunkEnd);
+
+		// The runnable yielded. It'll be called again with the updated currentIndex.
+		breakIf(currentIndex < chunkEnd);
+	}
+}
+
 RangedTask::RangedTask(Task& task, TIndex start, TIndex end, uint8_t priority) noexcept
 	: priority(priority)
 	, taskName(task.GetName())
@@ -42,6 +83,7 @@ RangedTask::RangedTask(Task& task, TIndex start, TIndex end, uint8_t priority) n
 	, start(start)
 	, end(end)
 	, currentIndex(start)
+	, grainSize(0)
 {
 	affinity.Unset(TaskSystem::GetBaseTaskStreamIndex());
 	affinity.Unset(TaskSystem::GetIOTaskStreamIndex());
@@ -6,6 +6,7 @@
 #pragma once
 #include <cstddef>
 #include <functional>
+#include "Runnable.h"
 #include "String/StaticString.h"
 #include "TaskStreamAffinity.h"
 
@@ -36,6 +37,10 @@ public:
 	// Index to be processed
 	mutable TIndex currentIndex;
 
+	// Maximum number of indices per runnable call when splittable. 0 if it's not splittable.
+	// A splittable RangedTask hands off a half of its remaining range whenever a worker stream is idle.
+	TIndex grainSize;
+
 public:
 	~RangedTask() = default;
 	RangedTask& operator=(const RangedTask& other) = default;
@@ -49,6 +54,8 @@ public:
 private:
 	RangedTask(Task& task, TIndex start, TIndex end, uint8_t priority) noexcept;
 
+	void RunSplittable(TRunnable runnable, void* userData) noexcept;
+
 	friend class Task;
 	friend class TaskStream;
 };
@@ -13,9 +13,9 @@ namespace hbe
 {
 
 SystemStatistics::SystemStatistics(Engine& engine) :
-	frameCount(0), slowFrameCount(0), engineLogCount(0), logCount(0), longLogCount(0), fallbackAllocCount(0),
-	allocCount(0), deallocCount(0), totalUsage(0), maxUsage(0), startTime(time::TStopWatch::now()),
-	currentTime(startTime)
+	frameCount(0), slowFrameCount(0), engineLogCount(0), logCount(0), longLogCount(0), logBackpressureCount(0),
+	logDropCount(0), fallbackAllocCount(0), allocCount(0), deallocCount(0), totalUsage(0), maxUsage(0),
+	startTime(time::TStopWatch::now()), currentTime(startTime)
 {
 	Assert(engine.IsMemoryManagerReady());
 	engine.SetSystemStatisticsReady();
@@ -94,6 +94,12 @@ void SystemStatistics::Print() noexcept
 	log.Out([curLongLogCount, curLogCount](auto& ls)
 	{ ls << "Long Log Count = " << curLongLogCount << " / " << curLogCount; });
 
+	log.Out([this](auto& ls)
+	{
+		ls << "Log Backpressure Count = " << logBackpressureCount.load(std::memory_order_relaxed)
+		   << ", Dropped Log Count = " << logDropCount.load(std::memory_order_relaxed);
+	});
+
 	log.Out([this](auto& ls) { ls << "Running Time = " << timeSinceStart << " sec"; });
 
 	log.Out([this](auto& ls)
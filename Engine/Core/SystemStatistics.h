@@ -25,6 +25,8 @@ private:
 	std::atomic<uint64_t> engineLogCount;
 	std::atomic<uint64_t> logCount;
 	std::atomic<uint64_t> longLogCount;
+	std::atomic<uint64_t> logBackpressureCount;
+	std::atomic<uint64_t> logDropCount;
 	std::atomic<uint64_t> fallbackAllocCount;
 
 	std::mutex sysMemReportLock;
@@ -63,8 +65,17 @@ public:
 	void IncEngineLogCount() noexcept { engineLogCount.fetch_add(1, std::memory_order_relaxed); }
 	void IncLogCount() noexcept { logCount.fetch_add(1, std::memory_order_relaxed); }
 	void IncLongLogCount() noexcept { longLogCount.fetch_add(1, std::memory_order_relaxed); }
+	void IncLogBackpressureCount() noexcept { logBackpressureCount.fetch_add(1, std::memory_order_relaxed); }
+	void IncLogDropCount() noexcept { logDropCount.fetch_add(1, std::memory_order_relaxed); }
 	void IncFallbackAllocCount() noexcept { fallbackAllocCount.fetch_add(1, std::memory_order_relaxed); }
 
+	[[nodiscard]] auto GetLogBackpressureCount() const noexcept
+	{
+		return logBackpressureCount.load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] auto GetLogDropCount() const noexcept { return logDropCount.load(std::memory_order_relaxed); }
+
 	[[nodiscard]] auto GetStartTime() const noexcept { return startTime; }
 	[[nodiscard]] auto GetCurrentTime() const noexcept { return currentTime; }
 	[[nodiscard]] auto GetTimeSinceStart() const noexcept { return timeSinceStart; }
@@ -2,6 +2,7 @@
 
 #include "Task.h"
 
+#include "Core/CommonMacros.h"
 #include "Engine/Engine.h"
 #include "Log/Logger.h"
 #include "TaskSystem.h"
@@ -15,6 +16,8 @@ Task::Task() noexcept
 	, numFinishedSubTasks(0)
 	, func(nullptr)
 	, userData(nullptr)
+	, completionCallback(nullptr)
+	, completionContext(nullptr)
 {
 }
 
@@ -24,6 +27,8 @@ Task::Task(StaticString taskName, TRunnable func, void* userData) noexcept
 	, numFinishedSubTasks(0)
 	, func(func)
 	, userData(userData)
+	, completionCallback(nullptr)
+	, completionContext(nullptr)
 {}
 
 void Task::Start(TIndex numberOfSubTasks, TIndex startIndex, TIndex endIndex, uint8_t priority) noexcept
@@ -49,7 +54,7 @@ void Task::Start(TIndex numberOfSubTasks, TIndex startIndex, TIndex endIndex, ui
 
 	constexpr TIndex one = 1;
 	const TIndex length = endIndex - startIndex + 1;
-	TIndex interval = length / numSubTasks; // always bigger than zero.
+	TIndex interval = length / numberOfSubTasks; // always bigger than zero.
 	interval = std::max(interval, one);
 	TIndex iStart = startIndex;
 	TIndex iEnd = iStart + interval;
@@ -67,6 +72,39 @@ void Task::Start(TIndex numberOfSubTasks, TIndex startIndex, TIndex endIndex, ui
 	taskSystem.Enqueue(rangedTask);
 }
 
+void Task::Reset() noexcept
+{
+	Assert(NumSubTasks() == 0 || HasDone(), "Task %s is reset while running.", name.c_str());
+
+	numSubTasks.store(0, std::memory_order::relaxed);
+	numFinishedSubTasks.store(0, std::memory_order::release);
+}
+
+void Task::ReportFinishedSubTask() noexcept
+{
+	const auto numFinished = numFinishedSubTasks.fetch_add(1, std::memory_order::seq_cst) + 1;
+	returnIf(completionCallback == nullptr);
+
+	// Once all sub-tasks have finished, no more sub-tasks can be generated, so only the last one sees it equal.
+	returnIf(numFinished != numSubTasks.load(std::memory_order::seq_cst));
+
+	completionCallback(completionContext);
+}
+
+void Task::SetCompletionCallback(TCompletionCallback callback, void* context) noexcept
+{
+	completionCallback = callback;
+	completionContext = context;
+}
+
+bool Task::HasDone() const noexcept
+{
+	const auto numFinished = numFinishedSubTasks.load(std::memory_order::seq_cst);
+	const auto numTotal = numSubTasks.load(std::memory_order::seq_cst);
+
+	return numTotal > 0 && numFinished >= numTotal;
+}
+
 void Task::BusyWait() const noexcept
 {
 	while (!HasDone());
@@ -84,7 +122,7 @@ void Task::Wait(uint32_t intervalMilliSecs) const noexcept
 
 RangedTask Task::GenerateSubTask(TIndex start, TIndex end, uint8_t priority) noexcept
 {
-	++numSubTasks;
+	numSubTasks.fetch_add(1, std::memory_order::seq_cst);
 	return {*this, start, end, priority};
 }
 } // namespace hbe
@@ -17,14 +17,15 @@ class Task final
 public:
 	using TIndex = std::size_t;
 	using TThreadID = std::thread::id;
-	using TNumSubTasks = uint8_t;
+	using TNumSubTasks = uint32_t;
+	using TCompletionCallback = void (*)(void* /*context*/);
 
 private:
 	// Task Name
 	StaticString name;
 
-	// Number of RangedTasks
-	TNumSubTasks numSubTasks;
+	// Number of RangedTasks. It can grow while running when a splittable RangedTask hands off a part of its range.
+	std::atomic<TNumSubTasks> numSubTasks;
 
 	// Number of finished RangedTasks
 	std::atomic<TNumSubTasks> numFinishedSubTasks;
@@ -35,6 +36,10 @@ private:
 	// Custom User Data
 	void* userData;
 
+	// Called once by the thread finishing the last RangedTask. Used by TaskGraph to launch successors.
+	TCompletionCallback completionCallback;
+	void* completionContext;
+
 public:
 	Task() noexcept;
 	Task(StaticString taskName, TRunnable func, void* userData) noexcept;
@@ -42,22 +47,30 @@ public:
 
 	void Start(TIndex numberOfSubTasks, TIndex startIndex, TIndex endIndex, uint8_t priority = 0) noexcept;
 
+	// Clear the sub-task counts to run the task again. The task should not be running.
+	void Reset() noexcept;
+
 	// Wait
 	void BusyWait() const noexcept;
 	void Wait(uint32_t intervalMilliSecs = 10) const noexcept;
 
 public:
 	[[nodiscard]] auto GetName() const noexcept { return name; }
-	[[nodiscard]] auto NumSubTasks() const noexcept { return numSubTasks; }
+	[[nodiscard]] auto NumSubTasks() const noexcept { return numSubTasks.load(std::memory_order::relaxed); }
 	[[nodiscard]] auto NumFinishedSubTasks() const noexcept { return numFinishedSubTasks.load(std::memory_order::relaxed); }
-	[[nodiscard]] bool HasDone() const noexcept { return numSubTasks > 0 && NumFinishedSubTasks() >= numSubTasks; }
+
+	// A sub-task is always generated before its parent reports finished, so load the finished count first.
+	[[nodiscard]] bool HasDone() const noexcept;
 
 	// Increase numFinishedSubTasks.  It guarantees all other global memory values are synced properly.
-	void ReportFinishedSubTask() noexcept { numFinishedSubTasks.fetch_add(1, std::memory_order::seq_cst); }
+	// It calls the completion callback if it's the last one. The callback may destroy the task, so the task is not
+	// accessed after the callback.
+	void ReportFinishedSubTask() noexcept;
 
 	[[nodiscard]] TRunnable GetRunnable() const noexcept { return func;}
 	void SetRunnable(TRunnable runnable) noexcept { func = runnable; }
 	[[nodiscard]] void* GetUserData() const noexcept { return userData; }
+	void SetCompletionCallback(TCompletionCallback callback, void* context) noexcept;
 
 	// Generate a RangedTask with the given range [start, end)
 	RangedTask GenerateSubTask(TIndex start, TIndex end, uint8_t priority = 0) noexcept;
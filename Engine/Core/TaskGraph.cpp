@@ -0,0 +1,412 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "TaskGraph.h"
+
+#include <atomic>
+#include <thread>
+
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "Engine/Engine.h"
+#include "Log/Logger.h"
+#include "TaskSystem.h"
+
+
+namespace hbe
+{
+
+TaskGraph::TaskGraph(StaticString name) noexcept
+	: name(name)
+	, numFinishedNodes(0)
+	, isDirty(false)
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+	Assert(IsDone(), "TaskGraph %s is destroyed while running.", name.c_str());
+
+	for (auto& node : nodes)
+	{
+		node.task->SetCompletionCallback(nullptr, nullptr);
+	}
+}
+
+TaskGraph::TNodeIndex TaskGraph::AddNode(Task& task, TIndex startIndex, TIndex endIndex, TIndex grainSize,
+	uint8_t priority) noexcept
+{
+	Assert(IsDone(), "TaskGraph %s is modified while running.", name.c_str());
+
+	for (auto& node : nodes)
+	{
+		Assert(node.task != &task, "Task %s is added to TaskGraph %s twice.", task.GetName().c_str(), name.c_str());
+	}
+
+	const auto index = static_cast<TNodeIndex>(nodes.size());
+	nodes.push_back(Node{this, &task, startIndex, endIndex, grainSize, priority, index, 0, {}});
+
+	// A graph which isn't running has all of its nodes finished.
+	numFinishedNodes.fetch_add(1, std::memory_order_relaxed);
+	isDirty = true;
+
+	return index;
+}
+
+void TaskGraph::AddDependency(TNodeIndex predecessor, TNodeIndex successor) noexcept
+{
+	Assert(IsDone(), "TaskGraph %s is modified while running.", name.c_str());
+	Assert(predecessor < nodes.size() && successor < nodes.size(), "Invalid node %u -> %u", predecessor, successor);
+	Assert(predecessor != successor, "A node can't depend on itself.");
+
+	nodes[predecessor].successors.push_back(successor);
+	++nodes[successor].numPredecessors;
+	isDirty = true;
+}
+
+bool TaskGraph::Run() noexcept
+{
+	Assert(IsDone(), "TaskGraph %s is run again before it's done.", name.c_str());
+
+	// Only the roots are launched, so a cycle would never finish.
+	returnValueIf(false, unlikely(isDirty) && !Build());
+
+	const auto numNodes = nodes.size();
+	returnValueIf(true, numNodes == 0);
+
+	numFinishedNodes.store(0, std::memory_order_relaxed);
+
+	// Reset every node before launching any, as a root can finish and launch its successors right away.
+	for (size_t i = 0; i < numNodes; ++i)
+	{
+		auto& node = nodes[i];
+		numPendingPredecessors[i] = node.numPredecessors;
+		node.task->Reset();
+		node.task->SetCompletionCallback(&TaskGraph::OnNodeFinished, &node);
+	}
+
+	for (auto& node : nodes)
+	{
+		continueIf(node.numPredecessors > 0);
+		Launch(node);
+	}
+
+	return true;
+}
+
+bool TaskGraph::IsDone() const noexcept
+{
+	return numFinishedNodes.load(std::memory_order_acquire) >= nodes.size();
+}
+
+void TaskGraph::BusyWait() const noexcept
+{
+	while (!IsDone());
+}
+
+void TaskGraph::Wait(uint32_t intervalMilliSecs) const noexcept
+{
+	const auto interval = std::chrono::milliseconds(intervalMilliSecs);
+
+	while (!IsDone())
+	{
+		std::this_thread::sleep_for(interval);
+	}
+}
+
+bool TaskGraph::Build() noexcept
+{
+	if (unlikely(!IsAcyclic()))
+	{
+		auto log = Logger::Get(name);
+		log.OutError("The graph has a cycle, so it can't run.");
+
+		return false;
+	}
+
+	numPendingPredecessors.resize(nodes.size());
+	isDirty = false;
+
+	return true;
+}
+
+bool TaskGraph::IsAcyclic() const noexcept
+{
+	// Kahn's algorithm. Every node is visited only if there's no cycle.
+	HVector<TCount> inDegrees;
+	HVector<TNodeIndex> readyNodes;
+	inDegrees.reserve(nodes.size());
+	readyNodes.reserve(nodes.size());
+
+	for (auto& node : nodes)
+	{
+		inDegrees.push_back(node.numPredecessors);
+		if (node.numPredecessors == 0)
+		{
+			readyNodes.push_back(node.index);
+		}
+	}
+
+	for (size_t i = 0; i < readyNodes.size(); ++i)
+	{
+		for (auto successor : nodes[readyNodes[i]].successors)
+		{
+			if (--inDegrees[successor] == 0)
+			{
+				readyNodes.push_back(successor);
+			}
+		}
+	}
+
+	return readyNodes.size() == nodes.size();
+}
+
+void TaskGraph::Launch(Node& node) noexcept
+{
+	auto& taskSystem = Engine::Get().GetTaskSystem();
+	taskSystem.ParallelFor(*node.task, node.startIndex, node.endIndex, node.grainSize, node.priority);
+}
+
+void TaskGraph::OnNodeFinished(void* context) noexcept
+{
+	auto& node = *static_cast<Node*>(context);
+	auto& graph = *node.graph;
+
+	for (auto successor : node.successors)
+	{
+		std::atomic_ref<TCount> numPending(graph.numPendingPredecessors[successor]);
+		continueIf(numPending.fetch_sub(1, std::memory_order_acq_rel) != 1);
+		graph.Launch(graph.nodes[successor]);
+	}
+
+	// The graph can be run again or destroyed from here, so this must be the last access to it.
+	graph.numFinishedNodes.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+void TaskGraphTest::Prepare()
+{
+	struct Recorder final
+	{
+		std::atomic<uint32_t> clock = 0;
+		uint32_t startTimes[8] = {};
+		uint32_t endTimes[8] = {};
+	};
+
+	struct NodeContext final
+	{
+		Recorder* recorder;
+		int id;
+	};
+
+	auto recordFunc = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+	{
+		auto& context = *static_cast<NodeContext*>(userData);
+		auto& recorder = *context.recorder;
+
+		recorder.startTimes[context.id] = recorder.clock.fetch_add(1) + 1;
+		recorder.endTimes[context.id] = recorder.clock.fetch_add(1) + 1;
+
+		return end - start;
+	};
+
+	AddTest("Empty Graph", [this](auto& ls)
+	{
+		TaskGraph graph("EmptyGraph");
+		graph.Run();
+
+		if (!graph.IsDone())
+		{
+			ls << "An empty graph should be done right after it runs." << lferr;
+		}
+	});
+
+	AddTest("Diamond Dependency (Replay)", [this, recordFunc](auto& ls)
+	{
+		// A -> B, A -> C, B -> D, C -> D
+		constexpr int NumNodes = 4;
+		constexpr int NumFrames = 100;
+
+		Recorder recorder;
+		NodeContext contexts[NumNodes] = {{&recorder, 0}, {&recorder, 1}, {&recorder, 2}, {&recorder, 3}};
+		Task tasks[NumNodes] = {Task("A", recordFunc, &contexts[0]), Task("B", recordFunc, &contexts[1]),
+			Task("C", recordFunc, &contexts[2]), Task("D", recordFunc, &contexts[3])};
+
+		TaskGraph graph("Diamond");
+		TaskGraph::TNodeIndex nodes[NumNodes];
+
+		for (int i = 0; i < NumNodes; ++i)
+		{
+			nodes[i] = graph.AddNode(tasks[i], 0, 1);
+		}
+
+		graph.AddDependency(nodes[0], nodes[1]);
+		graph.AddDependency(nodes[0], nodes[2]);
+		graph.AddDependency(nodes[1], nodes[3]);
+		graph.AddDependency(nodes[2], nodes[3]);
+
+		auto isBefore = [&recorder](int predecessor, int successor)
+		{
+			return recorder.endTimes[predecessor] < recorder.startTimes[successor];
+		};
+
+		for (int frame = 0; frame < NumFrames; ++frame)
+		{
+			graph.Run();
+			graph.Wait();
+
+			if (!isBefore(0, 1) || !isBefore(0, 2) || !isBefore(1, 3) || !isBefore(2, 3))
+			{
+				ls << "Dependency order is violated at frame " << frame << lferr;
+				return;
+			}
+
+			for (auto& task : tasks)
+			{
+				if (!task.HasDone())
+				{
+					ls << "A node has not been done at frame " << frame << lferr;
+					return;
+				}
+			}
+		}
+
+		ls << "The graph has been replayed " << NumFrames << " times in order." << lf;
+	});
+
+	AddTest("Cycle Is Rejected", [this](auto& ls)
+	{
+		// R -> A -> B -> C -> A. Only R is a root, so the cycle would never finish.
+		std::atomic<int> numRuns = 0;
+		auto countFunc = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+		{
+			static_cast<std::atomic<int>*>(userData)->fetch_add(1);
+			return end - start;
+		};
+
+		Task tasks[] = {Task("R", countFunc, &numRuns), Task("A", countFunc, &numRuns),
+			Task("B", countFunc, &numRuns), Task("C", countFunc, &numRuns)};
+
+		TaskGraph graph("Cycle");
+		TaskGraph::TNodeIndex nodes[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			nodes[i] = graph.AddNode(tasks[i], 0, 1);
+		}
+
+		graph.AddDependency(nodes[0], nodes[1]);
+		graph.AddDependency(nodes[1], nodes[2]);
+		graph.AddDependency(nodes[2], nodes[3]);
+		graph.AddDependency(nodes[3], nodes[1]);
+
+		for (int attempt = 0; attempt < 2; ++attempt)
+		{
+			if (graph.Run())
+			{
+				graph.BusyWait();
+				ls << "A cyclic graph has been run." << lferr;
+				return;
+			}
+
+			if (!graph.IsDone() || numRuns != 0)
+			{
+				ls << "A rejected graph should be done without running any node. Runs = " << numRuns.load() << lferr;
+				return;
+			}
+		}
+
+		ls << "The cyclic graph has been rejected." << lf;
+	});
+
+	AddTest("Parallel Nodes", [this](auto& ls)
+	{
+		// A chain of wide parallel-for nodes: fill, scale, then sum.
+		constexpr std::size_t Count = 1 << 16;
+
+		struct Context final
+		{
+			HVector<int> values;
+			std::atomic<int64_t> sum;
+
+			Context() : values(Count, 0), sum(0) {}
+		};
+
+		auto fillFunc = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+		{
+			auto& context = *static_cast<Context*>(userData);
+			for (auto i = start; i < end; ++i)
+			{
+				context.values[i] = static_cast<int>(i % 7);
+			}
+
+			return end - start;
+		};
+
+		auto scaleFunc = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+		{
+			auto& context = *static_cast<Context*>(userData);
+			for (auto i = start; i < end; ++i)
+			{
+				context.values[i] *= 3;
+			}
+
+			return end - start;
+		};
+
+		auto sumFunc = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+		{
+			auto& context = *static_cast<Context*>(userData);
+			int64_t sum = 0;
+			for (auto i = start; i < end; ++i)
+			{
+				sum += context.values[i];
+			}
+
+			context.sum.fetch_add(sum);
+
+			return end - start;
+		};
+
+		Context context;
+		Task fillTask("Fill", fillFunc, &context);
+		Task scaleTask("Scale", scaleFunc, &context);
+		Task sumTask("Sum", sumFunc, &context);
+
+		TaskGraph graph("ParallelNodes");
+		const auto fill = graph.AddNode(fillTask, 0, Count, 1024);
+		const auto scale = graph.AddNode(scaleTask, 0, Count, 1024);
+		const auto sum = graph.AddNode(sumTask, 0, Count, 1024);
+		graph.AddDependency(fill, scale);
+		graph.AddDependency(scale, sum);
+
+		int64_t expected = 0;
+		for (std::size_t i = 0; i < Count; ++i)
+		{
+			expected += static_cast<int64_t>(i % 7) * 3;
+		}
+
+		for (int frame = 0; frame < 10; ++frame)
+		{
+			context.sum = 0;
+			graph.Run();
+			graph.Wait();
+
+			if (context.sum != expected)
+			{
+				ls << "Sum mismatch at frame " << frame << ": " << context.sum.load() << " != " << expected << lferr;
+				return;
+			}
+		}
+
+		ls << "Sum = " << expected << lf;
+	});
+}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
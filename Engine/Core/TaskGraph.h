@@ -0,0 +1,102 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "HSTL/HVector.h"
+#include "String/StaticString.h"
+#include "Task.h"
+
+namespace hbe
+{
+
+/// @brief A reusable dependency graph (DAG) of Tasks.
+/// @details Build the graph once with AddNode and AddDependency, then call Run every frame. Root nodes are
+/// enqueued by Run, and each node is enqueued by the thread finishing its last predecessor, so no thread ever
+/// waits for a predecessor. Running the graph again does not allocate unless nodes or dependencies were added.
+/// Each node runs its Task over [startIndex, endIndex) with TaskSystem::ParallelFor.
+/// The Tasks are owned by the caller and shouldn't be started by anyone else while the graph is running.
+class TaskGraph final
+{
+public:
+	using TIndex = Task::TIndex;
+	using TNodeIndex = uint32_t;
+	using TCount = uint32_t;
+
+	static constexpr TNodeIndex InvalidNode = UINT32_MAX;
+
+private:
+	struct Node final
+	{
+		TaskGraph* graph;
+		Task* task;
+		TIndex startIndex;
+		TIndex endIndex;
+		TIndex grainSize;
+		uint8_t priority;
+		TNodeIndex index;
+		TCount numPredecessors;
+		HVector<TNodeIndex> successors;
+	};
+
+	StaticString name;
+	HVector<Node> nodes;
+	// Accessed through std::atomic_ref while running, so it can be resized when the graph changes.
+	HVector<TCount> numPendingPredecessors;
+	std::atomic<TCount> numFinishedNodes;
+	bool isDirty;
+
+public:
+	TaskGraph(const TaskGraph&) = delete;
+	TaskGraph& operator=(const TaskGraph&) = delete;
+
+	explicit TaskGraph(StaticString name) noexcept;
+	~TaskGraph();
+
+	// Add a node running the task over [startIndex, endIndex). The graph should not be running.
+	TNodeIndex AddNode(Task& task, TIndex startIndex, TIndex endIndex, TIndex grainSize = 1,
+		uint8_t priority = 0) noexcept;
+
+	// The successor is run after the predecessor has finished. The graph should not be running.
+	void AddDependency(TNodeIndex predecessor, TNodeIndex successor) noexcept;
+
+	// Enqueue root nodes and return immediately. The previous run should have finished.
+	// Returns false without running anything if the graph has a cycle.
+	bool Run() noexcept;
+
+	[[nodiscard]] bool IsDone() const noexcept;
+	void BusyWait() const noexcept;
+	void Wait(uint32_t intervalMilliSecs = 1) const noexcept;
+
+	[[nodiscard]] auto GetName() const noexcept { return name; }
+	[[nodiscard]] size_t NumNodes() const noexcept { return nodes.size(); }
+
+private:
+	// Allocate the counters and validate the graph after its structure has been changed.
+	[[nodiscard]] bool Build() noexcept;
+	[[nodiscard]] bool IsAcyclic() const noexcept;
+
+	void Launch(Node& node) noexcept;
+	static void OnNodeFinished(void* context) noexcept;
+};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+class TaskGraphTest : public TestCollection
+{
+public:
+	TaskGraphTest() : TestCollection("TaskGraphTest") {}
+
+protected:
+	void Prepare() override;
+};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
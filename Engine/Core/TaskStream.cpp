@@ -5,9 +5,11 @@
 #include <thread>
 
 #include "Config/ConfigParam.h"
+#include "Core/CommonMacros.h"
 #include "Engine/Engine.h"
 #include "Log/Logger.h"
 #include "OSAL/Intrinsic.h"
+#include "OSAL/OSMemory.h"
 #include "OSAL/OSThread.h"
 #include "ScopedTime.h"
 #include "TaskSystem.h"
@@ -16,6 +18,22 @@
 namespace hbe
 {
 
+namespace
+{
+	thread_local TaskStream* CurrentStream = nullptr;
+
+	size_t GetPriorityLane(uint8_t priority) noexcept
+	{
+		constexpr size_t NumPriorities = 256;
+		constexpr size_t LaneSize = NumPriorities / TaskStream::NumPriorityLanes;
+		static_assert(LaneSize * TaskStream::NumPriorityLanes == NumPriorities);
+
+		return priority / LaneSize;
+	}
+} // namespace
+
+TaskStream* TaskStream::GetCurrent() noexcept { return CurrentStream; }
+
 TaskStream::TaskQueueItem::TaskQueueItem(uint8_t priority, const RangedTask& task)
 	: priority(priority)
 	, task(task)
@@ -31,6 +49,9 @@ TaskStream::TaskStream()
 	: streamIndex(0)
 	, loopCount(0)
 	, allocator("None")
+	, inbox(Config::TaskStreamInboxSize)
+	, isParking(false)
+	, isWakeUpRequested(false)
 {
 	Assert(threadID == std::thread::id());
 }
@@ -40,6 +61,9 @@ TaskStream::TaskStream(StaticString name, TStreamIndex streamIndex)
 	, streamIndex(streamIndex)
 	, loopCount(0)
 	, allocator(name)
+	, inbox(Config::TaskStreamInboxSize)
+	, isParking(false)
+	, isWakeUpRequested(false)
 {
 	auto log = Logger::Get(name);
 	log.Out([name = name](auto& ls) { ls << name.c_str() << " is created."; });
@@ -47,14 +71,25 @@ TaskStream::TaskStream(StaticString name, TStreamIndex streamIndex)
 
 void TaskStream::Enqueue(const RangedTask& task) noexcept
 {
+	if (unlikely(!inbox.Push(task)))
+	{
+		std::scoped_lock<std::mutex> lock(queueLock);
+		taskQueue.Push(task);
+	}
+
+	// Pairs with the fence in Park. Either this sees the stream parking, or the stream sees the task.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	returnIf(!isParking.load(std::memory_order_relaxed));
+
 	std::scoped_lock<std::mutex> lock(queueLock);
-	taskQueue.Push(task);
 	cv.notify_one();
 }
 
 void TaskStream::Dequeue(std::optional<RangedTask>& outTask)
 {
 	std::scoped_lock<std::mutex> lock(queueLock);
+	DrainInbox();
+
 	if (taskQueue.IsEmpty())
 	{
 		outTask.reset();
@@ -64,7 +99,78 @@ void TaskStream::Dequeue(std::optional<RangedTask>& outTask)
 	outTask = taskQueue.Pop();
 }
 
-void TaskStream::WakeUp() noexcept { cv.notify_one(); }
+void TaskStream::DrainInbox() noexcept
+{
+	std::optional<RangedTask> task;
+	while (inbox.Pop(task))
+	{
+		taskQueue.Push(*task);
+	}
+}
+
+void TaskStream::Park(std::chrono::microseconds timeout) noexcept
+{
+	std::unique_lock lock(queueLock);
+	isParking.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	cv.wait_for(lock, timeout, [this]() { return isWakeUpRequested || !taskQueue.IsEmpty() || !inbox.IsEmpty(); });
+	isParking.store(false, std::memory_order_relaxed);
+	isWakeUpRequested = false;
+}
+
+void TaskStream::WakeUp() noexcept
+{
+	{
+		std::scoped_lock<std::mutex> lock(queueLock);
+		isWakeUpRequested = true;
+	}
+
+	cv.notify_one();
+}
+
+bool TaskStream::PushLocal(const RangedTask& task) noexcept
+{
+	Assert(CurrentStream == this, "Only the owner stream can push a local task.");
+
+	auto& lane = stealQueues[GetPriorityLane(task.priority)];
+
+	return lane.Push(task);
+}
+
+bool TaskStream::PopLocal(std::optional<RangedTask>& outTask) noexcept
+{
+	Assert(CurrentStream == this, "Only the owner stream can pop a local task.");
+
+	for (auto& lane : stealQueues)
+	{
+		returnValueIf(true, lane.Pop(outTask));
+	}
+
+	return false;
+}
+
+bool TaskStream::Steal(size_t lane, std::optional<RangedTask>& outTask) noexcept
+{
+	Assert(lane < NumPriorityLanes);
+
+	auto& queue = stealQueues[lane];
+	returnValueIf(false, queue.IsEmpty());
+
+	return queue.Steal(outTask);
+}
+
+bool TaskStream::IsWorker() const noexcept { return streamIndex > TaskSystem::GetIOTaskStreamIndex(); }
+
+bool TaskStream::HasLocalTasks() const noexcept
+{
+	for (auto& lane : stealQueues)
+	{
+		returnValueIf(true, !lane.IsEmpty());
+	}
+
+	return false;
+}
 
 void TaskStream::Start(TaskSystem& taskSys) noexcept
 {
@@ -83,6 +189,7 @@ void TaskStream::RunLoop() noexcept
 
 	TaskSystem::SetThreadName(name);
 	TaskSystem::SetStreamIndex(streamIndex);
+	CurrentStream = this;
 
 	const auto log = Logger::Get(name);
 	log.Out([name = name](auto& ls) { ls << name.c_str() << " has begun."; });
@@ -91,11 +198,27 @@ void TaskStream::RunLoop() noexcept
 
 	static ConfigParam<float, true> thresholdDuration("TaskStreamDurationThreshold",
 		"Print a warning log if it detects slower task. (seconds)", 0.16f);
+	static ConfigParam<size_t, true> spinCount("TaskStreamSpinCount",
+		"Number of times an idle stream looks for tasks again before it parks.", 64);
+	static ConfigParam<float, true> parkTimeout("TaskStreamParkTimeout",
+		"Maximum duration a parked stream sleeps without being woken up. (seconds)", 0.1f);
+	static ConfigParam<int, true> hugePages("TaskStreamHugePages",
+		"Back the banks of stream allocators by huge pages. (0: None, 1: Transparent, 2: Explicit)", 0);
+	static ConfigParam<bool, true> isNumaAware("TaskStreamNumaAwareBanks",
+		"Place the banks of stream allocators on the NUMA node the stream has begun on.", true);
+
+	{
+		const bool isNumaSystem = isNumaAware.Get() && OS::GetNumNumaNodes() > 1;
+		const int numaNode = isNumaSystem ? OS::GetCurrentNumaNode() : OS::AnyNumaNode;
+		allocator.SetBankBacking(static_cast<OS::EHugePages>(hugePages.Get()), numaNode);
+	}
 
 	auto& engine = Engine::Get();
 	auto& taskSys = engine.GetTaskSystem();
 
 	HVector<RangedTask> readdingBuffer;
+	size_t numIdleLoops = 0;
+	bool isIdle = false;
 
 	for (;likely(taskSys.IsRunning()); ++loopCount)
 	{
@@ -104,32 +227,74 @@ void TaskStream::RunLoop() noexcept
 		{
 			// Remove finished tasks
 			std::unique_lock lock(queueLock);
+			DrainInbox();
 			taskQueue.Remove([](const RangedTask& task) { return task.HasFinished(); });
 
+			// Waiting tasks go before the yielded ones. Otherwise a task that keeps yielding, like the logger on
+			// the IO stream, would starve every other task of its priority.
+			if (!taskQueue.IsEmpty())
+			{
+				rangedTask = taskQueue.Pop();
+			}
+
 			taskQueue.PushRange(readdingBuffer);
 			readdingBuffer.clear();
 
-			if (!taskQueue.IsEmpty())
+			if (!rangedTask.has_value() && !taskQueue.IsEmpty())
 			{
 				rangedTask = taskQueue.Pop();
 			}
 		}
 
+		// Only workers consume general tasks locally. Tasks pushed by the main and IO streams are stolen.
+		const bool isWorker = IsWorker();
+		if (!rangedTask.has_value() && isWorker)
+		{
+			PopLocal(rangedTask);
+		}
+
 		if (!rangedTask.has_value())
 		{
 			taskSys.Dequeue(rangedTask);
 		}
 
+		if (!rangedTask.has_value() && isWorker)
+		{
+			taskSys.Steal(*this, rangedTask);
+		}
+
 		if (!rangedTask.has_value())
 		{
-			// Wait for a signal for waitPeriod
-			std::unique_lock lock(queueLock);
-			constexpr std::chrono::milliseconds waitPeriod(10);
-			cv.wait_for(lock, waitPeriod);
+			// Only workers take split ranges, so the others don't count as idle.
+			if (!isIdle && isWorker)
+			{
+				isIdle = true;
+				taskSys.ReportIdle(true);
+			}
+
+			// Spin for a short while before parking, as a task often follows shortly after.
+			if (numIdleLoops < spinCount.Get())
+			{
+				++numIdleLoops;
+				std::this_thread::yield();
+				continue;
+			}
+
+			const std::chrono::duration<float> timeout(parkTimeout.Get());
+			taskSys.Park(*this, std::chrono::duration_cast<std::chrono::microseconds>(timeout));
+			numIdleLoops = 0;
 
 			continue;
 		}
 
+		if (isIdle)
+		{
+			isIdle = false;
+			taskSys.ReportIdle(false);
+		}
+
+		numIdleLoops = 0;
+
 		time::TDuration duration;
 		{
 			time::ScopedTime timer(duration);
@@ -148,6 +313,12 @@ void TaskStream::RunLoop() noexcept
 		}
 	}
 
+	if (isIdle)
+	{
+		taskSys.ReportIdle(false);
+	}
+
+	CurrentStream = nullptr;
 	log.Out([name = name](auto& ls) { ls << name.c_str() << " has been terminated."; });
 }
 } // namespace hbe
@@ -2,12 +2,18 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
 #include <queue>
+#include "Config/EngineConfig.h"
 #include "Container/Array.h"
+#include "Container/AtomicRingQueue.h"
 #include "Container/BoundedPriorityQueue.h"
+#include "Container/WorkStealingDeque.h"
 #include "HSTL/HVector.h"
 #include "Memory/MultiPoolAllocator.h"
 #include "RangedTask.h"
@@ -25,9 +31,15 @@ class TaskStream final
 	template<typename T>
 	using TVector = hbe::HVector<T>;
 	using TIndex = Task::TIndex;
-	using TStreamIndex = Array<RangedTask>::TIndex;
+	// Signed, as -1 is used for no stream.
+	using TStreamIndex = int;
 	using TThreadID = std::thread::id;
 	using TRangedTasks = TVector<RangedTask>;
+	using TStealQueue = WorkStealingDeque<RangedTask, Config::TaskStreamStealQueueSize>;
+
+public:
+	// RangedTask priorities [0, 255] are bucketed into lanes. Lower lanes are popped and stolen first.
+	static constexpr size_t NumPriorityLanes = 4;
 
 private:
 	struct TaskQueueItem final
@@ -48,18 +60,41 @@ private:
 	std::uint64_t loopCount;
 	MultiPoolAllocator allocator;
 
+	// Tasks enqueued into this stream by any thread. The priority queue behind the lock takes the overflow.
+	AtomicRingQueue<RangedTask> inbox;
+	std::atomic<bool> isParking;
+
 	std::mutex queueLock;
 	std::condition_variable cv;
+	bool isWakeUpRequested;
 	std::thread thread;
 	BoundedPriorityQueue<RangedTask> taskQueue;
 
+	// General tasks enqueued by this stream. Only this stream pushes and pops, other streams steal.
+	std::array<TStealQueue, NumPriorityLanes> stealQueues;
+
 public:
+	// The TaskStream running on the current thread, or nullptr on non-stream threads.
+	[[nodiscard]] static TaskStream* GetCurrent() noexcept;
+
 	TaskStream();
 	explicit TaskStream(StaticString name, TStreamIndex streamIndex);
 	~TaskStream() = default;
 
 	void Enqueue(const RangedTask& task) noexcept;
+
+	// Block until WakeUp is called, a task is enqueued into this stream, or the timeout expires.
+	// Use TaskSystem::Park instead, so that the stream can be found by TaskSystem::Enqueue.
+	void Park(std::chrono::microseconds timeout) noexcept;
 	void WakeUp() noexcept;
+
+	// Owner only. Returns false if the lane of the task is full.
+	bool PushLocal(const RangedTask& task) noexcept;
+	// Owner only. Takes the latest task of the highest priority lane.
+	bool PopLocal(std::optional<RangedTask>& outTask) noexcept;
+	// Any thread. Takes the oldest task of the given lane.
+	bool Steal(size_t lane, std::optional<RangedTask>& outTask) noexcept;
+
 	void Join() noexcept { thread.join(); }
 
 	[[nodiscard]] auto GetName() const noexcept { return name; }
@@ -68,12 +103,16 @@ public:
 	[[nodiscard]] auto& GetThread() const noexcept { return thread; }
 	[[nodiscard]] auto GetStreamIndex() const noexcept { return streamIndex; }
 	[[nodiscard]] auto GetLoopCount() const noexcept { return loopCount; }
+	[[nodiscard]] bool IsWorker() const noexcept;
+	[[nodiscard]] bool HasLocalTasks() const noexcept;
 
 	void Start(TaskSystem& taskSys) noexcept;
 	void RunLoop() noexcept;
 
 private:
 	void Dequeue(std::optional<RangedTask>& outTask);
+	// Move the tasks from the inbox to the priority queue. Called with the queue lock.
+	void DrainInbox() noexcept;
 };
 
 } // namespace hbe
@@ -2,12 +2,15 @@
 
 #include "TaskSystem.h"
 
+#include <algorithm>
+#include <bit>
 #include <exception>
 #include <future>
 #include <thread>
 
 #include "Config/ConfigParam.h"
 #include "Constants.h"
+#include "Core/CommonMacros.h"
 #include "Log/Logger.h"
 
 
@@ -18,6 +21,22 @@ namespace
 {
 	thread_local StaticString ThreadName;
 	thread_local TaskSystem::TIndex StreamIndex = 0;
+	thread_local uint32_t StealSeed = 0;
+
+	// xorshift32, used to pick a random victim to steal from.
+	uint32_t NextStealRandom() noexcept
+	{
+		if (unlikely(StealSeed == 0))
+		{
+			StealSeed = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+		}
+
+		StealSeed ^= StealSeed << 13;
+		StealSeed ^= StealSeed >> 17;
+		StealSeed ^= StealSeed << 5;
+
+		return StealSeed;
+	}
 	} // namespace
 
 	TaskSystem::TIndex TaskSystem::GetNumHardwareThreads() noexcept
@@ -65,9 +84,14 @@ namespace
 
 	TaskSystem::TaskSystem() noexcept
 		: isRunning(false)
+		, isWorkStealing(true)
 		, name("TaskSystem")
 		, numHardwareThreads(GetNumHardwareThreads())
 		, baseTaskThreadID(std::this_thread::get_id())
+		, taskQueueSize(0)
+		, numIdleWorkers(0)
+		, parkedStreams(0)
+		, coroutineFrameAllocator("CoroutineFramePool")
 	{
 		FatalAssert(numHardwareThreads > 0, "It should have at least one hardware thread.");
 	}
@@ -79,16 +103,16 @@ namespace
 
 	void TaskSystem::Initialize() noexcept
 	{
-		auto& logger = Logger::Get();
-		auto logFilter = [](auto level)
-		{
-			static TAtomicConfigParam<uint8_t> logLevel("Log.TaskSystem", "The TaskSystem Log Level",
-													static_cast<uint8_t>(ELogLevel::Warning));
+		static TAtomicConfigParam<uint8_t> CPLogLevel("Log.TaskSystem", "The TaskSystem logs above this level",
+			static_cast<uint8_t>(ELogLevel::Warning));
 
-			return level > static_cast<ELogLevel>(logLevel.Get());
-		};
+		static TAtomicConfigParam<bool> CPWorkStealing("TaskSystem.WorkStealing",
+			"Enqueue the general tasks of a task stream into its work-stealing queue, not the global queue", true);
+
+		const auto minLevel = std::min<uint8_t>(CPLogLevel.Get() + 1, static_cast<uint8_t>(ELogLevel::MAX));
+		Logger::Get().SetLevel(GetName(), static_cast<ELogLevel>(minLevel));
 
-		logger.SetFilter(GetName(), logFilter);
+		SetWorkStealing(CPWorkStealing.Get());
 
 		auto log = Logger::Get(GetName());
 		log.Out([this](auto& ls) { ls << "Hardware Concurrency = " << numHardwareThreads; });
@@ -99,6 +123,11 @@ namespace
 	void TaskSystem::RequestShutDown() noexcept
 	{
 		isRunning = false;
+
+		for (auto& stream : streams)
+		{
+			stream.WakeUp();
+		}
 	}
 
 	void TaskSystem::JoinAndClear() noexcept
@@ -130,12 +159,84 @@ namespace
 
 	void TaskSystem::Enqueue(const RangedTask& task) noexcept
 	{
-		std::scoped_lock<std::mutex> lock(taskQueueMutex);
-		taskQueue.Push(task);
+		// Main and IO streams never run their local tasks, they're only stolen by workers.
+		auto* stream = TaskStream::GetCurrent();
+		if (stream != nullptr && IsWorkStealing()
+			&& (!stream->IsWorker() || task.affinity.Get(stream->GetStreamIndex())))
+		{
+			if (stream->PushLocal(task))
+			{
+				WakeUpOne(task);
+				return;
+			}
+		}
+
+		EnqueueGlobal(task);
+	}
+
+	void TaskSystem::EnqueueGlobal(const RangedTask& task) noexcept
+	{
+		{
+			std::scoped_lock<std::mutex> lock(taskQueueMutex);
+			taskQueue.Push(task);
+			taskQueueSize.store(taskQueue.Size(), std::memory_order_release);
+		}
+
+		WakeUpOne(task);
+	}
+
+	void TaskSystem::WakeUpOne(const RangedTask& task) noexcept
+	{
+		// Pairs with the fence in Park. Either this sees the parking bit or the parking stream sees the task.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		TStreamMask parked = parkedStreams.load(std::memory_order_relaxed);
+		while (parked != 0)
+		{
+			TIndex target = -1;
+			for (TStreamMask bits = parked; bits != 0; bits &= bits - 1)
+			{
+				const auto index = static_cast<TIndex>(std::countr_zero(bits));
+				continueIf(!task.affinity.Get(index));
+
+				target = index;
+				break;
+			}
+
+			returnIf(target < 0);
+
+			// Claim the bit, so that concurrent Enqueues wake up different streams.
+			const TStreamMask bit = TStreamMask(1) << target;
+			if (parkedStreams.compare_exchange_weak(parked, parked & ~bit, std::memory_order_acq_rel,
+				std::memory_order_relaxed))
+			{
+				streams[target].WakeUp();
+				return;
+			}
+		}
+	}
+
+	bool TaskSystem::HasPendingTasks(const TaskStream& stream) const noexcept
+	{
+		returnValueIf(true, taskQueueSize.load(std::memory_order_relaxed) > 0);
+		returnValueIf(false, !stream.IsWorker());
+
+		for (auto& victim : streams)
+		{
+			returnValueIf(true, victim.HasLocalTasks());
+		}
+
+		return false;
 	}
 
 	void TaskSystem::Dequeue(std::optional<RangedTask>& outTask) noexcept
 	{
+		if (taskQueueSize.load(std::memory_order_acquire) == 0)
+		{
+			outTask.reset();
+			return;
+		}
+
 		std::scoped_lock<std::mutex> lock(taskQueueMutex);
 		if (taskQueue.IsEmpty())
 		{
@@ -162,6 +263,34 @@ namespace
 
 		outTask = rangedTask;
 		(void)taskQueue.Pop();
+		taskQueueSize.store(taskQueue.Size(), std::memory_order_release);
+	}
+
+	void TaskSystem::Steal(const TaskStream& thief, std::optional<RangedTask>& outTask) noexcept
+	{
+		const auto numStreams = static_cast<TIndex>(streams.Size());
+		returnIf(numStreams <= 1);
+
+		const auto thiefIndex = thief.GetStreamIndex();
+		const auto startIndex = static_cast<TIndex>(NextStealRandom() % static_cast<uint32_t>(numStreams));
+
+		for (size_t lane = 0; lane < TaskStream::NumPriorityLanes; ++lane)
+		{
+			for (TIndex i = 0; i < numStreams; ++i)
+			{
+				auto victimIndex = startIndex + i;
+				victimIndex = victimIndex < numStreams ? victimIndex : victimIndex - numStreams;
+				continueIf(victimIndex == thiefIndex);
+
+				auto& victim = streams[victimIndex];
+				continueIf(!victim.Steal(lane, outTask));
+
+				returnIf(outTask->affinity.Get(thiefIndex));
+
+				EnqueueGlobal(*outTask);
+				outTask.reset();
+			}
+		}
 	}
 
 	void TaskSystem::Enqueue(const TIndex streamIndex, const RangedTask& task) noexcept
@@ -177,14 +306,53 @@ namespace
 		stream.Enqueue(task);
 	}
 
+	void TaskSystem::ParallelFor(Task& task, size_t startIndex, size_t endIndex, size_t grainSize,
+		uint8_t priority) noexcept
+	{
+		auto rangedTask = task.GenerateSubTask(startIndex, std::max(startIndex, endIndex), priority);
+		rangedTask.grainSize = std::max<size_t>(grainSize, 1);
+
+		Enqueue(rangedTask);
+	}
+
+	void TaskSystem::ReportIdle(bool isIdle) noexcept
+	{
+		numIdleWorkers.fetch_add(isIdle ? 1 : -1, std::memory_order_relaxed);
+	}
+
+	void TaskSystem::Park(TaskStream& stream, std::chrono::microseconds timeout) noexcept
+	{
+		static_assert(MAX_NUM_TASK_STREAMS <= sizeof(TStreamMask) * 8, "The parked stream mask is too small.");
+
+		const auto index = stream.GetStreamIndex();
+		if (unlikely(index >= MAX_NUM_TASK_STREAMS))
+		{
+			// Not wakeable by Enqueue, so it just polls with the timeout.
+			stream.Park(timeout);
+			return;
+		}
+
+		const TStreamMask bit = TStreamMask(1) << index;
+		parkedStreams.fetch_or(bit, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// Re-check after announcing, as a task could have been enqueued before the bit was visible.
+		if (likely(isRunning) && !HasPendingTasks(stream))
+		{
+			stream.Park(timeout);
+		}
+
+		parkedStreams.fetch_and(~bit, std::memory_order_relaxed);
+	}
+
 	void TaskSystem::DispatchToMainThread(TMainThreadTask taskFunc, void* userData, uint8_t priority) noexcept
 	{
 		mainThreadTaskQueue.Enqueue(taskFunc, userData, priority);
 	}
 
-	size_t TaskSystem::ProcessMainThreadTasks() noexcept
+	size_t TaskSystem::ProcessMainThreadTasks(time::TDuration budget) noexcept
 	{
-		return mainThreadTaskQueue.ProcessTasks();
+		return mainThreadTaskQueue.ProcessTasks(budget);
 	}
 
 	StaticString TaskSystem::GetStreamName(int index) const noexcept
@@ -210,7 +378,7 @@ namespace
 				continue;
 			}
 
-			index = i;
+			index = static_cast<TIndex>(i);
 			break;
 		}
 
@@ -219,7 +387,7 @@ namespace
 
 	TaskStream& TaskSystem::GetStream(int index) noexcept
 	{
-		if (index < 0 || index >= streams.Size())
+		if (index < 0 || index >= static_cast<TIndex>(streams.Size()))
 		{
 			return streams[0];
 		}
@@ -278,9 +446,13 @@ namespace
 } // namespace hbe
 
 #ifdef __UNIT_TEST__
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include "../Engine/Engine.h"
 #include "OSAL/Intrinsic.h"
+#include "ScopedTime.h"
 #include "Test/TestCollection.h"
 
 namespace hbe
@@ -438,6 +610,303 @@ void TaskSystemTest::Prepare()
 			ls << "The error exceeds limit. Error = " << error << lferr;
 		}
 	});
+
+	AddTest("Wake Up Latency", [this](TLogOut& ls)
+	{
+		constexpr int NumRounds = 20;
+		constexpr auto IdleDuration = std::chrono::milliseconds(20);
+
+		auto func = [](void* userData, std::size_t, std::size_t end) -> std::size_t
+		{
+			*static_cast<time::TTime*>(userData) = time::GetNow();
+			return end;
+		};
+
+		auto& taskSys = Engine::Get().GetTaskSystem();
+		HVector<float> latencies;
+
+		for (int i = 0; i < NumRounds; ++i)
+		{
+			// Let the streams run out of spins and park.
+			std::this_thread::sleep_for(IdleDuration);
+
+			time::TTime startTime;
+			Task task("WakeUpTest", func, &startTime);
+
+			const auto enqueueTime = time::GetNow();
+			taskSys.Enqueue(task.GenerateSubTask(0, 1));
+			// Sleep rather than spin, so the woken stream gets a core even on a small machine.
+			task.Wait(1);
+
+			latencies.push_back(time::ToFloat(startTime - enqueueTime) * 1000.0f);
+		}
+
+		std::sort(latencies.begin(), latencies.end());
+		const float median = latencies[NumRounds / 2];
+		ls << "Wake up latency: median = " << median << " ms, max = " << latencies.back() << " ms" << lf;
+
+		// Parked streams time out in TaskStreamParkTimeout at the latest, so a slow median means nobody woke them.
+		if (median > 20.0f)
+		{
+			ls << "Parked streams are not woken up by Enqueue." << lferr;
+		}
+		else if (median > 1.0f)
+		{
+			ls << "Wake up latency is higher than expected." << lfwarn;
+		}
+	});
+
+	AddTest("Parallel For (Adaptive Splitting)", [this](TLogOut& ls)
+	{
+		constexpr std::size_t Count = 1 << 22;
+		constexpr std::size_t GrainSize = 256;
+
+		struct Context final
+		{
+			HVector<std::atomic<uint8_t>> visitCounts;
+			std::atomic<std::size_t> numCalls;
+
+			explicit Context(std::size_t count) : visitCounts(count), numCalls(0) {}
+		};
+
+		auto func = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+		{
+			auto& context = *static_cast<Context*>(userData);
+			context.numCalls.fetch_add(1, std::memory_order_relaxed);
+
+			double dummy = 0;
+			for (std::size_t i = start; i < end; ++i)
+			{
+				context.visitCounts[i].fetch_add(1, std::memory_order_relaxed);
+
+				// Uneven cost per index. The tail of the range is much heavier.
+				const std::size_t cost = i < (Count - Count / 8) ? 1 : 64;
+				for (std::size_t j = 0; j < cost; ++j)
+				{
+					dummy += std::sqrt(static_cast<double>(i + j));
+				}
+			}
+
+			return dummy >= 0 ? end - start : 0;
+		};
+
+		Context context(Count);
+		Task task("ParallelForTest", func, &context);
+
+		auto& taskSys = Engine::Get().GetTaskSystem();
+		taskSys.ParallelFor(task, 0, Count, GrainSize);
+		task.BusyWait();
+
+		for (std::size_t i = 0; i < Count; ++i)
+		{
+			const auto numVisits = context.visitCounts[i].load(std::memory_order_relaxed);
+			if (numVisits != 1)
+			{
+				ls << "Index " << i << " has been processed " << static_cast<int>(numVisits) << " times." << lferr;
+				return;
+			}
+		}
+
+		ls << "Indices = " << Count << ", Sub-tasks = " << task.NumSubTasks()
+		   << ", Runnable calls = " << context.numCalls.load() << lf;
+	});
+
+	AddTest("Performance (Work-Stealing vs Global Queue)", [this](TLogOut& ls)
+	{
+		constexpr std::size_t NumSpawners = 256;
+		constexpr std::size_t NumLeavesPerSpawner = 64;
+		constexpr std::size_t NumLeaves = NumSpawners * NumLeavesPerSpawner;
+		constexpr std::size_t NumItems = 1 << 20;
+		constexpr std::size_t GrainSize = 256;
+		constexpr int NumRepeats = 3;
+
+		struct Context final
+		{
+			TaskSystem* taskSys;
+			Task* leafTask;
+			std::atomic<bool> isReleased = false;
+			std::atomic<int> numHeld = 0;
+			std::atomic<uint64_t> sum = 0;
+		};
+
+		// Each index enqueues the leaves on the stream running it, so they go through Enqueue of a stream.
+		auto spawnFunc = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+		{
+			auto& context = *static_cast<Context*>(userData);
+			for (auto i = start; i < end; ++i)
+			{
+				for (std::size_t j = 0; j < NumLeavesPerSpawner; ++j)
+				{
+					context.taskSys->Enqueue(context.leafTask->GenerateSubTask(j, j + 1));
+				}
+			}
+
+			return end - start;
+		};
+
+		// Empty, so only the dispatch is measured.
+		auto leafFunc = [](void*, std::size_t start, std::size_t end) -> std::size_t
+		{
+			return end - start;
+		};
+
+		auto sumFunc = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+		{
+			auto& context = *static_cast<Context*>(userData);
+			uint64_t sum = 0;
+			for (auto i = start; i < end; ++i)
+			{
+				sum += i;
+			}
+
+			context.sum.fetch_add(sum, std::memory_order_relaxed);
+
+			return end - start;
+		};
+
+		// Keeps a worker busy, so the benchmark runs on the others.
+		auto holdFunc = [](void* userData, std::size_t start, std::size_t end) -> std::size_t
+		{
+			auto& context = *static_cast<Context*>(userData);
+			context.numHeld.fetch_add(1);
+			context.isReleased.wait(false);
+
+			return end - start;
+		};
+
+		auto& taskSys = Engine::Get().GetTaskSystem();
+		const auto firstWorkerIndex = TaskSystem::GetIOTaskStreamIndex() + 1;
+		const int numWorkers = TaskSystem::GetNumHardwareThreads() - firstWorkerIndex;
+		if (numWorkers < 1)
+		{
+			ls << "There's no worker stream to run the benchmark." << lfwarn;
+			return;
+		}
+
+		Task leafTask("BenchmarkLeaf", leafFunc, nullptr);
+		Context context{&taskSys, &leafTask};
+		Task spawnTask("BenchmarkSpawn", spawnFunc, &context);
+		Task sumTask("BenchmarkSum", sumFunc, &context);
+		Task holdTask("BenchmarkHold", holdFunc, &context);
+
+		auto runEnqueue = [&]()
+		{
+			leafTask.Reset();
+			spawnTask.Reset();
+
+			taskSys.ParallelFor(spawnTask, 0, NumSpawners);
+			// Every leaf has been generated once the spawners are done.
+			spawnTask.BusyWait();
+			leafTask.BusyWait();
+		};
+
+		auto runParallelFor = [&]()
+		{
+			sumTask.Reset();
+			context.sum = 0;
+
+			taskSys.ParallelFor(sumTask, 0, NumItems, GrainSize);
+			sumTask.BusyWait();
+		};
+
+		// The best of a few runs, in seconds.
+		auto measure = [](const auto& func) -> float
+		{
+			float best = std::numeric_limits<float>::max();
+			for (int i = 0; i < NumRepeats; ++i)
+			{
+				time::TDuration duration;
+				{
+					time::ScopedTime timer(duration);
+					func();
+				}
+
+				best = std::min(best, time::ToFloat(duration));
+			}
+
+			return std::max(best, 1.0e-6f);
+		};
+
+		// Hold the workers but the first ones, through their own queues, and wait until all of them are held.
+		auto holdWorkers = [&](int numStreams)
+		{
+			const int numToHold = numWorkers - numStreams;
+			context.isReleased = false;
+			context.numHeld = 0;
+			holdTask.Reset();
+
+			for (int i = 0; i < numToHold; ++i)
+			{
+				taskSys.Enqueue(firstWorkerIndex + numStreams + i, holdTask.GenerateSubTask(i, i + 1));
+			}
+
+			while (context.numHeld.load() < numToHold)
+			{
+				std::this_thread::yield();
+			}
+		};
+
+		auto releaseWorkers = [&]()
+		{
+			context.isReleased = true;
+			context.isReleased.notify_all();
+
+			if (holdTask.NumSubTasks() > 0)
+			{
+				holdTask.BusyWait();
+			}
+		};
+
+		const bool wasWorkStealing = taskSys.IsWorkStealing();
+		const uint64_t expectedSum = static_cast<uint64_t>(NumItems) * (NumItems - 1) / 2;
+
+		const int streamCounts[] = {1, 4, 16, numWorkers};
+		int lastCount = 0;
+
+		for (int numStreams : streamCounts)
+		{
+			numStreams = std::min(numStreams, numWorkers);
+			continueIf(numStreams <= lastCount);
+			lastCount = numStreams;
+
+			holdWorkers(numStreams);
+
+			taskSys.SetWorkStealing(false);
+			const float globalEnqueueSec = measure(runEnqueue);
+			const float globalForSec = measure(runParallelFor);
+			const bool isGlobalSumValid = context.sum == expectedSum;
+
+			taskSys.SetWorkStealing(true);
+			const float stealEnqueueSec = measure(runEnqueue);
+			const float stealForSec = measure(runParallelFor);
+			const bool isStealSumValid = context.sum == expectedSum;
+
+			releaseWorkers();
+			taskSys.SetWorkStealing(wasWorkStealing);
+
+			if (leafTask.NumSubTasks() != NumLeaves || !isGlobalSumValid || !isStealSumValid)
+			{
+				ls << "Streams = " << numStreams << ", leaves = " << leafTask.NumSubTasks() << " out of " << NumLeaves
+				   << ", sums are valid: global queue " << isGlobalSumValid << ", work-stealing " << isStealSumValid
+				   << lferr;
+				return;
+			}
+
+			const double globalRate = static_cast<double>(NumLeaves) / globalEnqueueSec / 1.0e6;
+			const double stealRate = static_cast<double>(NumLeaves) / stealEnqueueSec / 1.0e6;
+
+			ls << "Streams = " << numStreams << ", Enqueue: Global Queue = " << globalRate
+			   << " M tasks/sec, Work-Stealing = " << stealRate << " M tasks/sec, ParallelFor: Global Queue = "
+			   << (globalForSec * 1000.0f) << " ms, Work-Stealing = " << (stealForSec * 1000.0f) << " ms" << lf;
+
+			if (numStreams > 1 && stealEnqueueSec > globalEnqueueSec)
+			{
+				ls << "Work-stealing is slower than the global queue with " << numStreams << " streams. "
+				   << "Work-Stealing = " << stealEnqueueSec << " sec, Global Queue = " << globalEnqueueSec << " sec"
+				   << lfwarn;
+			}
+		}
+	});
 }
 
 } // namespace hbe
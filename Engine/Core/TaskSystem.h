@@ -4,10 +4,13 @@
 
 
 #include <atomic>
+#include <chrono>
 #include <thread>
+#include "Config/BuildConfig.h"
 #include "Container/Array.h"
 #include "Container/BoundedPriorityQueue.h"
 #include "MainThreadTaskQueue.h"
+#include "Memory/ThreadSafeMultiPoolAllocator.h"
 #include "TaskStream.h"
 
 namespace hbe
@@ -20,14 +23,18 @@ public:
 	using TThread = std::thread;
 	using TThreadID = std::thread::id;
 	using TStreamArray = Array<TaskStream>;
-	using TIndex = TStreamArray::TIndex;
+	// A stream index. Signed, as -1 is used for no stream.
+	using TIndex = int;
 	using TMainThreadTask = void (*)(void* /*userData*/);
+	using TStreamMask = uint64_t;
 
 	static constexpr TIndex BaseStreamIndex = 0;
 	static constexpr TIndex IOStreamIndex = 1;
 
 private:
 	std::atomic<bool> isRunning;
+	// Off to enqueue every general task into the global queue, as it was before the work-stealing queues.
+	std::atomic<bool> isWorkStealing;
 
 	const StaticString name;
 	const TIndex numHardwareThreads;
@@ -37,9 +44,16 @@ private:
 
 	std::mutex taskQueueMutex;
 	BoundedPriorityQueue<RangedTask> taskQueue;
+	std::atomic<size_t> taskQueueSize;
+	std::atomic<int> numIdleWorkers;
+	// Bit i is set while stream i is parked. Enqueue claims a bit to wake up exactly one stream.
+	std::atomic<TStreamMask> parkedStreams;
 
 	MainThreadTaskQueue mainThreadTaskQueue;
 
+	// Coroutine frames are allocated on one thread and often freed on another.
+	ThreadSafeMultiPoolAllocator coroutineFrameAllocator;
+
 public:
 	static TIndex GetNumHardwareThreads() noexcept;
 	static void SetThreadName(StaticString name) noexcept;
@@ -63,6 +77,8 @@ public:
 
 	// Enqueue a task into the general task queue which is a low-priority queue. The task will be executed after
 	// performing all existing special queue for eash task stream.
+	// On a task stream, it's pushed into the stream's work-stealing queue, so idle workers can steal it without
+	// taking the global lock. Other threads, or a full local queue, fall back to the global queue.
 	void Enqueue(const RangedTask& task) noexcept;
 
 	// Take the top priority task from the general task queue if task stream affinity has been set.
@@ -70,14 +86,36 @@ public:
 	// to prevent blocking the entire task streams by a task with null-affinity
 	void Dequeue(std::optional<RangedTask>& outTask) noexcept;
 
+	// Steal a general task from another stream, visiting victims from a random one and higher priority lanes first.
+	// A stolen task not allowed on the thief is handed over to the global queue.
+	void Steal(const TaskStream& thief, std::optional<RangedTask>& outTask) noexcept;
+
 	void Enqueue(TIndex streamIndex, const RangedTask& task) noexcept;
 
+	// Run the runnable of the task over [startIndex, endIndex) with lazy, recursive range splitting.
+	// It starts as a single RangedTask. A running part hands off a half of its remaining range whenever a worker
+	// is idle, so sub-tasks are created on demand rather than per index. The runnable is called with at most
+	// grainSize indices at a time. Wait for the task as usual.
+	void ParallelFor(Task& task, size_t startIndex, size_t endIndex, size_t grainSize = 1,
+		uint8_t priority = 0) noexcept;
+
+	// The tasks already in the work-stealing queues are still taken after it's turned off.
+	void SetWorkStealing(bool isEnabled) noexcept { isWorkStealing.store(isEnabled, std::memory_order_relaxed); }
+	[[nodiscard]] bool IsWorkStealing() const noexcept { return isWorkStealing.load(std::memory_order_relaxed); }
+
+	// Called by worker streams when they run out of tasks and when they resume.
+	void ReportIdle(bool isIdle) noexcept;
+	// Called by an idle task stream to sleep until a task is enqueued. The timeout is a safety net for tasks
+	// whose affinity excludes all parked streams.
+	void Park(TaskStream& stream, std::chrono::microseconds timeout) noexcept;
+	[[nodiscard]] bool HasIdleWorkers() const noexcept { return numIdleWorkers.load(std::memory_order_relaxed) > 0; }
+
 	// Dispatch a task to be executed on the main thread.
 	// The task will be queued and executed when the main thread processes its queue.
 	void DispatchToMainThread(TMainThreadTask task, void* userData, uint8_t priority = 0) noexcept;
 
-	// Process all pending main thread tasks.
-	size_t ProcessMainThreadTasks() noexcept;
+	// Process pending main thread tasks until the queue is empty or the budget is spent.
+	size_t ProcessMainThreadTasks(time::TDuration budget = time::TDuration::max()) noexcept;
 
 	[[nodiscard]] StaticString GetName() const noexcept { return name; }
 	[[nodiscard]] auto& IsRunning() const noexcept { return isRunning; }
@@ -88,6 +126,7 @@ public:
 	auto& GetIOTaskStream() const noexcept { return streams[GetIOTaskStreamIndex()]; }
 
 	auto& GetMainThreadTaskQueue() noexcept { return mainThreadTaskQueue; }
+	auto& GetCoroutineFrameAllocator() noexcept { return coroutineFrameAllocator; }
 
 	[[nodiscard]] StaticString GetStreamName(int index) const noexcept;
 	[[nodiscard]] TIndex GetStreamIndex(TThreadID id) const noexcept;
@@ -95,6 +134,10 @@ public:
 
 private:
 	void BuildStreams();
+	void EnqueueGlobal(const RangedTask& task) noexcept;
+	// Wake up one parked stream allowed to run the task, if any.
+	void WakeUpOne(const RangedTask& task) noexcept;
+	[[nodiscard]] bool HasPendingTasks(const TaskStream& stream) const noexcept;
 };
 
 } // namespace hbe
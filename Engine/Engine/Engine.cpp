@@ -82,6 +82,8 @@ namespace hbe
 		logger.StartTask(taskSystem);
 		isLoggerReady = true;
 
+		isResourceManagerReady = true;
+
 		auto log = Logger::Get(GetClassName());
 
 		log.Out("Command Line Arguments");
@@ -102,9 +104,15 @@ namespace hbe
 
 	void Engine::Run()
 	{
+		static ConfigParam<float, true> mainThreadTaskBudget("MainThreadTaskBudget",
+			"Maximum duration of main thread tasks processed at once. (seconds)", 0.002f);
+
 		while (taskSystem.GetMainThreadTaskQueue().HasPendingTasks() || taskSystem.IsRunning())
 		{
-			taskSystem.ProcessMainThreadTasks();
+			resourceManager.PostUpdate(*this);
+
+			const std::chrono::duration<float> budget(mainThreadTaskBudget.Get());
+			taskSystem.ProcessMainThreadTasks(std::chrono::duration_cast<time::TDuration>(budget));
 			std::this_thread::yield();
 		}
 
@@ -233,6 +241,13 @@ namespace hbe
 		std::cout << str << std::endl;
 	}
 
+	void Engine::ConsoleOut(std::string_view str)
+	{
+		std::lock_guard lock(consoleOutLock);
+		std::cout.write(str.data(), static_cast<std::streamsize>(str.length()));
+		std::cout.flush();
+	}
+
 	void Engine::PostInitialize()
 	{
 		using namespace StringUtil;
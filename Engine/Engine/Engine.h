@@ -95,6 +95,7 @@ namespace hbe
 		void FlushLog();
 
 		void ConsoleOutLn(const char* str);
+		void ConsoleOut(std::string_view str);
 
 	private:
 		void PostInitialize();
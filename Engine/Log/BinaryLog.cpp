@@ -0,0 +1,388 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "BinaryLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+
+namespace hbe
+{
+namespace BinaryLog
+{
+namespace
+{
+	// Appends to a fixed buffer the same way BufferStringBuilder does.
+	class Appender final
+	{
+	private:
+		char* buffer;
+		size_t lastIndex;
+		size_t length;
+
+	public:
+		Appender(char* buffer, size_t capacity) noexcept : buffer(buffer), lastIndex(capacity - 1), length(0)
+		{
+			buffer[0] = '\0';
+		}
+
+		[[nodiscard]] size_t Size() const noexcept { return length; }
+
+		void Append(std::string_view str) noexcept
+		{
+			const auto len = std::min(str.length(), lastIndex - length);
+			if (len == 0)
+			{
+				return;
+			}
+
+			memcpy(&buffer[length], str.data(), len);
+			length += len;
+			buffer[length] = '\0';
+		}
+
+		template<typename T>
+		void AppendFormat(const char* format, T value) noexcept
+		{
+			const size_t remained = lastIndex + 1 - length;
+			const auto written = snprintf(&buffer[length], remained, format, value);
+			if (written < 0)
+			{
+				return;
+			}
+
+			length = std::min(lastIndex, length + written);
+			buffer[length] = '\0';
+		}
+
+		void Append(const Arg& arg, const TStringResolver& resolver) noexcept
+		{
+			switch (arg.type)
+			{
+				case EArgType::Boolean:
+					Append(arg.boolValue ? "True" : "False");
+					break;
+
+				case EArgType::Char:
+					Append(std::string_view(&arg.charValue, 1));
+					break;
+
+				case EArgType::Int32:
+					AppendFormat("%d", static_cast<int>(arg.intValue));
+					break;
+
+				case EArgType::UInt32:
+					AppendFormat("%u", static_cast<unsigned int>(arg.uintValue));
+					break;
+
+				case EArgType::Int64:
+					AppendFormat("%lld", static_cast<long long>(arg.intValue));
+					break;
+
+				case EArgType::UInt64:
+					AppendFormat("%llu", static_cast<unsigned long long>(arg.uintValue));
+					break;
+
+				case EArgType::Float:
+				case EArgType::Double:
+					AppendFormat("%f", arg.doubleValue);
+					break;
+
+				case EArgType::Pointer:
+					AppendFormat("%p", arg.pointer);
+					break;
+
+				case EArgType::Text:
+					Append(arg.text);
+					break;
+
+				case EArgType::StaticText:
+					Append(resolver(arg.uintValue));
+					break;
+			}
+		}
+	};
+
+	template<typename T>
+	bool ReadValue(const uint8_t*& cursor, const uint8_t* end, T& outValue) noexcept
+	{
+		if (static_cast<size_t>(end - cursor) < sizeof(T))
+		{
+			return false;
+		}
+
+		memcpy(&outValue, cursor, sizeof(T));
+		cursor += sizeof(T);
+
+		return true;
+	}
+
+	template<typename T>
+	bool ReadValue(std::istream& input, T& outValue)
+	{
+		return static_cast<bool>(input.read(reinterpret_cast<char*>(&outValue), sizeof(T)));
+	}
+
+} // anonymous namespace
+
+	bool ReadArg(const uint8_t*& cursor, const uint8_t* end, Arg& outArg) noexcept
+	{
+		uint8_t type = 0;
+		if (!ReadValue(cursor, end, type))
+		{
+			return false;
+		}
+
+		outArg.type = static_cast<EArgType>(type);
+		outArg.text = std::string_view();
+
+		switch (outArg.type)
+		{
+			case EArgType::Boolean:
+			{
+				uint8_t value = 0;
+				const bool isValid = ReadValue(cursor, end, value);
+				outArg.boolValue = value != 0;
+
+				return isValid;
+			}
+
+			case EArgType::Char:
+				return ReadValue(cursor, end, outArg.charValue);
+
+			case EArgType::Int32:
+			{
+				int32_t value = 0;
+				const bool isValid = ReadValue(cursor, end, value);
+				outArg.intValue = value;
+
+				return isValid;
+			}
+
+			case EArgType::UInt32:
+			{
+				uint32_t value = 0;
+				const bool isValid = ReadValue(cursor, end, value);
+				outArg.uintValue = value;
+
+				return isValid;
+			}
+
+			case EArgType::Int64:
+				return ReadValue(cursor, end, outArg.intValue);
+
+			case EArgType::UInt64:
+			case EArgType::StaticText:
+				return ReadValue(cursor, end, outArg.uintValue);
+
+			case EArgType::Float:
+			{
+				float value = 0.0f;
+				const bool isValid = ReadValue(cursor, end, value);
+				outArg.doubleValue = value;
+
+				return isValid;
+			}
+
+			case EArgType::Double:
+				return ReadValue(cursor, end, outArg.doubleValue);
+
+			case EArgType::Pointer:
+			{
+				uint64_t value = 0;
+				const bool isValid = ReadValue(cursor, end, value);
+				outArg.pointer = reinterpret_cast<const void*>(static_cast<uintptr_t>(value));
+
+				return isValid;
+			}
+
+			case EArgType::Text:
+			{
+				uint32_t length = 0;
+				if (!ReadValue(cursor, end, length) || static_cast<size_t>(end - cursor) < length)
+				{
+					return false;
+				}
+
+				outArg.text = std::string_view(reinterpret_cast<const char*>(cursor), length);
+				cursor += length;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	size_t Format(char* buffer, size_t capacity, std::string_view format, const uint8_t* args, size_t size,
+		const TStringResolver& resolver) noexcept
+	{
+		Appender text(buffer, capacity);
+
+		const auto* cursor = args;
+		const auto* end = args + size;
+
+		size_t start = 0;
+		for (auto found = format.find("{}"); found != std::string_view::npos; found = format.find("{}", start))
+		{
+			Arg arg;
+			if (cursor >= end || !ReadArg(cursor, end, arg))
+			{
+				break;
+			}
+
+			text.Append(format.substr(start, found - start));
+			text.Append(arg, resolver);
+
+			start = found + 2;
+		}
+
+		// The placeholders without arguments are printed as they are.
+		text.Append(format.substr(start));
+
+		return text.Size();
+	}
+
+	void AppendTimeStamp(std::string& outStr, int64_t nanoSeconds)
+	{
+		using namespace std;
+
+		const chrono::nanoseconds diff(nanoSeconds);
+
+		auto hours = chrono::duration_cast<chrono::hours>(diff);
+		auto minutes = chrono::duration_cast<chrono::minutes>(diff);
+		auto seconds = chrono::duration_cast<chrono::seconds>(diff);
+		auto milliSeconds = chrono::duration_cast<chrono::milliseconds>(diff);
+
+		outStr.append(to_string(hours.count()));
+		outStr.push_back(':');
+		outStr.append(to_string(minutes.count() % 60));
+		outStr.push_back(':');
+		outStr.append(to_string(seconds.count() % 60));
+		outStr.push_back('.');
+		outStr.append(to_string(milliSeconds.count() % 1000));
+	}
+
+	const char* GetLevelName(uint8_t level) noexcept
+	{
+		constexpr const char* names[] = {"Verbose", "Info", "Significant", "Warning", "Error", "FatalError"};
+
+		return level < std::size(names) ? names[level] : "";
+	}
+
+	Decoder::Decoder() noexcept : numRecords(0) {}
+
+	bool Decoder::Decode(std::istream& input, std::ostream& output)
+	{
+		numRecords = 0;
+		error.clear();
+
+		char magic[sizeof(Magic)] = {};
+		uint8_t version = 0;
+
+		if (!input.read(magic, sizeof(magic)) || memcmp(magic, Magic, sizeof(Magic)) != 0)
+		{
+			return Fail("Not a binary log.");
+		}
+
+		if (!ReadValue(input, version) || version != Version)
+		{
+			return Fail("Unsupported version.");
+		}
+
+		std::unordered_map<uint64_t, std::string> strings;
+		auto resolver = [&strings](uint64_t id) -> std::string_view
+		{
+			auto found = strings.find(id);
+			return found == strings.end() ? std::string_view() : std::string_view(found->second);
+		};
+
+		std::vector<uint8_t> payload;
+		std::vector<char> textBuffer(MaxTextLength + 1);
+		std::string line;
+
+		uint8_t entry = 0;
+		while (ReadValue(input, entry))
+		{
+			if (entry == static_cast<uint8_t>(EEntry::String))
+			{
+				uint64_t id = 0;
+				uint32_t length = 0;
+
+				if (!ReadValue(input, id) || !ReadValue(input, length))
+				{
+					return Fail("Truncated string.");
+				}
+
+				std::string str(length, '\0');
+				if (!input.read(str.data(), length))
+				{
+					return Fail("Truncated string.");
+				}
+
+				strings[id] = std::move(str);
+				continue;
+			}
+
+			if (entry != static_cast<uint8_t>(EEntry::Record))
+			{
+				return Fail("Unknown entry.");
+			}
+
+			uint8_t level = 0;
+			int64_t timeStamp = 0;
+			uint64_t threadName = 0;
+			uint64_t category = 0;
+			uint64_t format = 0;
+			uint32_t size = 0;
+
+			if (!ReadValue(input, level) || !ReadValue(input, timeStamp) || !ReadValue(input, threadName)
+				|| !ReadValue(input, category) || !ReadValue(input, format) || !ReadValue(input, size))
+			{
+				return Fail("Truncated record.");
+			}
+
+			payload.resize(size);
+			if (!input.read(reinterpret_cast<char*>(payload.data()), size))
+			{
+				return Fail("Truncated record.");
+			}
+
+			line.clear();
+			line.push_back('[');
+			AppendTimeStamp(line, timeStamp);
+			line.append("][").append(resolver(threadName)).append("][").append(resolver(category)).append("][");
+			line.append(GetLevelName(level)).append("] ");
+
+			if (format == 0)
+			{
+				line.append(reinterpret_cast<const char*>(payload.data()), size);
+			}
+			else
+			{
+				const auto length = Format(textBuffer.data(), textBuffer.size(), resolver(format), payload.data(),
+					size, resolver);
+				line.append(textBuffer.data(), length);
+			}
+
+			line.push_back('\n');
+			output.write(line.data(), static_cast<std::streamsize>(line.size()));
+
+			++numRecords;
+		}
+
+		return true;
+	}
+
+	bool Decoder::Fail(const char* message)
+	{
+		error = message;
+		return false;
+	}
+
+} // namespace BinaryLog
+} // namespace hbe
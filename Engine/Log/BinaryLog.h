@@ -0,0 +1,107 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// The binary log format, shared by the engine and Tools/LogDecoder. It depends on the standard library only, so the
+// decoder can be built without the engine.
+namespace hbe
+{
+namespace BinaryLog
+{
+
+	// File header: Magic, followed by Version.
+	constexpr char Magic[7] = {'H', 'B', 'E', 'L', 'O', 'G', '\0'};
+	constexpr uint8_t Version = 1;
+
+	// The longest text of a record, the same as Logger::MaxTextLength.
+	constexpr size_t MaxTextLength = 128 * 1024 - 1;
+
+	// A file is a sequence of entries, each starting with its type. Integers are in the byte order of the writer.
+	//   String: uint64 id, uint32 length, char[length]
+	//   Record: uint8 level, int64 nanoseconds since the logger started, uint64 thread name id, uint64 category id,
+	//           uint64 format id, uint32 size, uint8[size]
+	// A string is written once before the first record referring to it. A record with the format id 0 carries the
+	// text, and the others the arguments of the format.
+	enum class EEntry : uint8_t
+	{
+		String = 1,
+		Record = 2
+	};
+
+	// Each argument is its type followed by the value. Text is a uint32 length followed by the characters, and
+	// StaticText is the id of a string entry.
+	enum class EArgType : uint8_t
+	{
+		Boolean,
+		Char,
+		Int32,
+		UInt32,
+		Int64,
+		UInt64,
+		Float,
+		Double,
+		Pointer,
+		Text,
+		StaticText
+	};
+
+	struct Arg final
+	{
+		EArgType type;
+		union
+		{
+			bool boolValue;
+			char charValue;
+			int64_t intValue;
+			uint64_t uintValue;
+			double doubleValue;
+			const void* pointer;
+		};
+		std::string_view text;
+	};
+
+	// Look up the text of a StaticText argument.
+	using TStringResolver = std::function<std::string_view(uint64_t id)>;
+
+	// Read an argument at cursor, and move the cursor past it. Return false if the arguments are corrupted.
+	[[nodiscard]] bool ReadArg(const uint8_t*& cursor, const uint8_t* end, Arg& outArg) noexcept;
+
+	// Substitute the arguments for the "{}"s in the format, the same way BufferStringBuilder prints them.
+	// The text is truncated to capacity - 1 characters, and always terminated. Return the length of the text.
+	size_t Format(char* buffer, size_t capacity, std::string_view format, const uint8_t* args, size_t size,
+		const TStringResolver& resolver) noexcept;
+
+	// The same as LogUtil::GetTimeStampString.
+	void AppendTimeStamp(std::string& outStr, int64_t nanoSeconds);
+	[[nodiscard]] const char* GetLevelName(uint8_t level) noexcept;
+
+	/// @brief Converts a binary log file back into the text log.
+	class Decoder final
+	{
+	private:
+		size_t numRecords;
+		std::string error;
+
+	public:
+		Decoder() noexcept;
+
+		// Return false if the input isn't a complete binary log, and the lines decoded so far are written.
+		bool Decode(std::istream& input, std::ostream& output);
+
+		[[nodiscard]] size_t GetNumRecords() const noexcept { return numRecords; }
+		[[nodiscard]] const std::string& GetError() const noexcept { return error; }
+
+	private:
+		bool Fail(const char* message);
+	};
+
+} // namespace BinaryLog
+} // namespace hbe
@@ -0,0 +1,292 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "BinaryLogWriter.h"
+
+#include <chrono>
+#include "Core/CommonMacros.h"
+
+
+namespace hbe
+{
+
+BinaryLogWriter::BinaryLogWriter(std::ostream& stream, const TTimePoint& startTime)
+	: stream(stream)
+	, startTime(startTime)
+{
+}
+
+void BinaryLogWriter::WriteHeader()
+{
+	stream.write(BinaryLog::Magic, sizeof(BinaryLog::Magic));
+	WriteValue(BinaryLog::Version);
+}
+
+void BinaryLogWriter::Write(const LogRecord& record)
+{
+	const auto threadName = WriteString(record.threadName);
+	const auto category = WriteString(record.category);
+	uint64_t format = 0;
+
+	if (record.IsBinary())
+	{
+		format = WriteString(StaticString(record.format));
+
+		const auto* cursor = record.GetArgs();
+		const auto* end = cursor + record.textLength;
+
+		BinaryLog::Arg arg;
+		while (cursor < end && BinaryLog::ReadArg(cursor, end, arg))
+		{
+			continueIf(arg.type != BinaryLog::EArgType::StaticText);
+
+			StaticStringID id;
+			id.ptr = reinterpret_cast<const uint8_t*>(arg.uintValue);
+			WriteString(StaticString(id));
+		}
+	}
+
+	const auto timeStamp = std::chrono::duration_cast<std::chrono::nanoseconds>(record.timeStamp - startTime);
+
+	WriteValue(BinaryLog::EEntry::Record);
+	WriteValue(record.level);
+	WriteValue(static_cast<int64_t>(timeStamp.count()));
+	WriteValue(threadName);
+	WriteValue(category);
+	WriteValue(format);
+	WriteValue(record.textLength);
+	stream.write(record.GetText(), record.textLength);
+}
+
+uint64_t BinaryLogWriter::WriteString(StaticString str)
+{
+	const auto id = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(str.GetID().ptr));
+	returnValueIf(id, !writtenStrings.insert(id).second);
+
+	const std::string_view text(str.c_str());
+
+	WriteValue(BinaryLog::EEntry::String);
+	WriteValue(id);
+	WriteValue(static_cast<uint32_t>(text.length()));
+	stream.write(text.data(), static_cast<std::streamsize>(text.length()));
+
+	return id;
+}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <sstream>
+#include <string>
+#include "Core/ScopedTime.h"
+#include "HSTL/HVector.h"
+#include "LogArgs.h"
+#include "LogUtil.h"
+#include "String/BufferStringBuilder.h"
+#include "String/InlineStringBuilder.h"
+
+namespace hbe
+{
+
+void BinaryLogWriterTest::Prepare()
+{
+	AddTest("Round Trip", [this](auto& ls)
+	{
+		LogRing ring(64 * 1024);
+		const StaticString threadName("BinaryLogWriter");
+		const StaticString category("RoundTrip");
+
+		HVector<std::string> expected;
+
+		auto addExpected = [&](const LogRecord& record, const char* text)
+		{
+			InlineStringBuilder<64> timeStamp;
+			LogUtil::GetTimeStampString(timeStamp, record.timeStamp);
+
+			std::string line("[");
+			line.append(timeStamp.c_str()).append("][").append(threadName.c_str()).append("][");
+			line.append(category.c_str()).append("][").append(LogUtil::GetLogLevelString(record.level).c_str());
+			line.append("] ").append(text);
+
+			expected.push_back(std::move(line));
+		};
+
+		// Encode the arguments as Logger does, and expect the text BufferStringBuilder prints.
+		auto addFormat = [&](ELogLevel level, StaticString format, auto&& printExpected, const auto&... args)
+		{
+			const size_t size = (LogArgs::GetSize(args) + ... + size_t(0));
+
+			auto* record = ring.Reserve(size, level, threadName, category, format.GetID());
+			auto* cursor = record->GetArgs();
+			((cursor = LogArgs::Encode(cursor, args)), ...);
+			ring.Commit(*record, size);
+
+			char buffer[256];
+			BufferStringBuilder text(buffer, sizeof(buffer));
+			printExpected(text);
+
+			addExpected(*record, text.c_str());
+		};
+
+		{
+			auto* record = ring.Reserve(64, ELogLevel::Warning, threadName, category);
+			BufferStringBuilder text(record->GetText(), 65);
+			text << "Plain text " << 42;
+			ring.Commit(*record, text.Size());
+
+			addExpected(*record, text.c_str());
+		}
+
+		const std::string name("Texture.png");
+		const char* nullText = nullptr;
+
+		addFormat(ELogLevel::Info, StaticString("Loaded {} in {} ms"),
+			[&](auto& text) { text << "Loaded " << name << " in " << 12.5 << " ms"; }, name, 12.5);
+		addFormat(ELogLevel::Verbose, StaticString("{} {} {} {} {}"),
+			[&](auto& text) { text << -7 << ' ' << 7u << ' ' << -(1ll << 40) << ' ' << (1ull << 63) << ' ' << 0.25f; },
+			-7, 7u, -(1ll << 40), 1ull << 63, 0.25f);
+		addFormat(ELogLevel::Error, StaticString("[{}] {}, {} and {}"),
+			[&](auto& text) { text << '[' << 'x' << "] " << true << ", " << category << " and " << nullText; },
+			'x', true, category, nullText);
+		addFormat(ELogLevel::Significant, StaticString("Missing {} and {}"),
+			[&](auto& text) { text << "Missing " << "an argument" << " and {}"; }, "an argument");
+
+		std::stringstream binary;
+		BinaryLogWriter writer(binary, LogUtil::GetStartTime());
+		writer.WriteHeader();
+
+		ring.Visit(ring.GetWritePos(), [&](const LogRecord& record) { writer.Write(record); });
+		ring.EndRead(ring.GetWritePos());
+
+		std::stringstream decoded;
+		BinaryLog::Decoder decoder;
+
+		if (!decoder.Decode(binary, decoded))
+		{
+			ls << "Failed to decode: " << decoder.GetError() << lferr;
+			return;
+		}
+
+		std::string line;
+		size_t index = 0;
+
+		while (std::getline(decoded, line))
+		{
+			if (index >= expected.size() || line != expected[index])
+			{
+				ls << "Line " << index << " is decoded as " << line << lferr;
+				return;
+			}
+
+			++index;
+		}
+
+		if (index != expected.size() || decoder.GetNumRecords() != expected.size())
+		{
+			ls << index << " lines are decoded, but " << expected.size() << " expected." << lferr;
+		}
+	});
+
+	AddTest("Truncated Input", [this](auto& ls)
+	{
+		LogRing ring(4096);
+		const auto format = StaticString("{}");
+
+		auto* record = ring.Reserve(LogArgs::GetSize(1), ELogLevel::Info, StaticString(), StaticString(), format.GetID());
+		LogArgs::Encode(record->GetArgs(), 1);
+		ring.Commit(*record, LogArgs::GetSize(1));
+
+		std::stringstream binary;
+		BinaryLogWriter writer(binary, LogUtil::GetStartTime());
+		writer.WriteHeader();
+
+		ring.Visit(ring.GetWritePos(), [&](const LogRecord& read) { writer.Write(read); });
+		ring.EndRead(ring.GetWritePos());
+
+		auto data = binary.str();
+		data.pop_back();
+
+		std::stringstream truncated(data);
+		std::stringstream decoded;
+		BinaryLog::Decoder decoder;
+
+		if (decoder.Decode(truncated, decoded))
+		{
+			ls << "A truncated record should fail to be decoded." << lferr;
+		}
+	});
+
+	AddTest("Capture Performance", [this](auto& ls)
+	{
+		constexpr size_t NumRecords = 1000000;
+		constexpr size_t MaxTextLength = Config::LogLineLength - 1;
+
+		LogRing ring(Config::LogRingBufferSize);
+		const StaticString threadName("BinaryLogWriter");
+		const StaticString category("Performance");
+		const StaticString format("Frame {} took {} ms on {} with {}");
+		const char* device = "GPU";
+
+		// Drain the ring when it's full, as the IO thread would.
+		auto reserve = [&](size_t size, StaticStringID recordFormat)
+		{
+			auto* record = ring.Reserve(size, ELogLevel::Info, threadName, category, recordFormat);
+			if (unlikely(record == nullptr))
+			{
+				ring.EndRead(ring.GetWritePos());
+				record = ring.Reserve(size, ELogLevel::Info, threadName, category, recordFormat);
+			}
+
+			return record;
+		};
+
+		time::TDuration textTime;
+		{
+			time::ScopedTime timer(textTime);
+
+			for (size_t i = 0; i < NumRecords; ++i)
+			{
+				auto* record = reserve(MaxTextLength, StaticStringID());
+
+				BufferStringBuilder text(record->GetText(), MaxTextLength + 1);
+				text << "Frame " << i << " took " << 16.6 << " ms on " << device << " with " << category;
+				ring.Commit(*record, text.Size());
+			}
+		}
+
+		ring.EndRead(ring.GetWritePos());
+
+		time::TDuration binaryTime;
+		{
+			time::ScopedTime timer(binaryTime);
+
+			for (size_t i = 0; i < NumRecords; ++i)
+			{
+				const size_t size = LogArgs::GetSize(i) + LogArgs::GetSize(16.6) + LogArgs::GetSize(device)
+					+ LogArgs::GetSize(category);
+
+				auto* record = reserve(size, format.GetID());
+
+				auto* cursor = LogArgs::Encode(record->GetArgs(), i);
+				cursor = LogArgs::Encode(cursor, 16.6);
+				cursor = LogArgs::Encode(cursor, device);
+				LogArgs::Encode(cursor, category);
+				ring.Commit(*record, size);
+			}
+		}
+
+		ring.EndRead(ring.GetWritePos());
+
+		const auto textNs = time::ToFloat(textTime) * 1e9 / NumRecords;
+		const auto binaryNs = time::ToFloat(binaryTime) * 1e9 / NumRecords;
+
+		ls << "Per record, text " << textNs << " ns, binary " << binaryNs << " ns" << lf;
+
+		if (binaryNs > textNs)
+		{
+			ls << "Capturing the arguments is slower than formatting the text." << lfwarn;
+		}
+	});
+}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
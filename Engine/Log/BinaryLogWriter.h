@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_set>
+#include "BinaryLog.h"
+#include "LogRing.h"
+#include "Memory/DefaultAllocator.h"
+#include "String/StaticString.h"
+
+namespace hbe
+{
+
+/// @brief Writes log records into a binary log, which Tools/LogDecoder turns back into the text log.
+/// @details A record is written as it is in the ring, with its arguments unformatted and its time stamp in
+/// nanoseconds. The static strings it refers to are written once, the first time they're seen.
+class BinaryLogWriter final
+{
+public:
+	using TTimePoint = LogRecord::TTimePoint;
+	using TStringIDs = std::unordered_set<uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>,
+		DefaultAllocator<uint64_t>>;
+
+private:
+	std::ostream& stream;
+	TTimePoint startTime;
+	TStringIDs writtenStrings;
+
+public:
+	BinaryLogWriter(std::ostream& stream, const TTimePoint& startTime);
+
+	BinaryLogWriter(const BinaryLogWriter&) = delete;
+	BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+	void WriteHeader();
+	void Write(const LogRecord& record);
+
+private:
+	uint64_t WriteString(StaticString str);
+
+	template<typename T>
+	void WriteValue(const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+class BinaryLogWriterTest : public TestCollection
+{
+public:
+	BinaryLogWriterTest() : TestCollection("BinaryLogWriterTest") {}
+
+protected:
+	void Prepare() override;
+};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
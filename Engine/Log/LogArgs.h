@@ -0,0 +1,174 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include "BinaryLog.h"
+#include "Config/EngineConfig.h"
+#include "String/StaticString.h"
+
+// Intern the format of a binary log once per call site. e.g. log.OutFormat(LOG_FORMAT("{} loaded"), name);
+#define LOG_FORMAT(format) ([]() -> hbe::StaticString { static const hbe::StaticString str(format); return str; }())
+
+namespace hbe
+{
+namespace LogArgs
+{
+
+	using EArgType = BinaryLog::EArgType;
+
+	// A longer text argument is truncated.
+	constexpr size_t MaxTextLength = Config::LogLineLength;
+
+	template<typename T>
+	constexpr bool IsText = std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, std::nullptr_t>;
+
+	template<typename T>
+	constexpr size_t GetMaxSize() noexcept
+	{
+		using TValue = std::decay_t<T>;
+
+		if constexpr (std::is_same_v<TValue, bool> || std::is_same_v<TValue, char>)
+		{
+			return 2;
+		}
+		else if constexpr (std::is_integral_v<TValue>)
+		{
+			return 1 + (sizeof(TValue) <= 4 ? 4 : 8);
+		}
+		else if constexpr (std::is_same_v<TValue, float>)
+		{
+			return 1 + sizeof(float);
+		}
+		else if constexpr (std::is_same_v<TValue, double>)
+		{
+			return 1 + sizeof(double);
+		}
+		else if constexpr (std::is_same_v<TValue, StaticString> || (std::is_pointer_v<TValue> && !IsText<TValue>))
+		{
+			return 1 + sizeof(uint64_t);
+		}
+		else
+		{
+			static_assert(IsText<TValue>, "The type can't be a binary log argument.");
+			return 1 + sizeof(uint32_t) + MaxTextLength;
+		}
+	}
+
+	template<typename T>
+	[[nodiscard]] std::string_view ToText(const T& value) noexcept
+	{
+		if constexpr (std::is_pointer_v<T>)
+		{
+			return value == nullptr ? std::string_view("Null") : std::string_view(value);
+		}
+		else
+		{
+			return std::string_view(value);
+		}
+	}
+
+	template<typename T>
+	[[nodiscard]] size_t GetSize(const T& value) noexcept
+	{
+		using TValue = std::decay_t<T>;
+
+		if constexpr (IsText<TValue>)
+		{
+			return 1 + sizeof(uint32_t) + std::min(ToText(value).length(), MaxTextLength);
+		}
+		else
+		{
+			return GetMaxSize<TValue>();
+		}
+	}
+
+	template<typename TStored>
+	uint8_t* Write(uint8_t* cursor, EArgType type, TStored value) noexcept
+	{
+		*cursor = static_cast<uint8_t>(type);
+		memcpy(cursor + 1, &value, sizeof(TStored));
+
+		return cursor + 1 + sizeof(TStored);
+	}
+
+	// Write the argument at cursor, and return the end of it. The caller has GetSize(value) bytes at cursor.
+	template<typename T>
+	uint8_t* Encode(uint8_t* cursor, const T& value) noexcept
+	{
+		using TValue = std::decay_t<T>;
+
+		if constexpr (std::is_same_v<TValue, bool>)
+		{
+			return Write(cursor, EArgType::Boolean, static_cast<uint8_t>(value));
+		}
+		else if constexpr (std::is_same_v<TValue, char>)
+		{
+			return Write(cursor, EArgType::Char, value);
+		}
+		else if constexpr (std::is_integral_v<TValue> && sizeof(TValue) <= 4)
+		{
+			if constexpr (std::is_signed_v<TValue>)
+			{
+				return Write(cursor, EArgType::Int32, static_cast<int32_t>(value));
+			}
+			else
+			{
+				return Write(cursor, EArgType::UInt32, static_cast<uint32_t>(value));
+			}
+		}
+		else if constexpr (std::is_integral_v<TValue>)
+		{
+			if constexpr (std::is_signed_v<TValue>)
+			{
+				return Write(cursor, EArgType::Int64, static_cast<int64_t>(value));
+			}
+			else
+			{
+				return Write(cursor, EArgType::UInt64, static_cast<uint64_t>(value));
+			}
+		}
+		else if constexpr (std::is_same_v<TValue, float>)
+		{
+			return Write(cursor, EArgType::Float, value);
+		}
+		else if constexpr (std::is_same_v<TValue, double>)
+		{
+			return Write(cursor, EArgType::Double, value);
+		}
+		else if constexpr (std::is_same_v<TValue, StaticString>)
+		{
+			const auto id = reinterpret_cast<uintptr_t>(value.GetID().ptr);
+			return Write(cursor, EArgType::StaticText, static_cast<uint64_t>(id));
+		}
+		else if constexpr (IsText<TValue>)
+		{
+			const auto text = ToText(value);
+			const auto length = static_cast<uint32_t>(std::min(text.length(), MaxTextLength));
+
+			cursor = Write(cursor, EArgType::Text, length);
+			memcpy(cursor, text.data(), length);
+
+			return cursor + length;
+		}
+		else
+		{
+			return Write(cursor, EArgType::Pointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+		}
+	}
+
+	// The text of a StaticText argument in this process.
+	[[nodiscard]] inline std::string_view ResolveString(uint64_t id) noexcept
+	{
+		StaticStringID stringID;
+		stringID.ptr = reinterpret_cast<const uint8_t*>(id);
+
+		return std::string_view(StaticString(stringID).c_str());
+	}
+
+} // namespace LogArgs
+} // namespace hbe
@@ -0,0 +1,328 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "LogCategory.h"
+
+#include <mutex>
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+
+
+namespace hbe
+{
+namespace
+{
+	// Every array is constant-initialized, so categories can be registered during the static initialization.
+	std::mutex RegistryLock;
+	std::atomic<size_t> NumCategories = 1;
+	std::atomic<uint8_t> DefaultLevel = static_cast<uint8_t>(ELogLevel::Info);
+
+	std::atomic<const uint8_t*> Keys[LogCategory::Capacity * 2];
+	LogCategory::TIndex Indices[LogCategory::Capacity * 2];
+
+	const uint8_t* Names[LogCategory::Capacity];
+	// The level of a category plus 1, or 0 to follow the default level. Accessed under the lock.
+	uint8_t Overrides[LogCategory::Capacity];
+
+} // anonymous namespace
+
+// The index 0 isn't registered by any category, and is shared by the ones beyond the capacity.
+std::atomic<uint8_t> LogCategory::states[Capacity] = {static_cast<uint8_t>(ELogLevel::Info)};
+
+LogCategory::TIndex LogCategory::Register(StaticString category) noexcept
+{
+	const auto id = category.GetID();
+	returnValueIf(0, unlikely(id.ptr == nullptr));
+
+	constexpr size_t Mask = NumSlots - 1;
+	auto slot = GetSlot(id);
+
+	for (;; slot = (slot + 1) & Mask)
+	{
+		const auto* key = Keys[slot].load(std::memory_order_acquire);
+		returnValueIf(Indices[slot], key == id.ptr);
+		breakIf(key == nullptr);
+	}
+
+	std::lock_guard lock(RegistryLock);
+
+	// Another thread may have registered it in the meantime.
+	for (;; slot = (slot + 1) & Mask)
+	{
+		const auto* key = Keys[slot].load(std::memory_order_relaxed);
+		returnValueIf(Indices[slot], key == id.ptr);
+		breakIf(key == nullptr);
+	}
+
+	const auto count = NumCategories.load(std::memory_order_relaxed);
+	if (unlikely(count >= Capacity))
+	{
+		Assert(false, "Too many log categories, %s shares the default level.", category.c_str());
+		return 0;
+	}
+
+	const auto index = static_cast<TIndex>(count);
+	Names[index] = id.ptr;
+	Overrides[index] = 0;
+	UpdateState(index);
+
+	Indices[slot] = index;
+	Keys[slot].store(id.ptr, std::memory_order_release);
+	NumCategories.store(count + 1, std::memory_order_release);
+
+	return index;
+}
+
+void LogCategory::SetDefaultLevel(ELogLevel level) noexcept
+{
+	std::lock_guard lock(RegistryLock);
+
+	DefaultLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+
+	const auto count = NumCategories.load(std::memory_order_relaxed);
+	for (size_t i = 0; i < count; ++i)
+	{
+		UpdateState(static_cast<TIndex>(i));
+	}
+}
+
+ELogLevel LogCategory::GetDefaultLevel() noexcept
+{
+	return static_cast<ELogLevel>(DefaultLevel.load(std::memory_order_relaxed));
+}
+
+void LogCategory::SetLevel(TIndex index, ELogLevel level) noexcept
+{
+	Assert(index < Capacity);
+	std::lock_guard lock(RegistryLock);
+
+	Overrides[index] = static_cast<uint8_t>(level) + 1;
+	UpdateState(index);
+}
+
+void LogCategory::ResetLevel(TIndex index) noexcept
+{
+	Assert(index < Capacity);
+	std::lock_guard lock(RegistryLock);
+
+	Overrides[index] = 0;
+	UpdateState(index);
+}
+
+void LogCategory::SetHasFilter(TIndex index, bool hasFilter) noexcept
+{
+	Assert(index < Capacity);
+	std::lock_guard lock(RegistryLock);
+
+	const auto level = states[index].load(std::memory_order_relaxed) & LevelMask;
+	states[index].store(hasFilter ? (level | HasFilter) : level, std::memory_order_relaxed);
+}
+
+StaticString LogCategory::GetName(TIndex index) noexcept
+{
+	returnValueIf(StaticString(), index == 0 || index >= NumCategories.load(std::memory_order_acquire));
+
+	StaticStringID id;
+	id.ptr = Names[index];
+
+	return StaticString(id);
+}
+
+size_t LogCategory::GetNumCategories() noexcept
+{
+	return NumCategories.load(std::memory_order_acquire) - 1;
+}
+
+size_t LogCategory::GetSlot(StaticStringID id) noexcept
+{
+	return id.GetHash() & (NumSlots - 1);
+}
+
+void LogCategory::UpdateState(TIndex index) noexcept
+{
+	const auto level = Overrides[index] != 0 ? Overrides[index] - 1 : DefaultLevel.load(std::memory_order_relaxed);
+	const auto filter = states[index].load(std::memory_order_relaxed) & HasFilter;
+
+	states[index].store(static_cast<uint8_t>(level | filter), std::memory_order_relaxed);
+}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <functional>
+#include <thread>
+#include "Core/ScopedTime.h"
+#include "HSTL/HUnorderedMap.h"
+#include "HSTL/HVector.h"
+#include "Logger.h"
+#include "String/InlineStringBuilder.h"
+
+namespace hbe
+{
+
+void LogCategoryTest::Prepare()
+{
+	AddTest("Register", [this](auto& ls)
+	{
+		const StaticString first("LogCategoryTest.First");
+		const StaticString second("LogCategoryTest.Second");
+
+		const auto firstIndex = LogCategory::Register(first);
+		const auto secondIndex = LogCategory::Register(second);
+
+		if (firstIndex == 0 || secondIndex == 0 || firstIndex == secondIndex)
+		{
+			ls << "Categories should have their own indices, but " << firstIndex << " and " << secondIndex << lferr;
+		}
+
+		if (LogCategory::Register(first) != firstIndex || LogCategory::GetName(firstIndex) != first)
+		{
+			ls << "A category should be resolved into the same index." << lferr;
+		}
+	});
+
+	AddTest("Levels", [this](auto& ls)
+	{
+		const auto index = LogCategory::Register(StaticString("LogCategoryTest.Levels"));
+		const auto defaultLevel = LogCategory::GetDefaultLevel();
+
+		LogCategory::SetLevel(index, ELogLevel::Warning);
+		if (LogCategory::IsEnabled(index, ELogLevel::Significant) || !LogCategory::IsEnabled(index, ELogLevel::Warning))
+		{
+			ls << "The level of the category isn't applied." << lferr;
+		}
+
+		LogCategory::SetHasFilter(index, true);
+		LogCategory::SetDefaultLevel(ELogLevel::Verbose);
+		const bool hasFilter = (LogCategory::GetState(index) & LogCategory::HasFilter) != 0;
+		if (LogCategory::IsEnabled(index, ELogLevel::Info) || !hasFilter)
+		{
+			ls << "The default level shouldn't override the level of the category, or drop the filter." << lferr;
+		}
+
+		LogCategory::ResetLevel(index);
+		LogCategory::SetHasFilter(index, false);
+		if (!LogCategory::IsEnabled(index, ELogLevel::Verbose) || LogCategory::GetState(index) != 0)
+		{
+			ls << "The category should follow the default level after reset." << lferr;
+		}
+
+		LogCategory::SetDefaultLevel(defaultLevel);
+		if (LogCategory::IsEnabled(index, ELogLevel::Verbose) != (defaultLevel == ELogLevel::Verbose))
+		{
+			ls << "The default level isn't restored." << lferr;
+		}
+	});
+
+	AddTest("Concurrent Register", [this](auto& ls)
+	{
+		constexpr size_t NumThreads = 8;
+		constexpr size_t NumNames = 64;
+
+		HVector<StaticString> names;
+		for (size_t i = 0; i < NumNames; ++i)
+		{
+			InlineStringBuilder<64> name;
+			name << "LogCategoryTest.Concurrent" << i;
+			names.emplace_back(name.c_str());
+		}
+
+		HVector<HVector<LogCategory::TIndex>> results(NumThreads);
+		HVector<std::thread> threads;
+
+		for (size_t t = 0; t < NumThreads; ++t)
+		{
+			threads.emplace_back([&names, &result = results[t]]()
+			{
+				for (auto& name : names)
+				{
+					result.push_back(LogCategory::Register(name));
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		for (size_t t = 1; t < NumThreads; ++t)
+		{
+			if (results[t] != results[0])
+			{
+				ls << "Thread " << t << " resolved a category into another index." << lferr;
+				return;
+			}
+		}
+
+		for (size_t i = 0; i < NumNames; ++i)
+		{
+			if (LogCategory::GetName(results[0][i]) != names[i])
+			{
+				ls << names[i] << " is registered as " << LogCategory::GetName(results[0][i]) << lferr;
+				return;
+			}
+		}
+	});
+
+	AddTest("Rejected Log Performance", [this](auto& ls)
+	{
+		constexpr size_t NumLogs = 10000000;
+
+		const StaticString category("LogCategoryTest.Rejected");
+		const auto index = LogCategory::Register(category);
+		LogCategory::SetLevel(index, ELogLevel::Warning);
+
+		size_t numCalled = 0;
+
+		// The former check, a filter looked up under a mutex before the level could reject the log.
+		std::mutex lock;
+		HUnorderedMap<StaticString, std::function<bool(ELogLevel)>> filters;
+		filters.emplace(category, [](ELogLevel level) { return level >= ELogLevel::Warning; });
+
+		time::TDuration lockTime;
+		{
+			time::ScopedTime timer(lockTime);
+
+			for (size_t i = 0; i < NumLogs; ++i)
+			{
+				std::lock_guard guard(lock);
+				auto found = filters.find(category);
+				continueIf(found != filters.end() && !found->second(ELogLevel::Info));
+
+				++numCalled;
+			}
+		}
+
+		time::TDuration levelTime;
+		{
+			time::ScopedTime timer(levelTime);
+
+			TLog log(category);
+			for (size_t i = 0; i < NumLogs; ++i)
+			{
+				log.Out(ELogLevel::Info, [&numCalled](auto&) { ++numCalled; });
+			}
+		}
+
+		LogCategory::ResetLevel(index);
+
+		if (numCalled > 0)
+		{
+			ls << numCalled << " rejected logs have run." << lferr;
+			return;
+		}
+
+		const auto lockNs = time::ToFloat(lockTime) * 1e9 / NumLogs;
+		const auto levelNs = time::ToFloat(levelTime) * 1e9 / NumLogs;
+
+		ls << "Rejected log: filter under a lock " << lockNs << " ns, level array " << levelNs << " ns" << lf;
+
+		if (levelNs > lockNs)
+		{
+			ls << "The level array is slower than looking up the filter under a lock." << lfwarn;
+		}
+	});
+}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "Config/BuildConfig.h"
+#include "Config/EngineConfig.h"
+#include "LogLevel.h"
+#include "String/StaticString.h"
+
+namespace hbe
+{
+
+// Whether the logs of the level are compiled in. The others are removed where the level is known at compile time.
+constexpr bool IsLogCompiledIn(ELogLevel level) noexcept
+{
+	return LOG_ENABLED && static_cast<uint8_t>(level) >= HBE_LOG_MIN_LEVEL;
+}
+
+/// @brief Registry of log categories, each resolved once into a fixed index.
+/// @details The state of every category, the lowest level it logs and whether it has a filter, sits in a flat
+/// atomic array, so a log is rejected by a single relaxed load. Looking up a registered category doesn't take a lock,
+/// and only registering a new one or changing a level does. Once the registry is full, the other categories share
+/// the index 0, which follows the default level.
+class LogCategory final
+{
+public:
+	using TIndex = uint16_t;
+
+	static constexpr size_t Capacity = Config::MaxLogCategories;
+	// The state of a category is the lowest level it logs, combined with HasFilter if its filter should be run.
+	static constexpr uint8_t LevelMask = 0x7F;
+	static constexpr uint8_t HasFilter = 0x80;
+
+private:
+	static_assert(Capacity <= UINT16_MAX, "The index of a log category should fit in TIndex.");
+
+	// Open addressing from the id of a category to its index, at most half full.
+	static constexpr size_t NumSlots = Capacity * 2;
+
+	static std::atomic<uint8_t> states[Capacity];
+
+public:
+	LogCategory() = delete;
+
+	// Return the index of the category, registering it if it's new.
+	[[nodiscard]] static TIndex Register(StaticString category) noexcept;
+
+	[[nodiscard]] static uint8_t GetState(TIndex index) noexcept
+	{
+		return states[index].load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] static bool IsEnabled(TIndex index, ELogLevel level) noexcept
+	{
+		return static_cast<uint8_t>(level) >= (GetState(index) & LevelMask);
+	}
+
+	// The lowest level of the categories without their own.
+	static void SetDefaultLevel(ELogLevel level) noexcept;
+	[[nodiscard]] static ELogLevel GetDefaultLevel() noexcept;
+
+	// ELogLevel::MAX disables the category.
+	static void SetLevel(TIndex index, ELogLevel level) noexcept;
+	// Follow the default level again.
+	static void ResetLevel(TIndex index) noexcept;
+	static void SetHasFilter(TIndex index, bool hasFilter) noexcept;
+
+	[[nodiscard]] static StaticString GetName(TIndex index) noexcept;
+	[[nodiscard]] static size_t GetNumCategories() noexcept;
+
+private:
+	[[nodiscard]] static size_t GetSlot(StaticStringID id) noexcept;
+	// Recalculate the state of the category. It should be called under the lock.
+	static void UpdateState(TIndex index) noexcept;
+};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+class LogCategoryTest : public TestCollection
+{
+public:
+	LogCategoryTest() : TestCollection("LogCategoryTest") {}
+
+protected:
+	void Prepare() override;
+};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,367 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "LogFileWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "OSAL/OSFileOpenMode.h"
+#include "OSAL/OSInputOutput.h"
+#include "OSAL/OSMemory.h"
+#include "String/InlineStringBuilder.h"
+
+
+namespace hbe
+{
+
+LogFileWriter::LogFileWriter() noexcept
+	: fileSize(0)
+	, maxFileSize(0)
+	, numBackups(0)
+	, buffer(nullptr)
+	, cursor(0)
+{
+}
+
+LogFileWriter::~LogFileWriter() noexcept { Close(); }
+
+bool LogFileWriter::Open(StaticString filePath, size_t inMaxFileSize, uint32_t inNumBackups) noexcept
+{
+	Close();
+
+	path = filePath;
+	maxFileSize = inMaxFileSize;
+	numBackups = inNumBackups;
+
+	buffer = static_cast<char*>(OS::VirtualAlloc(BufferSize));
+	if (unlikely(!OS::IsValidAllocation(buffer)))
+	{
+		buffer = nullptr;
+		return false;
+	}
+
+	return OpenFile();
+}
+
+void LogFileWriter::Close() noexcept
+{
+	if (IsOpen())
+	{
+		Write(std::string_view());
+		OS::Close(std::move(handle));
+	}
+
+	if (buffer != nullptr)
+	{
+		OS::VirtualFree(buffer, BufferSize);
+		buffer = nullptr;
+	}
+
+	cursor = 0;
+}
+
+void LogFileWriter::Append(std::string_view text) noexcept
+{
+	returnIf(!IsOpen());
+
+	if (likely(cursor + text.length() <= BufferSize))
+	{
+		memcpy(&buffer[cursor], text.data(), text.length());
+		cursor += text.length();
+
+		return;
+	}
+
+	Write(text);
+}
+
+void LogFileWriter::Flush() noexcept
+{
+	returnIf(!IsOpen());
+
+	Write(std::string_view());
+
+	if (maxFileSize > 0 && fileSize >= maxFileSize)
+	{
+		Rotate();
+	}
+}
+
+StaticString LogFileWriter::GetBackupPath(StaticString filePath, uint32_t index) noexcept
+{
+	InlineStringBuilder<Config::MaxPathLength> str;
+	str << filePath.c_str() << '.' << index;
+
+	return StaticString(str.c_str());
+}
+
+bool LogFileWriter::OpenFile() noexcept
+{
+	OS::FileOpenMode openMode;
+	openMode.SetWriteOnly();
+	openMode.SetCreate();
+	openMode.SetTruncate();
+
+	fileSize = 0;
+
+	return OS::Open(handle, path, openMode);
+}
+
+void LogFileWriter::Write(std::string_view text) noexcept
+{
+	OS::IOVector vectors[] = {{buffer, cursor}, {const_cast<char*>(text.data()), text.length()}};
+	cursor = 0;
+
+	OS::IOVector* begin = vectors;
+	OS::IOVector* end = vectors + std::size(vectors);
+
+	while (begin != end)
+	{
+		if (begin->size == 0)
+		{
+			++begin;
+			continue;
+		}
+
+		// The rest is dropped if it fails, so the logger doesn't get stuck.
+		auto written = OS::WriteV(handle, begin, end - begin);
+		returnIf(written == 0);
+
+		fileSize += written;
+
+		for (; begin != end && written >= begin->size; ++begin)
+		{
+			written -= begin->size;
+		}
+
+		if (begin != end)
+		{
+			begin->data = static_cast<char*>(begin->data) + written;
+			begin->size -= written;
+		}
+	}
+}
+
+void LogFileWriter::Rotate() noexcept
+{
+	OS::Close(std::move(handle));
+
+	if (numBackups > 0)
+	{
+		OS::Delete(GetBackupPath(path, numBackups));
+
+		for (auto index = numBackups - 1; index > 0; --index)
+		{
+			auto from = GetBackupPath(path, index);
+			continueIf(!OS::Exist(from));
+
+			OS::Rename(from, GetBackupPath(path, index + 1));
+		}
+
+		OS::Rename(path, GetBackupPath(path, 1));
+	}
+
+	OpenFile();
+}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <fstream>
+#include "Core/ScopedTime.h"
+#include "HSTL/HString.h"
+#include "HSTL/HVector.h"
+#include "OSAL/OSFileHandle.h"
+
+namespace hbe
+{
+
+void LogFileWriterTest::Prepare()
+{
+	// A line as Logger prints it.
+	auto buildLine = [](auto& outLine, size_t index)
+	{
+		InlineStringBuilder<128> text;
+		text << "[0:1:23.456][Main][LogFileWriterTest][Info] Line " << index << " of the benchmark, " << 0.5;
+
+		outLine.append(text.c_str(), text.Size());
+	};
+
+	AddTest("Large Text", [this](auto& ls)
+	{
+		static const StaticString path("LogFileWriterTest.log");
+
+		HString expected;
+		{
+			LogFileWriter writer;
+			if (!writer.Open(path, 0, 0))
+			{
+				ls << "Failed to open " << path << lferr;
+				return;
+			}
+
+			// Short text is buffered, and longer than the buffer is written with it.
+			HString large(LogFileWriter::BufferSize + 100, 'x');
+			for (auto text : {HString("Head\n"), large, HString("\n"), HString("Tail\n")})
+			{
+				writer.Append(text);
+				expected.append(text);
+			}
+
+			writer.Flush();
+
+			if (writer.GetFileSize() != expected.size())
+			{
+				ls << writer.GetFileSize() << " bytes are written, but " << expected.size() << " expected." << lferr;
+			}
+		}
+
+		std::ifstream file(path.c_str(), std::ios::binary);
+		std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		file.close();
+
+		if (content != std::string_view(expected))
+		{
+			ls << "The file has " << content.size() << " bytes different from the text appended." << lferr;
+		}
+
+		OS::Delete(path);
+	});
+
+	AddTest("Rotation", [this, buildLine](auto& ls)
+	{
+		static const StaticString path("LogFileWriterRotationTest.log");
+		constexpr size_t MaxFileSize = 4096;
+		constexpr uint32_t NumBackups = 2;
+
+		size_t maxBatchSize = 0;
+		{
+			LogFileWriter writer;
+			if (!writer.Open(path, MaxFileSize, NumBackups))
+			{
+				ls << "Failed to open " << path << lferr;
+				return;
+			}
+
+			HString batch;
+			for (size_t i = 0; i < 1000; ++i)
+			{
+				buildLine(batch, i);
+				batch.push_back('\n');
+				continueIf(i % 10 != 9);
+
+				writer.Append(batch);
+				writer.Flush();
+
+				maxBatchSize = std::max(maxBatchSize, batch.size());
+				batch.clear();
+			}
+		}
+
+		for (uint32_t index = 0; index <= NumBackups; ++index)
+		{
+			auto filePath = index == 0 ? path : LogFileWriter::GetBackupPath(path, index);
+
+			OS::FileHandle handle;
+			OS::FileOpenMode openMode;
+			openMode.SetReadOnly();
+
+			if (!OS::Open(handle, filePath, openMode))
+			{
+				ls << filePath << " should be kept." << lferr;
+				continue;
+			}
+
+			const auto size = handle.GetFileSize();
+			if (size >= MaxFileSize + maxBatchSize)
+			{
+				ls << filePath << " has " << size << " bytes over the max file size " << MaxFileSize << lferr;
+			}
+
+			OS::Close(std::move(handle));
+			OS::Delete(filePath);
+		}
+
+		auto removed = LogFileWriter::GetBackupPath(path, NumBackups + 1);
+		if (OS::Exist(removed))
+		{
+			ls << removed << " should be deleted." << lferr;
+			OS::Delete(removed);
+		}
+	});
+
+	AddTest("Throughput", [this, buildLine](auto& ls)
+	{
+		static const StaticString path("LogFileWriterThroughputTest.log");
+		constexpr size_t NumLines = 2000000;
+		constexpr size_t BatchSize = 1000;
+
+		// The former output, a string per line written by std::endl, which flushes every line.
+		time::TDuration streamTime;
+		{
+			time::ScopedTime timer(streamTime);
+
+			std::ofstream ofs(path.c_str());
+			HVector<HString> lines;
+			lines.reserve(BatchSize);
+
+			for (size_t i = 0; i < NumLines; ++i)
+			{
+				HString line;
+				buildLine(line, i);
+				lines.push_back(std::move(line));
+				continueIf(lines.size() < BatchSize);
+
+				for (auto& text : lines)
+				{
+					ofs << text << std::endl;
+				}
+
+				ofs.flush();
+				lines.clear();
+			}
+		}
+
+		OS::Delete(path);
+
+		time::TDuration writerTime;
+		size_t fileSize = 0;
+		{
+			time::ScopedTime timer(writerTime);
+
+			LogFileWriter writer;
+			writer.Open(path, 0, 0);
+
+			HString batch;
+			for (size_t i = 0; i < NumLines; ++i)
+			{
+				buildLine(batch, i);
+				batch.push_back('\n');
+				continueIf((i + 1) % BatchSize != 0);
+
+				writer.Append(batch);
+				writer.Flush();
+				batch.clear();
+			}
+
+			fileSize = writer.GetFileSize();
+		}
+
+		OS::Delete(path);
+
+		const auto streamSec = time::ToFloat(streamTime);
+		const auto writerSec = time::ToFloat(writerTime);
+
+		ls << NumLines << " lines (" << (fileSize / (1024 * 1024)) << " MB), std::endl per line " << streamSec
+		   << " sec, LogFileWriter " << writerSec << " sec (" << (NumLines / writerSec) << " lines/sec)" << lf;
+
+		if (writerSec > streamSec)
+		{
+			ls << "LogFileWriter is slower than writing with std::endl per line." << lfwarn;
+		}
+	});
+}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
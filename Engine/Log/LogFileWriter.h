@@ -0,0 +1,77 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "OSAL/OSFileHandle.h"
+#include "String/StaticString.h"
+
+namespace hbe
+{
+
+/// @brief Appends text to a log file through a large page-aligned buffer.
+/// @details Short text is copied into the buffer, which is written by Flush(), or when it gets full. Text which
+/// doesn't fit is written together with the buffered one by a vectored write, without being copied.
+/// The file is rotated by Flush() when it has grown to the max file size, so a file can be larger by the text
+/// appended since the last flush. The older files are kept as path.1 ... path.N.
+class LogFileWriter final
+{
+public:
+	static constexpr size_t BufferSize = 1024 * 1024;
+
+private:
+	StaticString path;
+	OS::FileHandle handle;
+	size_t fileSize;
+	size_t maxFileSize;
+	uint32_t numBackups;
+
+	char* buffer;
+	size_t cursor;
+
+public:
+	LogFileWriter() noexcept;
+	~LogFileWriter() noexcept;
+
+	LogFileWriter(const LogFileWriter&) = delete;
+	LogFileWriter& operator=(const LogFileWriter&) = delete;
+
+	// maxFileSize 0 never rotates the file.
+	bool Open(StaticString filePath, size_t maxFileSize, uint32_t numBackups) noexcept;
+	void Close() noexcept;
+	[[nodiscard]] bool IsOpen() const noexcept { return handle.IsValid(); }
+
+	void Append(std::string_view text) noexcept;
+	void Flush() noexcept;
+
+	[[nodiscard]] size_t GetFileSize() const noexcept { return fileSize; }
+	[[nodiscard]] static StaticString GetBackupPath(StaticString filePath, uint32_t index) noexcept;
+
+private:
+	bool OpenFile() noexcept;
+	// Write the buffered text followed by the given one.
+	void Write(std::string_view text) noexcept;
+	void Rotate() noexcept;
+};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+class LogFileWriterTest : public TestCollection
+{
+public:
+	LogFileWriterTest() : TestCollection("LogFileWriterTest") {}
+
+protected:
+	void Prepare() override;
+};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
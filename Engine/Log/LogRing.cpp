@@ -0,0 +1,269 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "LogRing.h"
+
+#include <bit>
+#include <new>
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "Memory/MemoryManager.h"
+#include "OSAL/OSMemory.h"
+
+
+namespace hbe
+{
+
+LogRing::LogRing(size_t capacity)
+	: buffer(nullptr)
+	, capacity(capacity)
+	, writePos(0)
+	, isOwned(false)
+	, readPos(0)
+{
+	FatalAssert(std::has_single_bit(capacity), "The capacity of LogRing should be a power of 2, but %zu.", capacity);
+
+	buffer = static_cast<uint8_t*>(MemoryManager::GetInstance().SysAllocate(capacity));
+	FatalAssert(OS::CheckAligned(buffer, alignof(LogRecord)));
+}
+
+LogRing::~LogRing()
+{
+	Assert(readPos.load() == writePos.load(), "LogRing is destroyed with unread records.");
+
+	MemoryManager::GetInstance().SysDeallocate(buffer, capacity);
+	buffer = nullptr;
+}
+
+bool LogRing::TryOwn() noexcept
+{
+	bool expected = false;
+	return isOwned.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+void LogRing::Release() noexcept
+{
+	isOwned.store(false, std::memory_order_release);
+}
+
+LogRecord* LogRing::Reserve(size_t maxTextLength, ELogLevel level, StaticString threadName,
+	StaticString category, StaticStringID format) noexcept
+{
+	const auto maxSize = GetRecordSize(maxTextLength);
+	Assert(maxSize <= capacity / 2, "A log record of %zu bytes is too large for the ring of %zu bytes.", maxSize,
+		capacity);
+
+	auto write = writePos.load(std::memory_order_relaxed);
+	const auto read = readPos.load(std::memory_order_acquire);
+	const auto freeSize = capacity - (write - read);
+
+	const auto offset = write & (capacity - 1);
+	const auto tailSize = capacity - offset;
+
+	if (tailSize < maxSize)
+	{
+		returnValueIf(nullptr, freeSize < tailSize + maxSize);
+
+		// Skip the tail, so the text is contiguous.
+		auto* padding = reinterpret_cast<LogRecord*>(&buffer[offset]);
+		padding->size = static_cast<uint32_t>(tailSize);
+		padding->level = ELogLevel::MAX;
+
+		write += tailSize;
+		writePos.store(write, std::memory_order_release);
+	}
+	else
+	{
+		returnValueIf(nullptr, freeSize < maxSize);
+	}
+
+	auto* ptr = &buffer[write & (capacity - 1)];
+	return new (ptr) LogRecord{0, level, 0, std::chrono::steady_clock::now(), threadName, category, format};
+}
+
+void LogRing::Commit(LogRecord& record, size_t textLength) noexcept
+{
+	const auto size = GetRecordSize(textLength);
+	record.size = static_cast<uint32_t>(size);
+	record.textLength = static_cast<uint32_t>(textLength);
+	record.GetText()[textLength] = '\0';
+
+	const auto write = writePos.load(std::memory_order_relaxed);
+	Assert(reinterpret_cast<uint8_t*>(&record) == &buffer[write & (capacity - 1)]);
+
+	writePos.store(write + size, std::memory_order_release);
+}
+
+size_t LogRing::GetRecordSize(size_t textLength) noexcept
+{
+	return OS::GetAligned(sizeof(LogRecord) + textLength + 1, alignof(LogRecord));
+}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <cstring>
+#include <thread>
+#include "Core/ScopedTime.h"
+#include "String/BufferStringBuilder.h"
+
+namespace hbe
+{
+
+void LogRingTest::Prepare()
+{
+	AddTest("Wrap Around", [this](auto& ls)
+	{
+		constexpr size_t Capacity = 4096;
+		constexpr size_t MaxTextLength = 200;
+
+		LogRing ring(Capacity);
+		if (!ring.TryOwn() || ring.TryOwn())
+		{
+			ls << "Only one producer should own the ring." << lferr;
+		}
+
+		// Write and read enough records to go around the ring several times.
+		uint32_t expected = 0;
+		for (uint32_t i = 0; i < 1000; ++i)
+		{
+			auto* record = ring.Reserve(MaxTextLength, ELogLevel::Info, StaticString("Producer"), StaticString("Ring"));
+			if (record == nullptr)
+			{
+				ls << "There should be room after reading everything." << lferr;
+				return;
+			}
+
+			BufferStringBuilder text(record->GetText(), MaxTextLength + 1);
+			text << "Record " << i;
+			ring.Commit(*record, text.Size());
+
+			if (i % 7 != 6)
+			{
+				continue;
+			}
+
+			const auto end = ring.GetWritePos();
+			bool isValid = true;
+
+			ring.Visit(end, [&](const LogRecord& read)
+			{
+				char buffer[64];
+				BufferStringBuilder expectedText(buffer, sizeof(buffer));
+				expectedText << "Record " << expected++;
+
+				isValid = isValid && strcmp(read.GetText(), expectedText.c_str()) == 0 && read.level == ELogLevel::Info;
+			});
+
+			ring.EndRead(end);
+
+			if (!isValid)
+			{
+				ls << "Records have been corrupted before " << expected << lferr;
+				return;
+			}
+		}
+
+		const auto end = ring.GetWritePos();
+		ring.Visit(end, [&](const LogRecord&) { ++expected; });
+		ring.EndRead(end);
+
+		if (expected != 1000)
+		{
+			ls << expected << " records have been read, but 1000 expected." << lferr;
+		}
+	});
+
+	AddTest("Full Ring", [this](auto& ls)
+	{
+		constexpr size_t Capacity = 1024;
+		constexpr size_t MaxTextLength = 256;
+
+		LogRing ring(Capacity);
+
+		size_t count = 0;
+		while (auto* record = ring.Reserve(MaxTextLength, ELogLevel::Info, StaticString(), StaticString()))
+		{
+			ring.Commit(*record, 0);
+			++count;
+
+			if (count > Capacity)
+			{
+				ls << "The ring never gets full." << lferr;
+				return;
+			}
+		}
+
+		const auto expected = (Capacity - LogRing::GetRecordSize(MaxTextLength)) / LogRing::GetRecordSize(0) + 1;
+		if (count != expected)
+		{
+			ls << count << " records have been written, but " << expected << " expected." << lferr;
+		}
+
+		ring.EndRead(ring.GetWritePos());
+	});
+
+	AddTest("Single Producer & Consumer", [this](auto& ls)
+	{
+		constexpr size_t NumRecords = 200000;
+		constexpr size_t MaxTextLength = 100;
+
+		LogRing ring(64 * 1024);
+		std::atomic<bool> isDone = false;
+		size_t numWaits = 0;
+
+		std::thread producer([&]()
+		{
+			for (size_t i = 0; i < NumRecords; ++i)
+			{
+				LogRecord* record = nullptr;
+				while ((record = ring.Reserve(MaxTextLength, ELogLevel::Verbose, StaticString(), StaticString()))
+					== nullptr)
+				{
+					++numWaits;
+					std::this_thread::yield();
+				}
+
+				BufferStringBuilder text(record->GetText(), MaxTextLength + 1);
+				text << i;
+				ring.Commit(*record, text.Size());
+			}
+
+			isDone = true;
+		});
+
+		size_t expected = 0;
+		bool isValid = true;
+
+		time::TDuration duration;
+		{
+			time::ScopedTime timer(duration);
+
+			while (!isDone.load() || ring.GetReadPos() != ring.GetWritePos())
+			{
+				const auto end = ring.GetWritePos();
+				ring.Visit(end, [&](const LogRecord& record)
+				{
+					isValid = isValid && static_cast<size_t>(atoll(record.GetText())) == expected;
+					++expected;
+				});
+
+				ring.EndRead(end);
+				std::this_thread::yield();
+			}
+		}
+
+		producer.join();
+
+		if (!isValid || expected != NumRecords)
+		{
+			ls << "Read " << expected << " / " << NumRecords << " records in order." << lferr;
+			return;
+		}
+
+		ls << NumRecords << " records in " << time::ToFloat(duration) << " sec, the producer waited " << numWaits
+		   << " times." << lf;
+	});
+}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,112 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Config/EngineConfig.h"
+#include "LogLevel.h"
+#include "String/StaticString.h"
+
+namespace hbe
+{
+
+/// @brief Header of a log record in a LogRing, followed by its zero-terminated text, or the arguments of its format.
+struct LogRecord final
+{
+	using TTimePoint = std::chrono::time_point<std::chrono::steady_clock>;
+
+	// Bytes of the record including the text, a multiple of alignof(LogRecord).
+	uint32_t size;
+	// MAX for the padding which skips the end of the ring.
+	ELogLevel level;
+	uint32_t textLength;
+	TTimePoint timeStamp;
+	StaticString threadName;
+	StaticString category;
+	// Null for a text record. Otherwise, textLength is the bytes of the arguments encoded by LogArgs.
+	StaticStringID format;
+
+	[[nodiscard]] bool IsBinary() const noexcept { return format.ptr != nullptr; }
+
+	[[nodiscard]] char* GetText() noexcept { return reinterpret_cast<char*>(this + 1); }
+	[[nodiscard]] const char* GetText() const noexcept { return reinterpret_cast<const char*>(this + 1); }
+	[[nodiscard]] uint8_t* GetArgs() noexcept { return reinterpret_cast<uint8_t*>(this + 1); }
+	[[nodiscard]] const uint8_t* GetArgs() const noexcept { return reinterpret_cast<const uint8_t*>(this + 1); }
+};
+
+/// @brief Single-producer, single-consumer ring buffer of variable-length log records.
+/// @details The producer reserves room for the longest text, writes the text in place, and commits the actual
+/// length. A record never wraps around the end of the buffer; the tail is skipped by a padding record instead.
+/// The consumer reads the committed records and frees them at once. A thread owns the ring to produce into it,
+/// and another thread can take it over after it's released.
+class LogRing final
+{
+private:
+	uint8_t* buffer;
+	size_t capacity;
+
+	alignas(Config::CacheLineSize) std::atomic<uint64_t> writePos;
+	std::atomic<bool> isOwned;
+	alignas(Config::CacheLineSize) std::atomic<uint64_t> readPos;
+
+public:
+	explicit LogRing(size_t capacity);
+	~LogRing();
+
+	LogRing(const LogRing&) = delete;
+	LogRing& operator=(const LogRing&) = delete;
+
+	[[nodiscard]] bool TryOwn() noexcept;
+	void Release() noexcept;
+
+	// Producer. Return nullptr if there's no room for a text of maxTextLength yet.
+	[[nodiscard]] LogRecord* Reserve(size_t maxTextLength, ELogLevel level, StaticString threadName,
+		StaticString category, StaticStringID format = StaticStringID()) noexcept;
+	void Commit(LogRecord& record, size_t textLength) noexcept;
+
+	// Consumer. Visit the records committed before end, which is taken by GetWritePos(), then free them by EndRead.
+	[[nodiscard]] uint64_t GetWritePos() const noexcept { return writePos.load(std::memory_order_acquire); }
+	[[nodiscard]] uint64_t GetReadPos() const noexcept { return readPos.load(std::memory_order_acquire); }
+
+	template<typename TFunc>
+	void Visit(uint64_t end, TFunc&& func) const noexcept
+	{
+		for (auto pos = readPos.load(std::memory_order_relaxed); pos < end;)
+		{
+			const auto* record = reinterpret_cast<const LogRecord*>(&buffer[pos & (capacity - 1)]);
+			if (record->level != ELogLevel::MAX)
+			{
+				func(*record);
+			}
+
+			pos += record->size;
+		}
+	}
+
+	void EndRead(uint64_t end) noexcept { readPos.store(end, std::memory_order_release); }
+
+	[[nodiscard]] static size_t GetRecordSize(size_t textLength) noexcept;
+};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+class LogRingTest : public TestCollection
+{
+public:
+	LogRingTest() : TestCollection("LogRingTest") {}
+
+protected:
+	void Prepare() override;
+};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
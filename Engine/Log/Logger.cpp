@@ -8,17 +8,22 @@
 #include "Config/BuildConfig.h"
 #include "Config/ConfigParam.h"
 #include "Config/EngineConfig.h"
+#include "BinaryLog.h"
 #include "Core/Debug.h"
 #include "Core/TaskSystem.h"
 #include "LogUtil.h"
 #include "Memory/AllocatorScope.h"
 #include "Memory/InlinePoolAllocator.h"
+#include "Memory/MemoryManager.h"
 #include "OSAL/Intrinsic.h"
+#include "String/InlineStringBuilder.h"
 #include "String/StringUtil.h"
 
 
 namespace hbe
 {
+static_assert(Logger::MaxTextLength == BinaryLog::MaxTextLength);
+
 namespace
 {
 #if LOG_FORCE_PRINT_IMMEDIATELY || LOG_BREAK_IF_WARNING || LOG_BREAK_IF_ERROR
@@ -36,45 +41,95 @@ namespace
 	}
 #endif // LOG_FORCE_IMMEDIATE
 
+	// Format on the stack, for the logs not going through the rings.
+	template<typename TFunc>
+	void FormatOnStack(const Logger::TLogFunction& logFunc, TFunc&& func)
+	{
+		char buffer[Logger::MaxTextLength + 1];
+		Logger::TLogStream ls(buffer, sizeof(buffer));
+		logFunc(ls);
+
+		func(ls);
+	}
+
 	void FallbackLog(StaticString category, ELogLevel level, const Logger::TLogFunction& logFunc)
 	{
 		auto& engine = Engine::Get();
 
-		Logger::TLogStream str;
-		str << '[' << category << "] ";
-		logFunc(str);
-
-		engine.Log(level, [&str](auto& ls) { ls << str.c_str(); });
+		FormatOnStack(logFunc, [&](auto& str)
+		{
+			engine.Log(level, [&](auto& ls) { ls << '[' << category << "] " << str.c_str(); });
+		});
 	}
 
+	struct ThreadRing final
+	{
+		const Logger* logger;
+		LogRing* ring;
+	};
+
+	thread_local ThreadRing CurrentRing = {nullptr, nullptr};
+	thread_local bool IsWritingRing = false;
+
 } // anonymous namespace
 
 Logger* Logger::instance = nullptr;
 
-Logger::SimpleLogger::SimpleLogger(StaticString category, ELogLevel level) noexcept : category(category), level(level) {}
+Logger::SimpleLogger::SimpleLogger(StaticString category, ELogLevel level) noexcept
+	: category(category)
+	, level(level)
+	, categoryIndex(LogCategory::Register(category))
+{
+}
 
-void Logger::SimpleLogger::Out(const TLogFunction& logFunc) const noexcept
+void Logger::SimpleLogger::Write(ELogLevel inLevel, const TLogFunction& logFunc) const noexcept
 {
 	if (unlikely(instance == nullptr))
 	{
-		FallbackLog(category, level, logFunc);
+		FallbackLog(category, inLevel, logFunc);
 
 		return;
 	}
 
-	instance->AddLog(category, level, logFunc);
+	instance->AddRecord(category, inLevel, logFunc);
 }
 
-void Logger::SimpleLogger::Out(ELogLevel inLevel, const TLogFunction& logFunc) const noexcept
+bool Logger::PassFilter(StaticString category, ELogLevel level) noexcept
+{
+	returnValueIf(true, unlikely(instance == nullptr));
+
+	std::lock_guard lock(instance->filterLock);
+
+	auto found = instance->filters.find(category);
+	returnValueIf(true, found == instance->filters.end() || found->second == nullptr);
+
+	return found->second(level);
+}
+
+void Logger::AddFormat(StaticString category, ELogLevel level, StaticString format, const EncodedArgs& args) noexcept
 {
 	if (unlikely(instance == nullptr))
 	{
-		FallbackLog(category, inLevel, logFunc);
+		FallbackLog(category, level, [&](auto& ls) { FormatText(ls, format, args); });
 
 		return;
 	}
 
-	instance->AddLog(category, inLevel, logFunc);
+	instance->AddFormatRecord(category, level, format, args);
+}
+
+void Logger::FormatText(TLogStream& ls, StaticString format, const EncodedArgs& args) noexcept
+{
+	AllocatorScope scope(MemoryManager::SystemAllocatorID);
+
+	HVector<uint8_t> encoded(args.size);
+	args.encode(encoded.data(), args.args);
+
+	HVector<char> text(MaxTextLength + 1);
+	const auto length = BinaryLog::Format(text.data(), text.size(), format.c_str(), encoded.data(), encoded.size(),
+		LogArgs::ResolveString);
+
+	ls << std::string_view(text.data(), length);
 }
 
 Logger& Logger::Get() noexcept
@@ -91,11 +146,15 @@ Logger::SimpleLogger Logger::Get(StaticString category, ELogLevel level) noexcep
 }
 
 Logger::Logger(Engine& engine, const char* path, const char* filename) noexcept
-	: allocator("LoggerMemoryPool"), inputAlloc("LoggerInputPool")
+	: allocator("LoggerMemoryPool")
 	, task("Logger", nullptr, this)
 	, hasInput(false)
-	, needFlush(false)
+	, rings{}
+	, numRings(0)
+	, sharedRing(Config::LogRingBufferSize)
 	, logPath(path)
+	, isBinary(false)
+	, binaryWriter(binaryFileStream, LogUtil::GetStartTime())
 {
 	Assert(engine.IsMemoryManagerReady());
 
@@ -104,15 +163,15 @@ Logger::Logger(Engine& engine, const char* path, const char* filename) noexcept
 
 	AllocatorScope scope(allocator);
 
-	{
-		AllocatorScope inputAllocScope(inputAlloc);
-		inputBuffer.reserve(16);
-		swapBuffer.reserve(16);
-	}
-
-	textBuffer.reserve(16);
+	records.reserve(16);
+	formatBuffer.resize(MaxTextLength + 1);
+	textBuffer.reserve(LogFileWriter::BufferSize);
 	filters.reserve(16);
 
+	static TAtomicConfigParam<uint8_t> CPLogLevel("Log.Level", "The Default Log Level",
+		static_cast<uint8_t>(ELogLevel::Info));
+	SetLevel(static_cast<ELogLevel>(CPLogLevel.Get()));
+
 	auto endChar = logPath[logPath.size() - 1];
 
 	{
@@ -134,10 +193,32 @@ Logger::Logger(Engine& engine, const char* path, const char* filename) noexcept
 	logPath.append(filename);
 	logPath.shrink_to_fit();
 
-	outFileStream.open(logPath.c_str());
+	static TAtomicConfigParam<bool> CPBinary("Log.Binary",
+		"Write the binary log, decoded by Tools/LogDecoder, instead of the text log", false);
+	isBinary = CPBinary.Get();
 
 	flushFuncs.reserve(2);
-	flushFuncs.emplace_back([this](const TTextBuffer& buffer) { WriteLog(buffer); });
+
+	if (isBinary)
+	{
+		TString binaryPath(logPath);
+		binaryPath.append(".bin");
+
+		binaryFileStream.open(binaryPath.c_str(), std::ios::binary);
+		binaryWriter.WriteHeader();
+	}
+	else
+	{
+		static TAtomicConfigParam<size_t> CPMaxFileSize("Log.MaxFileSize",
+			"The log file is rotated when it has grown to this size, or never if 0", 256 * 1024 * 1024);
+		static TAtomicConfigParam<int> CPNumBackupFiles("Log.NumBackupFiles", "How many rotated log files are kept",
+			3);
+
+		fileWriter.Open(StaticString(logPath.c_str()), CPMaxFileSize.Get(),
+			static_cast<uint32_t>(std::max(CPNumBackupFiles.Get(), 0)));
+		flushFuncs.emplace_back([this](const TTextBuffer& buffer) { WriteLog(buffer); });
+	}
+
 	flushFuncs.emplace_back([](const TTextBuffer& buffer) { PrintStdIO(buffer); });
 
 	engine.SetLoggerReady();
@@ -149,8 +230,18 @@ Logger::~Logger() noexcept
 
 	ProcessBuffer();
 
-	outFileStream.flush();
-	outFileStream.close();
+	fileWriter.Close();
+	binaryFileStream.close();
+
+	AllocatorScope scope(MemoryManager::SystemAllocatorID);
+	auto& mmgr = MemoryManager::GetInstance();
+
+	const auto count = numRings.exchange(0);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		mmgr.Delete(rings[i]);
+		rings[i] = nullptr;
+	}
 }
 
 StaticString Logger::GetName() noexcept
@@ -224,11 +315,19 @@ void Logger::StopTask(TaskSystem& taskSys)
 
 	ProcessBuffer();
 
-	outFileStream.flush();
-	outFileStream.close();
+	fileWriter.Close();
+	binaryFileStream.close();
 }
 
 void Logger::AddLog(StaticString category, ELogLevel level, const TLogFunction& logFunc) noexcept
+{
+	SimpleLogger log(category, level);
+	returnIf(!log.IsEnabled(level));
+
+	AddRecord(category, level, logFunc);
+}
+
+void Logger::AddRecord(StaticString category, ELogLevel level, const TLogFunction& logFunc) noexcept
 {
 	Assert(this == instance);
 
@@ -245,35 +344,12 @@ void Logger::AddLog(StaticString category, ELogLevel level, const TLogFunction&
 		return;
 	}
 
-	static TAtomicConfigParam<uint8_t> CPLogLevel("Log.Level", "The Default Log Level",
-												  static_cast<uint8_t>(ELogLevel::Info));
-
-	if (level < static_cast<ELogLevel>(CPLogLevel.Get()))
-	{
-		return;
-	}
-
-	{
-		std::lock_guard lock(filterLock);
-		auto found = filters.find(category);
-		if (found != filters.end())
-		{
-			auto& filter = found->second;
-			if (filter != nullptr && !filter(level)) return;
-		}
-	}
-
-	auto& engine = Engine::Get();
-	auto& taskSystem = engine.GetTaskSystem();
-	auto threadName = TaskSystem::GetCurrentStreamName();
-
-	TLogStream ls;
-	logFunc(ls);
+	const auto threadName = TaskSystem::GetCurrentStreamName();
 
 #if LOG_BREAK_IF_WARNING
 	if (unlikely(level >= ELogLevel::Warning))
 	{
-		ImmediateLog(level, category, ls.c_str());
+		FormatOnStack(logFunc, [&](auto& ls) { ImmediateLog(level, category, ls.c_str()); });
 		debugBreak();
 		return;
 	}
@@ -282,38 +358,40 @@ void Logger::AddLog(StaticString category, ELogLevel level, const TLogFunction&
 #if LOG_BREAK_IF_ERROR
 	if (unlikely(level >= ELogLevel::Error))
 	{
-		ImmediateLog(level, category, ls.c_str());
+		FormatOnStack(logFunc, [&](auto& ls) { ImmediateLog(level, category, ls.c_str()); });
 		debugBreak();
 		return;
 	}
 #endif // LOG_BREAK_IF_ERROR
 
 #if LOG_FORCE_PRINT_IMMEDIATELY
-	ImmediateLog(level, category, ls.c_str());
+	FormatOnStack(logFunc, [&](auto& ls) { ImmediateLog(level, category, ls.c_str()); });
 	return;
 #endif // LOG_FORCE_IMMEDIATE
 
 	if (unlikely(level >= ELogLevel::Error && std::this_thread::get_id() == threadID))
 	{
-		AllocatorScope memAllocScope(MemoryManager::SystemAllocatorID);
+		FormatOnStack(logFunc, [&](auto& ls)
+		{
+			AllocatorScope memAllocScope(MemoryManager::SystemAllocatorID);
 
-		thread_local TTextBuffer tmpTextBuffer;
-		tmpTextBuffer.reserve(1);
+			thread_local TTextBuffer tmpTextBuffer;
 
-		using namespace std;
-		InlineStringBuilder<64> timeStampStr;
-		LogUtil::GetTimeStampString(timeStampStr);
+			InlineStringBuilder<64> timeStampStr;
+			LogUtil::GetTimeStampString(timeStampStr);
 
-		auto levelStr = LogUtil::GetLogLevelString(level);
+			auto levelStr = LogUtil::GetLogLevelString(level);
 
-		InlineStringBuilder<Config::LogOutputBuffer + 128> text;
-		text << '[' << timeStampStr.c_str() << "][" << threadName << "][" << category << "][" << levelStr << "] "
-			 << ls.c_str();
+			InlineStringBuilder<Config::LogOutputBuffer + 128> text;
+			text << '[' << timeStampStr.c_str() << "][" << threadName << "][" << category << "][" << levelStr << "] "
+				 << ls.c_str();
 
-		tmpTextBuffer.emplace_back(text.c_str());
+			tmpTextBuffer.append(text.c_str(), text.Size()).push_back('\n');
 
-		FlushBuffer(tmpTextBuffer);
-		tmpTextBuffer.clear();
+			FlushBuffer(tmpTextBuffer);
+			tmpTextBuffer.clear();
+			fileWriter.Flush();
+		});
 
 		if (unlikely(level >= ELogLevel::FatalError))
 		{
@@ -323,18 +401,200 @@ void Logger::AddLog(StaticString category, ELogLevel level, const TLogFunction&
 		return;
 	}
 
-	size_t bufferSize = 0;
+	// A log function may log again. The nested one can't use the ring, as the outer one is being written into it.
+	auto* ring = IsWritingRing ? nullptr : AcquireRing();
+	if (likely(ring != nullptr))
+	{
+		WriteToRing(*ring, threadName, category, level, logFunc);
+	}
+	else
+	{
+		WriteToSharedRing(threadName, category, level, logFunc);
+	}
+}
+
+bool Logger::IsImmediate(ELogLevel level) const noexcept
+{
+#if LOG_FORCE_PRINT_IMMEDIATELY
+	return true;
+#endif // LOG_FORCE_PRINT_IMMEDIATELY
+
+#if LOG_BREAK_IF_WARNING
+	returnValueIf(true, level >= ELogLevel::Warning);
+#endif // LOG_BREAK_IF_WARNING
+
+#if LOG_BREAK_IF_ERROR
+	returnValueIf(true, level >= ELogLevel::Error);
+#endif // LOG_BREAK_IF_ERROR
+
+	return level >= ELogLevel::Error && std::this_thread::get_id() == threadID;
+}
+
+void Logger::AddFormatRecord(StaticString category, ELogLevel level, StaticString format,
+	const EncodedArgs& args) noexcept
+{
+	Assert(this == instance);
+
+	AllocatorScope scope(InvalidAllocatorID);
+
+	// The logs printed at once and the nested ones are formatted here, and go the same way as text logs.
+	auto* ring = IsWritingRing || IsImmediate(level) ? nullptr : AcquireRing();
+	if (unlikely(ring == nullptr))
+	{
+		AddRecord(category, level, [&](auto& ls) { FormatText(ls, format, args); });
+
+		return;
+	}
+
+	auto* record = Reserve(*ring, TaskSystem::GetCurrentStreamName(), category, level, args.size, format.GetID());
+	returnIf(record == nullptr);
+
+	args.encode(record->GetArgs(), args.args);
+	ring->Commit(*record, args.size);
+
+	Publish(level);
+}
+
+LogRing* Logger::AcquireRing() noexcept
+{
+	if (likely(CurrentRing.logger == this))
+	{
+		return CurrentRing.ring;
+	}
+
+	// Release the ring when the thread exits, so another thread can take it over.
+	struct RingOwner final
+	{
+		~RingOwner()
+		{
+			if (CurrentRing.ring != nullptr && CurrentRing.logger == instance)
+			{
+				CurrentRing.ring->Release();
+			}
+
+			CurrentRing = {nullptr, nullptr};
+		}
+	};
+
+	thread_local RingOwner owner;
+	(void) owner;
+
+	LogRing* ring = nullptr;
+
+	auto tryOwn = [this](uint32_t count) -> LogRing*
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			returnValueIf(rings[i], rings[i]->TryOwn());
+		}
+
+		return nullptr;
+	};
 
+	ring = tryOwn(numRings.load(std::memory_order_acquire));
+
+	if (ring == nullptr)
 	{
-		std::lock_guard lock(inputLock);
-		AllocatorScope inputAllocScope(inputAlloc);
-		inputBuffer.emplace_back(level, threadName, category, ls.c_str(), ls.Size());
+		std::lock_guard lock(ringLock);
+
+		const auto count = numRings.load(std::memory_order_relaxed);
+		ring = tryOwn(count);
 
-		bufferSize = inputBuffer.size();
-		hasInput.store(true, std::memory_order_release);
-		needFlush.store(true, std::memory_order_release);
+		if (ring == nullptr && count < Config::MaxLogRings)
+		{
+			AllocatorScope scope(MemoryManager::SystemAllocatorID);
+			ring = MemoryManager::GetInstance().New<LogRing>(Config::LogRingBufferSize);
+
+			const bool isOwned = ring->TryOwn();
+			Assert(isOwned);
+
+			rings[count] = ring;
+			numRings.store(count + 1, std::memory_order_release);
+		}
 	}
 
+	// The ring is null if all rings are taken, and then the thread uses the shared ring.
+	CurrentRing = {this, ring};
+
+	return ring;
+}
+
+void Logger::WriteToRing(LogRing& ring, StaticString threadName, StaticString category, ELogLevel level,
+	const TLogFunction& logFunc) noexcept
+{
+	auto* record = Reserve(ring, threadName, category, level, MaxTextLength, StaticStringID());
+	returnIf(record == nullptr);
+
+	IsWritingRing = true;
+
+	TLogStream ls(record->GetText(), MaxTextLength + 1);
+	logFunc(ls);
+
+	IsWritingRing = false;
+
+	ring.Commit(*record, ls.Size());
+	Publish(level);
+}
+
+void Logger::WriteToSharedRing(StaticString threadName, StaticString category, ELogLevel level,
+	const TLogFunction& logFunc) noexcept
+{
+	FormatOnStack(logFunc, [&](auto& ls)
+	{
+		{
+			std::lock_guard lock(sharedRingLock);
+
+			auto* record = Reserve(sharedRing, threadName, category, level, MaxTextLength, StaticStringID());
+			returnIf(record == nullptr);
+
+			std::copy_n(ls.c_str(), ls.Size(), record->GetText());
+			sharedRing.Commit(*record, ls.Size());
+		}
+
+		Publish(level);
+	});
+}
+
+LogRecord* Logger::Reserve(LogRing& ring, StaticString threadName, StaticString category, ELogLevel level,
+	size_t maxTextLength, StaticStringID format) noexcept
+{
+	auto* record = ring.Reserve(maxTextLength, level, threadName, category, format);
+	returnValueIf(record, likely(record != nullptr));
+
+	static TAtomicConfigParam<int> CPRingWaitMs("Log.RingWaitMs",
+		"How long a thread waits for the log ring to be drained before dropping the log", 100);
+
+	auto& statistics = Engine::Get().GetStatistics();
+	statistics.IncLogBackpressureCount();
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CPRingWaitMs.Get());
+
+	do
+	{
+		// Nobody else drains the rings if the logger task isn't running, or this is the IO thread.
+		if (std::this_thread::get_id() == threadID || !isRunning.load(std::memory_order_acquire))
+		{
+			ProcessBuffer();
+		}
+		else
+		{
+			Engine::Get().GetTaskSystem().GetIOTaskStream().WakeUp();
+			std::this_thread::yield();
+		}
+
+		record = ring.Reserve(maxTextLength, level, threadName, category, format);
+		returnValueIf(record, record != nullptr);
+	} while (std::chrono::steady_clock::now() < deadline);
+
+	statistics.IncLogDropCount();
+
+	return nullptr;
+}
+
+void Logger::Publish(ELogLevel level) noexcept
+{
+	const bool hadInput = hasInput.exchange(true, std::memory_order_acq_rel);
+
 	if (unlikely(level >= ELogLevel::FatalError))
 	{
 		Flush();
@@ -344,35 +604,59 @@ void Logger::AddLog(StaticString category, ELogLevel level, const TLogFunction&
 		return;
 	}
 
-	auto& ioStream = taskSystem.GetIOTaskStream();
+	// The IO thread has been woken up already for the logs it hasn't taken yet.
+	returnIf(hadInput);
+
+	auto& ioStream = Engine::Get().GetTaskSystem().GetIOTaskStream();
 	ioStream.WakeUp();
+}
 
-	if (bufferSize >= Config::LogForceFlushThreshold)
-	{
-		Flush();
-	}
+void Logger::SetLevel(ELogLevel level) noexcept { LogCategory::SetDefaultLevel(level); }
+
+void Logger::SetLevel(StaticString category, ELogLevel level) noexcept
+{
+	LogCategory::SetLevel(LogCategory::Register(category), level);
 }
 
+void Logger::ResetLevel(StaticString category) noexcept { LogCategory::ResetLevel(LogCategory::Register(category)); }
+
 void Logger::SetFilter(StaticString category, TLogFilter&& filter) noexcept
 {
-	std::lock_guard lock(filterLock);
-	filters[category] = std::move(filter);
+	const bool hasFilter = filter != nullptr;
+
+	{
+		std::lock_guard lock(filterLock);
+		filters[category] = std::move(filter);
+	}
+
+	LogCategory::SetHasFilter(LogCategory::Register(category), hasFilter);
 }
 
 void Logger::Flush() noexcept
 {
-	if (std::this_thread::get_id() == threadID)
+	if (std::this_thread::get_id() == threadID || !isRunning.load(std::memory_order_acquire))
 	{
 		ProcessBuffer();
 
 		return;
 	}
 
-	constexpr auto period = std::chrono::milliseconds(10);
-	while (needFlush.load(std::memory_order_relaxed))
+	// Wait until the records written so far are printed.
+	std::array<uint64_t, Config::MaxLogRings + 1> writePositions;
+	size_t index = 0;
+	ForEachRing([&](LogRing& ring) { writePositions[index++] = ring.GetWritePos(); });
+
+	constexpr auto period = std::chrono::milliseconds(1);
+	index = 0;
+
+	ForEachRing([&](LogRing& ring)
 	{
-		std::this_thread::sleep_for(period);
-	}
+		const auto writePos = writePositions[index++];
+		while (ring.GetReadPos() < writePos && isRunning.load(std::memory_order_acquire))
+		{
+			std::this_thread::sleep_for(period);
+		}
+	});
 }
 
 #if PROFILE_ENABLED
@@ -381,53 +665,102 @@ void Logger::ReportMemoryConfiguration() { allocator.ReportConfiguration(); }
 
 void Logger::ProcessBuffer() noexcept
 {
-	if (!hasInput.load(std::memory_order_acquire)) return;
+	std::lock_guard lock(processLock);
+
+	returnIf(!hasInput.exchange(false, std::memory_order_acquire));
 
 	AllocatorScope scope(allocator);
 
+	// Take the records committed so far in all rings, and print them in time order.
+	std::array<uint64_t, Config::MaxLogRings + 1> ends;
+	size_t index = 0;
+
+	records.clear();
+	ForEachRing([&](LogRing& ring)
 	{
-		std::lock_guard lockInput(inputLock);
-		std::swap(inputBuffer, swapBuffer);
-		hasInput.store(false, std::memory_order_release);
-	}
+		const auto end = ring.GetWritePos();
+		ring.Visit(end, [this](const LogRecord& record) { records.push_back(&record); });
+
+		ends[index++] = end;
+	});
 
-	if (swapBuffer.empty()) return;
+	std::stable_sort(records.begin(), records.end(),
+		[](const LogRecord* lhs, const LogRecord* rhs) { return lhs->timeStamp < rhs->timeStamp; });
 
-	bool needIOFlush = false;
-	textBuffer.reserve(swapBuffer.size());
+	const BinaryLog::TStringResolver resolver = LogArgs::ResolveString;
 
-	for (auto& log : swapBuffer)
+	for (auto* log : records)
 	{
-		if (log.level >= ELogLevel::Warning)
+#if PROFILE_ENABLED
 		{
-			needIOFlush = true;
+			auto& stat = Engine::Get().GetStatistics();
+			stat.IncLogCount();
+
+			if (log->textLength >= Config::LogLineLength - 1)
+			{
+				stat.IncLongLogCount();
+			}
+		}
+#endif // PROFILE_ENABLED
+
+		// The binary log has all records, and only the warnings and errors are printed.
+		if (isBinary)
+		{
+			binaryWriter.Write(*log);
+			continueIf(log->level < ELogLevel::Warning);
 		}
 
 		InlineStringBuilder<64> timeStampStr;
-		LogUtil::GetTimeStampString(timeStampStr, log.timeStamp);
-		auto levelStr = LogUtil::GetLogLevelString(log.level);
+		LogUtil::GetTimeStampString(timeStampStr, log->timeStamp);
+		auto levelStr = LogUtil::GetLogLevelString(log->level);
 
-		using namespace hbe;
-		InlineStringBuilder<Config::LogLineLength * 2> text;
+		auto& text = textBuffer;
+		text.append("[").append(timeStampStr.c_str()).append("][").append(log->threadName.c_str()).append("][");
+		text.append(log->category.c_str()).append("][").append(levelStr.c_str()).append("] ");
+
+		if (log->IsBinary())
+		{
+			const auto length = BinaryLog::Format(formatBuffer.data(), formatBuffer.size(),
+				StaticString(log->format).c_str(), log->GetArgs(), log->textLength, resolver);
+			text.append(formatBuffer.data(), length);
+		}
+		else
+		{
+			text.append(log->GetText(), log->textLength);
+		}
 
-		text << '[' << timeStampStr.c_str() << "][" << log.threadName << "][";
-		text << log.category << "][" << levelStr << "] ";
-		text << log.GetText();
+		text.push_back('\n');
 
-		textBuffer.emplace_back(text.c_str());
+		// Print a large batch in parts, so the buffer doesn't grow beyond the file writer's.
+		if (textBuffer.size() >= LogFileWriter::BufferSize)
+		{
+			FlushBuffer(textBuffer);
+			textBuffer.clear();
+		}
 	}
 
-	swapBuffer.clear();
+	index = 0;
+	ForEachRing([&](LogRing& ring) { ring.EndRead(ends[index++]); });
+
+	const bool hasRecords = !records.empty();
+	records.clear();
 
-	FlushBuffer(textBuffer);
-	textBuffer.clear();
+	returnIf(!hasRecords);
 
-	if (needIOFlush)
+	if (!textBuffer.empty())
 	{
-		outFileStream.flush();
+		FlushBuffer(textBuffer);
+		textBuffer.clear();
 	}
 
-	needFlush.store(false, std::memory_order_release);
+	if (isBinary)
+	{
+		binaryFileStream.flush();
+	}
+	else
+	{
+		fileWriter.Flush();
+	}
 }
 
 void Logger::FlushBuffer(const TTextBuffer& buffer) const noexcept
@@ -439,26 +772,8 @@ void Logger::FlushBuffer(const TTextBuffer& buffer) const noexcept
 	}
 }
 
-void Logger::WriteLog(const TTextBuffer& buffer) noexcept
-{
-	auto& ofs = outFileStream;
+void Logger::WriteLog(const TTextBuffer& buffer) noexcept { fileWriter.Append(buffer); }
 
-	for (auto& logText : buffer)
-	{
-		ofs << logText << std::endl;
-	}
-
-	ofs.flush();
-}
-
-void Logger::PrintStdIO(const TTextBuffer& buffer) noexcept
-{
-	auto& engine = Engine::Get();
-
-	for (auto& logText : buffer)
-	{
-		engine.ConsoleOutLn(logText.c_str());
-	}
-}
+void Logger::PrintStdIO(const TTextBuffer& buffer) noexcept { Engine::Get().ConsoleOut(buffer); }
 
 } // namespace hbe
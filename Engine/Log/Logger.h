@@ -2,18 +2,28 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <fstream>
+#include <string_view>
 #include <functional>
+#include <mutex>
 #include <thread>
+#include <tuple>
+#include "BinaryLogWriter.h"
+#include "Core/CommonMacros.h"
 #include "Core/Task.h"
 #include "HSTL/HString.h"
 #include "HSTL/HUnorderedMap.h"
 #include "HSTL/HVector.h"
+#include "LogArgs.h"
+#include "LogCategory.h"
+#include "LogFileWriter.h"
 #include "LogLevel.h"
-#include "LogLine.h"
+#include "LogRing.h"
 #include "Memory/MultiPoolAllocator.h"
-#include "Memory/ThreadSafeMultiPoolAllocator.h"
+#include "String/BufferStringBuilder.h"
 #include "String/InlineStringBuilder.h"
 #include "String/StaticString.h"
 
@@ -26,15 +36,19 @@ class TaskSystem;
 
 /// @brief Asynchronous, thread-safe logging system for the HardBop Engine.
 /// @details Runs on a dedicated IO thread to avoid blocking main application threads.
-/// Uses a producer-consumer pattern with thread-safe input buffer.
+/// Each thread writes its logs into its own LogRing without a lock, formatting the text in place, and the IO thread
+/// drains all rings in time order. When a ring is full, the thread waits for the IO thread up to Log.RingWaitMs,
+/// and then drops the log. Both are counted in SystemStatistics.
+/// OutFormat captures a static format and its arguments instead of the text, which is formatted by the IO thread, or
+/// by Tools/LogDecoder if Log.Binary writes the binary log.
 class Logger final
 {
 public:
 	using TString = hbe::HString;
-	using TLogBuffer = hbe::HVector<LogLine>;
-	using TTextBuffer = hbe::HVector<TString>;
+	// Lines of text, each followed by a new line.
+	using TTextBuffer = TString;
 	using TTimePoint = std::chrono::time_point<std::chrono::steady_clock>;
-	using TLogStream = InlineStringBuilder<Config::LogOutputBuffer>;
+	using TLogStream = BufferStringBuilder;
 	using TLogFunction = std::function<void(TLogStream&)>;
 	using TOutputFunc = std::function<void(const TTextBuffer&)>;
 	using TOutputFuncs = hbe::HVector<TOutputFunc>;
@@ -44,29 +58,75 @@ public:
 public:
 	/// @brief A lightweight logger wrapper that bundles category and default log level.
 	/// @details Simplifies logging by pre-setting category and level. Can be reused
-	/// across multiple log calls with the same settings.
+	/// across multiple log calls with the same settings. The category is resolved into its LogCategory index once,
+	/// so a rejected log costs a single relaxed load before the log function is even converted.
 	class SimpleLogger final
 	{
 	public:
 		const StaticString category;
 		const ELogLevel level;
+		const LogCategory::TIndex categoryIndex;
 
 		explicit SimpleLogger(StaticString category, ELogLevel level = ELogLevel::Info) noexcept;
-		void Out(const TLogFunction& logFunc) const noexcept;
-		void Out(ELogLevel level, const TLogFunction& logFunc) const noexcept;
 
-		void OutWarning(const TLogFunction& logFunc) const noexcept { Out(ELogLevel::Warning, logFunc); }
-		void OutError(const TLogFunction& logFunc) const noexcept { Out(ELogLevel::Error, logFunc); }
-		void OutFatalError(const TLogFunction& logFunc) const noexcept { Out(ELogLevel::FatalError, logFunc); }
+		[[nodiscard]] bool IsEnabled(ELogLevel inLevel) const noexcept
+		{
+			returnValueIf(false, !IsLogCompiledIn(inLevel));
+
+			const auto state = LogCategory::GetState(categoryIndex);
+			returnValueIf(false, static_cast<uint8_t>(inLevel) < (state & LogCategory::LevelMask));
+
+			return likely((state & LogCategory::HasFilter) == 0) || PassFilter(category, inLevel);
+		}
+
+		template<typename TFunc>
+		void Out(TFunc&& logFunc) const noexcept
+		{
+			Out(level, std::forward<TFunc>(logFunc));
+		}
+
+		template<typename TFunc>
+		void Out(ELogLevel inLevel, TFunc&& logFunc) const noexcept
+		{
+			returnIf(!IsEnabled(inLevel));
+			Write(inLevel, logFunc);
+		}
+
+		template<typename TFunc>
+		void OutWarning(TFunc&& logFunc) const noexcept
+		{
+			if constexpr (IsLogCompiledIn(ELogLevel::Warning))
+			{
+				Out(ELogLevel::Warning, std::forward<TFunc>(logFunc));
+			}
+		}
+
+		template<typename TFunc>
+		void OutError(TFunc&& logFunc) const noexcept
+		{
+			if constexpr (IsLogCompiledIn(ELogLevel::Error))
+			{
+				Out(ELogLevel::Error, std::forward<TFunc>(logFunc));
+			}
+		}
+
+		template<typename TFunc>
+		void OutFatalError(TFunc&& logFunc) const noexcept
+		{
+			if constexpr (IsLogCompiledIn(ELogLevel::FatalError))
+			{
+				Out(ELogLevel::FatalError, std::forward<TFunc>(logFunc));
+			}
+		}
 
 		void Out(const char* text) const noexcept
 		{
 			Out([text](auto& ls) { ls << text; });
 		}
 
-		void Out(ELogLevel level, const char* text) const noexcept
+		void Out(ELogLevel inLevel, const char* text) const noexcept
 		{
-			Out(level, [text](auto& ls) { ls << text; });
+			Out(inLevel, [text](auto& ls) { ls << text; });
 		}
 
 		void OutWarning(const char* text) const noexcept
@@ -83,29 +143,62 @@ public:
 		{
 			OutFatalError([text](auto& ls) { ls << text; });
 		}
+
+		// Substitute the arguments for the "{}"s in the format, which should be interned once by LOG_FORMAT.
+		template<typename... TArgs>
+		void OutFormat(StaticString format, const TArgs&... args) const noexcept
+		{
+			OutFormat(level, format, args...);
+		}
+
+		template<typename... TArgs>
+		void OutFormat(ELogLevel level, StaticString format, const TArgs&... args) const noexcept;
+
+	private:
+		void Write(ELogLevel inLevel, const TLogFunction& logFunc) const noexcept;
 	};
 
+	static constexpr size_t MaxTextLength = Config::LogOutputBuffer - 1;
+
 private:
+	// Arguments of OutFormat, encoded by LogArgs without knowing their types.
+	struct EncodedArgs final
+	{
+		size_t size;
+		void (*encode)(uint8_t* buffer, const void* args);
+		const void* args;
+	};
+
 	static Logger* instance;
 	MultiPoolAllocator allocator;
-	ThreadSafeMultiPoolAllocator inputAlloc;
 	Task task;
 	std::atomic<bool> isRunning;
 	std::atomic<bool> hasInput;
-	std::atomic<bool> needFlush;
+
+	// Rings are published by numRings, and never removed until the logger is destroyed.
+	std::array<LogRing*, Config::MaxLogRings> rings;
+	std::atomic<uint32_t> numRings;
+	std::mutex ringLock;
+
+	// Shared by the threads without a ring of their own, and by the logs nested in a log function.
+	LogRing sharedRing;
+	std::mutex sharedRingLock;
 
 	TString logPath;
-	TLogBuffer inputBuffer;
-	TLogBuffer swapBuffer;
+	HVector<const LogRecord*> records;
+	HVector<char> formatBuffer;
 	TTextBuffer textBuffer;
 	TOutputFuncs flushFuncs;
 	TFilters filters;
 
-	std::ofstream outFileStream;
+	LogFileWriter fileWriter;
+	bool isBinary;
+	std::ofstream binaryFileStream;
+	BinaryLogWriter binaryWriter;
 	std::thread::id threadID;
 
 	std::mutex filterLock;
-	std::mutex inputLock;
+	std::mutex processLock;
 
 public:
 	static Logger& Get() noexcept;
@@ -125,6 +218,12 @@ public:
 	void StartTask(TaskSystem& taskSys);
 	void StopTask(TaskSystem& taskSys);
 
+	// The lowest level logged in the categories without their own. Log.Level at start.
+	void SetLevel(ELogLevel level) noexcept;
+	// The lowest level logged in the category. ELogLevel::MAX disables it.
+	void SetLevel(StaticString category, ELogLevel level) noexcept;
+	void ResetLevel(StaticString category) noexcept;
+	// The filter runs only for the logs which pass the level, under a lock. A null filter removes it.
 	void SetFilter(StaticString category, TLogFilter&& filter) noexcept;
 	void AddLog(StaticString category, ELogLevel level, const TLogFunction& logFunc) noexcept;
 	void Flush() noexcept;
@@ -134,6 +233,40 @@ public:
 #endif // PROFILE_ENABLED
 
 private:
+	[[nodiscard]] static bool PassFilter(StaticString category, ELogLevel level) noexcept;
+	static void AddFormat(StaticString category, ELogLevel level, StaticString format,
+		const EncodedArgs& args) noexcept;
+	static void FormatText(TLogStream& ls, StaticString format, const EncodedArgs& args) noexcept;
+
+	void AddRecord(StaticString category, ELogLevel level, const TLogFunction& logFunc) noexcept;
+	// Whether the log should be printed at once on the calling thread instead of going through the rings.
+	[[nodiscard]] bool IsImmediate(ELogLevel level) const noexcept;
+	void AddFormatRecord(StaticString category, ELogLevel level, StaticString format,
+		const EncodedArgs& args) noexcept;
+
+	[[nodiscard]] LogRing* AcquireRing() noexcept;
+	void WriteToRing(LogRing& ring, StaticString threadName, StaticString category, ELogLevel level,
+		const TLogFunction& logFunc) noexcept;
+	void WriteToSharedRing(StaticString threadName, StaticString category, ELogLevel level,
+		const TLogFunction& logFunc) noexcept;
+
+	// Wait for the IO thread to make room up to Log.RingWaitMs. Return nullptr if the log should be dropped.
+	[[nodiscard]] LogRecord* Reserve(LogRing& ring, StaticString threadName, StaticString category, ELogLevel level,
+		size_t maxTextLength, StaticStringID format) noexcept;
+	void Publish(ELogLevel level) noexcept;
+
+	template<typename TFunc>
+	void ForEachRing(TFunc&& func) noexcept
+	{
+		const auto count = numRings.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			func(*rings[i]);
+		}
+
+		func(sharedRing);
+	}
+
 	void ProcessBuffer() noexcept;
 	void FlushBuffer(const TTextBuffer& buffer) const noexcept;
 
@@ -141,6 +274,26 @@ private:
 	static void PrintStdIO(const TTextBuffer& buffer) noexcept;
 };
 
+template<typename... TArgs>
+void Logger::SimpleLogger::OutFormat(ELogLevel inLevel, StaticString format, const TArgs&... args) const noexcept
+{
+	static_assert((LogArgs::GetMaxSize<TArgs>() + ... + size_t(0)) <= MaxTextLength,
+		"Too many arguments for a log record.");
+
+	returnIf(!IsEnabled(inLevel));
+
+	using TArgsRef = std::tuple<const TArgs&...>;
+	const TArgsRef argsRef(args...);
+
+	auto encode = [](uint8_t* buffer, const void* userData)
+	{
+		std::apply([buffer](const auto&... values) mutable { ((buffer = LogArgs::Encode(buffer, values)), ...); },
+			*static_cast<const TArgsRef*>(userData));
+	};
+
+	AddFormat(category, inLevel, format, EncodedArgs{(LogArgs::GetSize(args) + ... + size_t(0)), encode, &argsRef});
+}
+
 using TLog = Logger::SimpleLogger;
 using LogStream = Logger::TLogStream;
 
@@ -70,6 +70,23 @@ namespace hbe
 			mmgr.DeallocateTypes(ptr, n);
 		}
 
+		// Resize the block, in place if the allocator can extend it. The elements move as bytes, so they should be
+		// trivially relocatable.
+		[[nodiscard]] T* reallocate(T* ptr, std::size_t oldN, std::size_t newN) noexcept
+		{
+			// Mirror the allocate() fast-path, which took the block from malloc.
+			if (allocatorID == MemoryManager::SystemAllocatorID)
+			{
+				return static_cast<T*>(realloc(static_cast<void*>(ptr), newN * sizeof(T)));
+			}
+
+			AllocatorScope scope(allocatorID);
+			auto& mmgr = MemoryManager::GetInstance();
+			auto ptrNew = mmgr.Reallocate(ptr, oldN * sizeof(T), newN * sizeof(T));
+
+			return static_cast<T*>(ptrNew);
+		}
+
 		template<class TOther>
 		bool operator==(const DefaultAllocator<TOther>& rhs) const noexcept
 		{
@@ -2,8 +2,13 @@
 
 #pragma once
 
+#include <concepts>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "MemoryManager.h"
 
 namespace hbe
@@ -12,6 +17,53 @@ namespace hbe
 	using TAllocFunc = std::function<void*(size_t)>;
 	using TDeallocFunc = std::function<void(void*, size_t)>;
 
+	/// @brief Whether an object can move to another address as bytes, without its move constructor and destructor.
+	/// @details The trivially copyable types are, and a type which doesn't point into itself can specialize it.
+	template<typename T>
+	struct TriviallyRelocatable : std::is_trivially_copyable<T>
+	{
+	};
+
+	template<typename T>
+	concept CTriviallyRelocatable = TriviallyRelocatable<T>::value;
+
+	// An allocator which can resize a block, extending it in place if it can.
+	template<typename TAllocator>
+	concept CReallocatable = requires(TAllocator allocator, typename TAllocator::value_type* ptr, size_t n) {
+		{ allocator.reallocate(ptr, n, n) } -> std::same_as<typename TAllocator::value_type*>;
+	};
+
+	// Move the objects to the destination, which may overlap, and destroy the sources.
+	template<typename T>
+	void RelocateObjects(T* dst, T* src, size_t n) noexcept
+	{
+		if (n == 0 || dst == src)
+		{
+			return;
+		}
+
+		if constexpr (CTriviallyRelocatable<T>)
+		{
+			std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * n);
+		}
+		else if (dst < src)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				new (&dst[i]) T(std::move(src[i]));
+				src[i].~T();
+			}
+		}
+		else
+		{
+			for (size_t i = n; i > 0; --i)
+			{
+				new (&dst[i - 1]) T(std::move(src[i - 1]));
+				src[i - 1].~T();
+			}
+		}
+	}
+
 	template<typename TType, typename... TTypes, typename TAllocator>
 	TType* New(TAllocator& allocator, TTypes&&... args) noexcept
 	{
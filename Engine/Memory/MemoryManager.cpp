@@ -2,6 +2,9 @@
 
 #include "MemoryManager.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include "Config/ConfigParam.h"
 #include "Core/Debug.h"
 #include "Engine/Engine.h"
@@ -663,9 +666,44 @@ namespace hbe
 		allocProxy.deallocate(allocProxy.allocator, ptr, nBytes);
 	}
 
+	void* MemoryManager::Reallocate(TId id, void* ptr, size_t oldBytes, size_t newBytes)
+	{
+		if (unlikely(ptr == nullptr))
+		{
+			return Allocate(id, newBytes);
+		}
+
+#if FORCE_USE_SYSTEM_MALLOC
+		id = SystemAllocatorID;
+#endif // __USE_SYSTEM_MALLOC__
+
+#if !PROFILE_ENABLED && !MEMORY_INVESTIGATION_ENABLED
+		// The system allocator is malloc without tracking then, and realloc can extend or remap the pages.
+		if (id == SystemAllocatorID && newBytes > 0)
+		{
+			return realloc(ptr, newBytes);
+		}
+#endif // !PROFILE_ENABLED && !MEMORY_INVESTIGATION_ENABLED
+
+		auto newPtr = Allocate(id, newBytes);
+		if (newPtr != nullptr)
+		{
+			memcpy(newPtr, ptr, std::min(oldBytes, newBytes));
+		}
+
+		Deallocate(id, ptr, oldBytes);
+
+		return newPtr;
+	}
+
 	void* MemoryManager::Allocate(size_t nBytes) { return Allocate(GetScopedAllocatorID(), nBytes); }
 	void MemoryManager::Deallocate(void* ptr, size_t nBytes) { Deallocate(GetScopedAllocatorID(), ptr, nBytes); }
 
+	void* MemoryManager::Reallocate(void* ptr, size_t oldBytes, size_t newBytes)
+	{
+		return Reallocate(GetScopedAllocatorID(), ptr, oldBytes, newBytes);
+	}
+
 	bool MemoryManager::IsLogEnabled(ELogLevel level) const
 	{
 #if MEMORY_LOGGING_ENABLED
@@ -96,6 +96,10 @@ namespace hbe
 		void* Allocate(size_t nBytes);
 		void Deallocate(void* ptr, size_t nBytes);
 
+		// Resize a block, keeping its bytes. Only the system heap can extend it in place, and others move it.
+		void* Reallocate(TId id, void* ptr, size_t oldBytes, size_t newBytes);
+		void* Reallocate(void* ptr, size_t oldBytes, size_t newBytes);
+
 		bool IsLogEnabled(ELogLevel level) const;
 		void Log(ELogLevel level, TLogFunc func) const;
 
@@ -7,6 +7,7 @@
 #include <bit>
 #include <map>
 #include "Config/BuildConfig.h"
+#include "Core/CommonMacros.h"
 #include "Core/SystemStatistics.h"
 #include "Engine/Engine.h"
 #include "Log/Logger.h"
@@ -19,8 +20,8 @@ namespace hbe
 	MultiPoolAllocator::MultiPoolAllocator(const char* inName, size_t allocationUnit, size_t minBlockSize)
 
 		:
-		id(InvalidAllocatorID), parentID(InvalidAllocatorID), name(inName), bankSize(allocationUnit),
-		minBlock(minBlockSize)
+		id(InvalidAllocatorID), parentID(InvalidAllocatorID), name(inName), bankOptions{PageMap::PageSize},
+		bankSize(allocationUnit), minBlock(minBlockSize)
 	{
 		using namespace hbe;
 
@@ -40,6 +41,7 @@ namespace hbe
 
 		auto& mmgr = MemoryManager::GetInstance();
 		GenerateBanksByCache(mmgr);
+		InitSizeClasses();
 
 		size_t capacity = 0;
 		for (auto& bank : banks)
@@ -54,8 +56,8 @@ namespace hbe
 										   size_t allocationUnit, size_t minBlockSize)
 
 		:
-		id(InvalidAllocatorID), parentID(InvalidAllocatorID), name(inName), bankSize(allocationUnit),
-		minBlock(minBlockSize)
+		id(InvalidAllocatorID), parentID(InvalidAllocatorID), name(inName), bankOptions{PageMap::PageSize},
+		bankSize(allocationUnit), minBlock(minBlockSize)
 	{
 		using namespace hbe;
 
@@ -89,9 +91,11 @@ namespace hbe
 			InlineStringBuilder<1024> str;
 			str << name << '_' << config.blockSize << '_' << config.numberOfBlocks;
 
-			banks.emplace_back(str.c_str(), config.blockSize, config.numberOfBlocks);
+			banks.emplace_back(str.c_str(), config.blockSize, config.numberOfBlocks, bankOptions);
 		}
 
+		InitSizeClasses();
+
 		size_t capacity = 0;
 		for (auto& bank : banks)
 		{
@@ -131,21 +135,15 @@ namespace hbe
 			return nullptr;
 		}
 
-		auto index = GetBankIndex(size);
+		auto index = GetBankIndex(GetSizeClass(size));
 		if (index >= banks.size())
 		{
-			// Failed to find a suitable bank for the given size
+			// All banks of the size class are full, or there's none.
 			// Generate a new bank and allocate
 			return NewBankAllocate(size);
 		}
 
 		auto& bank = banks[index];
-		if (unlikely(bank.GetAvailableBlocks() <= 0))
-		{
-			// The bank is full. Need to generate a new bank
-			return NewBankAllocate(size);
-		}
-
 		auto ptr = bank.Allocate(size);
 
 #if PROFILE_ENABLED
@@ -189,6 +187,16 @@ namespace hbe
 
 		bank.Deallocate(ptr, size);
 
+		// The bank was full, so it's neither active nor in the list.
+		if (bank.GetAvailableBlocks() == 1)
+		{
+			const auto sizeClass = GetBankSizeClass(bank);
+			if (sizeClass < NumSizeClasses && sizeClasses[sizeClass].activeBank != index)
+			{
+				PushAvailableBank(sizeClass, static_cast<TBankIndex>(index));
+			}
+		}
+
 #if PROFILE_ENABLED
 		{
 			auto& mmgr = MemoryManager::GetInstance();
@@ -304,10 +312,10 @@ namespace hbe
 
 		// Create a new bank for the given size
 		auto blockSize = CalculateBlockSize(size);
-		auto numBlocks = CalculateNumberOfBlocks(bankSize, blockSize);
+		auto numBlocks = CalculateNumberOfBlocks(GetBankUnit(), blockSize);
 		GenerateBank(blockSize, numBlocks);
 
-		auto index = GetBankIndex(size);
+		auto index = GetBankIndex(GetSizeClass(size));
 		if (unlikely(index >= banks.size()))
 		{
 			FatalAssert(false);
@@ -342,43 +350,116 @@ namespace hbe
 			InlineStringBuilder<1024> str;
 			str << name << '_' << config.blockSize << '_' << config.numberOfBlocks;
 
-			banks.emplace_back(str.c_str(), config.blockSize, config.numberOfBlocks);
+			banks.emplace_back(str.c_str(), config.blockSize, config.numberOfBlocks, bankOptions);
 		}
 
 		return true;
 	}
-	size_t MultiPoolAllocator::GetBankIndex(size_t nBytes) const
+	void MultiPoolAllocator::SetBankBacking(OS::EHugePages hugePages, int numaNode)
+	{
+		bankOptions.hugePages = hugePages;
+		bankOptions.numaNode = numaNode;
+	}
+
+	void MultiPoolAllocator::InitSizeClasses()
+	{
+		Assert(std::has_single_bit(minBlock), "The minimum block size(%zu) should be a power of two.", minBlock);
+
+		for (auto& sizeClass : sizeClasses)
+		{
+			sizeClass.activeBank = InvalidBank;
+			sizeClass.availableBanks = InvalidBank;
+		}
+
+		nextAvailableBanks.clear();
+		nextAvailableBanks.reserve(banks.size());
+
+		for (size_t i = 0; i < banks.size(); ++i)
+		{
+			RegisterBank(static_cast<TBankIndex>(i));
+		}
+	}
+
+	void MultiPoolAllocator::RegisterBank(TBankIndex index)
+	{
+		Assert(index < InvalidBank);
+		Assert(nextAvailableBanks.size() == index);
+		nextAvailableBanks.push_back(InvalidBank);
+
+		auto& bank = banks[index];
+
+		// A bank out of the page map is still found by GetBankIndex(void*), but in linear time.
+		[[maybe_unused]] const bool isMapped = pageMap.Set(bank.GetBuffer(), bank.GetCapacity(), index + 1);
+		Assert(isMapped, "The bank[%s] is out of the page map.", bank.GetName().c_str());
+
+		returnIf(bank.GetAvailableBlocks() <= 0);
+
+		const auto sizeClass = GetBankSizeClass(bank);
+		returnIf(sizeClass >= NumSizeClasses);
+
+		auto& activeBank = sizeClasses[sizeClass].activeBank;
+		if (activeBank == InvalidBank || banks[activeBank].GetAvailableBlocks() <= 0)
+		{
+			activeBank = index;
+			return;
+		}
+
+		PushAvailableBank(sizeClass, index);
+	}
+
+	size_t MultiPoolAllocator::GetSizeClass(size_t nBytes) const
 	{
 		nBytes = std::max(minBlock, nBytes);
-		const auto doubleSize = nBytes * 2;
+		return std::bit_width((nBytes - 1) >> std::countr_zero(minBlock));
+	}
+
+	size_t MultiPoolAllocator::GetBankSizeClass(const PoolAllocator& bank) const
+	{
+		const auto blockSize = bank.GetBlockSize();
+		returnValueIf(NumSizeClasses, blockSize < minBlock);
+
+		return std::bit_width(blockSize >> std::countr_zero(minBlock)) - 1;
+	}
+
+	void MultiPoolAllocator::PushAvailableBank(size_t sizeClass, TBankIndex index)
+	{
+		auto& head = sizeClasses[sizeClass].availableBanks;
+		nextAvailableBanks[index] = head;
+		head = index;
+	}
 
+	size_t MultiPoolAllocator::GetBankIndex(size_t sizeClass)
+	{
 		const auto len = banks.size();
-		for (size_t i = 0; i < len; ++i)
+		returnValueIf(len, unlikely(sizeClass >= NumSizeClasses));
+
+		auto& entry = sizeClasses[sizeClass];
+		if (likely(entry.activeBank != InvalidBank && banks[entry.activeBank].GetAvailableBlocks() > 0))
 		{
-			auto& bank = banks[i];
-			if (nBytes > bank.GetBlockSize())
-			{
-				continue;
-			}
+			return entry.activeBank;
+		}
 
-			if (bank.GetAvailableBlocks() <= 0)
-			{
-				continue;
-			}
+		// Take over a bank with free blocks. The full one gets back to the list when one of its blocks is freed.
+		const auto index = entry.availableBanks;
+		returnValueIf(len, index == InvalidBank);
 
-			if (bank.GetBlockSize() > doubleSize)
-			{
-				return len;
-			}
+		entry.availableBanks = nextAvailableBanks[index];
+		nextAvailableBanks[index] = InvalidBank;
+		entry.activeBank = index;
 
-			return i;
-		}
+		Assert(banks[index].GetAvailableBlocks() > 0);
 
-		return len;
+		return index;
 	}
 
 	size_t MultiPoolAllocator::GetBankIndex(void* ptr) const
 	{
+		const auto value = pageMap.Get(ptr);
+		if (likely(value != PageMap::InvalidValue))
+		{
+			return value - 1;
+		}
+
 		size_t index = 0;
 
 		for (auto& bank : banks)
@@ -404,6 +485,14 @@ namespace hbe
 		return blockSize;
 	}
 
+	size_t MultiPoolAllocator::GetBankUnit() const
+	{
+		returnValueIf(bankSize, bankOptions.hugePages == OS::EHugePages::Disabled);
+
+		// A bank smaller than a huge page would leave the rest of it unused.
+		return OS::GetAligned(bankSize, static_cast<uint32_t>(OS::GetHugePageSize()));
+	}
+
 	size_t MultiPoolAllocator::CalculateNumberOfBlocks(size_t bankSize, size_t blockSize)
 	{
 		size_t numberOfBlocks = (bankSize + blockSize - 1) / blockSize;
@@ -432,9 +521,10 @@ namespace hbe
 		str << name << '_' << blockSize << '_' << numberOfBlocks;
 
 		{
+			// Banks are never reordered, as the page map and the size classes refer to them by index.
 			AllocatorScope allocScope(parentID);
-			banks.emplace_back(str.c_str(), blockSize, numberOfBlocks);
-			std::sort(banks.begin(), banks.end());
+			banks.emplace_back(str.c_str(), blockSize, numberOfBlocks, bankOptions);
+			RegisterBank(static_cast<TBankIndex>(banks.size() - 1));
 		}
 
 		auto log = Logger::Get(name);
@@ -534,6 +624,70 @@ namespace hbe
 #endif // PROFILE_ENABLED
 		});
 
+		AddTest("Many Banks", [this](auto& ls)
+		{
+			constexpr size_t NumBlocks = 20000;
+
+			// The cost of a round of allocations and deallocations shouldn't depend on the number of banks.
+			auto Run = [this, &ls](MultiPoolAllocator& allocator, time::TDuration& outDuration) -> bool
+			{
+				HVector<uint32_t*> blocks(NumBlocks, nullptr);
+				uint32_t seed = 12345;
+
+				time::ScopedTime timer(outDuration);
+
+				for (size_t i = 0; i < NumBlocks; ++i)
+				{
+					seed = seed * 1664525U + 1013904223U;
+					const size_t size = 16 + (seed >> 16) % 1008;
+
+					blocks[i] = static_cast<uint32_t*>(allocator.Allocate(size));
+					blocks[i][0] = static_cast<uint32_t>(i);
+					blocks[i][1] = static_cast<uint32_t>(size);
+				}
+
+				// Free in a scattered order, so most frees go to a bank other than the last one.
+				for (size_t i = 0; i < NumBlocks; ++i)
+				{
+					const auto index = (i * 7919) % NumBlocks;
+					auto* block = blocks[index];
+					if (block[0] != index)
+					{
+						ls << "Block " << index << " has been corrupted." << lferr;
+						return false;
+					}
+
+					allocator.Deallocate(block, block[1]);
+				}
+
+				return true;
+			};
+
+			MultiPoolAllocator fewBanks("FewBanksMultiPoolAlloc");
+			MultiPoolAllocator manyBanks("ManyBanksMultiPoolAlloc", 4096);
+
+			time::TDuration fewDuration;
+			time::TDuration manyDuration;
+			time::TDuration unused;
+
+			// The first rounds generate the banks.
+			returnIf(!Run(fewBanks, unused) || !Run(manyBanks, unused));
+			returnIf(!Run(fewBanks, fewDuration) || !Run(manyBanks, manyDuration));
+
+			const float fewSec = time::ToFloat(fewDuration);
+			const float manySec = time::ToFloat(manyDuration);
+
+			ls << fewBanks.NumBanks() << " banks = " << fewSec << " sec, " << manyBanks.NumBanks()
+			   << " banks = " << manySec << " sec" << lf;
+
+			constexpr float ToleranceFactor = 4.0f;
+			if (manySec > fewSec * ToleranceFactor)
+			{
+				ls << "It gets slower with more banks. " << fewBanks.NumBanks() << " banks = " << fewSec << " sec, "
+				   << manyBanks.NumBanks() << " banks = " << manySec << " sec" << lfwarn;
+			}
+		});
+
 		AddTest("Performance", [this](auto& ls)
 		{
 			time::TDuration heDuration;
@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include "Config/BuildConfig.h"
 #include "HSTL/HVector.h"
+#include "PageMap.h"
 #include "PoolAllocator.h"
 #include "PoolConfig.h"
 #include "String/StaticString.h"
@@ -16,6 +19,9 @@ namespace hbe
 	/// @brief A multi-pool allocator that manages multiple pools of different block sizes.
 	/// @details Uses multiple pools to handle various allocation sizes efficiently.
 	/// Blocks are organized into banks that can grow as needed.
+	/// Both lookups are constant time regardless of the number of banks. A request of n bytes belongs to the size
+	/// class log2(ceil(n / minBlock)), which serves it from its active bank or from a list of its banks with free
+	/// blocks. Bank buffers are page-aligned and registered to a page map, which finds the bank of a pointer.
 	class MultiPoolAllocator final
 	{
 	public:
@@ -24,14 +30,30 @@ namespace hbe
 		static constexpr size_t DefaultMinBlock = 16;
 		static constexpr size_t DefaultBankUnit = 1024ULL * 1024;
 		static constexpr size_t MinNumberOfBlocks = 16;
+		static constexpr size_t NumSizeClasses = 40;
 
 	private:
 		using TInitializerList = std::initializer_list<PoolConfig>;
+		using TBankIndex = uint32_t;
+
+		static constexpr TBankIndex InvalidBank = UINT32_MAX;
+
+		// Banks of blocks in [minBlock << n, minBlock << (n + 1)) serve the size class n.
+		struct SizeClass final
+		{
+			TBankIndex activeBank;
+			// Banks with free blocks other than the active one, linked through nextAvailableBanks.
+			TBankIndex availableBanks;
+		};
 
 		TAllocatorID id;
 		TAllocatorID parentID;
 		StaticString name;
 		hbe::HVector<PoolAllocator> banks;
+		hbe::HVector<TBankIndex> nextAvailableBanks;
+		std::array<SizeClass, NumSizeClasses> sizeClasses;
+		PageMap pageMap;
+		PoolBufferOptions bankOptions;
 		size_t bankSize;
 		size_t minBlock;
 
@@ -47,6 +69,11 @@ namespace hbe
 
 		[[nodiscard]] auto GetName() const { return name; }
 		[[nodiscard]] auto GetID() const { return id; }
+		[[nodiscard]] size_t NumBanks() const { return banks.size(); }
+
+		// Back the banks generated afterwards by huge pages, and place them on the NUMA node. Banks are grown to
+		// the huge page size.
+		void SetBankBacking(OS::EHugePages hugePages, int numaNode = OS::AnyNumaNode);
 
 		void PrintUsage() const;
 
@@ -59,9 +86,15 @@ namespace hbe
 		void* NewBankAllocate(size_t size);
 
 		bool GenerateBanksByCache(MemoryManager& mmgr);
-		[[nodiscard]] size_t GetBankIndex(size_t nBytes) const;
+		void InitSizeClasses();
+		void RegisterBank(TBankIndex index);
+		[[nodiscard]] size_t GetSizeClass(size_t nBytes) const;
+		[[nodiscard]] size_t GetBankSizeClass(const PoolAllocator& bank) const;
+		void PushAvailableBank(size_t sizeClass, TBankIndex index);
+		[[nodiscard]] size_t GetBankIndex(size_t sizeClass);
 		[[nodiscard]] size_t GetBankIndex(void* ptr) const;
 		[[nodiscard]] size_t CalculateBlockSize(size_t requested) const;
+		[[nodiscard]] size_t GetBankUnit() const;
 		static size_t CalculateNumberOfBlocks(size_t bankSize, size_t blockSize);
 		void GenerateBank(size_t blockSize, size_t numberOfBlocks);
 	};
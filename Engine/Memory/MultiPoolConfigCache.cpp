@@ -8,8 +8,13 @@
 #include "PoolConfigUtil.h"
 #include "Resource/BufferInputStream.h"
 #include "Resource/BufferOutputStream.h"
+#include "Resource/Serialization.h"
 #include "String/StringUtil.h"
 
+// The pool configs are copied at once, since they're packed.
+HBE_SCHEMA(hbe::PoolConfig, 1, HBE_FIELD(blockSize), HBE_FIELD(numberOfBlocks));
+HBE_SCHEMA(hbe::MultiPoolAllocatorConfig, 1, HBE_FIELD(uniqueName), HBE_FIELD(configs));
+
 namespace hbe
 {
 	StaticString MultiPoolConfigCache::GetClassName()
@@ -34,44 +39,15 @@ namespace hbe
 
 		Normalize();
 
-		size_t cacheSize = data.size();
-		bos << cacheSize;
+		Serialization::Write(bos, data);
 
 		if (unlikely(bos.HasError()))
 		{
-			log.OutError([](auto& ls) { ls << "An error occured while streaming out header data."; });
+			log.OutError([](auto& ls) { ls << "An error occured while streaming out pool config data."; });
 
 			return 0;
 		}
 
-		for (auto& item : data)
-		{
-			StaticString name(item.uniqueName);
-
-			auto nameStr = name.c_str();
-			bos << nameStr;
-
-			auto& configs = item.configs;
-			bos << configs.size();
-
-			for (auto& config : configs)
-			{
-				bos << config.blockSize;
-				bos << config.numberOfBlocks;
-			}
-
-			if (unlikely(bos.HasError()))
-			{
-				log.OutError([](auto& ls)
-				{
-					ls << "An error occured while streaming out pool config "
-						  "data";
-				});
-
-				return 0;
-			}
-		}
-
 		return bos.GetCursor();
 	}
 
@@ -105,46 +81,12 @@ namespace hbe
 			return false;
 		}
 
-		size_t size = 0;
-		bis >> size;
-
-		if (unlikely(bis.HasError()))
+		if (unlikely(!Serialization::Read(bis, data)))
 		{
 			log.OutError("Input stream failure.");
-			return false;
-		}
-
-		data.reserve(size);
-
-		for (size_t i = 0; i < size; ++i)
-		{
-			StaticString key;
-			bis >> key;
-
-			size_t configSize = 0;
-			bis >> configSize;
-
-			MemoryManager::TVector<PoolConfig> configs;
-			configs.reserve(configSize);
-
-			for (size_t j = 0; j < configSize; ++j)
-			{
-				size_t blockSize = 0;
-				size_t numberOfBlocks = 0;
-
-				bis >> blockSize;
-				bis >> numberOfBlocks;
-
-				configs.emplace_back(blockSize, numberOfBlocks);
-			}
+			data.clear();
 
-			if (unlikely(bis.HasError()))
-			{
-				log.OutError("Input stream failure.");
-				return false;
-			}
-
-			data.emplace_back(key.GetID(), std::move(configs));
+			return false;
 		}
 
 #ifdef __DEBUG__
@@ -10,7 +10,7 @@ namespace hbe
 	class Buffer;
 
 	/// @brief Cache for multi-pool allocator configurations.
-	/// @details Serializes and deserializes pool configurations.
+	/// @details Serializes and deserializes pool configurations by their schemas.
 	class MultiPoolConfigCache final
 	{
 	public:
@@ -21,7 +21,7 @@ namespace hbe
 		using TMultiPoolConfigs = TVector<MultiPoolAllocatorConfig>;
 
 	private:
-		static constexpr TVersion version = 0;
+		static constexpr TVersion version = 1;
 		TMultiPoolConfigs data;
 
 	public:
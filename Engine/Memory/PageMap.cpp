@@ -0,0 +1,170 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "PageMap.h"
+
+
+#include "AllocatorScope.h"
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "MemoryManager.h"
+
+namespace hbe
+{
+
+	PageMap::PageMap() : root(nullptr) {}
+
+	PageMap::~PageMap()
+	{
+		returnIf(root == nullptr);
+
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+		auto& mmgr = MemoryManager::GetInstance();
+
+		for (size_t i = 0; i < NodeSize; ++i)
+		{
+			auto* node = root[i];
+			continueIf(node == nullptr);
+
+			for (auto* leaf : node->leaves)
+			{
+				continueIf(leaf == nullptr);
+				mmgr.Delete(leaf);
+			}
+
+			mmgr.Delete(node);
+		}
+
+		mmgr.DeleteArray(root, NodeSize);
+		root = nullptr;
+	}
+
+	bool PageMap::Set(const void* ptr, size_t size, TValue value)
+	{
+		returnValueIf(true, size == 0);
+
+		const auto start = reinterpret_cast<uintptr_t>(ptr);
+		const auto last = start + size - 1;
+		returnValueIf(false, last < start || (last >> AddressBits) != 0);
+
+		const auto lastPage = last >> PageShift;
+		for (auto page = start >> PageShift; page <= lastPage; ++page)
+		{
+			auto* leaf = GetLeaf(page);
+			leaf->values[page & (NodeSize - 1)] = value;
+		}
+
+		return true;
+	}
+
+	PageMap::TValue PageMap::Get(const void* ptr) const
+	{
+		const auto address = reinterpret_cast<uintptr_t>(ptr);
+		returnValueIf(InvalidValue, root == nullptr || (address >> AddressBits) != 0);
+
+		const auto page = address >> PageShift;
+
+		const auto* node = root[page >> (LevelBits * 2)];
+		returnValueIf(InvalidValue, node == nullptr);
+
+		const auto* leaf = node->leaves[(page >> LevelBits) & (NodeSize - 1)];
+		returnValueIf(InvalidValue, leaf == nullptr);
+
+		return leaf->values[page & (NodeSize - 1)];
+	}
+
+	PageMap::Leaf* PageMap::GetLeaf(size_t pageNumber)
+	{
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+		auto& mmgr = MemoryManager::GetInstance();
+
+		if (unlikely(root == nullptr))
+		{
+			root = mmgr.NewArray<Node*>(NodeSize, nullptr);
+		}
+
+		auto*& node = root[pageNumber >> (LevelBits * 2)];
+		if (node == nullptr)
+		{
+			node = mmgr.New<Node>();
+		}
+
+		auto*& leaf = node->leaves[(pageNumber >> LevelBits) & (NodeSize - 1)];
+		if (leaf == nullptr)
+		{
+			leaf = mmgr.New<Leaf>();
+		}
+
+		return leaf;
+	}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Core/Types.h"
+#include "HSTL/HVector.h"
+
+namespace hbe
+{
+
+	void PageMapTest::Prepare()
+	{
+		AddTest("Set & Get", [this](auto& ls)
+		{
+			PageMap pageMap;
+
+			alignas(PageMap::PageSize) static Byte buffer[PageMap::PageSize * 4];
+
+			if (pageMap.Get(buffer) != PageMap::InvalidValue)
+			{
+				ls << "An empty map should return the invalid value." << lferr;
+			}
+
+			pageMap.Set(buffer, PageMap::PageSize + 1, 7);
+			pageMap.Set(buffer + PageMap::PageSize * 3, PageMap::PageSize, 9);
+
+			const PageMap::TValue expected[] = {7, 7, PageMap::InvalidValue, 9};
+			for (size_t i = 0; i < std::size(expected); ++i)
+			{
+				const auto value = pageMap.Get(buffer + PageMap::PageSize * i + PageMap::PageSize / 2);
+				if (value != expected[i])
+				{
+					ls << "Page " << i << " has " << value << ", but " << expected[i] << " expected." << lferr;
+				}
+			}
+
+			if (pageMap.Set(reinterpret_cast<void*>(uintptr_t(1) << 48), 1, 1))
+			{
+				ls << "An address beyond 48 bits should be rejected." << lferr;
+			}
+		});
+
+		AddTest("Distant Ranges", [this](auto& ls)
+		{
+			PageMap pageMap;
+
+			HVector<uintptr_t> addresses;
+			for (uintptr_t i = 1; i < 64; ++i)
+			{
+				addresses.push_back(i * (uintptr_t(1) << 41) + i * PageMap::PageSize);
+			}
+
+			for (size_t i = 0; i < addresses.size(); ++i)
+			{
+				pageMap.Set(reinterpret_cast<void*>(addresses[i]), 1, static_cast<PageMap::TValue>(i + 1));
+			}
+
+			for (size_t i = 0; i < addresses.size(); ++i)
+			{
+				const auto value = pageMap.Get(reinterpret_cast<void*>(addresses[i]));
+				if (value != i + 1)
+				{
+					ls << "Address " << reinterpret_cast<void*>(addresses[i]) << " has " << value << ", but " << (i + 1)
+					   << " expected." << lferr;
+					return;
+				}
+			}
+		});
+	}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hbe
+{
+	/// @brief Radix tree mapping memory pages to 32-bit values.
+	/// @details It covers a 48-bit address space with pages of PageSize bytes, in three levels of 4096 entries.
+	/// The nodes are allocated by the system allocator on demand, and freed when the map is destroyed.
+	/// Looking up an address is three dependent loads regardless of the number of mapped ranges.
+	/// It's not thread-safe.
+	class PageMap final
+	{
+	public:
+		using TValue = uint32_t;
+
+		static constexpr size_t PageShift = 12;
+		static constexpr size_t PageSize = size_t(1) << PageShift;
+		static constexpr TValue InvalidValue = 0;
+
+	private:
+		static constexpr size_t AddressBits = 48;
+		static constexpr size_t LevelBits = 12;
+		static constexpr size_t NodeSize = size_t(1) << LevelBits;
+		static_assert(PageShift + LevelBits * 3 == AddressBits);
+
+		struct Leaf final
+		{
+			TValue values[NodeSize];
+		};
+
+		struct Node final
+		{
+			Leaf* leaves[NodeSize];
+		};
+
+		Node** root;
+
+	public:
+		PageMap();
+		~PageMap();
+
+		PageMap(const PageMap&) = delete;
+		PageMap& operator=(const PageMap&) = delete;
+
+		// Map all pages overlapping [ptr, ptr + size). Return false if the range is out of the address space.
+		bool Set(const void* ptr, size_t size, TValue value);
+		[[nodiscard]] TValue Get(const void* ptr) const;
+
+	private:
+		[[nodiscard]] Leaf* GetLeaf(size_t pageNumber);
+	};
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+	class PageMapTest : public TestCollection
+	{
+	public:
+		PageMapTest() : TestCollection("PageMapTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+} // namespace hbe
+#endif //__UNIT_TEST__
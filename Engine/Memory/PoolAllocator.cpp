@@ -3,6 +3,7 @@
 #include "PoolAllocator.h"
 
 
+#include <bit>
 #include "Core/CommonUtil.h"
 #include "Core/Debug.h"
 #include "MemoryManager.h"
@@ -12,14 +13,16 @@ namespace hbe
 {
 #if PROFILE_ENABLED
 	PoolAllocator::PoolAllocator(const char* name, TSize blockSize, TSize numberOfBlocks,
-								 const hbe::source_location location)
+								 const PoolBufferOptions& options, const hbe::source_location location)
 #else // PROFILE_ENABLED
-	PoolAllocator::PoolAllocator(const char* name, TSize blockSize, TSize numberOfBlocks)
+	PoolAllocator::PoolAllocator(const char* name, TSize blockSize, TSize numberOfBlocks,
+								 const PoolBufferOptions& options)
 #endif // PROFILE_ENABLED
 		:
 		id(InvalidAllocatorID), parentID(InvalidAllocatorID), name(name),
 		blockSize(OS::GetAligned(std::max(blockSize, sizeof(TSize)), sizeof(TSize))), numberOfBlocks(numberOfBlocks),
-		numberOfFreeBlocks(numberOfBlocks), buffer(nullptr)
+		numberOfFreeBlocks(numberOfBlocks), buffer(nullptr), availables(nullptr), bufferOffset(0), bufferSize(0),
+		isMapped(false)
 #if PROFILE_ENABLED
 		,
 		maxUsedBlocks(0), srcLocation(location)
@@ -28,19 +31,42 @@ namespace hbe
 		Assert(blockSize >= sizeof(TSize));
 
 		parentID = hbe::MemoryManager::GetCurrentAllocatorID();
-		const TSize totalSize = blockSize * numberOfBlocks;
+		const TSize totalSize = this->blockSize * numberOfBlocks;
 		if (totalSize <= 0)
 		{
 			return;
 		}
 
+		const auto alignment = options.alignment;
+		Assert(alignment == 0 || std::has_single_bit(alignment), "The buffer alignment(%zu) should be a power of two.",
+			   alignment);
+
 		auto& mmgr = MemoryManager::GetInstance();
-		buffer = static_cast<Byte*>(mmgr.Allocate(totalSize));
+		if (options.IsMapped())
+		{
+			const auto pageSize = options.hugePages != OS::EHugePages::Disabled ? OS::GetHugePageSize() : OS::GetPageSize();
+			Assert(alignment <= pageSize, "The buffer alignment(%zu) is larger than a page.", alignment);
+
+			bufferSize = OS::GetAligned(totalSize, static_cast<uint32_t>(pageSize));
+			buffer = static_cast<Byte*>(OS::VirtualAlloc(bufferSize, options.hugePages, options.numaNode));
+			isMapped = OS::IsValidAllocation(buffer);
+		}
+
+		if (!isMapped)
+		{
+			bufferSize = alignment > 1 ? totalSize + alignment : totalSize;
+
+			auto* allocated = static_cast<Byte*>(mmgr.Allocate(bufferSize));
+			const auto address = reinterpret_cast<uintptr_t>(allocated);
+			bufferOffset = alignment > 1 ? ((address + alignment - 1) & ~(alignment - 1)) - address : 0;
+			buffer = allocated + bufferOffset;
+		}
+
 		availables = &buffer[0];
 
 		for (TSize i = 0; i < numberOfBlocks; ++i)
 		{
-			auto cursor = &buffer[i * blockSize];
+			auto cursor = &buffer[i * this->blockSize];
 			SetAs<TSize>(cursor, i + 1);
 		}
 
@@ -63,7 +89,7 @@ namespace hbe
 	PoolAllocator::PoolAllocator(PoolAllocator&& rhs) noexcept :
 		id(rhs.id), parentID(rhs.parentID), name(rhs.name), blockSize(rhs.blockSize),
 		numberOfBlocks(rhs.numberOfBlocks), numberOfFreeBlocks(rhs.numberOfFreeBlocks), buffer(rhs.buffer),
-		availables(rhs.availables)
+		availables(rhs.availables), bufferOffset(rhs.bufferOffset), bufferSize(rhs.bufferSize), isMapped(rhs.isMapped)
 #if PROFILE_ENABLED
 		,
 		maxUsedBlocks(rhs.maxUsedBlocks), srcLocation(rhs.srcLocation)
@@ -79,6 +105,9 @@ namespace hbe
 		rhs.numberOfFreeBlocks = 0;
 		rhs.buffer = nullptr;
 		rhs.availables = nullptr;
+		rhs.bufferOffset = 0;
+		rhs.bufferSize = 0;
+		rhs.isMapped = false;
 
 #if PROFILE_ENABLED
 		rhs.maxUsedBlocks = 0;
@@ -117,11 +146,17 @@ namespace hbe
 			return;
 		}
 
-		const size_t totalSize = blockSize * numberOfBlocks;
 		Assert(buffer != nullptr);
 
 		auto& mmgr = MemoryManager::GetInstance();
-		mmgr.Deallocate(buffer, totalSize);
+		if (isMapped)
+		{
+			OS::VirtualFree(buffer, bufferSize);
+		}
+		else
+		{
+			mmgr.Deallocate(buffer - bufferOffset, bufferSize);
+		}
 
 #if PROFILE_ENABLED
 		mmgr.DeregisterAllocator(GetID(), srcLocation);
@@ -299,6 +334,8 @@ namespace hbe
 } // namespace hbe
 
 #ifdef __UNIT_TEST__
+#include "Core/ScopedTime.h"
+#include "HSTL/HVector.h"
 
 namespace hbe
 {
@@ -332,6 +369,99 @@ namespace hbe
 				pool.Deallocate(ptr, allocSize);
 			}
 		});
+
+		AddTest("Huge Page Walk", [this](auto& ls)
+		{
+			struct Node final
+			{
+				Node* next;
+				uint64_t payload[7];
+			};
+
+			constexpr size_t NumNodes = 1 << 20;
+
+			// Chase pointers through the pool in a shuffled order, so nearly every step touches another page.
+			auto Walk = [](PoolAllocator& pool, time::TDuration& outDuration) -> uint64_t
+			{
+				HVector<Node*> nodes(NumNodes, nullptr);
+				for (auto& node : nodes)
+				{
+					node = static_cast<Node*>(pool.Allocate(sizeof(Node)));
+				}
+
+				uint32_t seed = 12345;
+				for (size_t i = NumNodes - 1; i > 0; --i)
+				{
+					seed = seed * 1664525U + 1013904223U;
+					std::swap(nodes[i], nodes[seed % (i + 1)]);
+				}
+
+				for (size_t i = 0; i < NumNodes; ++i)
+				{
+					nodes[i]->next = nodes[(i + 1) % NumNodes];
+					nodes[i]->payload[0] = i;
+				}
+
+				uint64_t sum = 0;
+				{
+					time::ScopedTime timer(outDuration);
+
+					const Node* node = nodes[0];
+					for (size_t i = 0; i < NumNodes; ++i)
+					{
+						sum += node->payload[0];
+						node = node->next;
+					}
+				}
+
+				for (auto* node : nodes)
+				{
+					pool.Deallocate(node, sizeof(Node));
+				}
+
+				return sum;
+			};
+
+			time::TDuration normalDuration;
+			time::TDuration hugeDuration;
+			uint64_t normalSum = 0;
+			uint64_t hugeSum = 0;
+
+			{
+				PoolAllocator pool("NormalPagePool", sizeof(Node), NumNodes);
+				normalSum = Walk(pool, normalDuration);
+			}
+
+			{
+				PoolAllocator pool("HugePagePool", sizeof(Node), NumNodes, {.hugePages = OS::EHugePages::Transparent});
+				if (!pool.IsMapped())
+				{
+					ls << "The huge page pool should be mapped from the OS." << lferr;
+				}
+
+				hugeSum = Walk(pool, hugeDuration);
+			}
+
+			constexpr uint64_t ExpectedSum = uint64_t(NumNodes) * (NumNodes - 1) / 2;
+			if (normalSum != ExpectedSum || hugeSum != ExpectedSum)
+			{
+				ls << "The walk has visited wrong nodes. " << normalSum << ", " << hugeSum << " != " << ExpectedSum
+				   << lferr;
+			}
+
+			const float normalSec = time::ToFloat(normalDuration);
+			const float hugeSec = time::ToFloat(hugeDuration);
+
+			ls << "Walking " << NumNodes << " nodes: normal pages = " << normalSec << " sec, huge pages = " << hugeSec
+			   << " sec" << lf;
+
+			constexpr float ToleranceFactor = 1.2f;
+			if (hugeSec > normalSec * ToleranceFactor)
+			{
+				ls << "Huge pages are slower than normal pages. " << hugeSec << " sec > " << normalSec << " sec"
+				   << lfwarn;
+			}
+		});
 	}
 
 } // namespace hbe
@@ -4,12 +4,25 @@
 
 #include "AllocatorID.h"
 #include "Core/Types.h"
+#include "OSAL/OSMemory.h"
 #include "OSAL/SourceLocation.h"
 #include "String/StaticString.h"
 
 namespace hbe
 {
 
+	/// @brief How the buffer of a PoolAllocator is allocated.
+	struct PoolBufferOptions final
+	{
+		// The buffer is aligned by over-allocating, if it's not zero.
+		size_t alignment = 0;
+		// The buffer is mapped from the OS instead of the parent allocator, if any of them is set.
+		OS::EHugePages hugePages = OS::EHugePages::Disabled;
+		int numaNode = OS::AnyNumaNode;
+
+		[[nodiscard]] bool IsMapped() const { return hugePages != OS::EHugePages::Disabled || numaNode >= 0; }
+	};
+
 	/// @brief Fixed-size block allocator for objects of a single type.
 	/// @details Pre-allocates a pool of memory blocks and manages free list.
 	/// Efficient for allocations of many objects of the same size.
@@ -28,6 +41,11 @@ namespace hbe
 
 		Byte* buffer;
 		Pointer availables;
+		// The buffer starts at bufferOffset of an allocation of bufferSize bytes, which is mapped from the OS if
+		// isMapped is set.
+		TSize bufferOffset;
+		TSize bufferSize;
+		bool isMapped;
 
 #if PROFILE_ENABLED
 		size_t maxUsedBlocks;
@@ -36,10 +54,10 @@ namespace hbe
 
 	public:
 #if PROFILE_ENABLED
-		PoolAllocator(const char* name, TSize blockSize, TSize numberOfBlocks,
+		PoolAllocator(const char* name, TSize blockSize, TSize numberOfBlocks, const PoolBufferOptions& options = {},
 					  hbe::source_location location = hbe::source_location::current());
 #else // PROFILE_ENABLED
-		PoolAllocator(const char* name, TSize blockSize, TSize numberOfBlocks);
+		PoolAllocator(const char* name, TSize blockSize, TSize numberOfBlocks, const PoolBufferOptions& options = {});
 #endif // PROFILE_ENABLED
 
 		PoolAllocator(PoolAllocator&& rhs) noexcept;
@@ -62,6 +80,7 @@ namespace hbe
 		[[nodiscard]] auto GetBlockSize() const { return blockSize; }
 		[[nodiscard]] auto NumberOfFreeBlocks() const { return numberOfFreeBlocks; }
 		[[nodiscard]] auto GetBuffer() const { return buffer; }
+		[[nodiscard]] bool IsMapped() const { return isMapped; }
 
 #if PROFILE_ENABLED
 		[[nodiscard]] auto GetUsedBlocksMax() const { return maxUsedBlocks; }
@@ -4,10 +4,12 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <bit>
 #include <map>
 #include "../Engine/Engine.h"
 #include "Config/BuildConfig.h"
+#include "Core/CommonMacros.h"
 #include "Core/SystemStatistics.h"
 #include "Log/Logger.h"
 #include "Memory/MemoryManager.h"
@@ -16,16 +18,75 @@
 namespace hbe
 {
 
+	namespace
+	{
+		using TSlotMask = uint64_t;
+		static_assert(ThreadSafeMultiPoolAllocator::MaxThreadCaches <= sizeof(TSlotMask) * 8);
+
+		std::atomic<TSlotMask> UsedThreadCacheSlots = 0;
+
+		// A slot is shared by all ThreadSafeMultiPoolAllocators, and released when the thread exits.
+		// The next owner of the slot takes over the cached blocks.
+		struct ThreadCacheSlotOwner final
+		{
+			int index = -1;
+
+			~ThreadCacheSlotOwner()
+			{
+				returnIf(index < 0);
+				UsedThreadCacheSlots.fetch_and(~(TSlotMask(1) << index), std::memory_order_release);
+			}
+		};
+
+		constexpr int UnassignedSlot = -2;
+		constexpr int NoSlot = -1;
+
+		// Kept apart from the owner, so the fast path doesn't go through the initialization guard of a thread_local
+		// with a destructor.
+		thread_local int CurrentSlot = UnassignedSlot;
+		thread_local ThreadCacheSlotOwner CurrentSlotOwner;
+
+		int AssignThreadCacheSlot()
+		{
+			CurrentSlot = NoSlot;
+
+			auto used = UsedThreadCacheSlots.load(std::memory_order_relaxed);
+			while (true)
+			{
+				const auto index = std::countr_one(used);
+				returnValueIf(NoSlot, index >= static_cast<int>(ThreadSafeMultiPoolAllocator::MaxThreadCaches));
+
+				const auto claimed = used | (TSlotMask(1) << index);
+				if (UsedThreadCacheSlots.compare_exchange_weak(used, claimed, std::memory_order_acquire,
+															   std::memory_order_relaxed))
+				{
+					CurrentSlotOwner.index = index;
+					CurrentSlot = index;
+					return index;
+				}
+			}
+		}
+
+		int GetThreadCacheSlot()
+		{
+			const auto slot = CurrentSlot;
+			returnValueIf(slot, likely(slot != UnassignedSlot));
+
+			return AssignThreadCacheSlot();
+		}
+	} // namespace
+
 	ThreadSafeMultiPoolAllocator::ThreadSafeMultiPoolAllocator(const char* inName, size_t allocationUnit,
 															   size_t minBlockSize)
 
 		:
 		id(InvalidAllocatorID), parentID(InvalidAllocatorID), name(inName), bankSize(allocationUnit),
-		minBlock(minBlockSize)
+		minBlock(minBlockSize), isThreadCacheEnabled(true)
 	{
 		using namespace hbe;
 
 		parentID = MemoryManager::GetCurrentAllocatorID();
+		InitThreadCaches();
 
 		auto allocFunc = [](void* allocPtr, size_t n) -> void*
 		{
@@ -57,11 +118,12 @@ namespace hbe
 
 		:
 		id(InvalidAllocatorID), parentID(InvalidAllocatorID), name(inName), bankSize(allocationUnit),
-		minBlock(minBlockSize)
+		minBlock(minBlockSize), isThreadCacheEnabled(true)
 	{
 		using namespace hbe;
 
 		parentID = MemoryManager::GetCurrentAllocatorID();
+		InitThreadCaches();
 
 		auto allocFunc = [](void* allocPtr, size_t n) -> void*
 		{
@@ -143,29 +205,30 @@ namespace hbe
 		}
 
 		void* ptr = nullptr;
-#if PROFILE_ENABLED
 		size_t allocated = 0;
-#endif // PROFILE_ENABLED
+
+		if (likely(requested <= GetMaxCachedBlockSize()))
 		{
-			std::lock_guard lockGuard(lock);
+			// Blocks of a size class are interchangeable, so they're allocated by the class size on either path.
+			const auto sizeClass = GetSizeClass(requested);
+			const auto classSize = minBlock << sizeClass;
+			allocated = classSize;
 
-			auto index = GetBankIndex(requested);
-			if (index >= banks.size())
+			auto* cache = GetThreadCache();
+			if (likely(cache != nullptr))
 			{
-				return NewBankAllocate(requested);
+				ptr = AllocateCached(*cache, sizeClass);
 			}
-
-			auto& bank = banks[index];
-			if (unlikely(bank.GetAvailableBlocks() <= 0))
+			else
 			{
-				return NewBankAllocate(requested);
+				std::lock_guard lockGuard(lock);
+				ptr = AllocateFromBanks(classSize, allocated);
 			}
-
-			ptr = bank.Allocate(requested);
-
-#if PROFILE_ENABLED
-			allocated = bank.GetBlockSize();
-#endif // PROFILE_ENABLED
+		}
+		else
+		{
+			std::lock_guard lockGuard(lock);
+			ptr = AllocateFromBanks(requested, allocated);
 		}
 
 #if PROFILE_ENABLED
@@ -189,6 +252,25 @@ namespace hbe
 #if PROFILE_ENABLED
 		size_t allocated = 0;
 #endif // PROFILE_ENABLED
+
+		// The size class is unknown when the size isn't given, so it goes back to its bank.
+		if (likely(size > 0 && size <= GetMaxCachedBlockSize()))
+		{
+			auto* cache = GetThreadCache();
+			if (likely(cache != nullptr))
+			{
+				const auto sizeClass = GetSizeClass(size);
+				DeallocateCached(*cache, sizeClass, ptr);
+
+#if PROFILE_ENABLED
+				auto& mmgr = MemoryManager::GetInstance();
+				mmgr.ReportDeallocation(GetID(), ptr, size, minBlock << sizeClass);
+#endif // PROFILE_ENABLED
+
+				return;
+			}
+		}
+
 		{
 			std::lock_guard lockGuard(lock);
 
@@ -309,7 +391,155 @@ namespace hbe
 	}
 #endif // PROFILE_ENABLED
 
-	void* ThreadSafeMultiPoolAllocator::NewBankAllocate(size_t size)
+	void ThreadSafeMultiPoolAllocator::InitThreadCaches()
+	{
+		Assert(minBlock >= sizeof(FreeBlock), "The minimum block size(%zu) can't hold free list links.", minBlock);
+		Assert(std::has_single_bit(minBlock), "The minimum block size(%zu) should be a power of two.", minBlock);
+
+		for (auto& cache : threadCaches)
+		{
+			for (auto& magazine : cache.magazines)
+			{
+				magazine.head = nullptr;
+				magazine.count = 0;
+			}
+		}
+
+		for (auto& depot : depots)
+		{
+			depot.batches = nullptr;
+		}
+	}
+
+	ThreadSafeMultiPoolAllocator::ThreadCache* ThreadSafeMultiPoolAllocator::GetThreadCache()
+	{
+		returnValueIf(nullptr, unlikely(!isThreadCacheEnabled));
+
+		const auto slot = GetThreadCacheSlot();
+		returnValueIf(nullptr, unlikely(slot < 0));
+
+		return &threadCaches[slot];
+	}
+
+	size_t ThreadSafeMultiPoolAllocator::GetSizeClass(size_t requested) const
+	{
+		// minBlock is a power of two, so it's bit_width(ceil(requested / minBlock) - 1) without a division.
+		return std::bit_width((requested - 1) >> std::countr_zero(minBlock));
+	}
+
+	void* ThreadSafeMultiPoolAllocator::AllocateCached(ThreadCache& cache, size_t sizeClass)
+	{
+		auto& magazine = cache.magazines[sizeClass];
+		if (unlikely(magazine.head == nullptr))
+		{
+			Refill(magazine, sizeClass);
+			returnValueIf(nullptr, unlikely(magazine.head == nullptr));
+		}
+
+		auto* block = magazine.head;
+		magazine.head = block->next;
+		--magazine.count;
+
+		return block;
+	}
+
+	void ThreadSafeMultiPoolAllocator::DeallocateCached(ThreadCache& cache, size_t sizeClass, void* ptr)
+	{
+		auto& magazine = cache.magazines[sizeClass];
+
+		auto* block = static_cast<FreeBlock*>(ptr);
+		block->next = magazine.head;
+		magazine.head = block;
+		++magazine.count;
+
+		if (unlikely(magazine.count >= MagazineCapacity))
+		{
+			Flush(magazine, sizeClass);
+		}
+	}
+
+	void ThreadSafeMultiPoolAllocator::Refill(Magazine& magazine, size_t sizeClass)
+	{
+		// Batches flushed by the other threads first.
+		{
+			auto& depot = depots[sizeClass];
+			std::lock_guard lockGuard(depot.lock);
+
+			auto* batch = depot.batches;
+			if (batch != nullptr)
+			{
+				depot.batches = batch->nextBatch;
+
+				magazine.head = batch;
+				magazine.count = MagazineBatch;
+				return;
+			}
+		}
+
+		const auto blockSize = minBlock << sizeClass;
+
+		FreeBlock* head = nullptr;
+		uint32_t count = 0;
+		{
+			std::lock_guard lockGuard(lock);
+
+			for (; count < MagazineBatch; ++count)
+			{
+				size_t allocated = 0;
+				auto* block = static_cast<FreeBlock*>(AllocateFromBanks(blockSize, allocated));
+				breakIf(unlikely(block == nullptr));
+
+				block->next = head;
+				head = block;
+			}
+		}
+
+		magazine.head = head;
+		magazine.count = count;
+	}
+
+	void ThreadSafeMultiPoolAllocator::Flush(Magazine& magazine, size_t sizeClass)
+	{
+		static_assert(MagazineCapacity == MagazineBatch * 2);
+		Assert(magazine.count == MagazineCapacity);
+
+		// Keep the most recently freed blocks, as they're likely to be in the cache, and flush the rest as a batch.
+		auto* last = magazine.head;
+		for (uint32_t i = 1; i < MagazineBatch; ++i)
+		{
+			last = last->next;
+		}
+
+		auto* batch = last->next;
+		last->next = nullptr;
+		magazine.count = MagazineBatch;
+
+		auto& depot = depots[sizeClass];
+		std::lock_guard lockGuard(depot.lock);
+
+		batch->nextBatch = depot.batches;
+		depot.batches = batch;
+	}
+
+	void* ThreadSafeMultiPoolAllocator::AllocateFromBanks(size_t size, size_t& outAllocated)
+	{
+		auto index = GetBankIndex(size);
+		if (index >= banks.size())
+		{
+			return NewBankAllocate(size, outAllocated);
+		}
+
+		auto& bank = banks[index];
+		if (unlikely(bank.GetAvailableBlocks() <= 0))
+		{
+			return NewBankAllocate(size, outAllocated);
+		}
+
+		outAllocated = bank.GetBlockSize();
+		return bank.Allocate(size);
+	}
+
+	void* ThreadSafeMultiPoolAllocator::NewBankAllocate(size_t size, size_t& outAllocated)
 	{
 		auto& engine = Engine::Get();
 		auto& statistics = engine.GetStatistics();
@@ -327,16 +557,9 @@ namespace hbe
 		}
 
 		auto& bank = banks[index];
-		auto ptr = bank.Allocate(size);
-
-#ifdef PROFILE_ENABLED
-		{
-			auto& mmgr = MemoryManager::GetInstance();
-			mmgr.ReportAllocation(GetID(), ptr, size, bank.GetBlockSize());
-		}
-#endif // PROFILE_ENABLED
+		outAllocated = bank.GetBlockSize();
 
-		return ptr;
+		return bank.Allocate(size);
 	}
 
 	bool ThreadSafeMultiPoolAllocator::GenerateBanksByCache(const MemoryManager& mmgr)
@@ -463,6 +686,9 @@ namespace hbe
 } // namespace hbe
 
 #ifdef __UNIT_TEST__
+#include <barrier>
+#include <cstdlib>
+#include <thread>
 #include "AllocatorScope.h"
 #include "Core/ScopedTime.h"
 
@@ -617,6 +843,153 @@ namespace hbe
 				   << lfwarn;
 			}
 		});
+
+		AddTest("Cross-Thread Deallocation", [this](auto& ls)
+		{
+			constexpr int NumBlocks = 10000;
+
+			ThreadSafeMultiPoolAllocator allocator("CrossThreadMultiPoolAlloc");
+
+			HVector<uint32_t*> blocks(NumBlocks, nullptr);
+			std::thread producer([&]()
+			{
+				for (int i = 0; i < NumBlocks; ++i)
+				{
+					auto* block = static_cast<uint32_t*>(allocator.Allocate(sizeof(uint32_t) * (1 + i % 64)));
+					*block = static_cast<uint32_t>(i);
+					blocks[i] = block;
+				}
+			});
+			producer.join();
+
+			// Freed on another thread, and then reused by this one.
+			for (int i = 0; i < NumBlocks; ++i)
+			{
+				if (*blocks[i] != static_cast<uint32_t>(i))
+				{
+					ls << "Block " << i << " has been corrupted." << lferr;
+					return;
+				}
+
+				allocator.Deallocate(blocks[i], sizeof(uint32_t) * (1 + i % 64));
+			}
+
+			for (int i = 0; i < NumBlocks; ++i)
+			{
+				blocks[i] = static_cast<uint32_t*>(allocator.Allocate(sizeof(uint32_t) * (1 + i % 64)));
+				*blocks[i] = static_cast<uint32_t>(i);
+			}
+
+			for (int i = 0; i < NumBlocks; ++i)
+			{
+				if (*blocks[i] != static_cast<uint32_t>(i))
+				{
+					ls << "Block " << i << " is shared by another allocation." << lferr;
+					return;
+				}
+
+				allocator.Deallocate(blocks[i], sizeof(uint32_t) * (1 + i % 64));
+			}
+		});
+
+		AddTest("Multi-Threaded Performance", [this](auto& ls)
+		{
+			constexpr int NumRounds = 100;
+			constexpr int NumBlocksPerRound = 1024;
+			constexpr int ThreadCounts[] = {1, 2, 4, 8};
+
+			struct Functions final
+			{
+				void* (*allocate)(void* context, size_t size);
+				void (*deallocate)(void* context, void* ptr, size_t size);
+				void* context;
+			};
+
+			// Each thread allocates blocks of mixed sizes every round, and frees the ones allocated by its neighbour.
+			auto Run = [](const Functions& funcs, int numThreads) -> float
+			{
+				HVector<HVector<void*>> slots(numThreads, HVector<void*>(NumBlocksPerRound, nullptr));
+				std::barrier sync(numThreads);
+
+				auto Work = [&](int threadIndex)
+				{
+					auto& mine = slots[threadIndex];
+					auto& neighbours = slots[(threadIndex + 1) % numThreads];
+					uint32_t seed = 2654435761U * (threadIndex + 1);
+
+					for (int round = 0; round < NumRounds; ++round)
+					{
+						for (auto& ptr : mine)
+						{
+							seed = seed * 1664525U + 1013904223U;
+							const size_t size = 16 + (seed >> 16) % 1008;
+
+							ptr = funcs.allocate(funcs.context, size);
+							*static_cast<size_t*>(ptr) = size;
+						}
+
+						sync.arrive_and_wait();
+
+						for (auto& ptr : neighbours)
+						{
+							funcs.deallocate(funcs.context, ptr, *static_cast<size_t*>(ptr));
+							ptr = nullptr;
+						}
+
+						sync.arrive_and_wait();
+					}
+				};
+
+				time::TDuration duration;
+				{
+					time::ScopedTime timer(duration);
+
+					HVector<std::thread> threads;
+					for (int i = 0; i < numThreads; ++i)
+					{
+						threads.emplace_back(Work, i);
+					}
+
+					for (auto& thread : threads)
+					{
+						thread.join();
+					}
+				}
+
+				return time::ToFloat(duration);
+			};
+
+			ThreadSafeMultiPoolAllocator allocator("MTPerfTestMultiPoolAlloc");
+
+			const Functions mallocFuncs = {[](void*, size_t size) { return std::malloc(size); },
+										   [](void*, void* ptr, size_t) { std::free(ptr); }, nullptr};
+
+			const Functions poolFuncs = {[](void* context, size_t size)
+										 { return static_cast<ThreadSafeMultiPoolAllocator*>(context)->Allocate(size); },
+										 [](void* context, void* ptr, size_t size)
+										 { static_cast<ThreadSafeMultiPoolAllocator*>(context)->Deallocate(ptr, size); },
+										 &allocator};
+
+			for (auto numThreads : ThreadCounts)
+			{
+				const float mallocSec = Run(mallocFuncs, numThreads);
+
+				allocator.SetThreadCacheEnabled(false);
+				const float lockedSec = Run(poolFuncs, numThreads);
+
+				allocator.SetThreadCacheEnabled(true);
+				const float cachedSec = Run(poolFuncs, numThreads);
+
+				ls << numThreads << " threads: Cached = " << cachedSec << " sec, Locked = " << lockedSec
+				   << " sec, std malloc = " << mallocSec << " sec" << lf;
+
+				if (cachedSec > mallocSec)
+				{
+					ls << "ThreadSafeMultiPoolAllocator is slower than std malloc with " << numThreads
+					   << " threads. Cached = " << cachedSec << " sec, std malloc = " << mallocSec << " sec" << lfwarn;
+				}
+			}
+		});
 	}
 
 } // namespace hbe
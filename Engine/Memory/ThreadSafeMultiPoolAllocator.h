@@ -2,7 +2,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <mutex>
 #include "Config/BuildConfig.h"
+#include "Config/EngineConfig.h"
 #include "HSTL/HVector.h"
 #include "PoolAllocator.h"
 #include "PoolConfig.h"
@@ -11,8 +15,12 @@
 namespace hbe
 {
 	/// @brief Thread-safe multi-pool allocator with multiple block sizes.
-	/// @details Manages multiple pool allocators of different block sizes.
-	/// Uses mutex synchronization for thread safety.
+	/// @details Manages multiple pool allocators of different block sizes, guarded by a mutex.
+	/// Small blocks are served from per-thread caches (magazines) in front of the banks, so most calls don't take
+	/// the lock. Each thread keeps a short free list per size class, refilled from the banks in batches under the
+	/// lock. A full magazine flushes half of its blocks as a batch to the depot of its size class, which is where
+	/// blocks freed by another thread end up, and an empty one takes a batch from the depot before the banks.
+	/// Blocks in the caches still count as used in the bank statistics.
 	class ThreadSafeMultiPoolAllocator final
 	{
 	public:
@@ -22,9 +30,41 @@ namespace hbe
 		static constexpr size_t DefaultBankUnit = 1024ULL * 1024;
 		static constexpr size_t MinNumberOfBlocks = 16;
 
+		// Size classes are minBlock * 2^n. Larger blocks always go to the banks under the lock.
+		static constexpr size_t NumCachedClasses = 8;
+		static constexpr uint32_t MagazineCapacity = 32;
+		static constexpr uint32_t MagazineBatch = MagazineCapacity / 2;
+		// Threads beyond this number don't have a cache, and use the locked path.
+		static constexpr size_t MaxThreadCaches = 64;
+
 	private:
 		using TInitializerList = std::initializer_list<PoolConfig>;
 
+		struct FreeBlock final
+		{
+			FreeBlock* next;
+			// Valid on the first block of a batch in a depot.
+			FreeBlock* nextBatch;
+		};
+
+		struct Magazine final
+		{
+			FreeBlock* head;
+			uint32_t count;
+		};
+
+		struct alignas(Config::CacheLineSize) ThreadCache final
+		{
+			std::array<Magazine, NumCachedClasses> magazines;
+		};
+
+		// Full batches of MagazineBatch blocks, exchanged between the thread caches.
+		struct alignas(Config::CacheLineSize) Depot final
+		{
+			std::mutex lock;
+			FreeBlock* batches;
+		};
+
 		TAllocatorID id;
 		TAllocatorID parentID;
 		StaticString name;
@@ -34,6 +74,12 @@ namespace hbe
 		size_t bankSize;
 		size_t minBlock;
 
+		// Indexed by the thread cache slot. Each slot is owned by a single thread at a time.
+		std::array<ThreadCache, MaxThreadCaches> threadCaches;
+		// Flushed batches per size class, guarded by their own locks so they don't contend with the banks.
+		std::array<Depot, NumCachedClasses> depots;
+		bool isThreadCacheEnabled;
+
 	public:
 		explicit ThreadSafeMultiPoolAllocator(const char* name, size_t allocationUnit = DefaultBankUnit,
 											  size_t minBlockSize = DefaultMinBlock);
@@ -47,6 +93,10 @@ namespace hbe
 		[[nodiscard]] auto GetName() const { return name; }
 		[[nodiscard]] auto GetID() const { return id; }
 
+		// For benchmarks against the locked path. It should not be changed while other threads use the allocator.
+		void SetThreadCacheEnabled(bool isEnabled) { isThreadCacheEnabled = isEnabled; }
+		[[nodiscard]] bool IsThreadCacheEnabled() const { return isThreadCacheEnabled; }
+
 		void PrintUsage();
 
 #if PROFILE_ENABLED
@@ -54,7 +104,18 @@ namespace hbe
 #endif // PROFILE_ENABLED
 
 	private:
-		void* NewBankAllocate(size_t size);
+		void InitThreadCaches();
+		[[nodiscard]] ThreadCache* GetThreadCache();
+		[[nodiscard]] size_t GetSizeClass(size_t requested) const;
+		[[nodiscard]] size_t GetMaxCachedBlockSize() const { return minBlock << (NumCachedClasses - 1); }
+		void* AllocateCached(ThreadCache& cache, size_t sizeClass);
+		void DeallocateCached(ThreadCache& cache, size_t sizeClass, void* ptr);
+		void Refill(Magazine& magazine, size_t sizeClass);
+		void Flush(Magazine& magazine, size_t sizeClass);
+
+		// The lock should be held.
+		void* AllocateFromBanks(size_t size, size_t& outAllocated);
+		void* NewBankAllocate(size_t size, size_t& outAllocated);
 		bool GenerateBanksByCache(const class MemoryManager& mmgr);
 		[[nodiscard]] size_t GetBankIndex(size_t nBytes) const;
 		[[nodiscard]] size_t GetBankIndex(void* ptr) const;
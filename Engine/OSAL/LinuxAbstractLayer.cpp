@@ -6,6 +6,8 @@
 #ifdef PLATFORM_LINUX
 #include <cstdio>
 #include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "String/StringUtil.h"
 
@@ -44,6 +46,15 @@ bool IsDirectory(const char* path)
 	return false;
 }
 
+bool MakeDirectory(const char* path)
+{
+	returnValueIf(true, IsDirectory(path));
+
+	return mkdir(path, 0755) == 0;
+}
+
+bool DeleteDirectory(const char* path) { return rmdir(path) == 0; }
+
 HVector<HString> ListFilesInDirectory(const char* path)
 {
 	HVector<HString> fileList;
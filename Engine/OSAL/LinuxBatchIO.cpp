@@ -0,0 +1,303 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "OSBatchIO.h"
+
+#include "Core/CommonMacros.h"
+#include "Log/Logger.h"
+#include "String/StringUtil.h"
+
+#ifdef PLATFORM_LINUX
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace OS
+{
+
+/// @brief io_uring by the system calls, with the submission and completion queues mapped.
+class IOUring final
+{
+public:
+	int fd;
+
+	void* sqMemory;
+	size_t sqMemorySize;
+	void* cqMemory;
+	size_t cqMemorySize;
+	io_uring_sqe* sqes;
+	size_t sqesSize;
+
+	uint32_t* sqHead;
+	uint32_t* sqTail;
+	uint32_t* sqArray;
+	uint32_t sqMask;
+	uint32_t* cqHead;
+	uint32_t* cqTail;
+	io_uring_cqe* cqes;
+	uint32_t cqMask;
+
+	// Entries filled, published to the kernel by Submit.
+	uint32_t localTail;
+	uint32_t numToSubmit;
+};
+
+namespace
+{
+
+int Setup(uint32_t numEntries, io_uring_params& params) noexcept
+{
+	return static_cast<int>(syscall(__NR_io_uring_setup, numEntries, &params));
+}
+
+int Enter(int fd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags) noexcept
+{
+	return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+bool IsSupported(int fd) noexcept
+{
+	constexpr uint32_t MaxOps = 256;
+	constexpr size_t size = sizeof(io_uring_probe) + MaxOps * sizeof(io_uring_probe_op);
+
+	auto probe = static_cast<io_uring_probe*>(std::calloc(1, size));
+	returnValueIf(false, probe == nullptr);
+
+	bool isSupported = syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, MaxOps) >= 0;
+	for (auto op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE})
+	{
+		breakIf(!isSupported);
+		isSupported = op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+	}
+
+	std::free(probe);
+
+	return isSupported;
+}
+
+template<typename T>
+T* Offset(void* base, uint32_t offset) noexcept
+{
+	return reinterpret_cast<T*>(static_cast<uint8_t*>(base) + offset);
+}
+
+} // namespace
+
+IOUring* BatchIO::CreateRing(uint32_t queueDepth) noexcept
+{
+	using namespace hbe;
+	using namespace StringUtil;
+
+	static auto log = Logger::Get(ToFunctionName(__PRETTY_FUNCTION__));
+
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+
+	int fd = Setup(queueDepth, params);
+	if (unlikely(fd < 0))
+	{
+		log.OutWarning([](auto& ls) { ls << "io_uring isn't available. reason(" << std::strerror(errno) << ')'; });
+
+		return nullptr;
+	}
+
+	if (unlikely(!IsSupported(fd)))
+	{
+		log.OutWarning([](auto& ls) { ls << "io_uring doesn't support open/read/close."; });
+		close(fd);
+
+		return nullptr;
+	}
+
+	auto ring = new IOUring();
+	ring->fd = fd;
+
+	ring->sqMemorySize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	ring->cqMemorySize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+	const bool isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (isSingleMap)
+	{
+		ring->sqMemorySize = std::max(ring->sqMemorySize, ring->cqMemorySize);
+		ring->cqMemorySize = ring->sqMemorySize;
+	}
+
+	ring->sqMemory = mmap(nullptr, ring->sqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+		IORING_OFF_SQ_RING);
+	ring->cqMemory = isSingleMap ? ring->sqMemory
+		: mmap(nullptr, ring->cqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+			IORING_OFF_CQ_RING);
+
+	ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+	auto sqes = mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+		IORING_OFF_SQES);
+	ring->sqes = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe*>(sqes);
+
+	if (unlikely(ring->sqMemory == MAP_FAILED || ring->cqMemory == MAP_FAILED || ring->sqes == nullptr))
+	{
+		log.OutWarning([](auto& ls) { ls << "io_uring mapping failed. reason(" << std::strerror(errno) << ')'; });
+		DestroyRing(ring);
+
+		return nullptr;
+	}
+
+	ring->sqHead = Offset<uint32_t>(ring->sqMemory, params.sq_off.head);
+	ring->sqTail = Offset<uint32_t>(ring->sqMemory, params.sq_off.tail);
+	ring->sqArray = Offset<uint32_t>(ring->sqMemory, params.sq_off.array);
+	ring->sqMask = *Offset<uint32_t>(ring->sqMemory, params.sq_off.ring_mask);
+	ring->cqHead = Offset<uint32_t>(ring->cqMemory, params.cq_off.head);
+	ring->cqTail = Offset<uint32_t>(ring->cqMemory, params.cq_off.tail);
+	ring->cqes = Offset<io_uring_cqe>(ring->cqMemory, params.cq_off.cqes);
+	ring->cqMask = *Offset<uint32_t>(ring->cqMemory, params.cq_off.ring_mask);
+
+	ring->localTail = *ring->sqTail;
+	ring->numToSubmit = 0;
+
+	return ring;
+}
+
+void BatchIO::DestroyRing(IOUring* ring) noexcept
+{
+	returnIf(ring == nullptr);
+
+	if (ring->sqes != nullptr)
+	{
+		munmap(ring->sqes, ring->sqesSize);
+	}
+
+	if (ring->cqMemory != MAP_FAILED && ring->cqMemory != ring->sqMemory)
+	{
+		munmap(ring->cqMemory, ring->cqMemorySize);
+	}
+
+	if (ring->sqMemory != MAP_FAILED)
+	{
+		munmap(ring->sqMemory, ring->sqMemorySize);
+	}
+
+	close(ring->fd);
+	delete ring;
+}
+
+void BatchIO::PushRing(IOUring& ring, const BatchIORequest& request) noexcept
+{
+	const uint32_t index = ring.localTail & ring.sqMask;
+	auto& sqe = ring.sqes[index];
+	std::memset(&sqe, 0, sizeof(sqe));
+
+	switch (request.type)
+	{
+	case EBatchIOType::Open:
+		sqe.opcode = IORING_OP_OPENAT;
+		sqe.fd = AT_FDCWD;
+		sqe.addr = reinterpret_cast<uint64_t>(request.path);
+		sqe.len = S_IRUSR | S_IWUSR;
+		sqe.open_flags = static_cast<uint32_t>(request.openMode.value);
+		break;
+
+	case EBatchIOType::Read:
+		sqe.opcode = IORING_OP_READ;
+		sqe.fd = request.fd;
+		sqe.addr = reinterpret_cast<uint64_t>(request.buffer);
+		sqe.len = static_cast<uint32_t>(request.size);
+		sqe.off = request.offset;
+		break;
+
+	case EBatchIOType::Close:
+		sqe.opcode = IORING_OP_CLOSE;
+		sqe.fd = request.fd;
+		break;
+	}
+
+	sqe.user_data = reinterpret_cast<uint64_t>(request.userData);
+	ring.sqArray[index] = index;
+
+	++ring.localTail;
+	++ring.numToSubmit;
+}
+
+int BatchIO::SubmitRing(IOUring& ring, bool shouldWait) noexcept
+{
+	std::atomic_ref<uint32_t>(*ring.sqTail).store(ring.localTail, std::memory_order_release);
+
+	const uint32_t flags = shouldWait ? IORING_ENTER_GETEVENTS : 0;
+	int result = 0;
+
+	do
+	{
+		result = Enter(ring.fd, ring.numToSubmit, shouldWait ? 1 : 0, flags);
+	}
+	while (result < 0 && errno == EINTR);
+
+	returnValueIf(-errno, result < 0);
+
+	ring.numToSubmit -= static_cast<uint32_t>(result);
+
+	return result;
+}
+
+void BatchIO::CancelRing(IOUring& ring, std::vector<BatchIOCompletion>& outCompletions, int64_t error) noexcept
+{
+	// The kernel takes the entries only in io_uring_enter, so the ones after what it has taken can be withdrawn.
+	for (uint32_t i = ring.numToSubmit; i > 0; --i)
+	{
+		const uint32_t index = (ring.localTail - i) & ring.sqMask;
+		outCompletions.push_back({reinterpret_cast<void*>(ring.sqes[index].user_data), error});
+	}
+
+	ring.localTail -= ring.numToSubmit;
+	ring.numToSubmit = 0;
+	std::atomic_ref<uint32_t>(*ring.sqTail).store(ring.localTail, std::memory_order_release);
+}
+
+size_t BatchIO::PollRing(IOUring& ring, BatchIOCompletion* outCompletions, size_t capacity) noexcept
+{
+	std::atomic_ref<uint32_t> head(*ring.cqHead);
+	std::atomic_ref<uint32_t> tail(*ring.cqTail);
+
+	uint32_t current = head.load(std::memory_order_relaxed);
+	const uint32_t last = tail.load(std::memory_order_acquire);
+
+	size_t count = 0;
+	for (; current != last && count < capacity; ++current, ++count)
+	{
+		auto& cqe = ring.cqes[current & ring.cqMask];
+		outCompletions[count] = {reinterpret_cast<void*>(cqe.user_data), cqe.res};
+	}
+
+	head.store(current, std::memory_order_release);
+
+	return count;
+}
+
+int64_t BatchIO::RunBlocking(const BatchIORequest& request) noexcept
+{
+	int64_t result = 0;
+
+	switch (request.type)
+	{
+	case EBatchIOType::Open:
+		result = ::open(request.path, request.openMode.value, S_IRUSR | S_IWUSR);
+		break;
+
+	case EBatchIOType::Read:
+		result = pread(request.fd, request.buffer, request.size, static_cast<off_t>(request.offset));
+		break;
+
+	case EBatchIOType::Close:
+		result = close(request.fd);
+		break;
+	}
+
+	return result < 0 ? -errno : result;
+}
+
+} // namespace OS
+#endif // PLATFORM_LINUX
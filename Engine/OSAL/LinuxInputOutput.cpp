@@ -16,6 +16,7 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace OS
@@ -88,6 +89,12 @@ bool Delete(hbe::StaticString filePath) noexcept
 	return rc == 0;
 }
 
+bool Rename(hbe::StaticString fromPath, hbe::StaticString toPath) noexcept
+{
+	auto rc = rename(fromPath.c_str(), toPath.c_str());
+	return rc == 0;
+}
+
 size_t Read(const FileHandle& handle, void* buffer, size_t size) noexcept
 {
 	using namespace hbe;
@@ -176,6 +183,43 @@ size_t Write(const FileHandle& handle, void* buffer, size_t size) noexcept
 	return result;
 }
 
+size_t WriteV(const FileHandle& handle, const IOVector* vectors, size_t count) noexcept
+{
+	using namespace hbe;
+	using namespace StringUtil;
+
+	static_assert(sizeof(IOVector) == sizeof(iovec) && offsetof(IOVector, data) == offsetof(iovec, iov_base)
+		&& offsetof(IOVector, size) == offsetof(iovec, iov_len));
+
+	static auto log = Logger::Get(ToFunctionName(__PRETTY_FUNCTION__));
+
+	int fd = handle.fd;
+	if (unlikely(fd < 0))
+	{
+		log.OutWarning([fd](auto& ls) { ls << "Invalid file handle (fd:" << fd << ")."; });
+
+		return 0;
+	}
+
+	if (unlikely(vectors == nullptr || count == 0))
+	{
+		log.OutWarning([](auto& ls) { ls << "No buffer to write."; });
+
+		return 0;
+	}
+
+	auto result = writev(fd, reinterpret_cast<const iovec*>(vectors), static_cast<int>(count));
+	if (unlikely(result < 0))
+	{
+		log.OutWarning([count](auto& ls)
+		{ ls << "Write of " << count << " buffers failed. Reason(" << std::strerror(errno) << ')'; });
+
+		return 0;
+	}
+
+	return static_cast<size_t>(result);
+}
+
 bool Truncate(const FileHandle& handle, size_t size) noexcept
 {
 	using namespace hbe;
@@ -4,20 +4,120 @@
 
 #ifdef PLATFORM_LINUX
 #include <cerrno>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <malloc.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
+#include "Core/CommonMacros.h"
 #include "Core/Debug.h"
 #include "Intrinsic.h"
 
+namespace
+{
+	// From <numaif.h>, which needs libnuma.
+	constexpr int MemPolicyPreferred = 1;
+	constexpr size_t DefaultHugePageSize = 2 * 1024 * 1024;
+
+	size_t ReadHugePageSize()
+	{
+		auto* file = fopen("/proc/meminfo", "r");
+		returnValueIf(DefaultHugePageSize, file == nullptr);
+
+		size_t kiloBytes = 0;
+		char line[256];
+		while (fgets(line, sizeof(line), file) != nullptr)
+		{
+			breakIf(sscanf(line, "Hugepagesize: %zu kB", &kiloBytes) == 1);
+		}
+
+		fclose(file);
+
+		return kiloBytes > 0 ? kiloBytes * 1024 : DefaultHugePageSize;
+	}
+
+	int ReadNumNumaNodes()
+	{
+		// A list of node ranges such as "0" or "0-3".
+		auto* file = fopen("/sys/devices/system/node/possible", "r");
+		returnValueIf(1, file == nullptr);
+
+		char list[256] = {};
+		const bool isRead = fgets(list, sizeof(list), file) != nullptr;
+		fclose(file);
+
+		returnValueIf(1, !isRead);
+
+		int lastNode = 0;
+		for (const char* cursor = list; *cursor != '\0'; ++cursor)
+		{
+			continueIf(*cursor < '0' || *cursor > '9');
+
+			lastNode = atoi(cursor);
+			while (cursor[1] >= '0' && cursor[1] <= '9')
+			{
+				++cursor;
+			}
+		}
+
+		return lastNode + 1;
+	}
+
+	void* MapAligned(size_t size, size_t alignment)
+	{
+		const auto mappedSize = size + alignment;
+		auto* mapped = static_cast<uint8_t*>(
+			mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+		returnValueIf(MAP_FAILED, mapped == MAP_FAILED);
+
+		const auto address = reinterpret_cast<uintptr_t>(mapped);
+		auto* aligned = mapped + (((address + alignment - 1) & ~(alignment - 1)) - address);
+
+		const auto headSize = static_cast<size_t>(aligned - mapped);
+		if (headSize > 0)
+		{
+			munmap(mapped, headSize);
+		}
+
+		const auto tailSize = mappedSize - headSize - size;
+		if (tailSize > 0)
+		{
+			munmap(aligned + size, tailSize);
+		}
+
+		return aligned;
+	}
+} // namespace
+
 size_t OS::GetAllocSize(void* ptr) noexcept { return malloc_usable_size(ptr); }
 
 size_t OS::GetPageSize() noexcept { return sysconf(_SC_PAGESIZE); }
 
+size_t OS::GetHugePageSize() noexcept
+{
+	static const size_t hugePageSize = ReadHugePageSize();
+	return hugePageSize;
+}
+
+int OS::GetNumNumaNodes() noexcept
+{
+	static const int numNodes = ReadNumNumaNodes();
+	return numNodes;
+}
+
+int OS::GetCurrentNumaNode() noexcept
+{
+	unsigned int cpu = 0;
+	unsigned int node = 0;
+	returnValueIf(0, syscall(SYS_getcpu, &cpu, &node, nullptr) != 0);
+
+	return static_cast<int>(node);
+}
+
 void* OS::VirtualAlloc(size_t size)
 {
 	auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
@@ -25,6 +125,40 @@ void* OS::VirtualAlloc(size_t size)
 	return ptr;
 }
 
+void* OS::VirtualAlloc(size_t size, EHugePages hugePages, int numaNode)
+{
+	void* ptr = MAP_FAILED;
+
+	if (hugePages == EHugePages::Explicit)
+	{
+		ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	}
+
+	if (ptr == MAP_FAILED && hugePages != EHugePages::Disabled)
+	{
+		ptr = MapAligned(size, GetHugePageSize());
+		if (ptr != MAP_FAILED)
+		{
+			// It fails if transparent huge pages are disabled, and then the range is backed by normal pages.
+			madvise(ptr, size, MADV_HUGEPAGE);
+		}
+	}
+
+	if (ptr == MAP_FAILED)
+	{
+		ptr = VirtualAlloc(size);
+	}
+
+	// No page has been touched yet, so the policy applies to all of them. It fails without NUMA support.
+	if (ptr != MAP_FAILED && numaNode >= 0 && numaNode < static_cast<int>(sizeof(unsigned long) * 8 - 1))
+	{
+		const unsigned long nodeMask = 1UL << numaNode;
+		syscall(SYS_mbind, ptr, size, MemPolicyPreferred, &nodeMask, sizeof(nodeMask) * 8, 0);
+	}
+
+	return ptr;
+}
+
 // BUG FIX: Memory allocated with mmap() must be freed with munmap(), not free()
 // Using free() on mmap'd memory causes undefined behavior and heap corruption
 void OS::VirtualFree(void* address, std::size_t size) noexcept { munmap(address, size); }
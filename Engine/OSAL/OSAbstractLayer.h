@@ -30,6 +30,10 @@ namespace OS
 hbe::HString GetFullPath(const hbe::HString& path);
 
 bool IsDirectory(const char* path);
+// Return true if the directory exists after the call.
+bool MakeDirectory(const char* path);
+// Delete an empty directory.
+bool DeleteDirectory(const char* path);
 
 hbe::HVector<hbe::HString> ListFilesInDirectory(const char* path);
 
@@ -0,0 +1,543 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "OSBatchIO.h"
+
+#include <algorithm>
+#include "Core/CommonMacros.h"
+#include "Intrinsic.h"
+
+namespace OS
+{
+
+BatchIO::BatchIO(uint32_t queueDepth, bool allowKernelQueue, uint32_t numThreads) noexcept
+	: queueDepth(std::max(queueDepth, 1u))
+	, numInFlight(0)
+	, numQueued(0)
+	, ring(allowKernelQueue ? CreateRing(this->queueDepth) : nullptr)
+	, isStopping(false)
+{
+	returnIf(ring != nullptr);
+
+	queued.reserve(this->queueDepth);
+	completions.reserve(this->queueDepth);
+
+	numThreads = std::clamp(numThreads, 1u, this->queueDepth);
+	threads.reserve(numThreads);
+
+	for (uint32_t i = 0; i < numThreads; ++i)
+	{
+		threads.emplace_back([this]() { RunThread(); });
+	}
+}
+
+BatchIO::~BatchIO() noexcept
+{
+	// The requests in flight should be completed, or the buffers and the file descriptors would be left to the kernel.
+	while (numInFlight > 0)
+	{
+		// Nothing completes if the kernel queue has failed, and then the ring teardown cancels the rest.
+		BatchIOCompletion discarded[64];
+		breakIf(Poll(discarded, std::size(discarded), true) == 0);
+	}
+
+	DestroyRing(ring);
+
+	{
+		std::lock_guard guard(lock);
+		isStopping = true;
+	}
+
+	requestCondition.notify_all();
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+bool BatchIO::Push(const BatchIORequest& request) noexcept
+{
+	returnValueIf(false, numInFlight >= queueDepth);
+
+	if (ring != nullptr)
+	{
+		PushRing(*ring, request);
+	}
+	else
+	{
+		queued.push_back(request);
+	}
+
+	++numInFlight;
+	++numQueued;
+
+	return true;
+}
+
+size_t BatchIO::Submit() noexcept
+{
+	returnValueIf(0, numQueued == 0);
+
+	if (ring != nullptr)
+	{
+		// If it's failed, they stay queued, and the next waiting Poll tries again.
+		const auto result = SubmitRing(*ring, false);
+		returnValueIf(0, result < 0);
+
+		numQueued -= static_cast<size_t>(result);
+
+		return static_cast<size_t>(result);
+	}
+
+	auto numSubmitted = queued.size();
+	{
+		std::lock_guard guard(lock);
+		requests.insert(requests.end(), queued.begin(), queued.end());
+	}
+
+	queued.clear();
+	numQueued = 0;
+
+	if (numSubmitted > 1)
+	{
+		requestCondition.notify_all();
+	}
+	else
+	{
+		requestCondition.notify_one();
+	}
+
+	return numSubmitted;
+}
+
+size_t BatchIO::Poll(BatchIOCompletion* outCompletions, size_t capacity, bool shouldWait) noexcept
+{
+	returnValueIf(0, capacity == 0 || numInFlight == 0);
+
+	size_t count = 0;
+
+	if (ring != nullptr)
+	{
+		count = TakeCompletions(outCompletions, capacity);
+		count += PollRing(*ring, outCompletions + count, capacity - count);
+
+		while (count == 0 && shouldWait)
+		{
+			// Submit the queued ones, if any, and wait for a completion by a system call.
+			const auto result = SubmitRing(*ring, true);
+			if (unlikely(result < 0))
+			{
+				// Retrying would spin on the same error. The ones in the kernel are left to later polls.
+				CancelRing(*ring, completions, result);
+				numQueued = 0;
+
+				count = TakeCompletions(outCompletions, capacity);
+				count += PollRing(*ring, outCompletions + count, capacity - count);
+				break;
+			}
+
+			numQueued -= static_cast<size_t>(result);
+			count = PollRing(*ring, outCompletions, capacity);
+		}
+	}
+	else
+	{
+		if (shouldWait)
+		{
+			Submit();
+		}
+
+		std::unique_lock guard(lock);
+
+		if (shouldWait)
+		{
+			completionCondition.wait(guard, [this]() { return !completions.empty(); });
+		}
+
+		count = TakeCompletions(outCompletions, capacity);
+	}
+
+	numInFlight -= count;
+
+	return count;
+}
+
+size_t BatchIO::TakeCompletions(BatchIOCompletion* outCompletions, size_t capacity) noexcept
+{
+	const size_t count = std::min(capacity, completions.size());
+	std::copy(completions.end() - count, completions.end(), outCompletions);
+	completions.resize(completions.size() - count);
+
+	return count;
+}
+
+void BatchIO::RunThread() noexcept
+{
+	while (true)
+	{
+		BatchIORequest request;
+		{
+			std::unique_lock guard(lock);
+			requestCondition.wait(guard, [this]() { return isStopping || !requests.empty(); });
+			returnIf(requests.empty());
+
+			request = requests.front();
+			requests.pop_front();
+		}
+
+		BatchIOCompletion completion{request.userData, RunBlocking(request)};
+		{
+			std::lock_guard guard(lock);
+			completions.push_back(completion);
+		}
+
+		completionCondition.notify_one();
+	}
+}
+
+} // namespace OS
+
+#ifdef __UNIT_TEST__
+#include <cstring>
+#include "../Engine/Engine.h"
+#include "Core/ScopedTime.h"
+#include "Core/TaskSystem.h"
+#include "HSTL/HVector.h"
+#include "OSAbstractLayer.h"
+#include "OSFileHandle.h"
+#include "OSInputOutput.h"
+#include "String/InlineStringBuilder.h"
+#include "String/StaticString.h"
+
+namespace hbe
+{
+
+namespace
+{
+
+constexpr const char* Directory = "BatchIOTestFiles";
+constexpr size_t FileSize = 4 * 1024;
+
+StaticString GetTestPath(size_t index)
+{
+	InlineStringBuilder<256> path;
+	path << Directory << "/File" << index << ".data";
+
+	return StaticString(path.c_str());
+}
+
+uint8_t GetTestByte(size_t fileIndex, size_t offset)
+{
+	return static_cast<uint8_t>((fileIndex * 31 + offset) & 0xFF);
+}
+
+bool WriteTestFiles(const HVector<StaticString>& paths)
+{
+	uint8_t data[FileSize];
+
+	OS::FileOpenMode openMode;
+	openMode.SetWriteOnly();
+	openMode.SetCreate();
+	openMode.SetTruncate();
+
+	for (size_t i = 0; i < paths.size(); ++i)
+	{
+		for (size_t offset = 0; offset < FileSize; ++offset)
+		{
+			data[offset] = GetTestByte(i, offset);
+		}
+
+		OS::FileHandle handle;
+		returnValueIf(false, !OS::Open(handle, paths[i], openMode));
+
+		const bool isWritten = OS::Write(handle, data, FileSize) == FileSize;
+		OS::Close(std::move(handle));
+		returnValueIf(false, !isWritten);
+	}
+
+	return true;
+}
+
+void DeleteTestFiles(const HVector<StaticString>& paths)
+{
+	for (auto path : paths)
+	{
+		OS::Delete(path);
+	}
+
+	OS::DeleteDirectory(Directory);
+}
+
+bool IsTestData(size_t fileIndex, const uint8_t* data)
+{
+	for (size_t offset = 0; offset < FileSize; ++offset)
+	{
+		returnValueIf(false, data[offset] != GetTestByte(fileIndex, offset));
+	}
+
+	return true;
+}
+
+/// @brief Reads the files through open, read and close requests, driven by a task on the IO stream.
+class BatchReader final
+{
+public:
+	struct Slot final
+	{
+		size_t fileIndex;
+		int fd;
+		OS::EBatchIOType stage;
+		bool isValid;
+		uint8_t buffer[FileSize];
+	};
+
+	OS::BatchIO& io;
+	const HVector<StaticString>& paths;
+	// A slot per request in flight, reused by the next file after closing.
+	HVector<Slot> slots;
+	HVector<Slot*> freeSlots;
+	size_t nextIndex;
+	size_t numValid;
+	Task task;
+
+	BatchReader(OS::BatchIO& io, const HVector<StaticString>& paths)
+		: io(io)
+		, paths(paths)
+		, slots(io.GetQueueDepth())
+		, nextIndex(0)
+		, numValid(0)
+		, task(StaticString("BatchReader"), Run, this)
+	{
+		for (auto& slot : slots)
+		{
+			freeSlots.push_back(&slot);
+		}
+	}
+
+	void Read(TaskSystem& taskSys)
+	{
+		taskSys.Enqueue(TaskSystem::GetIOTaskStreamIndex(), task.GenerateSubTask(0, paths.size()));
+		task.BusyWait();
+	}
+
+private:
+	// A round of push, submit and poll. Return the number of files closed.
+	static size_t Run(void* userData, size_t, size_t)
+	{
+		auto& reader = *static_cast<BatchReader*>(userData);
+		auto& io = reader.io;
+
+		OS::FileOpenMode openMode;
+		openMode.SetReadOnly();
+
+		while (reader.nextIndex < reader.paths.size() && !reader.freeSlots.empty())
+		{
+			auto& slot = *reader.freeSlots.back();
+			reader.freeSlots.pop_back();
+
+			slot.fileIndex = reader.nextIndex++;
+			slot.fd = -1;
+			slot.stage = OS::EBatchIOType::Open;
+			slot.isValid = false;
+
+			io.Push({OS::EBatchIOType::Open, reader.paths[slot.fileIndex].c_str(), openMode, -1, nullptr, 0, 0, &slot});
+		}
+
+		io.Submit();
+
+		OS::BatchIOCompletion completions[64];
+		const size_t count = io.Poll(completions, std::size(completions), true);
+
+		size_t numClosed = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto& slot = *static_cast<Slot*>(completions[i].userData);
+			const auto result = completions[i].result;
+
+			if (slot.stage == OS::EBatchIOType::Open && result >= 0)
+			{
+				slot.fd = static_cast<int>(result);
+				slot.stage = OS::EBatchIOType::Read;
+				io.Push({OS::EBatchIOType::Read, nullptr, {}, slot.fd, slot.buffer, FileSize, 0, &slot});
+				continue;
+			}
+
+			if (slot.stage == OS::EBatchIOType::Read)
+			{
+				slot.isValid = result == FileSize && IsTestData(slot.fileIndex, slot.buffer);
+				slot.stage = OS::EBatchIOType::Close;
+				io.Push({OS::EBatchIOType::Close, nullptr, {}, slot.fd, nullptr, 0, 0, &slot});
+				continue;
+			}
+
+			// Closed, or failed to open.
+			reader.numValid += slot.isValid && result == 0 ? 1 : 0;
+			reader.freeSlots.push_back(&slot);
+			++numClosed;
+		}
+
+		io.Submit();
+
+		return numClosed;
+	}
+};
+
+} // anonymous namespace
+
+void BatchIOTest::Prepare()
+{
+	using namespace OS;
+
+	AddTest("Open/Read/Close", [this](auto& ls)
+	{
+		HVector<StaticString> paths;
+		for (size_t i = 0; i < 16; ++i)
+		{
+			paths.push_back(GetTestPath(i));
+		}
+
+		if (!OS::MakeDirectory(Directory) || !WriteTestFiles(paths))
+		{
+			ls << "Failed to write test files." << lferr;
+			DeleteTestFiles(paths);
+			return;
+		}
+
+		for (bool allowKernelQueue : {true, false})
+		{
+			BatchIO io(8, allowKernelQueue);
+
+			BatchReader reader(io, paths);
+			reader.Read(Engine::Get().GetTaskSystem());
+
+			if (reader.numValid != paths.size() || io.GetNumInFlight() != 0)
+			{
+				ls << io.GetBackendName() << ": read " << reader.numValid << " out of " << paths.size()
+				   << " files, in flight " << io.GetNumInFlight() << lferr;
+			}
+			else
+			{
+				ls << io.GetBackendName() << ": read " << reader.numValid << " files." << lf;
+			}
+		}
+
+		DeleteTestFiles(paths);
+	});
+
+	AddTest("Failure", [this](auto& ls)
+	{
+		for (bool allowKernelQueue : {true, false})
+		{
+			BatchIO io(4, allowKernelQueue);
+
+			FileOpenMode openMode;
+			openMode.SetReadOnly();
+
+			int tag = 0;
+			io.Push({EBatchIOType::Open, "BatchIOTestNotExisting.data", openMode, -1, nullptr, 0, 0, &tag});
+			io.Submit();
+
+			BatchIOCompletion completion{nullptr, 0};
+			const auto count = io.Poll(&completion, 1, true);
+
+			if (count != 1 || completion.userData != &tag || completion.result >= 0)
+			{
+				ls << io.GetBackendName() << ": opening a missing file returns " << completion.result << lferr;
+			}
+			else
+			{
+				ls << io.GetBackendName() << ": " << std::strerror(static_cast<int>(-completion.result)) << lf;
+			}
+		}
+	});
+
+	AddTest("Read 10k Files", [this](auto& ls)
+	{
+		constexpr size_t NumFiles = 10000;
+
+		HVector<StaticString> paths;
+		paths.reserve(NumFiles);
+		for (size_t i = 0; i < NumFiles; ++i)
+		{
+			paths.push_back(GetTestPath(i));
+		}
+
+		if (!OS::MakeDirectory(Directory) || !WriteTestFiles(paths))
+		{
+			ls << "Failed to write test files." << lferr;
+			DeleteTestFiles(paths);
+			return;
+		}
+
+		time::TDuration blockingTime;
+		size_t numBlockingRead = 0;
+		{
+			time::ScopedTime timer(blockingTime);
+
+			FileOpenMode openMode;
+			openMode.SetReadOnly();
+
+			uint8_t buffer[FileSize];
+			for (size_t fileIndex = 0; fileIndex < paths.size(); ++fileIndex)
+			{
+				FileHandle handle;
+				continueIf(!OS::Open(handle, paths[fileIndex], openMode));
+
+				const bool isRead = OS::Read(handle, buffer, FileSize) == FileSize;
+				numBlockingRead += isRead && IsTestData(fileIndex, buffer) ? 1 : 0;
+				OS::Close(std::move(handle));
+			}
+		}
+
+		auto& taskSys = Engine::Get().GetTaskSystem();
+
+		auto measure = [&taskSys, &paths](bool allowKernelQueue, size_t& outNumRead, const char*& outName)
+		{
+			BatchIO io(BatchIO::DefaultQueueDepth, allowKernelQueue);
+			BatchReader reader(io, paths);
+
+			time::TDuration duration;
+			{
+				time::ScopedTime timer(duration);
+				reader.Read(taskSys);
+			}
+
+			outNumRead = reader.numValid;
+			outName = io.GetBackendName();
+
+			return time::ToFloat(duration);
+		};
+
+		size_t numBatchRead = 0;
+		const char* batchName = nullptr;
+		const auto batchSec = measure(true, numBatchRead, batchName);
+
+		size_t numPoolRead = 0;
+		const char* poolName = nullptr;
+		const auto poolSec = measure(false, numPoolRead, poolName);
+
+		DeleteTestFiles(paths);
+
+		if (numBlockingRead != NumFiles || numBatchRead != NumFiles || numPoolRead != NumFiles)
+		{
+			ls << "Read " << numBlockingRead << " files by blocking calls, " << numBatchRead << " by " << batchName
+			   << ", " << numPoolRead << " by " << poolName << " out of " << NumFiles << lferr;
+			return;
+		}
+
+		const auto blockingSec = time::ToFloat(blockingTime);
+
+		ls << NumFiles << " files of " << FileSize << " bytes: blocking " << blockingSec << " sec ("
+		   << (NumFiles / blockingSec) << " files/s), " << batchName << ' ' << batchSec << " sec ("
+		   << (NumFiles / batchSec) << " files/s), " << poolName << ' ' << poolSec << " sec ("
+		   << (NumFiles / poolSec) << " files/s)" << lf;
+
+		if (batchSec > blockingSec)
+		{
+			ls << "Batched reading by " << batchName << " is slower than the blocking calls." << lfwarn;
+		}
+	});
+}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,133 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "OSFileOpenMode.h"
+
+namespace OS
+{
+
+class IOUring;
+
+enum class EBatchIOType : uint8_t
+{
+	Open,
+	Read,
+	Close
+};
+
+struct BatchIORequest final
+{
+	EBatchIOType type;
+	// Open: the path, which should be valid until it's completed.
+	const char* path;
+	FileOpenMode openMode;
+	// Read and Close: the file descriptor taken by Open.
+	int fd;
+	// Read: up to size bytes at the offset.
+	void* buffer;
+	size_t size;
+	size_t offset;
+	// Returned with the completion.
+	void* userData;
+};
+
+struct BatchIOCompletion final
+{
+	void* userData;
+	// The file descriptor opened, the bytes read, or 0 for Close. A negative errno if it's failed.
+	int64_t result;
+};
+
+/// @brief Submits file operations in batches, and polls their completions in any order.
+/// @details On Linux, it's io_uring, where a batch of requests costs a single system call. Otherwise, or if the
+/// kernel doesn't support it, a pool of threads runs the requests by blocking calls. A single thread drives it,
+/// e.g. a task on the IO stream. Keep the requests in flight within the queue depth.
+class BatchIO final
+{
+public:
+	static constexpr uint32_t DefaultQueueDepth = 256;
+	static constexpr uint32_t DefaultNumThreads = 4;
+
+private:
+	uint32_t queueDepth;
+	size_t numInFlight;
+	size_t numQueued;
+	IOUring* ring;
+
+	// The thread pool, used without the ring.
+	std::vector<std::thread> threads;
+	std::vector<BatchIORequest> queued;
+	std::mutex lock;
+	std::condition_variable requestCondition;
+	std::condition_variable completionCondition;
+	std::deque<BatchIORequest> requests;
+	std::vector<BatchIOCompletion> completions;
+	bool isStopping;
+
+public:
+	// allowKernelQueue false always uses the thread pool.
+	explicit BatchIO(uint32_t queueDepth = DefaultQueueDepth, bool allowKernelQueue = true,
+		uint32_t numThreads = DefaultNumThreads) noexcept;
+	~BatchIO() noexcept;
+
+	BatchIO(const BatchIO&) = delete;
+	BatchIO& operator=(const BatchIO&) = delete;
+
+	[[nodiscard]] bool IsKernelQueue() const noexcept { return ring != nullptr; }
+	[[nodiscard]] const char* GetBackendName() const noexcept { return IsKernelQueue() ? "io_uring" : "ThreadPool"; }
+	[[nodiscard]] uint32_t GetQueueDepth() const noexcept { return queueDepth; }
+	// Requests pushed but not completed yet.
+	[[nodiscard]] size_t GetNumInFlight() const noexcept { return numInFlight; }
+
+	// Queue a request until Submit(). Return false if the queue depth is reached.
+	bool Push(const BatchIORequest& request) noexcept;
+	// Start the queued requests at once. Return the number of requests submitted.
+	size_t Submit() noexcept;
+	// Take the completions. If shouldWait, wait for at least one while there're requests in flight. If the kernel
+	// queue fails to wait, the requests not submitted yet complete with the error, and it may return 0.
+	size_t Poll(BatchIOCompletion* outCompletions, size_t capacity, bool shouldWait) noexcept;
+
+private:
+	void RunThread() noexcept;
+	// Move the completions gathered here, by the threads or by a failed submit, to the output.
+	size_t TakeCompletions(BatchIOCompletion* outCompletions, size_t capacity) noexcept;
+
+	// Per platform. CreateRing returns nullptr if there's no kernel queue.
+	[[nodiscard]] static IOUring* CreateRing(uint32_t queueDepth) noexcept;
+	static void DestroyRing(IOUring* ring) noexcept;
+	static void PushRing(IOUring& ring, const BatchIORequest& request) noexcept;
+	// Return the number of requests submitted, or a negative errno.
+	static int SubmitRing(IOUring& ring, bool shouldWait) noexcept;
+	// Take back the requests not submitted to the kernel, and add them to the output as failed with the error.
+	static void CancelRing(IOUring& ring, std::vector<BatchIOCompletion>& outCompletions, int64_t error) noexcept;
+	static size_t PollRing(IOUring& ring, BatchIOCompletion* outCompletions, size_t capacity) noexcept;
+	[[nodiscard]] static int64_t RunBlocking(const BatchIORequest& request) noexcept;
+};
+
+} // namespace OS
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+class BatchIOTest final : public TestCollection
+{
+public:
+	BatchIOTest() : TestCollection("BatchIOTest") {}
+
+protected:
+	void Prepare() override;
+};
+
+} // namespace hbe
+#endif //__UNIT_TEST__
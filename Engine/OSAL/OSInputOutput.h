@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "String/StaticString.h"
 
 namespace OS
@@ -12,13 +13,23 @@ class FileOpenMode;
 class ProtectionMode;
 class MapSyncMode;
 
+// A buffer of a vectored write, laid out as struct iovec.
+struct IOVector final
+{
+	void* data;
+	size_t size;
+};
+
 bool Open(FileHandle& outHandle, hbe::StaticString filePath, FileOpenMode openMode) noexcept;
 bool Close(FileHandle&& handle) noexcept;
 bool Exist(hbe::StaticString filePath) noexcept;
 bool Delete(hbe::StaticString filePath) noexcept;
+bool Rename(hbe::StaticString fromPath, hbe::StaticString toPath) noexcept;
 
 size_t Read(const FileHandle& handle, void* buffer, size_t size) noexcept;
 size_t Write(const FileHandle& handle, void* buffer, size_t size) noexcept;
+// Write the buffers in order by a system call. Return the bytes written, which can be less than the total.
+size_t WriteV(const FileHandle& handle, const IOVector* vectors, size_t count) noexcept;
 bool Truncate(const FileHandle& handle, size_t size) noexcept;
 
 void* MapMemory(FileHandle& fileHandle, size_t size, ProtectionMode protection, size_t offset) noexcept;
@@ -30,9 +30,27 @@ template<typename T>
 	return multiplier * alignBytes;
 }
 
+/// @brief Page backing of the memory allocated by VirtualAlloc.
+enum class EHugePages : uint8_t
+{
+	Disabled,
+	// Transparent huge pages requested by madvise. The range is aligned to the huge page size.
+	Transparent,
+	// Huge pages reserved by the system (MAP_HUGETLB). It falls back to Transparent if they're not available.
+	Explicit
+};
+
+constexpr int AnyNumaNode = -1;
+
 [[nodiscard]] size_t GetAllocSize(void* ptr) noexcept;
 [[nodiscard]] size_t GetPageSize() noexcept;
+[[nodiscard]] size_t GetHugePageSize() noexcept;
+[[nodiscard]] int GetNumNumaNodes() noexcept;
+[[nodiscard]] int GetCurrentNumaNode() noexcept;
 void* VirtualAlloc(size_t size);
+// The size should be a multiple of the huge page size unless hugePages is Disabled. Pages are preferably placed on
+// numaNode when they're touched first. The options are hints, and ignored where the platform doesn't support them.
+void* VirtualAlloc(size_t size, EHugePages hugePages, int numaNode = AnyNumaNode);
 void VirtualFree(void* address, std::size_t n) noexcept;
 void ProtectMemory(void* address, std::size_t n) noexcept;
 
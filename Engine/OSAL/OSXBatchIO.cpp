@@ -0,0 +1,50 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "OSBatchIO.h"
+
+#ifdef PLATFORM_OSX
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OS
+{
+
+// No kernel queue on OSX. The thread pool runs the requests.
+IOUring* BatchIO::CreateRing(uint32_t) noexcept { return nullptr; }
+
+void BatchIO::DestroyRing(IOUring*) noexcept {}
+
+void BatchIO::PushRing(IOUring&, const BatchIORequest&) noexcept {}
+
+int BatchIO::SubmitRing(IOUring&, bool) noexcept { return 0; }
+
+void BatchIO::CancelRing(IOUring&, std::vector<BatchIOCompletion>&, int64_t) noexcept {}
+
+size_t BatchIO::PollRing(IOUring&, BatchIOCompletion*, size_t) noexcept { return 0; }
+
+int64_t BatchIO::RunBlocking(const BatchIORequest& request) noexcept
+{
+	int64_t result = 0;
+
+	switch (request.type)
+	{
+	case EBatchIOType::Open:
+		result = ::open(request.path, request.openMode.value, S_IRUSR | S_IWUSR);
+		break;
+
+	case EBatchIOType::Read:
+		result = pread(request.fd, request.buffer, request.size, static_cast<off_t>(request.offset));
+		break;
+
+	case EBatchIOType::Close:
+		result = close(request.fd);
+		break;
+	}
+
+	return result < 0 ? -errno : result;
+}
+
+} // namespace OS
+#endif // PLATFORM_OSX
@@ -20,6 +20,12 @@ size_t OS::GetPageSize() noexcept
 	return pageSize;
 }
 
+size_t OS::GetHugePageSize() noexcept { return 2 * 1024 * 1024; }
+
+int OS::GetNumNumaNodes() noexcept { return 1; }
+
+int OS::GetCurrentNumaNode() noexcept { return 0; }
+
 void* OS::VirtualAlloc(size_t size)
 {
 	auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
@@ -27,6 +33,9 @@ void* OS::VirtualAlloc(size_t size)
 	return ptr;
 }
 
+// Huge pages and NUMA placement aren't exposed to user space mappings.
+void* OS::VirtualAlloc(size_t size, EHugePages, int) { return VirtualAlloc(size); }
+
 // BUG FIX: Memory allocated with mmap() must be freed with munmap(), not free()
 // Using free() on mmap'd memory causes undefined behavior and heap corruption
 void OS::VirtualFree(void* address, std::size_t size) noexcept { munmap(address, size); }
@@ -34,6 +34,15 @@ bool IsDirectory(const char* path)
 	return true;
 }
 
+bool MakeDirectory(const char* path)
+{
+	returnValueIf(true, IsDirectory(path));
+
+	return CreateDirectoryA(path, nullptr) != 0;
+}
+
+bool DeleteDirectory(const char* path) { return RemoveDirectoryA(path) != 0; }
+
 HVector<HString> ListFilesInDirectory(const char* path)
 {
 	HVector<HString> fileList;
@@ -32,6 +32,47 @@ size_t OS::GetPageSize() noexcept
 
 void* OS::VirtualAlloc(size_t size) { return ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE); }
 
+size_t OS::GetHugePageSize() noexcept
+{
+	static const size_t largePageSize = GetLargePageMinimum();
+	return largePageSize > 0 ? largePageSize : 2 * 1024 * 1024;
+}
+
+int OS::GetNumNumaNodes() noexcept
+{
+	ULONG highestNode = 0;
+	returnValueIf(1, !GetNumaHighestNodeNumber(&highestNode));
+
+	return static_cast<int>(highestNode) + 1;
+}
+
+int OS::GetCurrentNumaNode() noexcept
+{
+	PROCESSOR_NUMBER processor;
+	GetCurrentProcessorNumberEx(&processor);
+
+	USHORT node = 0;
+	returnValueIf(0, !GetNumaProcessorNodeEx(&processor, &node));
+
+	return static_cast<int>(node);
+}
+
+void* OS::VirtualAlloc(size_t size, EHugePages hugePages, int numaNode)
+{
+	const auto process = GetCurrentProcess();
+	const DWORD preferred = numaNode >= 0 ? static_cast<DWORD>(numaNode) : NUMA_NO_PREFERRED_NODE;
+
+	// Large pages need SeLockMemoryPrivilege, and there are no transparent huge pages.
+	if (hugePages == EHugePages::Explicit)
+	{
+		auto* ptr = ::VirtualAllocExNuma(process, nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+										 PAGE_READWRITE, preferred);
+		returnValueIf(ptr, ptr != nullptr);
+	}
+
+	return ::VirtualAllocExNuma(process, nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, preferred);
+}
+
 void OS::VirtualFree(void* address, std::size_t n) noexcept
 {
 	auto result = ::VirtualFree(address, n, MEM_RELEASE);
@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "ArchiveFormat.h"
+
+#include <algorithm>
+#include <cstring>
+#include "LZCodec.h"
+
+
+namespace hbe
+{
+namespace ArchiveFormat
+{
+
+	uint64_t CalculateHash(std::string_view name) noexcept
+	{
+		uint64_t hashCode = 5381;
+
+		for (size_t ch : name)
+		{
+			hashCode = ((hashCode << 5) + hashCode) + ch; /* hash * 33 + c */
+		}
+
+		return hashCode;
+	}
+
+	Writer::Writer(std::ostream& output) : output(output), offset(0)
+	{
+		// Reserve the header, written by Finish.
+		const Header header{};
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		offset = sizeof(header);
+	}
+
+	bool Writer::Add(std::string_view name, const void* data, size_t size, ECompression compression)
+	{
+		if (name.empty() || names.size() + name.size() > UINT32_MAX)
+		{
+			return Fail("Invalid name: " + std::string(name));
+		}
+
+		const auto hash = CalculateHash(name);
+		if (!hashes.insert(hash).second)
+		{
+			return Fail("The hash of " + std::string(name) + " is already added.");
+		}
+
+		const char padding[DataAlignment] = {};
+		const auto paddingSize = (DataAlignment - offset % DataAlignment) % DataAlignment;
+		output.write(padding, static_cast<std::streamsize>(paddingSize));
+		offset += paddingSize;
+
+		Entry entry{};
+		entry.hash = hash;
+		entry.offset = offset;
+		entry.size = size;
+		entry.originalSize = size;
+		entry.nameOffset = static_cast<uint32_t>(names.size());
+		entry.nameLength = static_cast<uint32_t>(name.size());
+		entry.compression = ECompression::Stored;
+
+		if (compression == ECompression::LZ && LZCodec::CompressFrame(data, size, frame) && frame.size() < size)
+		{
+			data = frame.data();
+			entry.size = frame.size();
+			entry.compression = ECompression::LZ;
+		}
+
+		output.write(static_cast<const char*>(data), static_cast<std::streamsize>(entry.size));
+		offset += entry.size;
+
+		entries.push_back(entry);
+		names.append(name);
+
+		return output.good() || Fail("Failed to write " + std::string(name));
+	}
+
+	bool Writer::Finish()
+	{
+		std::sort(entries.begin(), entries.end(), [](auto& lhs, auto& rhs) { return lhs.hash < rhs.hash; });
+
+		const char padding[DataAlignment] = {};
+		const auto paddingSize = (DataAlignment - offset % DataAlignment) % DataAlignment;
+		output.write(padding, static_cast<std::streamsize>(paddingSize));
+		offset += paddingSize;
+
+		Header header{};
+		std::memcpy(header.magic, Magic, sizeof(Magic));
+		header.version = Version;
+		header.numEntries = static_cast<uint32_t>(entries.size());
+		header.tocOffset = offset;
+		header.namesOffset = offset + entries.size() * sizeof(Entry);
+		header.namesSize = names.size();
+
+		output.write(reinterpret_cast<const char*>(entries.data()),
+			static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+		output.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+		output.seekp(0);
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		output.flush();
+
+		return output.good() || Fail("Failed to write the TOC.");
+	}
+
+	bool Writer::Fail(std::string message)
+	{
+		error = std::move(message);
+		return false;
+	}
+
+	View::View() noexcept : data(nullptr), size(0), entries(nullptr), numEntries(0), names(nullptr) {}
+
+	bool View::Open(const uint8_t* inData, size_t inSize) noexcept
+	{
+		Close();
+
+		if (inData == nullptr || inSize < sizeof(Header))
+		{
+			return false;
+		}
+
+		Header header;
+		std::memcpy(&header, inData, sizeof(header));
+
+		if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version
+			|| header.tocOffset % alignof(Entry) != 0 || header.tocOffset > inSize
+			|| header.numEntries > (inSize - header.tocOffset) / sizeof(Entry)
+			|| header.namesOffset != header.tocOffset + header.numEntries * sizeof(Entry)
+			|| header.namesSize > inSize - header.namesOffset)
+		{
+			return false;
+		}
+
+		auto toc = reinterpret_cast<const Entry*>(inData + header.tocOffset);
+		for (uint32_t i = 0; i < header.numEntries; ++i)
+		{
+			auto& entry = toc[i];
+			if (entry.offset > inSize || entry.size > inSize - entry.offset
+				|| uint64_t(entry.nameOffset) + entry.nameLength > header.namesSize
+				|| (i > 0 && toc[i - 1].hash >= entry.hash))
+			{
+				return false;
+			}
+		}
+
+		data = inData;
+		size = inSize;
+		entries = toc;
+		numEntries = header.numEntries;
+		names = reinterpret_cast<const char*>(inData + header.namesOffset);
+
+		return true;
+	}
+
+	void View::Close() noexcept
+	{
+		data = nullptr;
+		size = 0;
+		entries = nullptr;
+		numEntries = 0;
+		names = nullptr;
+	}
+
+	std::string_view View::GetName(const Entry& entry) const noexcept
+	{
+		return std::string_view(names + entry.nameOffset, entry.nameLength);
+	}
+
+	const Entry* View::Find(uint64_t hash, std::string_view name) const noexcept
+	{
+		auto end = entries + numEntries;
+		auto found = std::lower_bound(entries, end, hash, [](auto& entry, uint64_t value) { return entry.hash < value; });
+
+		if (found == end || found->hash != hash || GetName(*found) != name)
+		{
+			return nullptr;
+		}
+
+		return found;
+	}
+
+} // namespace ArchiveFormat
+} // namespace hbe
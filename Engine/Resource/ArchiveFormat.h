@@ -0,0 +1,124 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// The packed archive format, shared by ResourceArchive and Tools/ResourcePacker. It depends on the standard library
+// only, so the packer can be built without the engine.
+namespace hbe
+{
+namespace ArchiveFormat
+{
+
+	// Header, the data of the entries, the TOC sorted by the hash, and then the names.
+	// Integers are in the byte order of the writer.
+	constexpr char Magic[7] = {'H', 'B', 'E', 'P', 'A', 'K', '\0'};
+	constexpr uint8_t Version = 1;
+	// The data of every entry starts at a multiple of it, so it can be read as any type in place.
+	constexpr uint64_t DataAlignment = 16;
+
+	enum class ECompression : uint8_t
+	{
+		Stored = 0,
+		// An LZCodec frame.
+		LZ = 1
+	};
+
+	struct Header final
+	{
+		char magic[sizeof(Magic)];
+		uint8_t version;
+		uint32_t numEntries;
+		uint32_t reserved;
+		uint64_t tocOffset;
+		uint64_t namesOffset;
+		uint64_t namesSize;
+	};
+
+	struct Entry final
+	{
+		// StaticString::GetHash() of the name.
+		uint64_t hash;
+		uint64_t offset;
+		uint64_t size;
+		// The size after decompressed.
+		uint64_t originalSize;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		ECompression compression;
+		uint8_t reserved[7];
+	};
+
+	static_assert(sizeof(Header) == 40);
+	static_assert(sizeof(Entry) == 48);
+
+	// The same as StringUtil::CalculateHash, which StaticString keeps.
+	[[nodiscard]] uint64_t CalculateHash(std::string_view name) noexcept;
+
+	/// @brief Writes an archive, adding the data of the entries one by one.
+	class Writer final
+	{
+	private:
+		std::ostream& output;
+		uint64_t offset;
+		std::vector<Entry> entries;
+		std::string names;
+		std::unordered_set<uint64_t> hashes;
+		std::vector<uint8_t> frame;
+		std::string error;
+
+	public:
+		// The output should be seekable, since the header is written last.
+		explicit Writer(std::ostream& output);
+
+		// Return false if the name or its hash is already added, or the output failed.
+		// A compressed entry is stored as it is, unless it gets smaller.
+		bool Add(std::string_view name, const void* data, size_t size, ECompression compression = ECompression::Stored);
+		// Write the TOC, the names and the header.
+		bool Finish();
+
+		[[nodiscard]] size_t GetNumEntries() const noexcept { return entries.size(); }
+		[[nodiscard]] const std::string& GetError() const noexcept { return error; }
+
+	private:
+		bool Fail(std::string message);
+	};
+
+	/// @brief Reads an archive in place, e.g. mapped in memory.
+	class View final
+	{
+	private:
+		const uint8_t* data;
+		size_t size;
+		const Entry* entries;
+		uint32_t numEntries;
+		const char* names;
+
+	public:
+		View() noexcept;
+
+		// Validate the header and the TOC. The data should be valid while it's used.
+		bool Open(const uint8_t* data, size_t size) noexcept;
+		void Close() noexcept;
+
+		[[nodiscard]] bool IsOpen() const noexcept { return data != nullptr; }
+		[[nodiscard]] size_t GetSize() const noexcept { return size; }
+		[[nodiscard]] uint32_t GetNumEntries() const noexcept { return numEntries; }
+		[[nodiscard]] const Entry& GetEntry(uint32_t index) const noexcept { return entries[index]; }
+		[[nodiscard]] std::string_view GetName(const Entry& entry) const noexcept;
+		[[nodiscard]] const uint8_t* GetData(const Entry& entry) const noexcept { return data + entry.offset; }
+
+		// Binary search on the TOC. Return nullptr if there's no entry of the name.
+		[[nodiscard]] const Entry* Find(uint64_t hash, std::string_view name) const noexcept;
+		[[nodiscard]] const Entry* Find(std::string_view name) const noexcept { return Find(CalculateHash(name), name); }
+	};
+
+} // namespace ArchiveFormat
+} // namespace hbe
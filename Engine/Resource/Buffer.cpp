@@ -55,6 +55,26 @@ namespace hbe
 #endif // __DEBUG__
 	}
 
+	Buffer& Buffer::operator=(Buffer&& rhs) noexcept
+	{
+		returnValueIf(*this, this == &rhs);
+
+		if (data != nullptr && releaser != nullptr)
+		{
+			releaser(size, data);
+		}
+
+		size = rhs.size;
+		data = rhs.data;
+		releaser = std::move(rhs.releaser);
+
+		rhs.size = 0;
+		rhs.data = nullptr;
+		rhs.releaser = nullptr;
+
+		return *this;
+	}
+
 	StaticString Buffer::GetClassName() const noexcept
 	{
 		using namespace StringUtil;
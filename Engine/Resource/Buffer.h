@@ -24,6 +24,8 @@ namespace hbe
 		Buffer(const TGenerateBuffer& genFunc, const TReleaseBuffer& releaseFunc);
 		~Buffer();
 
+		Buffer& operator=(Buffer&& rhs) noexcept;
+
 		[[nodiscard]] StaticString GetClassName() const noexcept;
 		void SetReleaser(TReleaseBuffer&& releaseFunc);
 
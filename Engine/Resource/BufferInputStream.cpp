@@ -107,42 +107,42 @@ namespace hbe
 
 	This& BufferInputStream::operator>>(StaticString& str) noexcept
 	{
-		size_t length = 0;
-		Get<size_t>(length, 0);
+		auto view = GetView<char>();
 
-		if (length <= 0)
+		if (view.empty())
 		{
 			const static StaticString zeroStr("");
 			str = zeroStr;
 			return *this;
 		}
 
-		using namespace hbe;
+		str = StaticString(std::string_view(view.data(), view.size()));
 
-		constexpr size_t InlineBufferSize = 256;
-		HInlineString<InlineBufferSize> tmpStr;
-		tmpStr.reserve(length);
-
-		char ch = '\0';
+		return *this;
+	}
 
-		for (size_t i = 0; i < length; ++i)
-		{
-			Get<char>(ch, '\0');
-			tmpStr.push_back(ch);
-		}
+	This& BufferInputStream::operator>>(hbe::HString& str) noexcept
+	{
+		auto view = GetView<char>();
+		str.assign(view.data(), view.size());
 
-		Assert(tmpStr.size() == length);
+		return *this;
+	}
 
-		str = StaticString(tmpStr.c_str());
+	This& BufferInputStream::operator>>(std::string_view& str) noexcept
+	{
+		auto view = GetView<char>();
+		str = std::string_view(view.data(), view.size());
 
 		return *this;
 	}
 
-	This& BufferInputStream::operator>>(const hbe::HString& str) noexcept { return *this; }
-
 } // namespace hbe
 
 #ifdef __UNIT_TEST__
+#include "BufferOutputStream.h"
+#include "BufferUtil.h"
+#include "Core/ScopedTime.h"
 #include "Memory/MemoryManager.h"
 #include "String/StringUtil.h"
 
@@ -252,6 +252,227 @@ namespace hbe
 				ls << "Invalid error count " << bis.GetErrorCount() << ", 0 is expected." << lferr;
 			}
 		});
+
+		AddTest("Out of Bounds", [this](auto& ls)
+		{
+			auto buffer = BufferUtil::GetMemoryBuffer<uint32_t>(3, 7);
+			BufferInputStream bis(buffer);
+
+			// 12 bytes: a uint64_t fits at 0, and the next one doesn't at 8.
+			uint64_t value = 0;
+			bis >> value;
+			bis >> value;
+
+			if (bis.GetErrorCount() != 1 || value != 0)
+			{
+				ls << "A value across the end should fail. Error Count = " << bis.GetErrorCount() << lferr;
+			}
+
+			uint32_t last = 0;
+			bis >> last;
+
+			if (bis.GetErrorCount() != 1 || last != 7)
+			{
+				ls << "The failed read shouldn't move the cursor. value = " << last << lferr;
+			}
+		});
+
+		AddTest("Views", [this](auto& ls)
+		{
+			auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(1024, 0);
+			{
+				int values[] = {1, 2, 3, 4, 5};
+				BufferOutputStream bos(buffer);
+				bos << "Hello, views" << values << "Second";
+			}
+
+			BufferInputStream bis(buffer);
+
+			std::string_view text;
+			std::span<const int> ints;
+			HString second;
+			bis >> text >> ints >> second;
+
+			const auto begin = buffer.GetData();
+			const auto end = begin + buffer.GetSize();
+			auto isInBuffer = [begin, end](const void* ptr)
+			{
+				return static_cast<const uint8_t*>(ptr) >= begin && static_cast<const uint8_t*>(ptr) < end;
+			};
+
+			if (text != "Hello, views" || !isInBuffer(text.data()))
+			{
+				ls << "Invalid string view [" << HString(text).c_str() << ']' << lferr;
+			}
+
+			if (ints.size() != 5 || ints[0] != 1 || ints[4] != 5 || !isInBuffer(ints.data()))
+			{
+				ls << "Invalid span of " << ints.size() << " elements" << lferr;
+			}
+
+			if (second != "Second" || bis.HasError())
+			{
+				ls << "Invalid string " << second.c_str() << ", Error Count = " << bis.GetErrorCount() << lferr;
+			}
+		});
+
+		AddTest("Read into Filled Containers", [this](auto& ls)
+		{
+			// Copied one by one, as it's not trivially copyable.
+			struct Value final
+			{
+				int value;
+
+				Value(int value = 0) : value(value) {}
+				Value(const Value& rhs) : value(rhs.value) {}
+				Value& operator=(const Value& rhs) = default;
+			};
+
+			auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(256, 0);
+			{
+				int values[] = {1, 2, 3, 4, 5};
+				BufferOutputStream bos(buffer);
+				bos << values << values;
+			}
+
+			// The bulk copy and the element-wise copy should end up the same.
+			HVector<int> ints = {-1, -2, -3};
+			HVector<Value> objects = {-1, -2, -3};
+
+			BufferInputStream bis(buffer);
+			bis.operator>> <int>(ints);
+			bis.operator>> <Value>(objects);
+
+			bool isSame = ints.size() == objects.size();
+			for (size_t i = 0; isSame && i < ints.size(); ++i)
+			{
+				isSame = ints[i] == objects[i].value;
+			}
+
+			if (bis.HasError() || !isSame || ints != HVector<int>{1, 2, 3, 4, 5})
+			{
+				ls << "The read values differ by the copy. Sizes " << ints.size() << ", " << objects.size() << lferr;
+			}
+		});
+
+		AddTest("Read Many", [this](auto& ls)
+		{
+			auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(64, 0);
+			{
+				BufferOutputStream bos(buffer);
+				bos << uint8_t(1) << uint32_t(2) << uint16_t(3) << uint64_t(4) << 5.0f;
+			}
+
+			uint8_t a = 0;
+			uint32_t b = 0;
+			uint16_t c = 0;
+			uint64_t d = 0;
+			float e = 0;
+
+			BufferInputStream bis(buffer);
+			if (!bis.ReadMany(a, b, c, d, e) || a != 1 || b != 2 || c != 3 || d != 4 || e != 5.0f)
+			{
+				ls << "ReadMany should read the same as >> each." << lferr;
+			}
+
+			uint64_t values[8] = {};
+			if (bis.Read(values, 8) || bis.GetErrorCount() != 1)
+			{
+				ls << "Read across the end should fail at once." << lferr;
+			}
+
+			uint32_t rest[6] = {};
+			if (!bis.Read(rest, 6))
+			{
+				ls << "The failed batch shouldn't move the cursor." << lferr;
+			}
+		});
+
+		AddTest("Bulk Read Performance", [this](auto& ls)
+		{
+			constexpr size_t Count = 1024 * 1024;
+
+			auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(sizeof(size_t) + Count * sizeof(uint32_t), 0);
+			{
+				HVector<uint32_t> values(Count);
+				for (size_t i = 0; i < Count; ++i)
+				{
+					values[i] = static_cast<uint32_t>(i);
+				}
+
+				BufferOutputStream bos(buffer);
+				bos << Count;
+				for (auto value : values)
+				{
+					bos << value;
+				}
+			}
+
+			uint64_t elementSum = 0;
+			uint64_t bulkSum = 0;
+			uint64_t viewSum = 0;
+			time::TDuration elementTime;
+			time::TDuration bulkTime;
+			time::TDuration viewTime;
+
+			{
+				time::ScopedTime timer(elementTime);
+
+				BufferInputStream bis(buffer);
+				size_t count = 0;
+				bis >> count;
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					uint32_t value = 0;
+					bis >> value;
+					elementSum += value;
+				}
+			}
+
+			{
+				time::ScopedTime timer(bulkTime);
+
+				BufferInputStream bis(buffer);
+				HVector<uint32_t> values;
+				bis.operator>><uint32_t>(values);
+
+				for (auto value : values)
+				{
+					bulkSum += value;
+				}
+			}
+
+			{
+				time::ScopedTime timer(viewTime);
+
+				BufferInputStream bis(buffer);
+				for (auto value : bis.GetView<uint32_t>())
+				{
+					viewSum += value;
+				}
+			}
+
+			const uint64_t expected = uint64_t(Count) * (Count - 1) / 2;
+			if (elementSum != expected || bulkSum != expected || viewSum != expected)
+			{
+				ls << "Invalid sum " << elementSum << ", " << bulkSum << ", " << viewSum << ", but " << expected
+				   << " is expected." << lferr;
+				return;
+			}
+
+			const auto elementSec = time::ToFloat(elementTime);
+			const auto bulkSec = time::ToFloat(bulkTime);
+			const auto viewSec = time::ToFloat(viewTime);
+
+			ls << Count << " elements: one by one " << elementSec << " sec, bulk copy " << bulkSec << " sec, view "
+			   << viewSec << " sec" << lf;
+
+			if (viewSec > elementSec)
+			{
+				ls << "Reading by a view is slower than one by one." << lfwarn;
+			}
+		});
 	}
 
 } // namespace hbe
@@ -2,8 +2,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
 
 #include "Core/CommonMacros.h"
 #include "Buffer.h"
@@ -29,7 +34,13 @@ namespace hbe
 		[[nodiscard]] auto GetErrorCount() const noexcept { return errorCount; }
 		[[nodiscard]] bool HasError() const noexcept { return errorCount > 0; }
 		void ClearErrorCount() noexcept { errorCount = 0; }
+		// For the readers on top of the stream, which found the data invalid.
+		void AddError() noexcept { ++errorCount; }
 		[[nodiscard]] bool IsDone() const noexcept { return cursor >= buffer.GetSize(); }
+		[[nodiscard]] size_t GetRemainingSize() const noexcept
+		{
+			return buffer.GetSize() - std::min(cursor, buffer.GetSize());
+		}
 
 		This& operator>>(char& value) noexcept;
 		This& operator>>(int8_t& value) noexcept;
@@ -48,7 +59,16 @@ namespace hbe
 		This& operator>>(long double& value) noexcept;
 
 		This& operator>>(StaticString& str) noexcept;
-		This& operator>>(const hbe::HString& str) noexcept;
+		This& operator>>(hbe::HString& str) noexcept;
+		// A view into the buffer, valid while the buffer is.
+		This& operator>>(std::string_view& str) noexcept;
+
+		template<typename T>
+		This& operator>>(std::span<const T>& view) noexcept
+		{
+			view = GetView<T>();
+			return *this;
+		}
 
 		template<typename T, size_t N>
 		This& operator>>(T (&array)[N]) noexcept
@@ -64,30 +84,101 @@ namespace hbe
 			return *this;
 		}
 
+		// An array or a string written by BufferOutputStream, as a view into the buffer. Empty if it's failed.
+		template<typename T>
+		[[nodiscard]] std::span<const T> GetView() noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			size_t length = 0;
+			Get<size_t>(length, 0);
+			returnValueIf({}, length == 0);
+
+			auto data = Take<T>(length);
+			returnValueIf({}, data == nullptr);
+
+			return std::span<const T>(data, length);
+		}
+
+		// Read count values in a row, the same as >> each, with a bounds check for all of them.
+		template<typename T>
+		bool Read(T* outValues, size_t count) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			auto data = Take<T>(count);
+			returnValueIf(false, data == nullptr);
+
+			if (count > 0)
+			{
+				std::memcpy(outValues, data, count * sizeof(T));
+			}
+
+			return true;
+		}
+
+		// Read the bytes at the cursor without alignment.
+		bool ReadBytes(void* outData, size_t size) noexcept { return Read(static_cast<uint8_t*>(outData), size); }
+		// A view of the bytes at the cursor without alignment. nullptr if it's out of the buffer.
+		[[nodiscard]] const uint8_t* GetBytes(size_t size) noexcept { return Take<uint8_t>(size); }
+
+		// Read the values in order, the same as >> each, with a bounds check for all of them.
+		// Nothing is read if they're out of the buffer.
+		template<typename... Ts>
+		bool ReadMany(Ts&... values) noexcept
+		{
+			static_assert((std::is_trivially_copyable_v<Ts> && ...));
+
+			size_t end = cursor;
+			((end = Align<Ts>(end) + sizeof(Ts)), ...);
+
+			if (unlikely(!IsValidIndex(end)))
+			{
+				++errorCount;
+				return false;
+			}
+
+			auto bufferBase = buffer.GetData();
+			((cursor = Align<Ts>(cursor), std::memcpy(&values, &bufferBase[cursor], sizeof(Ts)), cursor += sizeof(Ts)),
+				...);
+
+			return true;
+		}
+
 	private:
-		[[nodiscard]] bool IsValidIndex(size_t index) const noexcept { return cursor < buffer.GetSize(); }
+		[[nodiscard]] bool IsValidIndex(size_t index) const noexcept { return index <= buffer.GetSize(); }
 
+		// A value is aligned to its size from the start of the buffer.
 		template<typename T>
-		void Get(T& value, const T& defaultValue) noexcept
+		[[nodiscard]] static size_t Align(size_t index) noexcept
 		{
 			constexpr size_t tSize = sizeof(T);
-			const size_t startIndex = ((cursor + tSize - 1) / tSize) * tSize;
-			const size_t newIndex = startIndex + tSize;
+			return ((index + tSize - 1) / tSize) * tSize;
+		}
+
+		// Check the bounds of count values at once, and move the cursor past them. Return nullptr if it's failed.
+		template<typename T>
+		[[nodiscard]] const T* Take(size_t count) noexcept
+		{
+			const size_t startIndex = Align<T>(cursor);
+			const size_t remains = buffer.GetSize() - std::min(startIndex, buffer.GetSize());
 
-			if (unlikely(!IsValidIndex(newIndex)))
+			if (unlikely(buffer.GetData() == nullptr || count > remains / sizeof(T)))
 			{
 				++errorCount;
-				value = defaultValue;
-				return;
+				return nullptr;
 			}
 
-			cursor = startIndex;
+			cursor = startIndex + sizeof(T) * count;
 
-			auto bufferBase = buffer.GetData();
-			auto data = reinterpret_cast<const T*>(&bufferBase[cursor]);
-			value = *data;
+			return reinterpret_cast<const T*>(&buffer.GetData()[startIndex]);
+		}
 
-			cursor = newIndex;
+		template<typename T>
+		void Get(T& value, const T& defaultValue) noexcept
+		{
+			auto data = Take<T>(1);
+			value = data == nullptr ? defaultValue : *data;
 		}
 
 		template<typename T>
@@ -102,22 +193,17 @@ namespace hbe
 				return;
 			}
 
-			constexpr size_t tSize = sizeof(T);
-			const size_t startIndex = ((cursor + tSize - 1) / tSize) * tSize;
-			const size_t newIndex = startIndex + (tSize * length);
+			auto data = Take<T>(length);
+			returnIf(data == nullptr);
 
-			if (unlikely(!IsValidIndex(newIndex)))
+			if constexpr (std::is_trivially_copyable_v<T>)
 			{
-				++errorCount;
-				return;
+				std::memcpy(arrayBuffer, data, sizeof(T) * length);
+			}
+			else
+			{
+				std::copy(data, data + length, arrayBuffer);
 			}
-
-			auto bufferBase = buffer.GetData();
-			auto dataBegin = reinterpret_cast<const T*>(&bufferBase[cursor]);
-			auto dataEnd = dataBegin + length;
-			std::copy(dataBegin, dataEnd, arrayBuffer);
-
-			cursor = newIndex;
 		}
 
 		template<typename T, class TContainer = TVector<T>>
@@ -132,24 +218,21 @@ namespace hbe
 
 			if (length <= 0) return;
 
-			constexpr size_t tSize = sizeof(T);
-			const size_t startIndex = ((cursor + tSize - 1) / tSize) * tSize;
-			const size_t newIndex = startIndex + (tSize * length);
+			auto data = Take<T>(length);
+			returnIf(data == nullptr);
 
-			if (unlikely(!IsValidIndex(newIndex)))
+			// Both paths add after what's in the container, as back_inserter does.
+			if constexpr (std::is_trivially_copyable_v<T> && requires { array.resize(length); array.data(); })
 			{
-				++errorCount;
-				return;
+				const size_t oldSize = array.size();
+				array.resize(oldSize + length);
+				std::memcpy(array.data() + oldSize, data, sizeof(T) * length);
+			}
+			else
+			{
+				array.reserve(length);
+				std::copy(data, data + length, std::back_inserter(array));
 			}
-
-			array.reserve(length);
-
-			auto bufferBase = buffer.GetData();
-			auto dataBegin = reinterpret_cast<const T*>(&bufferBase[cursor]);
-			auto dataEnd = dataBegin + length;
-			std::copy(dataBegin, dataEnd, std::back_inserter(array));
-
-			cursor = newIndex;
 		}
 
 		const Buffer& buffer;
@@ -2,6 +2,8 @@
 
 #include "BufferOutputStream.h"
 
+#include <algorithm>
+#include <cstring>
 #include "String/StringUtil.h"
 
 
@@ -120,6 +122,25 @@ namespace hbe
 		return *this;
 	}
 
+	void BufferOutputStream::WriteBytes(const void* data, size_t size) noexcept
+	{
+		Assert(std::this_thread::get_id() == threadID);
+
+		if (unlikely(size > buffer.GetSize() - std::min(cursor, buffer.GetSize())))
+		{
+			++errorCount;
+			return;
+		}
+
+		auto bufferBase = buffer.GetData();
+		if (bufferBase != nullptr && size > 0)
+		{
+			std::memcpy(&bufferBase[cursor], data, size);
+		}
+
+		cursor += size;
+	}
+
 } // namespace hbe
 
 #ifdef __UNIT_TEST__
@@ -49,6 +49,9 @@ namespace hbe
 		This& operator<<(long double value) noexcept;
 		This& operator<<(const char* str) noexcept;
 
+		// Write the bytes at the cursor without alignment. Only the cursor moves if the buffer has no data.
+		void WriteBytes(const void* data, size_t size) noexcept;
+
 		template<typename T, size_t N>
 		This& operator<<(T (&array)[N]) noexcept
 		{
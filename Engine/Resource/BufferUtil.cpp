@@ -132,7 +132,7 @@ namespace hbe
 			using namespace OS;
 
 			FileOpenMode openMode;
-			openMode.SetReadWrite();
+			openMode.SetReadOnly();
 
 			ProtectionMode protection;
 			protection.SetReadable();
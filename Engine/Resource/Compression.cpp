@@ -0,0 +1,510 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "Compression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "Core/CommonMacros.h"
+#include "Core/Task.h"
+#include "Core/TaskSystem.h"
+#include "Memory/MemoryManager.h"
+
+
+namespace hbe
+{
+	namespace
+	{
+		using namespace BufferTypes;
+
+		// Uninitialized, as the data is written over.
+		Buffer AllocateBuffer(size_t size)
+		{
+			auto& mmgr = MemoryManager::GetInstance();
+
+			auto generator = [&mmgr, size](TSize& outSize, TBufferData& outData)
+			{
+				outSize = size;
+				outData = mmgr.AllocateByType<uint8_t>(size);
+			};
+
+			auto releaser = [&mmgr](TSize size, TBufferData data) { mmgr.DeallocateTypes<uint8_t>(data, size); };
+
+			return Buffer(generator, releaser);
+		}
+
+		struct DecompressContext final
+		{
+			const LZCodec::FrameView& view;
+			uint8_t* output;
+			std::atomic<bool> hasFailed;
+		};
+
+		size_t RunDecompress(void* userData, size_t startIndex, size_t endIndex)
+		{
+			auto* context = static_cast<DecompressContext*>(userData);
+
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				if (unlikely(!context->view.DecompressBlock(static_cast<uint32_t>(i), context->output)))
+				{
+					context->hasFailed.store(true, std::memory_order_relaxed);
+				}
+			}
+
+			return endIndex - startIndex;
+		}
+
+	} // anonymous namespace
+
+	namespace Compression
+	{
+		Buffer Compress(const Buffer& source, uint32_t blockSize)
+		{
+			std::vector<uint8_t> frame;
+			returnValueIf(Buffer(), !LZCodec::CompressFrame(source.GetData(), source.GetSize(), frame, blockSize));
+
+			auto buffer = AllocateBuffer(frame.size());
+			std::memcpy(buffer.GetData(), frame.data(), frame.size());
+
+			return buffer;
+		}
+
+		Buffer Decompress(const void* frame, size_t size, TaskSystem* taskSystem)
+		{
+			LZCodec::FrameView view;
+			returnValueIf(Buffer(), !view.Open(frame, size));
+
+			auto buffer = AllocateBuffer(view.GetOriginalSize());
+			const auto numBlocks = view.GetNumBlocks();
+
+			if (taskSystem == nullptr || numBlocks <= 1)
+			{
+				returnValueIf(Buffer(), !view.Decompress(buffer.GetData()));
+				return buffer;
+			}
+
+			static const StaticString taskName("Compression.Decompress");
+
+			DecompressContext context{view, buffer.GetData(), false};
+			Task task(taskName, RunDecompress, &context);
+
+			taskSystem->ParallelFor(task, 0, numBlocks);
+			task.BusyWait();
+
+			returnValueIf(Buffer(), context.hasFailed.load(std::memory_order_relaxed));
+
+			return buffer;
+		}
+
+		Buffer Decompress(const Buffer& frame, TaskSystem* taskSystem)
+		{
+			return Decompress(frame.GetData(), frame.GetSize(), taskSystem);
+		}
+
+	} // namespace Compression
+
+	CompressedOutputStream::CompressedOutputStream(BufferOutputStream& output, uint32_t blockSize) noexcept
+		: output(output)
+		, blockSize(std::max<uint32_t>(blockSize, 1))
+		, isFinished(false)
+	{
+		block.reserve(this->blockSize);
+		output.WriteBytes(&this->blockSize, sizeof(this->blockSize));
+	}
+
+	CompressedOutputStream::~CompressedOutputStream() noexcept { Finish(); }
+
+	void CompressedOutputStream::Write(const void* data, size_t size) noexcept
+	{
+		Assert(!isFinished);
+
+		auto bytes = static_cast<const uint8_t*>(data);
+
+		while (size > 0)
+		{
+			const size_t length = std::min<size_t>(size, blockSize - block.size());
+			block.insert(block.end(), bytes, bytes + length);
+			bytes += length;
+			size -= length;
+
+			if (block.size() == blockSize)
+			{
+				WriteBlock();
+			}
+		}
+	}
+
+	void CompressedOutputStream::Finish() noexcept
+	{
+		returnIf(isFinished);
+
+		if (!block.empty())
+		{
+			WriteBlock();
+		}
+
+		const uint32_t end = 0;
+		output.WriteBytes(&end, sizeof(end));
+		isFinished = true;
+	}
+
+	void CompressedOutputStream::WriteBlock() noexcept
+	{
+		const auto originalSize = static_cast<uint32_t>(block.size());
+
+		// Stored as it is, unless it gets smaller.
+		compressed.resize(originalSize - 1);
+		auto storedSize = static_cast<uint32_t>(
+			LZCodec::CompressBlock(block.data(), block.size(), compressed.data(), compressed.size()));
+		auto data = compressed.data();
+
+		if (storedSize == 0)
+		{
+			storedSize = originalSize;
+			data = block.data();
+		}
+
+		output.WriteBytes(&originalSize, sizeof(originalSize));
+		output.WriteBytes(&storedSize, sizeof(storedSize));
+		output.WriteBytes(data, storedSize);
+
+		block.clear();
+	}
+
+	CompressedInputStream::CompressedInputStream(BufferInputStream& input) noexcept
+		: input(input)
+		, cursor(0)
+		, blockSize(0)
+		, isEnded(false)
+	{
+		if (unlikely(!input.ReadBytes(&blockSize, sizeof(blockSize)) || blockSize == 0))
+		{
+			isEnded = true;
+		}
+	}
+
+	bool CompressedInputStream::Read(void* outData, size_t size) noexcept
+	{
+		auto bytes = static_cast<uint8_t*>(outData);
+
+		while (size > 0)
+		{
+			if (cursor == block.size() && !ReadBlock())
+			{
+				input.AddError();
+				return false;
+			}
+
+			const size_t length = std::min(size, block.size() - cursor);
+			std::memcpy(bytes, block.data() + cursor, length);
+			cursor += length;
+			bytes += length;
+			size -= length;
+		}
+
+		return true;
+	}
+
+	bool CompressedInputStream::IsDone() noexcept
+	{
+		return cursor == block.size() && (isEnded || !ReadBlock());
+	}
+
+	bool CompressedInputStream::ReadBlock() noexcept
+	{
+		returnValueIf(false, isEnded);
+
+		block.clear();
+		cursor = 0;
+
+		uint32_t originalSize = 0;
+		uint32_t storedSize = 0;
+
+		if (unlikely(!input.ReadBytes(&originalSize, sizeof(originalSize))))
+		{
+			isEnded = true;
+			return false;
+		}
+
+		if (originalSize == 0)
+		{
+			isEnded = true;
+			return false;
+		}
+
+		const uint8_t* data = nullptr;
+		if (unlikely(originalSize > blockSize || !input.ReadBytes(&storedSize, sizeof(storedSize))
+			|| storedSize > originalSize || (data = input.GetBytes(storedSize)) == nullptr))
+		{
+			input.AddError();
+			isEnded = true;
+			return false;
+		}
+
+		block.resize(originalSize);
+
+		if (storedSize == originalSize)
+		{
+			std::memcpy(block.data(), data, storedSize);
+			return true;
+		}
+
+		if (unlikely(!LZCodec::DecompressBlock(data, storedSize, block.data(), originalSize)))
+		{
+			input.AddError();
+			block.clear();
+			isEnded = true;
+			return false;
+		}
+
+		return true;
+	}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "../Engine/Engine.h"
+#include "BufferUtil.h"
+#include "Core/ScopedTime.h"
+
+namespace hbe
+{
+	namespace
+	{
+		// Words in a random order, compressed about as well as text.
+		HVector<uint8_t> GenerateText(size_t size, uint32_t seed)
+		{
+			static const char* words[] = {"buffer ", "stream ", "engine ", "task ", "resource ", "block ", "frame ",
+				"compress ", "the ", "a ", "of ", "and ", "\n"};
+
+			HVector<uint8_t> text;
+			text.reserve(size + 16);
+
+			uint32_t state = seed;
+			while (text.size() < size)
+			{
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+
+				const char* word = words[state % std::size(words)];
+				text.insert(text.end(), word, word + strlen(word));
+
+				if (state % 7 == 0)
+				{
+					text.push_back(static_cast<uint8_t>('0' + state % 10));
+				}
+			}
+
+			text.resize(size);
+			return text;
+		}
+
+		HVector<uint8_t> GenerateNoise(size_t size, uint32_t seed)
+		{
+			HVector<uint8_t> noise(size);
+			uint32_t state = seed;
+
+			for (auto& value : noise)
+			{
+				state = state * 1664525U + 1013904223U;
+				value = static_cast<uint8_t>(state >> 24);
+			}
+
+			return noise;
+		}
+
+		Buffer ToBuffer(const HVector<uint8_t>& data)
+		{
+			auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(data.size(), 0);
+			if (!data.empty())
+			{
+				std::memcpy(buffer.GetData(), data.data(), data.size());
+			}
+
+			return buffer;
+		}
+
+		bool IsSame(const Buffer& buffer, const HVector<uint8_t>& data)
+		{
+			return buffer.GetSize() == data.size()
+				&& (data.empty() || std::memcmp(buffer.GetData(), data.data(), data.size()) == 0);
+		}
+
+	} // anonymous namespace
+
+	void CompressionTest::Prepare()
+	{
+		AddTest("Round Trip", [this](auto& ls)
+		{
+			auto& taskSys = Engine::Get().GetTaskSystem();
+
+			HVector<HVector<uint8_t>> samples;
+			samples.push_back({});
+			samples.push_back({'a', 'b', 'c', 'd', 'e'});
+			samples.push_back(HVector<uint8_t>(100000, 'x'));
+			samples.push_back(GenerateText(1000, 1));
+			samples.push_back(GenerateText(300000, 2));
+			samples.push_back(GenerateNoise(200000, 3));
+
+			for (size_t i = 0; i < samples.size(); ++i)
+			{
+				auto& sample = samples[i];
+				auto frame = Compression::Compress(ToBuffer(sample), 16 * 1024);
+
+				if (frame.GetData() == nullptr)
+				{
+					ls << "Failed to compress the sample " << i << lferr;
+					continue;
+				}
+
+				ls << "Sample " << i << ": " << sample.size() << " -> " << frame.GetSize() << " bytes" << lf;
+
+				if (!IsSame(Compression::Decompress(frame), sample)
+					|| !IsSame(Compression::Decompress(frame, &taskSys), sample))
+				{
+					ls << "The sample " << i << " is different after a round trip." << lferr;
+				}
+			}
+
+			if (samples[2].size() / 100 < Compression::Compress(ToBuffer(samples[2])).GetSize())
+			{
+				ls << "A run of the same byte should be compressed more than 100 times." << lferr;
+			}
+		});
+
+		AddTest("Corrupted Data", [this](auto& ls)
+		{
+			auto text = GenerateText(100000, 4);
+			std::vector<uint8_t> frame;
+			LZCodec::CompressFrame(text.data(), text.size(), frame, 16 * 1024);
+
+			if (Compression::Decompress(frame.data(), frame.size() / 2).GetData() != nullptr)
+			{
+				ls << "Decompressed a truncated frame." << lferr;
+			}
+
+			frame[0] = 'X';
+			if (Compression::Decompress(frame.data(), frame.size()).GetData() != nullptr)
+			{
+				ls << "Decompressed a frame of a wrong magic." << lferr;
+			}
+
+			// Garbage shouldn't be read or written out of the bounds.
+			HVector<uint8_t> output(4096);
+			size_t numDecoded = 0;
+
+			for (uint32_t seed = 1; seed <= 1000; ++seed)
+			{
+				auto noise = GenerateNoise(64 + seed % 512, seed);
+				const bool isDecoded = LZCodec::DecompressBlock(noise.data(), noise.size(), output.data(), output.size());
+				numDecoded += isDecoded ? 1 : 0;
+			}
+
+			ls << numDecoded << " out of 1000 random blocks are decoded." << lf;
+		});
+
+		AddTest("Streams", [this](auto& ls)
+		{
+			constexpr size_t NumValues = 100000;
+
+			auto write = [](Buffer& buffer)
+			{
+				BufferOutputStream bos(buffer);
+				CompressedOutputStream cos(bos, 4096);
+
+				for (size_t i = 0; i < NumValues; ++i)
+				{
+					cos << static_cast<uint32_t>(i / 16) << static_cast<uint8_t>(i % 4);
+				}
+
+				cos.Finish();
+				return bos.GetCursor();
+			};
+
+			auto dummy = BufferUtil::GenerateDummyBuffer();
+			const auto size = write(dummy);
+			auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(size, 0);
+			write(buffer);
+
+			BufferInputStream bis(buffer);
+			CompressedInputStream cis(bis);
+
+			for (size_t i = 0; i < NumValues; ++i)
+			{
+				uint32_t value = 0;
+				uint8_t byte = 0;
+				cis >> value >> byte;
+
+				if (value != i / 16 || byte != i % 4)
+				{
+					ls << "Invalid value " << value << " at " << i << lferr;
+					return;
+				}
+			}
+
+			if (!cis.IsDone() || cis.HasError())
+			{
+				ls << "The stream isn't done. Error Count = " << bis.GetErrorCount() << lferr;
+			}
+
+			uint32_t value = 0;
+			if (cis.Read(&value, sizeof(value)) || !cis.HasError())
+			{
+				ls << "Read past the end of the stream." << lferr;
+			}
+
+			ls << NumValues * 5 << " bytes are streamed into " << size << " bytes." << lf;
+		});
+
+		AddTest("Parallel Decompression", [this](auto& ls)
+		{
+			constexpr size_t Size = 32 * 1024 * 1024;
+
+			auto text = GenerateText(Size, 5);
+			time::TDuration compressTime;
+			time::TDuration sequentialTime;
+			time::TDuration parallelTime;
+
+			Buffer frame;
+			{
+				auto source = ToBuffer(text);
+				time::ScopedTime timer(compressTime);
+				frame = Compression::Compress(source);
+			}
+
+			Buffer sequential;
+			{
+				time::ScopedTime timer(sequentialTime);
+				sequential = Compression::Decompress(frame);
+			}
+
+			Buffer parallel;
+			{
+				time::ScopedTime timer(parallelTime);
+				parallel = Compression::Decompress(frame, &Engine::Get().GetTaskSystem());
+			}
+
+			if (!IsSame(sequential, text) || !IsSame(parallel, text))
+			{
+				ls << "The data is different after decompressed." << lferr;
+				return;
+			}
+
+			auto toMBps = [](time::TDuration duration)
+			{ return (Size / (1024.0f * 1024.0f)) / time::ToFloat(duration); };
+
+			ls << "32MB -> " << frame.GetSize() << " bytes: compress " << toMBps(compressTime) << " MB/s, decompress "
+			   << toMBps(sequentialTime) << " MB/s, in parallel " << toMBps(parallelTime) << " MB/s" << lf;
+
+			// The blocks can't run in parallel on a single core.
+			if (parallelTime > sequentialTime && TaskSystem::GetNumHardwareThreads() > 1)
+			{
+				ls << "Decompressing in parallel is slower than one by one." << lfwarn;
+			}
+		});
+	}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,129 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Buffer.h"
+#include "BufferInputStream.h"
+#include "BufferOutputStream.h"
+#include "HSTL/HVector.h"
+#include "LZCodec.h"
+
+namespace hbe
+{
+	class TaskSystem;
+
+	/// @brief LZ compression of buffers, as a stage of the buffer generators.
+	/// @details A buffer is compressed into a frame of independent blocks (see LZCodec), so the blocks of a large one
+	/// are decompressed in parallel on the task streams.
+	namespace Compression
+	{
+		// Compress the buffer into a frame.
+		[[nodiscard]] Buffer Compress(const Buffer& source, uint32_t blockSize = LZCodec::DefaultBlockSize);
+
+		// Decompress a frame. An empty buffer if it's not a valid frame.
+		// The blocks are decompressed in parallel if a task system is given, waiting for them. So it shouldn't be
+		// called on a task stream, which could wait for itself.
+		[[nodiscard]] Buffer Decompress(const void* frame, size_t size, TaskSystem* taskSystem = nullptr);
+		[[nodiscard]] Buffer Decompress(const Buffer& frame, TaskSystem* taskSystem = nullptr);
+
+	} // namespace Compression
+
+	/// @brief Compresses what's written into blocks of a BufferOutputStream.
+	/// @details The stream is the block size, then (uint32 original size, uint32 stored size, data) of each block,
+	/// ending with an original size 0. A block stored as it is has the same sizes.
+	class CompressedOutputStream final
+	{
+	public:
+		using This = CompressedOutputStream;
+
+		explicit CompressedOutputStream(BufferOutputStream& output,
+			uint32_t blockSize = LZCodec::DefaultBlockSize) noexcept;
+		// Finish if it hasn't been.
+		~CompressedOutputStream() noexcept;
+
+		CompressedOutputStream(const CompressedOutputStream&) = delete;
+		CompressedOutputStream& operator=(const CompressedOutputStream&) = delete;
+
+		void Write(const void* data, size_t size) noexcept;
+
+		template<typename T>
+		This& operator<<(const T& value) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			Write(&value, sizeof(T));
+
+			return *this;
+		}
+
+		// Compress the last block, and write the end of the stream.
+		void Finish() noexcept;
+
+		[[nodiscard]] bool HasError() const noexcept { return output.HasError(); }
+
+	private:
+		void WriteBlock() noexcept;
+
+		BufferOutputStream& output;
+		HVector<uint8_t> block;
+		HVector<uint8_t> compressed;
+		uint32_t blockSize;
+		bool isFinished;
+	};
+
+	/// @brief Reads what CompressedOutputStream has written, decompressing a block at a time.
+	class CompressedInputStream final
+	{
+	public:
+		using This = CompressedInputStream;
+
+		explicit CompressedInputStream(BufferInputStream& input) noexcept;
+
+		CompressedInputStream(const CompressedInputStream&) = delete;
+		CompressedInputStream& operator=(const CompressedInputStream&) = delete;
+
+		// Return false if there's not enough data, counted as an error of the input stream.
+		bool Read(void* outData, size_t size) noexcept;
+
+		template<typename T>
+		This& operator>>(T& value) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			Read(&value, sizeof(T));
+
+			return *this;
+		}
+
+		[[nodiscard]] bool HasError() const noexcept { return input.HasError(); }
+		// Whether all the blocks have been read.
+		[[nodiscard]] bool IsDone() noexcept;
+
+	private:
+		bool ReadBlock() noexcept;
+
+		BufferInputStream& input;
+		HVector<uint8_t> block;
+		size_t cursor;
+		uint32_t blockSize;
+		bool isEnded;
+	};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+	class CompressionTest final : public TestCollection
+	{
+	public:
+		CompressionTest() : TestCollection("CompressionTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,423 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "LZCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace hbe
+{
+namespace LZCodec
+{
+
+	namespace
+	{
+		constexpr int HashBits = 12;
+		// The last literals and the last match, so a match is found with 4 bytes read ahead.
+		constexpr size_t LastLiterals = 5;
+		constexpr size_t MinInputSize = LastLiterals + MinMatch + 4;
+		// Copied at once for short literals and matches, where there's room to write past them.
+		constexpr size_t WildCopySize = 16;
+
+		uint32_t Read32(const uint8_t* data) noexcept
+		{
+			uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		uint64_t Read64(const uint8_t* data) noexcept
+		{
+			uint64_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		uint32_t Hash(uint32_t value) noexcept { return (value * 2654435761U) >> (32 - HashBits); }
+
+		void WriteLength(uint8_t*& output, size_t length) noexcept
+		{
+			for (; length >= 255; length -= 255)
+			{
+				*output++ = 255;
+			}
+
+			*output++ = static_cast<uint8_t>(length);
+		}
+
+		bool ReadLength(const uint8_t*& input, const uint8_t* end, size_t& length) noexcept
+		{
+			uint8_t value = 255;
+			while (value == 255)
+			{
+				if (input >= end)
+				{
+					return false;
+				}
+
+				value = *input++;
+				length += value;
+			}
+
+			return true;
+		}
+
+		// The bytes a sequence takes at most.
+		size_t GetSequenceSize(size_t numLiterals, size_t matchLength) noexcept
+		{
+			return 1 + numLiterals / 255 + 1 + numLiterals + 2 + matchLength / 255 + 1;
+		}
+
+		// The length of the common bytes, compared 8 bytes at a time.
+		size_t CountMatch(const uint8_t* lhs, const uint8_t* rhs, const uint8_t* rhsEnd) noexcept
+		{
+			const uint8_t* start = rhs;
+
+			while (rhs + sizeof(uint64_t) <= rhsEnd && Read64(lhs) == Read64(rhs))
+			{
+				lhs += sizeof(uint64_t);
+				rhs += sizeof(uint64_t);
+			}
+
+			while (rhs < rhsEnd && *lhs == *rhs)
+			{
+				++lhs;
+				++rhs;
+			}
+
+			return static_cast<size_t>(rhs - start);
+		}
+
+	} // anonymous namespace
+
+	size_t CompressBlock(const uint8_t* source, size_t size, uint8_t* outData, size_t capacity) noexcept
+	{
+		uint8_t* output = outData;
+		uint8_t* const outputEnd = outData + capacity;
+		size_t anchor = 0;
+
+		auto emit = [&](size_t position, size_t offset, size_t matchLength) -> bool
+		{
+			const size_t numLiterals = position - anchor;
+			if (GetSequenceSize(numLiterals, matchLength) > static_cast<size_t>(outputEnd - output))
+			{
+				return false;
+			}
+
+			const size_t extraLength = matchLength == 0 ? 0 : matchLength - MinMatch;
+			uint8_t* token = output++;
+			*token = static_cast<uint8_t>((std::min<size_t>(numLiterals, 15) << 4) | std::min<size_t>(extraLength, 15));
+
+			if (numLiterals >= 15)
+			{
+				WriteLength(output, numLiterals - 15);
+			}
+
+			std::memcpy(output, source + anchor, numLiterals);
+			output += numLiterals;
+
+			if (matchLength > 0)
+			{
+				*output++ = static_cast<uint8_t>(offset);
+				*output++ = static_cast<uint8_t>(offset >> 8);
+
+				if (extraLength >= 15)
+				{
+					WriteLength(output, extraLength - 15);
+				}
+			}
+
+			return true;
+		};
+
+		if (size >= MinInputSize)
+		{
+			uint32_t table[1 << HashBits] = {};
+			const size_t searchEnd = size - LastLiterals - MinMatch;
+			const uint8_t* const matchEnd = source + size - LastLiterals;
+			size_t position = 0;
+
+			while (position < searchEnd)
+			{
+				const auto value = Read32(source + position);
+				auto& slot = table[Hash(value)];
+				size_t candidate = slot;
+				slot = static_cast<uint32_t>(position);
+
+				if (candidate >= position || position - candidate > MaxOffset || Read32(source + candidate) != value)
+				{
+					// Skip faster over the data which doesn't compress.
+					position += 1 + ((position - anchor) >> 6);
+					continue;
+				}
+
+				while (position > anchor && candidate > 0 && source[position - 1] == source[candidate - 1])
+				{
+					--position;
+					--candidate;
+				}
+
+				const size_t matchLength = MinMatch
+					+ CountMatch(source + candidate + MinMatch, source + position + MinMatch, matchEnd);
+
+				if (!emit(position, position - candidate, matchLength))
+				{
+					return 0;
+				}
+
+				position += matchLength;
+				anchor = position;
+
+				if (position - 2 < searchEnd)
+				{
+					table[Hash(Read32(source + position - 2))] = static_cast<uint32_t>(position - 2);
+				}
+			}
+		}
+
+		if (!emit(size, 0, 0))
+		{
+			return 0;
+		}
+
+		return static_cast<size_t>(output - outData);
+	}
+
+	bool DecompressBlock(const uint8_t* source, size_t size, uint8_t* outData, size_t originalSize) noexcept
+	{
+		const uint8_t* input = source;
+		const uint8_t* const inputEnd = source + size;
+		uint8_t* output = outData;
+		uint8_t* const outputEnd = outData + originalSize;
+
+		while (input < inputEnd)
+		{
+			const uint8_t token = *input++;
+
+			size_t numLiterals = token >> 4;
+			if (numLiterals == 15 && !ReadLength(input, inputEnd, numLiterals))
+			{
+				return false;
+			}
+
+			if (numLiterals > static_cast<size_t>(inputEnd - input)
+				|| numLiterals > static_cast<size_t>(outputEnd - output))
+			{
+				return false;
+			}
+
+			// Mostly short, so a fixed size copy is faster, where both have room for it.
+			if (numLiterals <= WildCopySize && static_cast<size_t>(inputEnd - input) >= WildCopySize
+				&& static_cast<size_t>(outputEnd - output) >= WildCopySize)
+			{
+				std::memcpy(output, input, WildCopySize);
+			}
+			else
+			{
+				std::memcpy(output, input, numLiterals);
+			}
+
+			input += numLiterals;
+			output += numLiterals;
+
+			if (input == inputEnd)
+			{
+				// The last sequence.
+				return output == outputEnd;
+			}
+
+			if (inputEnd - input < 2)
+			{
+				return false;
+			}
+
+			const size_t offset = input[0] | (size_t(input[1]) << 8);
+			input += 2;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !ReadLength(input, inputEnd, matchLength))
+			{
+				return false;
+			}
+
+			matchLength += MinMatch;
+
+			if (offset == 0 || offset > static_cast<size_t>(output - outData)
+				|| matchLength > static_cast<size_t>(outputEnd - output))
+			{
+				return false;
+			}
+
+			const uint8_t* match = output - offset;
+			if (offset >= sizeof(uint64_t) && static_cast<size_t>(outputEnd - output) >= matchLength + WildCopySize)
+			{
+				// 8 bytes at a time, past the end of the match. They don't overlap, as the offset is 8 or more.
+				for (size_t i = 0; i < matchLength; i += sizeof(uint64_t))
+				{
+					std::memcpy(output + i, match + i, sizeof(uint64_t));
+				}
+
+				output += matchLength;
+				continue;
+			}
+
+			if (offset >= matchLength)
+			{
+				std::memcpy(output, match, matchLength);
+				output += matchLength;
+				continue;
+			}
+
+			// Overlapped, so the repeated bytes are copied as they're written.
+			for (size_t i = 0; i < matchLength; ++i)
+			{
+				output[i] = match[i];
+			}
+
+			output += matchLength;
+		}
+
+		return false;
+	}
+
+	bool CompressFrame(const void* data, size_t size, std::vector<uint8_t>& outFrame, uint32_t blockSize)
+	{
+		if (blockSize == 0 || (data == nullptr && size > 0))
+		{
+			return false;
+		}
+
+		auto source = static_cast<const uint8_t*>(data);
+
+		FrameHeader header{};
+		std::memcpy(header.magic, Magic, sizeof(Magic));
+		header.blockSize = blockSize;
+		header.originalSize = size;
+		header.numBlocks = static_cast<uint32_t>((size + blockSize - 1) / blockSize);
+
+		if ((size + blockSize - 1) / blockSize > UINT32_MAX)
+		{
+			return false;
+		}
+
+		std::vector<BlockEntry> blocks(header.numBlocks);
+		size_t offset = sizeof(FrameHeader) + sizeof(BlockEntry) * blocks.size();
+		outFrame.resize(offset);
+
+		for (uint32_t i = 0; i < header.numBlocks; ++i)
+		{
+			const size_t start = size_t(i) * blockSize;
+			const size_t length = std::min<size_t>(blockSize, size - start);
+
+			// Stored if it doesn't get smaller.
+			outFrame.resize(offset + length);
+			auto compressedSize = CompressBlock(source + start, length, outFrame.data() + offset, length);
+
+			auto& block = blocks[i];
+			block.offset = offset;
+
+			if (compressedSize == 0)
+			{
+				std::memcpy(outFrame.data() + offset, source + start, length);
+				compressedSize = length;
+				block.isStored = 1;
+			}
+
+			block.size = static_cast<uint32_t>(compressedSize);
+			offset += compressedSize;
+		}
+
+		outFrame.resize(offset);
+		std::memcpy(outFrame.data(), &header, sizeof(header));
+		std::memcpy(outFrame.data() + sizeof(header), blocks.data(), sizeof(BlockEntry) * blocks.size());
+
+		return true;
+	}
+
+	FrameView::FrameView() noexcept : data(nullptr), header{}, blocks(nullptr) {}
+
+	bool FrameView::Open(const void* inData, size_t size) noexcept
+	{
+		data = nullptr;
+		header = FrameHeader{};
+		blocks = nullptr;
+
+		if (!IsFrame(inData, size))
+		{
+			return false;
+		}
+
+		auto frame = static_cast<const uint8_t*>(inData);
+
+		FrameHeader inHeader;
+		std::memcpy(&inHeader, frame, sizeof(inHeader));
+
+		if (inHeader.blockSize == 0
+			|| inHeader.numBlocks != (inHeader.originalSize + inHeader.blockSize - 1) / inHeader.blockSize
+			|| inHeader.numBlocks > (size - sizeof(FrameHeader)) / sizeof(BlockEntry)
+			|| reinterpret_cast<uintptr_t>(frame + sizeof(FrameHeader)) % alignof(BlockEntry) != 0)
+		{
+			return false;
+		}
+
+		auto table = reinterpret_cast<const BlockEntry*>(frame + sizeof(FrameHeader));
+		for (uint32_t i = 0; i < inHeader.numBlocks; ++i)
+		{
+			auto& block = table[i];
+			const uint64_t length = std::min<uint64_t>(inHeader.blockSize,
+				inHeader.originalSize - uint64_t(i) * inHeader.blockSize);
+
+			if (block.offset > size || block.size > size - block.offset || (block.isStored && block.size != length))
+			{
+				return false;
+			}
+		}
+
+		data = frame;
+		header = inHeader;
+		blocks = table;
+
+		return true;
+	}
+
+	bool FrameView::DecompressBlock(uint32_t index, uint8_t* outData) const noexcept
+	{
+		if (index >= header.numBlocks)
+		{
+			return false;
+		}
+
+		auto& block = blocks[index];
+		const uint64_t start = uint64_t(index) * header.blockSize;
+		const size_t length = static_cast<size_t>(std::min<uint64_t>(header.blockSize, header.originalSize - start));
+
+		if (block.isStored)
+		{
+			std::memcpy(outData + start, data + block.offset, length);
+			return true;
+		}
+
+		return LZCodec::DecompressBlock(data + block.offset, block.size, outData + start, length);
+	}
+
+	bool FrameView::Decompress(uint8_t* outData) const noexcept
+	{
+		for (uint32_t i = 0; i < header.numBlocks; ++i)
+		{
+			if (!DecompressBlock(i, outData))
+			{
+				return false;
+			}
+		}
+
+		return IsOpen();
+	}
+
+	bool IsFrame(const void* data, size_t size) noexcept
+	{
+		return data != nullptr && size >= sizeof(FrameHeader) && std::memcmp(data, Magic, sizeof(Magic)) == 0;
+	}
+
+} // namespace LZCodec
+} // namespace hbe
@@ -0,0 +1,91 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A fast LZ compressor in the family of LZ4, shared by the engine and Tools/ResourcePacker. It depends on the standard
+// library only, so the packer can be built without the engine.
+namespace hbe
+{
+namespace LZCodec
+{
+
+	/// @details A block is a run of sequences, each of them a token, literals, and a match copied from the output.
+	///   token: the literal length (high 4 bits) and the match length - MinMatch (low 4 bits). 15 is followed by
+	///          bytes added to it, until one is less than 255.
+	///   literals, uint16 offset back into the output, then the match.
+	/// The last sequence has the literals only.
+	constexpr size_t MinMatch = 4;
+	constexpr size_t MaxOffset = UINT16_MAX;
+
+	// The largest size a block of the size can be compressed into.
+	[[nodiscard]] constexpr size_t GetMaxBlockSize(size_t size) noexcept { return size + size / 255 + 16; }
+
+	// Compress a block. Return the compressed size, or 0 if it doesn't fit in the capacity.
+	size_t CompressBlock(const uint8_t* source, size_t size, uint8_t* outData, size_t capacity) noexcept;
+	// Decompress a block into exactly originalSize bytes. Return false if the data is corrupted.
+	bool DecompressBlock(const uint8_t* source, size_t size, uint8_t* outData, size_t originalSize) noexcept;
+
+	/// @details A frame is a header, the block table, and then the blocks. The data is split into blocks of
+	/// blockSize, compressed independently, so they can be decompressed in parallel. A block which doesn't get smaller
+	/// is stored as it is. Integers are in the byte order of the writer.
+	constexpr char Magic[4] = {'H', 'B', 'L', 'Z'};
+	constexpr uint32_t DefaultBlockSize = 64 * 1024;
+
+	struct FrameHeader final
+	{
+		char magic[sizeof(Magic)];
+		uint32_t blockSize;
+		uint64_t originalSize;
+		uint32_t numBlocks;
+		uint32_t reserved;
+	};
+
+	struct BlockEntry final
+	{
+		// From the start of the frame.
+		uint64_t offset;
+		uint32_t size;
+		uint32_t isStored;
+	};
+
+	static_assert(sizeof(FrameHeader) == 24);
+	static_assert(sizeof(BlockEntry) == 16);
+
+	// Compress the data into a frame, replacing the output.
+	bool CompressFrame(const void* data, size_t size, std::vector<uint8_t>& outFrame,
+		uint32_t blockSize = DefaultBlockSize);
+
+	/// @brief Reads a frame in place, e.g. mapped in memory.
+	class FrameView final
+	{
+	private:
+		const uint8_t* data;
+		FrameHeader header;
+		const BlockEntry* blocks;
+
+	public:
+		FrameView() noexcept;
+
+		// Validate the header and the block table. The data should be valid while it's used.
+		bool Open(const void* data, size_t size) noexcept;
+
+		[[nodiscard]] bool IsOpen() const noexcept { return data != nullptr; }
+		[[nodiscard]] uint64_t GetOriginalSize() const noexcept { return header.originalSize; }
+		[[nodiscard]] uint32_t GetNumBlocks() const noexcept { return header.numBlocks; }
+		[[nodiscard]] uint32_t GetBlockSize() const noexcept { return header.blockSize; }
+
+		// Decompress the block into its place in the output of GetOriginalSize() bytes.
+		bool DecompressBlock(uint32_t index, uint8_t* outData) const noexcept;
+		// Decompress all the blocks one by one.
+		bool Decompress(uint8_t* outData) const noexcept;
+	};
+
+	// Whether the data starts with a frame header.
+	[[nodiscard]] bool IsFrame(const void* data, size_t size) noexcept;
+
+} // namespace LZCodec
+} // namespace hbe
@@ -2,12 +2,87 @@
 
 #include "Resource.h"
 
+#include "Core/Debug.h"
+
 
 namespace hbe
 {
 
-	Resource::Resource() noexcept = default;
+	ResourceItem::ResourceItem(uint32_t id, StaticString path, TDecoder decoder) noexcept
+		: id(id)
+		, path(path)
+		, decoder(decoder)
+		, referenceCount(0)
+		, state(EResourceState::Loading)
+	{
+	}
+
+	Resource::Resource() noexcept : item(nullptr) {}
+
+	Resource::Resource(ResourceItem* item) noexcept : item(item)
+	{
+		if (item != nullptr)
+		{
+			item->referenceCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	Resource::Resource(const Resource& rhs) noexcept : Resource(rhs.item) {}
+
+	Resource::Resource(Resource&& rhs) noexcept : item(rhs.item) { rhs.item = nullptr; }
+
+	Resource::~Resource() noexcept { Reset(); }
+
+	Resource& Resource::operator=(const Resource& rhs) noexcept
+	{
+		if (item != rhs.item)
+		{
+			Resource copied(rhs);
+			*this = std::move(copied);
+		}
+
+		return *this;
+	}
+
+	Resource& Resource::operator=(Resource&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			Reset();
+
+			item = rhs.item;
+			rhs.item = nullptr;
+		}
+
+		return *this;
+	}
+
+	void Resource::Reset() noexcept
+	{
+		if (item == nullptr)
+		{
+			return;
+		}
+
+		// ResourceManager unloads it later on the main thread.
+		item->referenceCount.fetch_sub(1, std::memory_order_release);
+		item = nullptr;
+	}
+
+	EResourceState Resource::GetState() const noexcept
+	{
+		return item == nullptr ? EResourceState::Failed : item->state.load(std::memory_order_acquire);
+	}
+
+	uint32_t Resource::GetID() const noexcept { return item == nullptr ? 0 : item->id; }
+
+	StaticString Resource::GetPath() const noexcept { return item == nullptr ? StaticString() : item->path; }
+
+	const Buffer& Resource::GetBuffer() const noexcept
+	{
+		FatalAssert(IsLoaded(), "The resource %s isn't loaded.", GetPath().c_str());
 
-	Resource::~Resource() noexcept = default;
+		return item->buffer;
+	}
 
 } // namespace hbe
@@ -1,19 +1,73 @@
 // Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
 
 #pragma once
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include "Buffer.h"
 #include "String/StaticString.h"
 
 namespace hbe
 {
 
-	/// @brief Handle to a loaded resource managed by ResourceManager.
+	enum class EResourceState : uint8_t
+	{
+		Loading,
+		Loaded,
+		Failed
+	};
+
+	/// @brief Internal storage for a resource with reference counting, owned by ResourceManager.
+	class ResourceItem final
+	{
+	public:
+		// Decode the file in place of its buffer on a worker stream. Return false if it's corrupted.
+		using TDecoder = bool (*)(StaticString path, Buffer& inOutBuffer);
+
+		const uint32_t id;
+		const StaticString path;
+		const TDecoder decoder;
+
+		std::atomic<uint32_t> referenceCount;
+		// Published by the main thread, unless ResourceManager::Load loads it. The buffer is valid once it's Loaded.
+		std::atomic<EResourceState> state;
+		Buffer buffer;
+
+		ResourceItem(uint32_t id, StaticString path, TDecoder decoder) noexcept;
+	};
+
+	/// @brief Handle to a resource managed by ResourceManager.
+	/// @details Copies of a handle share the resource, which is unloaded by ResourceManager::PostUpdate() after the
+	/// last handle is gone. A requested resource is loading until the main thread publishes it.
 	class Resource final
 	{
+	private:
+		ResourceItem* item;
+
+		friend class ResourceManager;
+
 	public:
 		Resource() noexcept;
+		explicit Resource(ResourceItem* item) noexcept;
+		Resource(const Resource& rhs) noexcept;
+		Resource(Resource&& rhs) noexcept;
 		~Resource() noexcept;
+
+		Resource& operator=(const Resource& rhs) noexcept;
+		Resource& operator=(Resource&& rhs) noexcept;
+
+		void Reset() noexcept;
+
+		[[nodiscard]] bool IsValid() const noexcept { return item != nullptr; }
+		[[nodiscard]] EResourceState GetState() const noexcept;
+		[[nodiscard]] bool IsLoading() const noexcept { return GetState() == EResourceState::Loading; }
+		[[nodiscard]] bool IsLoaded() const noexcept { return GetState() == EResourceState::Loaded; }
+		[[nodiscard]] bool HasFailed() const noexcept { return GetState() == EResourceState::Failed; }
+
+		[[nodiscard]] uint32_t GetID() const noexcept;
+		[[nodiscard]] StaticString GetPath() const noexcept;
+		// It should be loaded.
+		[[nodiscard]] const Buffer& GetBuffer() const noexcept;
 	};
 
 } // namespace hbe
@@ -0,0 +1,425 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "ResourceArchive.h"
+
+#include "BufferUtil.h"
+#include "Compression.h"
+#include "Core/CommonMacros.h"
+#include "Log/Logger.h"
+
+
+namespace hbe
+{
+	namespace
+	{
+		StaticString GetClassName()
+		{
+			static StaticString name("ResourceArchive");
+			return name;
+		}
+
+	} // anonymous namespace
+
+	ResourceArchive::ResourceArchive() noexcept : numViews(0) {}
+
+	ResourceArchive::~ResourceArchive() noexcept { Close(); }
+
+	bool ResourceArchive::Open(StaticString archivePath) noexcept
+	{
+		Close();
+
+		auto log = Logger::Get(GetClassName());
+
+		mapping = BufferUtil::GetReadOnlyFileBuffer(archivePath);
+		returnValueIf(false, mapping.GetData() == nullptr);
+
+		if (unlikely(!view.Open(mapping.GetData(), mapping.GetSize())))
+		{
+			log.OutError([archivePath](auto& ls) { ls << archivePath << " isn't a valid archive."; });
+			mapping = Buffer();
+
+			return false;
+		}
+
+		path = archivePath;
+
+		log.Out([this](auto& ls) { ls << "Opened " << path << ", " << view.GetNumEntries() << " entries."; });
+
+		return true;
+	}
+
+	void ResourceArchive::Close() noexcept
+	{
+		returnIf(!view.IsOpen());
+
+		FatalAssert(GetNumViews() == 0, "%s is closed with %zu views left.", path.c_str(), GetNumViews());
+
+		view.Close();
+		mapping = Buffer();
+		path = StaticString();
+	}
+
+	bool ResourceArchive::Contains(StaticString entryPath) const noexcept { return Find(entryPath) != nullptr; }
+
+	Buffer ResourceArchive::GetBuffer(StaticString entryPath) const noexcept
+	{
+		bool isCompressed = false;
+		auto buffer = GetView(entryPath, isCompressed);
+		returnValueIf(buffer, !isCompressed);
+
+		auto decompressed = Compression::Decompress(buffer);
+		if (unlikely(decompressed.GetData() == nullptr && Find(entryPath)->originalSize > 0))
+		{
+			auto log = Logger::Get(GetClassName());
+			log.OutError([entryPath](auto& ls) { ls << "Failed to decompress " << entryPath; });
+		}
+
+		return decompressed;
+	}
+
+	Buffer ResourceArchive::GetView(StaticString entryPath, bool& outIsCompressed) const noexcept
+	{
+		using namespace BufferTypes;
+
+		outIsCompressed = false;
+
+		auto entry = Find(entryPath);
+		returnValueIf(Buffer(), entry == nullptr);
+
+		if (unlikely(entry->compression != ArchiveFormat::ECompression::Stored
+			&& entry->compression != ArchiveFormat::ECompression::LZ))
+		{
+			auto log = Logger::Get(GetClassName());
+			log.OutError([entryPath](auto& ls) { ls << entryPath << " is compressed in an unknown way."; });
+
+			return Buffer();
+		}
+
+		outIsCompressed = entry->compression == ArchiveFormat::ECompression::LZ;
+		numViews.fetch_add(1, std::memory_order_relaxed);
+
+		auto data = const_cast<uint8_t*>(view.GetData(*entry));
+		auto generator = [data, size = entry->size](TSize& outSize, TBufferData& outData)
+		{
+			outSize = size;
+			outData = data;
+		};
+
+		return Buffer(generator, [this](TSize, TBufferData) { numViews.fetch_sub(1, std::memory_order_relaxed); });
+	}
+
+	const ArchiveFormat::Entry* ResourceArchive::Find(StaticString entryPath) const noexcept
+	{
+		return view.Find(entryPath.GetHash(), std::string_view(entryPath.c_str(), entryPath.GetLength()));
+	}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <fstream>
+#include "Core/ScopedTime.h"
+#include "HSTL/HVector.h"
+#include "OSAL/OSAbstractLayer.h"
+#include "OSAL/OSFileHandle.h"
+#include "OSAL/OSFileOpenMode.h"
+#include "OSAL/OSInputOutput.h"
+#include "String/InlineStringBuilder.h"
+
+namespace hbe
+{
+	namespace
+	{
+		constexpr const char* ArchivePath = "ResourceArchiveTest.pak";
+		constexpr const char* Directory = "ResourceArchiveTestFiles";
+
+		StaticString GetTestPath(size_t index)
+		{
+			InlineStringBuilder<256> path;
+			path << Directory << "/File" << index << ".res";
+
+			return StaticString(path.c_str());
+		}
+
+		HVector<uint8_t> GetTestData(size_t index, size_t size)
+		{
+			HVector<uint8_t> data(size);
+			for (size_t i = 0; i < size; ++i)
+			{
+				data[i] = static_cast<uint8_t>(index * 7 + i);
+			}
+
+			return data;
+		}
+
+		bool WriteArchive(const HVector<StaticString>& paths, size_t size)
+		{
+			std::ofstream output(ArchivePath, std::ios::binary | std::ios::trunc);
+			ArchiveFormat::Writer writer(output);
+
+			for (size_t i = 0; i < paths.size(); ++i)
+			{
+				auto data = GetTestData(i, size);
+				returnValueIf(false, !writer.Add(paths[i].c_str(), data.data(), data.size()));
+			}
+
+			return writer.Finish();
+		}
+
+		bool IsTestData(const Buffer& buffer, size_t index, size_t size)
+		{
+			returnValueIf(false, buffer.GetData() == nullptr || buffer.GetSize() != size);
+
+			auto data = GetTestData(index, size);
+			return memcmp(buffer.GetData(), data.data(), size) == 0;
+		}
+
+	} // anonymous namespace
+
+	void ResourceArchiveTest::Prepare()
+	{
+		AddTest("Pack and Read", [this](auto& ls)
+		{
+			HVector<StaticString> paths;
+			for (size_t i = 0; i < 64; ++i)
+			{
+				paths.push_back(GetTestPath(i));
+			}
+
+			if (!WriteArchive(paths, 1000))
+			{
+				ls << "Failed to write " << ArchivePath << lferr;
+				return;
+			}
+
+			{
+				ResourceArchive archive;
+				if (!archive.Open(StaticString(ArchivePath)) || archive.GetNumEntries() != paths.size())
+				{
+					ls << "Failed to open " << ArchivePath << lferr;
+					OS::Delete(StaticString(ArchivePath));
+					return;
+				}
+
+				for (size_t i = 0; i < paths.size(); ++i)
+				{
+					auto buffer = archive.GetBuffer(paths[i]);
+					if (!IsTestData(buffer, i, 1000))
+					{
+						ls << "Wrong data of " << paths[i] << lferr;
+						break;
+					}
+
+					if (archive.GetBuffer(paths[i]).GetData() != buffer.GetData())
+					{
+						ls << "The buffers of " << paths[i] << " aren't views of the mapping." << lferr;
+						break;
+					}
+
+					if (reinterpret_cast<uintptr_t>(buffer.GetData()) % ArchiveFormat::DataAlignment != 0)
+					{
+						ls << "The data of " << paths[i] << " isn't aligned." << lferr;
+						break;
+					}
+				}
+
+				if (archive.GetNumViews() != 0)
+				{
+					ls << archive.GetNumViews() << " views are left after released." << lferr;
+				}
+
+				const StaticString missing("ResourceArchiveTestFiles/Missing.res");
+				if (archive.Contains(missing) || archive.GetBuffer(missing).GetData() != nullptr)
+				{
+					ls << "Found a missing entry." << lferr;
+				}
+
+				if (paths[0].GetHash() != ArchiveFormat::CalculateHash(paths[0].c_str()))
+				{
+					ls << "The archive hash is different from StaticString's." << lferr;
+				}
+			}
+
+			OS::Delete(StaticString(ArchivePath));
+		});
+
+		AddTest("Compressed Entries", [this](auto& ls)
+		{
+			constexpr size_t Size = 100000;
+
+			{
+				std::ofstream output(ArchivePath, std::ios::binary | std::ios::trunc);
+				ArchiveFormat::Writer writer(output);
+
+				for (size_t i = 0; i < 4; ++i)
+				{
+					auto data = GetTestData(i, Size);
+					writer.Add(GetTestPath(i).c_str(), data.data(), data.size(), ArchiveFormat::ECompression::LZ);
+				}
+
+				if (!writer.Finish())
+				{
+					ls << "Failed to write " << ArchivePath << lferr;
+					return;
+				}
+			}
+
+			{
+				ResourceArchive archive;
+				archive.Open(StaticString(ArchivePath));
+
+				for (size_t i = 0; i < 4; ++i)
+				{
+					if (!IsTestData(archive.GetBuffer(GetTestPath(i)), i, Size))
+					{
+						ls << "Wrong data of " << GetTestPath(i) << lferr;
+					}
+				}
+
+				if (archive.GetNumViews() != 0)
+				{
+					ls << "A compressed entry shouldn't be a view of the mapping." << lferr;
+				}
+
+				bool isCompressed = false;
+				auto frame = archive.GetView(GetTestPath(0), isCompressed);
+				if (!isCompressed || archive.GetNumViews() != 1
+					|| !IsTestData(Compression::Decompress(frame), 0, Size))
+				{
+					ls << "The view of a compressed entry isn't its frame." << lferr;
+				}
+			}
+
+			const auto archiveSize = BufferUtil::GetReadOnlyFileBuffer(StaticString(ArchivePath)).GetSize();
+			ls << (4 * Size) << " bytes are packed into " << archiveSize << " bytes." << lf;
+
+			if (archiveSize >= 4 * Size)
+			{
+				ls << "The entries aren't compressed." << lferr;
+			}
+
+			OS::Delete(StaticString(ArchivePath));
+		});
+
+		AddTest("Invalid Archive", [this](auto& ls)
+		{
+			HVector<StaticString> paths;
+			paths.push_back(GetTestPath(0));
+			paths.push_back(GetTestPath(0));
+
+			{
+				std::ofstream output(ArchivePath, std::ios::binary | std::ios::trunc);
+				ArchiveFormat::Writer writer(output);
+
+				auto data = GetTestData(0, 16);
+				if (!writer.Add(paths[0].c_str(), data.data(), data.size())
+					|| writer.Add(paths[1].c_str(), data.data(), data.size()))
+				{
+					ls << "The duplicated entry isn't rejected." << lferr;
+				}
+				else
+				{
+					ls << "Rejected: " << writer.GetError().c_str() << lf;
+				}
+			}
+
+			{
+				std::ofstream output(ArchivePath, std::ios::binary | std::ios::trunc);
+				output << "This is not an archive, but long enough to have a header.";
+			}
+
+			ResourceArchive archive;
+			if (archive.Open(StaticString(ArchivePath)))
+			{
+				ls << "Opened a corrupted archive." << lferr;
+			}
+
+			OS::Delete(StaticString(ArchivePath));
+		});
+
+		AddTest("Open Performance", [this](auto& ls)
+		{
+			constexpr size_t NumFiles = 1000;
+			constexpr size_t FileSize = 1024;
+
+			HVector<StaticString> paths;
+			for (size_t i = 0; i < NumFiles; ++i)
+			{
+				paths.push_back(GetTestPath(i));
+			}
+
+			OS::FileOpenMode openMode;
+			openMode.SetWriteOnly();
+			openMode.SetCreate();
+			openMode.SetTruncate();
+
+			bool isWritten = OS::MakeDirectory(Directory) && WriteArchive(paths, FileSize);
+			for (size_t i = 0; i < NumFiles && isWritten; ++i)
+			{
+				auto data = GetTestData(i, FileSize);
+
+				OS::FileHandle handle;
+				isWritten = OS::Open(handle, paths[i], openMode) && OS::Write(handle, data.data(), FileSize) == FileSize;
+				OS::Close(std::move(handle));
+			}
+
+			size_t numFileRead = 0;
+			size_t numArchiveRead = 0;
+			time::TDuration fileTime{};
+			time::TDuration archiveTime{};
+
+			if (isWritten)
+			{
+				{
+					time::ScopedTime timer(fileTime);
+
+					for (size_t i = 0; i < NumFiles; ++i)
+					{
+						auto buffer = BufferUtil::GetReadOnlyFileBuffer(paths[i]);
+						numFileRead += IsTestData(buffer, i, FileSize) ? 1 : 0;
+					}
+				}
+
+				{
+					time::ScopedTime timer(archiveTime);
+
+					ResourceArchive archive;
+					archive.Open(StaticString(ArchivePath));
+
+					for (size_t i = 0; i < NumFiles; ++i)
+					{
+						auto buffer = archive.GetBuffer(paths[i]);
+						numArchiveRead += IsTestData(buffer, i, FileSize) ? 1 : 0;
+					}
+				}
+			}
+
+			for (auto path : paths)
+			{
+				OS::Delete(path);
+			}
+
+			OS::DeleteDirectory(Directory);
+			OS::Delete(StaticString(ArchivePath));
+
+			if (numFileRead != NumFiles || numArchiveRead != NumFiles)
+			{
+				ls << "Read " << numFileRead << " files, and " << numArchiveRead << " entries out of " << NumFiles
+				   << lferr;
+				return;
+			}
+
+			const auto fileSec = time::ToFloat(fileTime);
+			const auto archiveSec = time::ToFloat(archiveTime);
+
+			ls << NumFiles << " files: mapped one by one " << fileSec << " sec, from an archive " << archiveSec
+			   << " sec (x" << (fileSec / archiveSec) << ')' << lf;
+
+			if (archiveSec > fileSec)
+			{
+				ls << "Reading from an archive is slower than mapping the files." << lfwarn;
+			}
+		});
+	}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
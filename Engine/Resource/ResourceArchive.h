@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include "ArchiveFormat.h"
+#include "Buffer.h"
+#include "String/StaticString.h"
+
+namespace hbe
+{
+
+	/// @brief A packed archive mapped once, whose entries are read in place.
+	/// @details The TOC is sorted by StaticString::GetHash(), so a lookup is a binary search without hashing the path.
+	/// The buffers of the stored entries are views into the mapping, which should be released before closing the
+	/// archive. Archives are written by Tools/ResourcePacker, or ArchiveFormat::Writer.
+	class ResourceArchive final
+	{
+	public:
+		ResourceArchive() noexcept;
+		~ResourceArchive() noexcept;
+
+		ResourceArchive(const ResourceArchive&) = delete;
+		ResourceArchive& operator=(const ResourceArchive&) = delete;
+
+		// Map the archive, and validate its TOC. Return false if it's not an archive.
+		bool Open(StaticString path) noexcept;
+		void Close() noexcept;
+
+		[[nodiscard]] bool IsOpen() const noexcept { return view.IsOpen(); }
+		[[nodiscard]] StaticString GetPath() const noexcept { return path; }
+		[[nodiscard]] uint32_t GetNumEntries() const noexcept { return view.GetNumEntries(); }
+		[[nodiscard]] bool Contains(StaticString entryPath) const noexcept;
+
+		// A view of the entry, or an empty buffer if there's no entry of the path.
+		// A compressed entry is decompressed into a new buffer instead.
+		[[nodiscard]] Buffer GetBuffer(StaticString entryPath) const noexcept;
+		// A view of the entry as it's stored, so a compressed one can be decompressed by Compression::Decompress later.
+		[[nodiscard]] Buffer GetView(StaticString entryPath, bool& outIsCompressed) const noexcept;
+		// The views which haven't been released yet.
+		[[nodiscard]] size_t GetNumViews() const noexcept { return numViews.load(std::memory_order_relaxed); }
+
+	private:
+		[[nodiscard]] const ArchiveFormat::Entry* Find(StaticString entryPath) const noexcept;
+
+		StaticString path;
+		Buffer mapping;
+		ArchiveFormat::View view;
+		mutable std::atomic<size_t> numViews;
+	};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+	class ResourceArchiveTest final : public TestCollection
+	{
+	public:
+		ResourceArchiveTest() : TestCollection("ResourceArchiveTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+} // namespace hbe
+#endif //__UNIT_TEST__
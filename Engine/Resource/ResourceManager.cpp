@@ -2,19 +2,718 @@
 
 #include "ResourceManager.h"
 
+#include <algorithm>
+#include <thread>
 #include "../Engine/Engine.h"
+#include "BufferUtil.h"
+#include "Compression.h"
+#include "Core/CommonMacros.h"
 #include "Core/TaskSystem.h"
+#include "Log/Logger.h"
+#include "Memory/AllocatorScope.h"
+#include "Memory/MemoryManager.h"
 
 
 namespace hbe
 {
+	namespace
+	{
+		StaticString GetClassName()
+		{
+			static StaticString name("ResourceManager");
+			return name;
+		}
 
-	ResourceManager::ResourceManager() noexcept = default;
+	} // anonymous namespace
 
-	ResourceManager::~ResourceManager() noexcept = default;
+	ResourceManager::LoadingBatch::LoadingBatch(ResourceManager& manager, const TVector<ResourceItem*>& items) noexcept
+		: manager(manager)
+		, readTask(StaticString("ResourceManager.Read"), RunRead, this)
+		, decodeTask(StaticString("ResourceManager.Decode"), RunDecode, this)
+	{
+		entries.reserve(items.size());
+		for (auto* item : items)
+		{
+			entries.push_back(Entry{item, false, false});
+		}
 
-	void ResourceManager::PostUpdate(Engine& engine) noexcept {}
+		readTask.SetCompletionCallback(OnRead, this);
+		decodeTask.SetCompletionCallback(OnDecoded, this);
+	}
 
-	void ResourceManager::RequestTasks(TaskSystem& taskSys) noexcept {}
+	ResourceManager::ResourceManager() noexcept : lastID(0), numLoading(0) {}
+
+	ResourceManager::~ResourceManager() noexcept
+	{
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+		auto& mmgr = MemoryManager::GetInstance();
+
+		// The engine joins the task streams before destroying it, so no batch is running.
+		for (auto* batch : batches)
+		{
+			mmgr.Delete(batch);
+		}
+
+		for (auto& [path, item] : resources)
+		{
+			Assert(item->referenceCount.load() == 0, "%s is still referenced by %u handles.", path.c_str(),
+				item->referenceCount.load());
+
+			mmgr.Delete(item);
+		}
+
+		// After the resources, which may be views into the archives.
+		for (auto* archive : archives)
+		{
+			mmgr.Delete(archive);
+		}
+
+		batches.clear();
+		resources.clear();
+		loadingRequests.clear();
+		archives.clear();
+	}
+
+	void ResourceManager::PostUpdate(Engine& engine) noexcept
+	{
+		RequestTasks(engine.GetTaskSystem());
+		UnloadUnused();
+	}
+
+	Resource ResourceManager::RequestLoad(StaticString path)
+	{
+		bool isNew = false;
+		return FindOrAdd(path, true, isNew);
+	}
+
+	Resource ResourceManager::Load(StaticString path)
+	{
+		bool isNew = false;
+		auto resource = FindOrAdd(path, false, isNew);
+
+		if (isNew)
+		{
+			auto* item = resource.item;
+			const bool isLoaded = ReadItem(*item);
+			item->state.store(isLoaded ? EResourceState::Loaded : EResourceState::Failed, std::memory_order_release);
+
+			return resource;
+		}
+
+		auto& taskSys = Engine::Get().GetTaskSystem();
+		while (resource.IsLoading())
+		{
+			// The main thread publishes the requests, so it can't just wait for them.
+			if (TaskSystem::IsBaseThread())
+			{
+				RequestTasks(taskSys);
+				taskSys.ProcessMainThreadTasks();
+			}
+
+			std::this_thread::yield();
+		}
+
+		return resource;
+	}
+
+	bool ResourceManager::MountArchive(StaticString path) noexcept
+	{
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+		auto& mmgr = MemoryManager::GetInstance();
+
+		auto* archive = mmgr.New<ResourceArchive>();
+		if (unlikely(!archive->Open(path)))
+		{
+			mmgr.Delete(archive);
+			return false;
+		}
+
+		std::lock_guard guard(lock);
+		archives.push_back(archive);
+
+		return true;
+	}
+
+	void ResourceManager::SetDecoder(StaticString extension, TDecoder decoder) noexcept
+	{
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+		std::lock_guard guard(lock);
+
+		if (decoder == nullptr)
+		{
+			decoders.erase(extension);
+			return;
+		}
+
+		decoders[extension] = decoder;
+	}
+
+	size_t ResourceManager::GetNumResources() noexcept
+	{
+		std::lock_guard guard(lock);
+		return resources.size();
+	}
+
+	void ResourceManager::RequestTasks(TaskSystem& taskSys) noexcept
+	{
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+
+		LoadingBatch* batch = nullptr;
+		{
+			std::lock_guard guard(lock);
+			returnIf(loadingRequests.empty());
+
+			batch = MemoryManager::GetInstance().New<LoadingBatch>(*this, loadingRequests);
+			batches.push_back(batch);
+			loadingRequests.clear();
+		}
+
+		auto readTask = batch->readTask.GenerateSubTask(0, batch->entries.size());
+		taskSys.Enqueue(TaskSystem::GetIOTaskStreamIndex(), readTask);
+	}
+
+	void ResourceManager::UnloadUnused() noexcept
+	{
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+		auto& mmgr = MemoryManager::GetInstance();
+
+		// A handle is only made under the lock, so an unreferenced resource can't be taken in the meantime.
+		std::lock_guard guard(lock);
+
+		std::erase_if(resources, [&mmgr](auto& pair)
+		{
+			auto* item = pair.second;
+			returnValueIf(false, item->referenceCount.load(std::memory_order_acquire) > 0);
+			returnValueIf(false, item->state.load(std::memory_order_acquire) == EResourceState::Loading);
+
+			mmgr.Delete(item);
+			return true;
+		});
+	}
+
+	Resource ResourceManager::FindOrAdd(StaticString path, bool isRequested, bool& outIsNew) noexcept
+	{
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+		std::lock_guard guard(lock);
+
+		auto found = resources.find(path);
+		if (found != resources.end())
+		{
+			outIsNew = false;
+			return Resource(found->second);
+		}
+
+		auto* item = MemoryManager::GetInstance().New<ResourceItem>(++lastID, path, FindDecoder(path));
+		resources.emplace(path, item);
+		outIsNew = true;
+
+		if (isRequested)
+		{
+			loadingRequests.push_back(item);
+			numLoading.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		return Resource(item);
+	}
+
+	ResourceManager::TDecoder ResourceManager::FindDecoder(StaticString path) noexcept
+	{
+		returnValueIf(nullptr, decoders.empty());
+
+		const std::string_view str(path.c_str());
+		const auto dot = str.rfind('.');
+		returnValueIf(nullptr, dot == std::string_view::npos || str.find('/', dot) != std::string_view::npos);
+
+		auto found = decoders.find(StaticString(str.substr(dot + 1)));
+		return found == decoders.end() ? nullptr : found->second;
+	}
+
+	Buffer ResourceManager::ReadBuffer(StaticString path, bool& outIsCompressed) noexcept
+	{
+		// The archives are only added until the manager is destroyed, so they're looked up without the lock.
+		TVector<ResourceArchive*> mounted;
+		{
+			std::lock_guard guard(lock);
+			mounted = archives;
+		}
+
+		for (auto* archive : mounted)
+		{
+			auto buffer = archive->GetView(path, outIsCompressed);
+			returnValueIf(buffer, buffer.GetData() != nullptr);
+		}
+
+		outIsCompressed = false;
+
+		return BufferUtil::GetReadOnlyFileBuffer(path);
+	}
+
+	bool ResourceManager::ReadItem(ResourceItem& item) noexcept
+	{
+		bool isCompressed = false;
+		item.buffer = ReadBuffer(item.path, isCompressed);
+		returnValueIf(false, item.buffer.GetData() == nullptr);
+
+		if (isCompressed)
+		{
+			item.buffer = Compression::Decompress(item.buffer);
+			returnValueIf(false, item.buffer.GetData() == nullptr);
+		}
+
+		return item.decoder == nullptr || item.decoder(item.path, item.buffer);
+	}
+
+	size_t ResourceManager::RunRead(void* userData, size_t startIndex, size_t)
+	{
+		auto* batch = static_cast<LoadingBatch*>(userData);
+		auto& entry = batch->entries[startIndex];
+		auto* item = entry.item;
+
+		// A file at a time, so the other tasks on the IO stream can run in between.
+		item->buffer = batch->manager.ReadBuffer(item->path, entry.isCompressed);
+
+		return 1;
+	}
+
+	size_t ResourceManager::RunDecode(void* userData, size_t startIndex, size_t endIndex)
+	{
+		auto* batch = static_cast<LoadingBatch*>(userData);
+
+		for (size_t i = startIndex; i < endIndex; ++i)
+		{
+			auto& entry = batch->entries[i];
+			auto& item = *entry.item;
+
+			// One by one, as the entries of the batch are spread over the workers already, and a worker can't wait
+			// for the blocks decompressed in parallel.
+			if (entry.isCompressed && item.buffer.GetData() != nullptr)
+			{
+				item.buffer = Compression::Decompress(item.buffer);
+			}
+
+			entry.isLoaded = item.buffer.GetData() != nullptr
+				&& (item.decoder == nullptr || item.decoder(item.path, item.buffer));
+		}
+
+		return endIndex - startIndex;
+	}
+
+	void ResourceManager::OnRead(void* context)
+	{
+		auto* batch = static_cast<LoadingBatch*>(context);
+
+		auto& taskSys = Engine::Get().GetTaskSystem();
+		taskSys.ParallelFor(batch->decodeTask, 0, batch->entries.size());
+	}
+
+	void ResourceManager::OnDecoded(void* context)
+	{
+		// The batch is deleted by Publish, so it isn't accessed after this.
+		auto& taskSys = Engine::Get().GetTaskSystem();
+		taskSys.DispatchToMainThread(Publish, context);
+	}
+
+	void ResourceManager::Publish(void* userData)
+	{
+		auto* batch = static_cast<LoadingBatch*>(userData);
+		auto& manager = batch->manager;
+
+		auto log = Logger::Get(GetClassName());
+
+		for (auto& entry : batch->entries)
+		{
+			auto* item = entry.item;
+			item->state.store(entry.isLoaded ? EResourceState::Loaded : EResourceState::Failed,
+				std::memory_order_release);
+
+			if (unlikely(!entry.isLoaded))
+			{
+				log.OutWarning([item](auto& ls) { ls << "Failed to load " << item->path; });
+			}
+		}
+
+		manager.numLoading.fetch_sub(batch->entries.size(), std::memory_order_release);
+
+		AllocatorScope scope(MemoryManager::SystemAllocatorID);
+		{
+			std::lock_guard guard(manager.lock);
+			std::erase(manager.batches, batch);
+		}
+
+		MemoryManager::GetInstance().Delete(batch);
+	}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <cstring>
+#include <fstream>
+#include "Core/ScopedTime.h"
+#include "HSTL/HString.h"
+#include "OSAL/OSAbstractLayer.h"
+#include "OSAL/OSFileHandle.h"
+#include "OSAL/OSFileOpenMode.h"
+#include "OSAL/OSInputOutput.h"
+#include "String/InlineStringBuilder.h"
+
+namespace hbe
+{
+	namespace
+	{
+		constexpr size_t ChecksumSize = sizeof(uint64_t);
+
+		uint64_t GetChecksum(const uint8_t* data, size_t size)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash = (hash ^ data[i]) * 1099511628211ull;
+			}
+
+			return hash;
+		}
+
+		// A test file is its checksum followed by the contents.
+		bool WriteTestFile(StaticString path, size_t size, uint32_t seed)
+		{
+			HVector<uint8_t> data(ChecksumSize + size);
+
+			uint32_t state = seed * 2654435761u + 1;
+			for (size_t i = ChecksumSize; i < data.size(); ++i)
+			{
+				state = state * 1664525u + 1013904223u;
+				data[i] = static_cast<uint8_t>(state >> 24);
+			}
+
+			const auto checksum = GetChecksum(&data[ChecksumSize], size);
+			memcpy(data.data(), &checksum, ChecksumSize);
+
+			OS::FileOpenMode openMode;
+			openMode.SetWriteOnly();
+			openMode.SetCreate();
+			openMode.SetTruncate();
+
+			OS::FileHandle handle;
+			returnValueIf(false, !OS::Open(handle, path, openMode));
+
+			const bool isWritten = OS::Write(handle, data.data(), data.size()) == data.size();
+			OS::Close(std::move(handle));
+
+			return isWritten;
+		}
+
+		bool VerifyChecksum(StaticString, Buffer& buffer)
+		{
+			returnValueIf(false, buffer.GetSize() < ChecksumSize);
+
+			uint64_t checksum = 0;
+			memcpy(&checksum, buffer.GetData(), ChecksumSize);
+
+			return checksum == GetChecksum(buffer.GetData() + ChecksumSize, buffer.GetSize() - ChecksumSize);
+		}
+
+		StaticString GetTestPath(const char* directory, size_t index)
+		{
+			InlineStringBuilder<256> path;
+			path << directory << "/File" << index << ".res";
+
+			return StaticString(path.c_str());
+		}
+
+		// Pump the main thread until the requests are published.
+		void WaitForRequests(ResourceManager& manager)
+		{
+			auto& engine = Engine::Get();
+			auto& taskSys = engine.GetTaskSystem();
+
+			while (manager.GetNumLoading() > 0)
+			{
+				manager.PostUpdate(engine);
+				taskSys.ProcessMainThreadTasks();
+				std::this_thread::yield();
+			}
+		}
+
+	} // anonymous namespace
+
+	void ResourceManagerTest::Prepare()
+	{
+		AddTest("Load", [this](auto& ls)
+		{
+			const StaticString path("ResourceManagerTest.res");
+			if (!WriteTestFile(path, 1000, 1))
+			{
+				ls << "Failed to write " << path << lferr;
+				return;
+			}
+
+			{
+				ResourceManager manager;
+				manager.SetDecoder(StaticString("res"), VerifyChecksum);
+
+				auto resource = manager.Load(path);
+				if (!resource.IsLoaded() || resource.GetBuffer().GetSize() != ChecksumSize + 1000)
+				{
+					ls << "Failed to load " << path << lferr;
+				}
+
+				auto missing = manager.Load(StaticString("ResourceManagerTest.Missing.res"));
+				if (!missing.HasFailed())
+				{
+					ls << "A missing file should fail to load." << lferr;
+				}
+			}
+
+			OS::Delete(path);
+		});
+
+		AddTest("Deduplication", [this](auto& ls)
+		{
+			const StaticString path("ResourceManagerTest.Shared.res");
+			if (!WriteTestFile(path, 4096, 2))
+			{
+				ls << "Failed to write " << path << lferr;
+				return;
+			}
+
+			{
+				ResourceManager manager;
+				manager.SetDecoder(StaticString("res"), VerifyChecksum);
+
+				auto first = manager.RequestLoad(path);
+				auto second = manager.RequestLoad(path);
+
+				if (first.GetID() != second.GetID() || manager.GetNumLoading() != 1)
+				{
+					ls << "The requests in flight should share a resource." << lferr;
+				}
+
+				if (!first.IsLoading())
+				{
+					ls << "A request should be loading until the main thread publishes it." << lferr;
+				}
+
+				WaitForRequests(manager);
+
+				auto third = manager.RequestLoad(path);
+				if (!first.IsLoaded() || !second.IsLoaded() || third.GetID() != first.GetID())
+				{
+					ls << "The loaded resource should be shared." << lferr;
+				}
+
+				first.Reset();
+				second.Reset();
+				manager.PostUpdate(Engine::Get());
+
+				if (manager.GetNumResources() != 1)
+				{
+					ls << "A referenced resource has been unloaded." << lferr;
+				}
+
+				third.Reset();
+				manager.PostUpdate(Engine::Get());
+
+				if (manager.GetNumResources() != 0)
+				{
+					ls << "The unreferenced resource should be unloaded." << lferr;
+				}
+			}
+
+			OS::Delete(path);
+		});
+
+		AddTest("Decode Failure", [this](auto& ls)
+		{
+			const StaticString path("ResourceManagerTest.Corrupted.res");
+			if (!WriteTestFile(path, 100, 3))
+			{
+				ls << "Failed to write " << path << lferr;
+				return;
+			}
+
+			{
+				ResourceManager manager;
+				manager.SetDecoder(StaticString("res"), [](StaticString, Buffer&) { return false; });
+
+				auto resource = manager.RequestLoad(path);
+				WaitForRequests(manager);
+
+				if (!resource.HasFailed())
+				{
+					ls << "A resource which fails to decode should fail to load." << lferr;
+				}
+			}
+
+			OS::Delete(path);
+		});
+
+		AddTest("Archive", [this](auto& ls)
+		{
+			const StaticString archivePath("ResourceManagerTest.pak");
+			// The last two are compressed, decompressed by the decode stage.
+			const StaticString paths[] = {StaticString("ResourceManagerTest.Packed0.res"),
+				StaticString("ResourceManagerTest.Packed1.res"), StaticString("ResourceManagerTest.Packed2.res"),
+				StaticString("ResourceManagerTest.Packed3.res")};
+
+			{
+				std::ofstream output(archivePath.c_str(), std::ios::binary | std::ios::trunc);
+				ArchiveFormat::Writer writer(output);
+
+				for (size_t i = 0; i < std::size(paths); ++i)
+				{
+					// Packed, and then the loose file is gone.
+					const bool isWritten = WriteTestFile(paths[i], 2000, static_cast<uint32_t>(i));
+					{
+						const auto compression = i < 2 ? ArchiveFormat::ECompression::Stored
+							: ArchiveFormat::ECompression::LZ;
+
+						auto buffer = BufferUtil::GetReadOnlyFileBuffer(paths[i]);
+						if (!isWritten
+							|| !writer.Add(paths[i].c_str(), buffer.GetData(), buffer.GetSize(), compression))
+						{
+							ls << "Failed to pack " << paths[i] << lferr;
+						}
+					}
+
+					OS::Delete(paths[i]);
+				}
+
+				writer.Finish();
+			}
+
+			{
+				ResourceManager manager;
+				manager.SetDecoder(StaticString("res"), VerifyChecksum);
+
+				if (!manager.MountArchive(archivePath))
+				{
+					ls << "Failed to mount " << archivePath << lferr;
+				}
+
+				for (size_t i = 0; i < std::size(paths); i += 2)
+				{
+					auto loaded = manager.Load(paths[i]);
+					auto requested = manager.RequestLoad(paths[i + 1]);
+					WaitForRequests(manager);
+
+					if (!loaded.IsLoaded() || !requested.IsLoaded())
+					{
+						ls << "Failed to load " << paths[i] << " and " << paths[i + 1] << " from " << archivePath
+						   << lferr;
+					}
+				}
+			}
+
+			OS::Delete(archivePath);
+		});
+
+		AddTest("Loading Throughput", [this](auto& ls)
+		{
+			constexpr const char* Directory = "ResourceManagerTestFiles";
+			constexpr size_t NumFiles = 256;
+			constexpr size_t FileSize = 256 * 1024;
+
+			if (!OS::MakeDirectory(Directory))
+			{
+				ls << "Failed to make " << Directory << lferr;
+				return;
+			}
+
+			for (size_t i = 0; i < NumFiles; ++i)
+			{
+				if (!WriteTestFile(GetTestPath(Directory, i), FileSize, static_cast<uint32_t>(i)))
+				{
+					ls << "Failed to write test files." << lferr;
+					return;
+				}
+			}
+
+			HVector<StaticString> paths;
+			for (auto& name : OS::ListFilesInDirectory(Directory))
+			{
+				HString path(Directory);
+				path.append("/").append(name);
+				paths.emplace_back(path.c_str());
+			}
+
+			ResourceManager manager;
+			manager.SetDecoder(StaticString("res"), VerifyChecksum);
+
+			auto countLoaded = [](const HVector<Resource>& resources)
+			{
+				return std::count_if(resources.begin(), resources.end(), [](auto& res) { return res.IsLoaded(); });
+			};
+
+			time::TDuration syncTime;
+			size_t numSyncLoaded = 0;
+			{
+				HVector<Resource> resources;
+				resources.reserve(paths.size());
+
+				{
+					time::ScopedTime timer(syncTime);
+
+					for (auto path : paths)
+					{
+						resources.push_back(manager.Load(path));
+					}
+				}
+
+				numSyncLoaded = countLoaded(resources);
+			}
+
+			manager.PostUpdate(Engine::Get());
+
+			time::TDuration asyncTime;
+			size_t numAsyncLoaded = 0;
+			{
+				HVector<Resource> resources;
+				resources.reserve(paths.size());
+
+				{
+					time::ScopedTime timer(asyncTime);
+
+					for (auto path : paths)
+					{
+						resources.push_back(manager.RequestLoad(path));
+					}
+
+					WaitForRequests(manager);
+				}
+
+				numAsyncLoaded = countLoaded(resources);
+			}
+
+			manager.PostUpdate(Engine::Get());
+
+			for (auto path : paths)
+			{
+				OS::Delete(path);
+			}
+
+			OS::DeleteDirectory(Directory);
+
+			if (numSyncLoaded != paths.size() || numAsyncLoaded != paths.size() || paths.size() != NumFiles)
+			{
+				ls << "Loaded " << numSyncLoaded << " files synchronously and " << numAsyncLoaded
+				   << " asynchronously out of " << paths.size() << lferr;
+				return;
+			}
+
+			const auto totalMB = static_cast<float>(NumFiles * FileSize) / (1024 * 1024);
+			const auto syncSec = time::ToFloat(syncTime);
+			const auto asyncSec = time::ToFloat(asyncTime);
+
+			ls << NumFiles << " files (" << totalMB << " MB): Load " << syncSec << " sec (" << (totalMB / syncSec)
+			   << " MB/s), RequestLoad " << asyncSec << " sec (" << (totalMB / asyncSec) << " MB/s, "
+			   << (NumFiles / asyncSec) << " files/s)" << lf;
+
+			if (asyncSec > syncSec)
+			{
+				ls << "Loading asynchronously is slower than loading on the main thread." << lfwarn;
+			}
+		});
+	}
 
 } // namespace hbe
+#endif //__UNIT_TEST__
@@ -2,9 +2,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include "Buffer.h"
+#include "Core/Task.h"
+#include "HSTL/HUnorderedMap.h"
 #include "HSTL/HVector.h"
 #include "Resource.h"
+#include "ResourceArchive.h"
 #include "String/StaticString.h"
 
 namespace hbe
@@ -14,45 +19,98 @@ namespace hbe
 	class TaskSystem;
 
 	/// @brief Manages resource loading and lifetime with reference counting.
+	/// @details Requests are taken by PostUpdate() on the main thread in a batch. The IO stream maps the files of a
+	/// batch by BufferUtil::GetReadOnlyFileBuffer, the worker streams decompress the compressed archive entries and run
+	/// the decoders, and then the main thread publishes the results. Requests of a path being loaded, or already
+	/// loaded, share the same resource.
 	class ResourceManager final
 	{
 	public:
 		template<typename T>
 		using TVector = hbe::HVector<T>;
+		using TDecoder = ResourceItem::TDecoder;
 
 		ResourceManager() noexcept;
 		~ResourceManager() noexcept;
 
+		// Called on the main thread every frame. Dispatch the requests, and unload the resources without handles.
 		void PostUpdate(Engine& engine) noexcept;
 		[[nodiscard]] Resource RequestLoad(StaticString path);
+		// Load on the calling thread, or wait for the request in flight.
 		[[nodiscard]] Resource Load(StaticString path);
 
+		// Read the resources in the archive from it, instead of the files. The archives mounted earlier come first.
+		bool MountArchive(StaticString path) noexcept;
+
+		// Decode the files with the extension, e.g. "png", after reading them. It applies to the later requests.
+		void SetDecoder(StaticString extension, TDecoder decoder) noexcept;
+
+		[[nodiscard]] size_t GetNumResources() noexcept;
+		// The requests which haven't been published yet.
+		[[nodiscard]] size_t GetNumLoading() const noexcept { return numLoading.load(std::memory_order_acquire); }
+
 	private:
 		void RequestTasks(TaskSystem& taskSys) noexcept;
+		void UnloadUnused() noexcept;
 
-		/// @brief Internal storage for a loaded resource with reference counting.
-		class ResourceItem final
-		{
-		public:
-			ResourceItem() : id(0), referenceCount(0) {}
+		// Find or add the resource of the path. A new one is queued if it's requested.
+		[[nodiscard]] Resource FindOrAdd(StaticString path, bool isRequested, bool& outIsNew) noexcept;
+		[[nodiscard]] TDecoder FindDecoder(StaticString path) noexcept;
+		// A view into a mounted archive as it's stored, or the file mapped.
+		[[nodiscard]] Buffer ReadBuffer(StaticString path, bool& outIsCompressed) noexcept;
+		// Read and decode the file on the calling thread. Return false if it's failed.
+		bool ReadItem(ResourceItem& item) noexcept;
 
-			uint32_t id;
-			uint32_t referenceCount;
-			StaticString path;
-			Buffer buffer;
-		};
-
-		class LoadingRequest final
+		/// @brief Requests taken at once, read by a task on the IO stream and decoded by a task on the workers.
+		class LoadingBatch final
 		{
 		public:
-			LoadingRequest() : resourceID(0) {}
+			struct Entry final
+			{
+				ResourceItem* item;
+				// Read from an archive as it's stored, so it's decompressed before decoded.
+				bool isCompressed;
+				bool isLoaded;
+			};
 
-			uint32_t resourceID;
-			StaticString path;
+			ResourceManager& manager;
+			TVector<Entry> entries;
+			Task readTask;
+			Task decodeTask;
+
+			LoadingBatch(ResourceManager& manager, const TVector<ResourceItem*>& items) noexcept;
 		};
 
-		TVector<ResourceItem> resources;
+		static size_t RunRead(void* userData, size_t startIndex, size_t endIndex);
+		static size_t RunDecode(void* userData, size_t startIndex, size_t endIndex);
+		static void OnRead(void* context);
+		static void OnDecoded(void* context);
+		static void Publish(void* userData);
+
+		std::mutex lock;
+		HUnorderedMap<StaticString, ResourceItem*> resources;
+		HUnorderedMap<StaticString, TDecoder> decoders;
 		TVector<ResourceItem*> loadingRequests;
+		TVector<LoadingBatch*> batches;
+		TVector<ResourceArchive*> archives;
+		uint32_t lastID;
+		std::atomic<size_t> numLoading;
 	};
 
 } // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+	class ResourceManagerTest final : public TestCollection
+	{
+	public:
+		ResourceManagerTest() : TestCollection("ResourceManagerTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+} // namespace hbe
+#endif //__UNIT_TEST__
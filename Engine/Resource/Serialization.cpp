@@ -0,0 +1,314 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "Serialization.h"
+
+
+#ifdef __UNIT_TEST__
+#include <array>
+#include "BufferUtil.h"
+#include "Core/ScopedTime.h"
+#include "HSTL/HVector.h"
+
+namespace hbe
+{
+	namespace
+	{
+		struct Point final
+		{
+			uint32_t id = 0;
+			float x = 0;
+			float y = 0;
+			float z = 0;
+		};
+
+		struct Padded final
+		{
+			uint8_t tag = 0;
+			uint32_t value = 0;
+		};
+
+		struct Record final
+		{
+			uint32_t id = 0;
+			std::array<int16_t, 3> color = {};
+			HString name;
+			StaticString category;
+			HVector<Point> points;
+			HVector<HString> tags;
+			HVector<Padded> padded;
+		};
+
+		struct ItemV1 final
+		{
+			uint32_t id = 0;
+			float weight = 0;
+			HString name;
+		};
+
+		// The weight is removed, and the flags are added at version 2.
+		struct ItemV2 final
+		{
+			uint32_t id = 0;
+			HString name;
+			uint64_t flags = 0xFF;
+		};
+
+	} // anonymous namespace
+} // namespace hbe
+
+HBE_SCHEMA(hbe::Point, 1, HBE_FIELD(id), HBE_FIELD(x), HBE_FIELD(y), HBE_FIELD(z));
+HBE_SCHEMA(hbe::Padded, 1, HBE_FIELD(tag), HBE_FIELD(value));
+HBE_SCHEMA(hbe::Record, 1, HBE_FIELD(id), HBE_FIELD(color), HBE_FIELD(name), HBE_FIELD(category), HBE_FIELD(points),
+	HBE_FIELD(tags), HBE_FIELD(padded));
+HBE_SCHEMA(hbe::ItemV1, 1, HBE_FIELD(id), HBE_FIELD(weight), HBE_FIELD(name));
+HBE_SCHEMA(hbe::ItemV2, 2, HBE_FIELD(id), HBE_REMOVED_FIELD(float, weight, 0, 2), HBE_FIELD(name),
+	HBE_FIELD(flags, 2));
+
+namespace hbe
+{
+	namespace
+	{
+		bool operator==(const Point& a, const Point& b)
+		{
+			return a.id == b.id && a.x == b.x && a.y == b.y && a.z == b.z;
+		}
+
+		bool operator==(const Padded& a, const Padded& b) { return a.tag == b.tag && a.value == b.value; }
+
+		bool operator==(const Record& a, const Record& b)
+		{
+			return a.id == b.id && a.color == b.color && a.name == b.name && a.category == b.category
+				&& a.points == b.points && a.tags == b.tags && a.padded == b.padded;
+		}
+
+		HVector<Point> GetPoints(size_t count)
+		{
+			HVector<Point> points(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const auto value = static_cast<float>(i);
+				points[i] = Point{static_cast<uint32_t>(i), value, value * 0.5f, -value};
+			}
+
+			return points;
+		}
+
+		template<typename T>
+		size_t GetSerializedSize(const T& value)
+		{
+			auto buffer = BufferUtil::GenerateDummyBuffer();
+			BufferOutputStream bos(buffer);
+			Serialization::Write(bos, value);
+
+			return bos.GetCursor();
+		}
+
+		template<typename T>
+		Buffer WriteToBuffer(const T& value)
+		{
+			auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(GetSerializedSize(value), 0);
+			BufferOutputStream bos(buffer);
+			Serialization::Write(bos, value);
+
+			return buffer;
+		}
+
+	} // anonymous namespace
+
+	void SerializationTest::Prepare()
+	{
+		AddTest("Packed Layout", [this](auto& ls)
+		{
+			if (!Serialization::IsPacked<Point>())
+			{
+				ls << "Point should be copied at once." << lferr;
+			}
+
+			if (Serialization::IsPacked<Padded>())
+			{
+				ls << "Padded has padding, so it can't be copied at once." << lferr;
+			}
+
+			if (Serialization::IsPacked<Record>())
+			{
+				ls << "Record has strings, so it can't be copied at once." << lferr;
+			}
+		});
+
+		AddTest("Round Trip", [this](auto& ls)
+		{
+			Record record;
+			record.id = 42;
+			record.color = {1, -2, 3};
+			record.name = "Serialization";
+			record.category = StaticString("Test");
+			record.points = GetPoints(10);
+			record.tags = {"A", "", "Tag"};
+			record.padded = {Padded{1, 2}, Padded{3, 4}};
+
+			HVector<Record> records(3, record);
+			records[1].points.clear();
+			records[2].name = "Other";
+
+			const auto size = GetSerializedSize(records);
+			auto buffer = WriteToBuffer(records);
+
+			HVector<Record> readRecords;
+			BufferInputStream bis(buffer);
+
+			if (!Serialization::Read(bis, readRecords))
+			{
+				ls << "Failed to read. Error Count = " << bis.GetErrorCount() << lferr;
+				return;
+			}
+
+			if (readRecords != records)
+			{
+				ls << "The records are different after a round trip." << lferr;
+			}
+
+			if (!bis.IsDone())
+			{
+				ls << bis.GetRemainingSize() << " bytes are left out of " << size << lferr;
+			}
+		});
+
+		AddTest("Schema Evolution", [this](auto& ls)
+		{
+			HVector<ItemV1> items = {ItemV1{1, 0.5f, "One"}, ItemV1{2, 1.5f, "Two"}};
+			auto buffer = WriteToBuffer(items);
+
+			HVector<ItemV2> newItems;
+			BufferInputStream bis(buffer);
+
+			if (!Serialization::Read(bis, newItems) || newItems.size() != items.size())
+			{
+				ls << "Failed to read the version 1 as the version 2." << lferr;
+				return;
+			}
+
+			for (size_t i = 0; i < items.size(); ++i)
+			{
+				auto& item = newItems[i];
+				if (item.id != items[i].id || item.name != items[i].name || item.flags != 0xFF)
+				{
+					ls << "Invalid item " << item.id << ", " << item.name.c_str() << ", flags " << item.flags << lferr;
+				}
+			}
+
+			ItemV2 item{3, "Three", 7};
+			auto newBuffer = WriteToBuffer(item);
+
+			ItemV2 readItem;
+			BufferInputStream newBis(newBuffer);
+
+			if (!Serialization::Read(newBis, readItem) || readItem.id != 3 || readItem.name != "Three"
+				|| readItem.flags != 7)
+			{
+				ls << "Failed to read the version 2." << lferr;
+			}
+		});
+
+		AddTest("Invalid Data", [this](auto& ls)
+		{
+			{
+				ItemV2 item{3, "Three", 7};
+				auto buffer = WriteToBuffer(item);
+				BufferInputStream bis(buffer);
+
+				ItemV1 oldItem;
+				if (Serialization::Read(bis, oldItem))
+				{
+					ls << "Read the data of a newer version." << lferr;
+				}
+			}
+
+			{
+				auto points = GetPoints(100);
+				auto buffer = WriteToBuffer(points);
+				Buffer truncated = BufferUtil::GetMemoryBuffer<uint8_t>(buffer.GetSize() / 2, 0);
+				std::memcpy(truncated.GetData(), buffer.GetData(), truncated.GetSize());
+
+				HVector<Point> readPoints;
+				BufferInputStream bis(truncated);
+
+				if (Serialization::Read(bis, readPoints))
+				{
+					ls << "Read the truncated data." << lferr;
+				}
+			}
+
+			{
+				auto buffer = BufferUtil::GetMemoryBuffer<uint64_t>(2, UINT64_MAX);
+
+				HVector<HString> strings;
+				BufferInputStream bis(buffer);
+
+				if (Serialization::Read(bis, strings) || !strings.empty())
+				{
+					ls << "Read an array larger than the buffer." << lferr;
+				}
+			}
+		});
+
+		AddTest("1M Records Performance", [this](auto& ls)
+		{
+			constexpr size_t NumRecords = 1'000'000;
+
+			const auto points = GetPoints(NumRecords);
+			const auto size = GetSerializedSize(points);
+
+			HVector<Point> streamPoints(NumRecords);
+			HVector<Point> schemaPoints;
+			time::TDuration streamTime;
+			time::TDuration schemaTime;
+
+			{
+				auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(sizeof(Point) * NumRecords, 0);
+				time::ScopedTime timer(streamTime);
+
+				BufferOutputStream bos(buffer);
+				for (auto& point : points)
+				{
+					bos << point.id << point.x << point.y << point.z;
+				}
+
+				BufferInputStream bis(buffer);
+				for (auto& point : streamPoints)
+				{
+					bis >> point.id >> point.x >> point.y >> point.z;
+				}
+			}
+
+			{
+				auto buffer = BufferUtil::GetMemoryBuffer<uint8_t>(size, 0);
+				time::ScopedTime timer(schemaTime);
+
+				BufferOutputStream bos(buffer);
+				Serialization::Write(bos, points);
+
+				BufferInputStream bis(buffer);
+				Serialization::Read(bis, schemaPoints);
+			}
+
+			if (streamPoints != points || schemaPoints != points)
+			{
+				ls << "The records are different after a round trip." << lferr;
+				return;
+			}
+
+			const auto streamSec = time::ToFloat(streamTime);
+			const auto schemaSec = time::ToFloat(schemaTime);
+
+			ls << NumRecords << " records (" << size << " bytes): field by field " << streamSec << " sec, by the schema "
+			   << schemaSec << " sec (x" << (streamSec / schemaSec) << ')' << lf;
+
+			if (schemaSec > streamSec)
+			{
+				ls << "Serializing by the schema is slower than field by field." << lfwarn;
+			}
+		});
+	}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
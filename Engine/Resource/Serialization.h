@@ -0,0 +1,388 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include "BufferInputStream.h"
+#include "BufferOutputStream.h"
+#include "Core/CommonMacros.h"
+#include "HSTL/HString.h"
+#include "String/StaticString.h"
+
+namespace hbe
+{
+
+	// The fields of T to serialize, declared by HBE_SCHEMA.
+	template<typename T>
+	struct Schema;
+
+} // namespace hbe
+
+// Declare the schema of a type at the global namespace, e.g.
+//   HBE_SCHEMA(hbe::PoolConfig, 1, HBE_FIELD(blockSize), HBE_FIELD(numberOfBlocks), HBE_FIELD(flags, 1))
+// A field with a version is added at the version. Once a field is removed, declare it by HBE_REMOVED_FIELD with the
+// versions it was in, so the data of the older versions can still be read. The fields should be public.
+#define HBE_SCHEMA(Type, version, ...) \
+	template<> \
+	struct hbe::Schema<Type> final \
+	{ \
+		using TClass = Type; \
+		static constexpr uint16_t Version = version; \
+		static constexpr auto Fields = std::make_tuple(__VA_ARGS__); \
+	}
+
+#define HBE_FIELD(name, ...) hbe::Serialization::Field(#name, &TClass::name __VA_OPT__(, ) __VA_ARGS__)
+#define HBE_REMOVED_FIELD(type, name, since, until) hbe::Serialization::RemovedField<type>{#name, since, until}
+
+namespace hbe
+{
+namespace Serialization
+{
+
+	/// @details The data are written in the byte order of the writer, without alignment.
+	///   Raw value (trivially copyable): its bytes
+	///   String (HString, std::string, StaticString, StaticStringID): uint32 length, char[length]
+	///   Array (HVector, std::vector): uint64 count, then the elements. Schema elements share a uint16 version.
+	///   Schema value: uint16 version, then the fields of the version in order.
+	/// An array of schema records is copied at once if the fields cover the record in order without padding, and
+	/// the version is the same as the reader's.
+
+	constexpr uint16_t Latest = UINT16_MAX;
+
+	template<typename TClass, typename TMember>
+	struct SchemaField final
+	{
+		const char* name;
+		TMember TClass::*member;
+		uint16_t since;
+		uint16_t until;
+
+		[[nodiscard]] constexpr bool IsIn(uint16_t version) const noexcept { return since <= version && version < until; }
+	};
+
+	template<typename TValue>
+	struct RemovedField final
+	{
+		using TMember = TValue;
+
+		const char* name;
+		uint16_t since;
+		uint16_t until;
+
+		[[nodiscard]] constexpr bool IsIn(uint16_t version) const noexcept { return since <= version && version < until; }
+	};
+
+	template<typename TClass, typename TMember>
+	constexpr auto Field(const char* name, TMember TClass::*member, uint16_t since = 0, uint16_t until = Latest)
+	{
+		return SchemaField<TClass, TMember>{name, member, since, until};
+	}
+
+	template<typename T>
+	concept CSchema = requires {
+		Schema<T>::Version;
+		Schema<T>::Fields;
+	};
+
+	template<typename T>
+	concept CString = std::is_same_v<T, HString> || std::is_same_v<T, std::string> || std::is_same_v<T, StaticString>
+		|| std::is_same_v<T, StaticStringID>;
+
+	template<typename T>
+	concept CArray = !CString<T> && requires(T array, size_t count) {
+		typename T::value_type;
+		array.data();
+		array.size();
+		array.resize(count);
+	};
+
+	template<typename T>
+	concept CRaw = std::is_trivially_copyable_v<T> && !CSchema<T> && !CString<T>;
+
+	template<typename T>
+	void WriteValue(BufferOutputStream& os, const T& value) noexcept;
+	template<typename T>
+	void ReadValue(BufferInputStream& is, T& value) noexcept;
+
+	// Whether the fields of the current version are the bytes of the record in order, so the records are copied at
+	// once. Checked once per type.
+	template<CSchema T>
+	[[nodiscard]] bool IsPacked() noexcept
+	{
+		static const bool isPacked = []()
+		{
+			if constexpr (!std::is_trivially_copyable_v<T> || !std::is_default_constructible_v<T>)
+			{
+				return false;
+			}
+			else
+			{
+				const T object{};
+				const auto base = reinterpret_cast<const uint8_t*>(&object);
+				size_t expected = 0;
+				bool isContiguous = true;
+
+				auto check = [&]<typename TField>(const TField& field)
+				{
+					if constexpr (requires { field.member; })
+					{
+						using TMember = std::remove_cvref_t<decltype(object.*field.member)>;
+						const auto offset = static_cast<size_t>(reinterpret_cast<const uint8_t*>(&(object.*field.member)) - base);
+
+						isContiguous = isContiguous && CRaw<TMember> && field.IsIn(Schema<T>::Version)
+							&& offset == expected;
+						expected += sizeof(TMember);
+					}
+				};
+
+				std::apply([&](const auto&... fields) { (check(fields), ...); }, Schema<T>::Fields);
+
+				return isContiguous && expected == sizeof(T);
+			}
+		}();
+
+		return isPacked;
+	}
+
+	template<CSchema T>
+	void WriteFields(BufferOutputStream& os, const T& value) noexcept
+	{
+		auto write = [&]<typename TField>(const TField& field)
+		{
+			if constexpr (requires { field.member; })
+			{
+				if (field.IsIn(Schema<T>::Version))
+				{
+					WriteValue(os, value.*field.member);
+				}
+			}
+		};
+
+		std::apply([&](const auto&... fields) { (write(fields), ...); }, Schema<T>::Fields);
+	}
+
+	template<CSchema T>
+	void ReadFields(BufferInputStream& is, T& value, uint16_t version) noexcept
+	{
+		auto read = [&]<typename TField>(const TField& field)
+		{
+			returnIf(!field.IsIn(version));
+
+			if constexpr (requires { field.member; })
+			{
+				ReadValue(is, value.*field.member);
+			}
+			else
+			{
+				// Removed, so skipped.
+				typename TField::TMember discarded{};
+				ReadValue(is, discarded);
+			}
+		};
+
+		std::apply([&](const auto&... fields) { (read(fields), ...); }, Schema<T>::Fields);
+	}
+
+	template<typename T>
+	void WriteValue(BufferOutputStream& os, const T& value) noexcept
+	{
+		if constexpr (CSchema<T>)
+		{
+			const uint16_t version = Schema<T>::Version;
+			os.WriteBytes(&version, sizeof(version));
+			WriteFields(os, value);
+		}
+		else if constexpr (CString<T>)
+		{
+			std::string_view str;
+			if constexpr (std::is_same_v<T, StaticStringID>)
+			{
+				str = StaticString(value).c_str();
+			}
+			else
+			{
+				str = std::string_view(value.c_str());
+			}
+
+			const auto length = static_cast<uint32_t>(str.length());
+			os.WriteBytes(&length, sizeof(length));
+			os.WriteBytes(str.data(), length);
+		}
+		else if constexpr (CArray<T>)
+		{
+			using TElement = typename T::value_type;
+
+			const uint64_t count = value.size();
+			os.WriteBytes(&count, sizeof(count));
+
+			if constexpr (CSchema<TElement>)
+			{
+				const uint16_t version = Schema<TElement>::Version;
+				os.WriteBytes(&version, sizeof(version));
+
+				if (IsPacked<TElement>())
+				{
+					os.WriteBytes(value.data(), sizeof(TElement) * count);
+					return;
+				}
+
+				for (auto& element : value)
+				{
+					WriteFields(os, element);
+				}
+			}
+			else if constexpr (CRaw<TElement>)
+			{
+				os.WriteBytes(value.data(), sizeof(TElement) * count);
+			}
+			else
+			{
+				for (auto& element : value)
+				{
+					WriteValue(os, element);
+				}
+			}
+		}
+		else
+		{
+			static_assert(CRaw<T>, "No schema for the type.");
+			os.WriteBytes(&value, sizeof(T));
+		}
+	}
+
+	template<typename T>
+	void ReadValue(BufferInputStream& is, T& value) noexcept
+	{
+		if constexpr (CSchema<T>)
+		{
+			uint16_t version = 0;
+			returnIf(!is.ReadBytes(&version, sizeof(version)));
+
+			if (unlikely(version > Schema<T>::Version))
+			{
+				// Written by a newer one.
+				is.AddError();
+				return;
+			}
+
+			ReadFields(is, value, version);
+		}
+		else if constexpr (CString<T>)
+		{
+			uint32_t length = 0;
+			returnIf(!is.ReadBytes(&length, sizeof(length)));
+
+			auto data = reinterpret_cast<const char*>(is.GetBytes(length));
+			returnIf(data == nullptr);
+
+			const std::string_view str(data, length);
+			if constexpr (std::is_same_v<T, StaticStringID>)
+			{
+				value = StaticString(str).GetID();
+			}
+			else if constexpr (std::is_same_v<T, StaticString>)
+			{
+				value = StaticString(str);
+			}
+			else
+			{
+				value.assign(str.data(), str.size());
+			}
+		}
+		else if constexpr (CArray<T>)
+		{
+			using TElement = typename T::value_type;
+
+			uint64_t count = 0;
+			returnIf(!is.ReadBytes(&count, sizeof(count)));
+
+			// Every element takes a byte at least, unless it's an empty record.
+			if (unlikely(count > is.GetRemainingSize() && sizeof(TElement) > 0))
+			{
+				is.AddError();
+				return;
+			}
+
+			if constexpr (CSchema<TElement>)
+			{
+				uint16_t version = 0;
+				returnIf(!is.ReadBytes(&version, sizeof(version)));
+
+				if (unlikely(version > Schema<TElement>::Version))
+				{
+					is.AddError();
+					return;
+				}
+
+				value.resize(count);
+
+				if (version == Schema<TElement>::Version && IsPacked<TElement>())
+				{
+					is.ReadBytes(value.data(), sizeof(TElement) * count);
+					return;
+				}
+
+				for (auto& element : value)
+				{
+					ReadFields(is, element, version);
+				}
+			}
+			else if constexpr (CRaw<TElement>)
+			{
+				value.resize(count);
+				is.ReadBytes(value.data(), sizeof(TElement) * count);
+			}
+			else
+			{
+				value.resize(count);
+				for (auto& element : value)
+				{
+					ReadValue(is, element);
+				}
+			}
+		}
+		else
+		{
+			static_assert(CRaw<T>, "No schema for the type.");
+			is.ReadBytes(&value, sizeof(T));
+		}
+	}
+
+	// Serialize the value. Only the size is counted if the buffer has no data, e.g. BufferUtil::GenerateDummyBuffer.
+	template<typename T>
+	void Write(BufferOutputStream& os, const T& value) noexcept
+	{
+		WriteValue(os, value);
+	}
+
+	// Deserialize the value written by any version up to the current one. Return false if it's failed.
+	template<typename T>
+	bool Read(BufferInputStream& is, T& value) noexcept
+	{
+		ReadValue(is, value);
+		return !is.HasError();
+	}
+
+} // namespace Serialization
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+	class SerializationTest final : public TestCollection
+	{
+	public:
+		SerializationTest() : TestCollection("SerializationTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,54 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#include "BufferStringBuilder.h"
+
+
+#ifdef __UNIT_TEST__
+#include "InlineStringBuilder.h"
+
+namespace hbe
+{
+
+	void BufferStringBuilderTest::Prepare()
+	{
+		AddTest("Same Format as InlineStringBuilder", [this](auto& ls)
+		{
+			char buffer[256];
+			BufferStringBuilder builder(buffer, sizeof(buffer));
+			InlineStringBuilder<256> expected;
+
+			builder << "Text " << 'c' << ' ' << true << ' ' << nullptr << ' ' << -12 << ' ' << 34u << ' ' << -56L << ' '
+					<< 78UL << ' ' << 1.5f << ' ' << 2.25 << ' ' << StaticString("Static") << hendl;
+			expected << "Text " << 'c' << ' ' << true << ' ' << nullptr << ' ' << -12 << ' ' << 34u << ' ' << -56L << ' '
+					 << 78UL << ' ' << 1.5f << ' ' << 2.25 << ' ' << StaticString("Static") << hendl;
+
+			if (builder.Size() != expected.Size() || strcmp(builder.c_str(), expected.c_str()) != 0)
+			{
+				ls << "[" << builder.c_str() << "] != [" << expected.c_str() << "]" << lferr;
+			}
+		});
+
+		AddTest("Truncation", [this](auto& ls)
+		{
+			char buffer[8];
+			BufferStringBuilder builder(buffer, sizeof(buffer));
+
+			builder << "0123" << 4567 << "89" << 'x';
+
+			if (builder.Size() != 7 || strcmp(builder.c_str(), "0123456") != 0)
+			{
+				ls << "It should be truncated to 0123456, but [" << builder.c_str() << "]" << lferr;
+			}
+
+			builder.Clear();
+			builder << "abc";
+
+			if (strcmp(builder.c_str(), "abc") != 0)
+			{
+				ls << "It should be abc after Clear(), but [" << builder.c_str() << "]" << lferr;
+			}
+		});
+	}
+
+} // namespace hbe
+#endif //__UNIT_TEST__
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "Core/CommonMacros.h"
+#include "Core/Debug.h"
+#include "EndLine.h"
+#include "OSAL/Intrinsic.h"
+#include "StaticString.h"
+#include "StringUtil.h"
+
+// Truncating to the buffer in AppendFormat is intended. GCC warns at the inlined callers when it can prove it.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-truncation"
+#endif
+
+namespace hbe
+{
+
+	/// @brief A string builder writing into an external fixed-size buffer.
+	/// @details It formats the same way as InlineStringBuilder, but the caller owns the buffer, so the text can be
+	/// built in place, e.g. in a log ring. The text is truncated to capacity - 1 characters, and always terminated.
+	class BufferStringBuilder final
+	{
+	public:
+		using TThis = BufferStringBuilder;
+
+		BufferStringBuilder(char* buffer, size_t capacity) noexcept
+			: buffer(buffer), lastIndex(capacity - 1), length(0)
+		{
+			Assert(buffer != nullptr && capacity > 0);
+			buffer[0] = '\0';
+		}
+
+		BufferStringBuilder(const BufferStringBuilder&) = delete;
+		BufferStringBuilder& operator=(const BufferStringBuilder&) = delete;
+
+		void Clear() noexcept
+		{
+			length = 0;
+			buffer[0] = '\0';
+		}
+
+		[[nodiscard]] auto c_str() const noexcept { return static_cast<const char*>(buffer); }
+
+		[[nodiscard]] auto Size() const noexcept { return length; }
+
+		[[nodiscard]] auto Capacity() const noexcept { return lastIndex + 1; }
+
+		[[nodiscard]] operator const char*() const noexcept { return c_str(); }
+
+		TThis& Hex(uint8_t value) noexcept
+		{
+			if (std::isprint(value))
+			{
+				return AppendFormat("%c", value);
+			}
+
+			return AppendFormat("%02x", value);
+		}
+
+		TThis& operator<<(nullptr_t) noexcept { return *this << "Null"; }
+
+		TThis& operator<<(bool value) noexcept { return *this << (value ? "True" : "False"); }
+
+		TThis& operator<<(char ch) noexcept
+		{
+			// Work on copies, as writing through buffer could alias the members for the compiler.
+			const size_t pos = length;
+			returnValueIf(*this, pos >= lastIndex);
+
+			buffer[pos] = ch;
+			buffer[pos + 1] = '\0';
+			length = pos + 1;
+
+			return *this;
+		}
+
+		TThis& operator<<(const char* str) noexcept
+		{
+			if (unlikely(str == nullptr))
+			{
+				return *this << nullptr;
+			}
+
+			return *this << std::string_view(str);
+		}
+
+		TThis& operator<<(const std::string_view& str) noexcept
+		{
+			const size_t pos = length;
+			returnValueIf(*this, pos >= lastIndex);
+
+			const auto len = std::min(str.length(), lastIndex - pos);
+			memcpy(&buffer[pos], str.data(), len);
+			buffer[pos + len] = '\0';
+			length = pos + len;
+
+			return *this;
+		}
+
+		template<class CharT, class Traits, class Allocator>
+		TThis& operator<<(const std::basic_string<CharT, Traits, Allocator>& str) noexcept
+		{
+			return *this << static_cast<std::string_view>(str);
+		}
+
+		TThis& operator<<(StaticString str) noexcept { return *this << str.c_str(); }
+
+		TThis& operator<<(unsigned char value) noexcept { return AppendFormat("%u", value); }
+		TThis& operator<<(short value) noexcept { return AppendFormat("%d", value); }
+		TThis& operator<<(unsigned short value) noexcept { return AppendFormat("%u", value); }
+		TThis& operator<<(int value) noexcept { return AppendFormat("%d", value); }
+		TThis& operator<<(unsigned int value) noexcept { return AppendFormat("%u", value); }
+		TThis& operator<<(long value) noexcept { return AppendFormat("%ld", value); }
+		TThis& operator<<(unsigned long value) noexcept { return AppendFormat("%lu", value); }
+		TThis& operator<<(long long value) noexcept { return AppendFormat("%lld", value); }
+		TThis& operator<<(unsigned long long value) noexcept { return AppendFormat("%llu", value); }
+		TThis& operator<<(float value) noexcept { return AppendFormat("%f", value); }
+		TThis& operator<<(double value) noexcept { return AppendFormat("%lf", value); }
+		TThis& operator<<(long double value) noexcept { return AppendFormat("%Le", value); }
+		TThis& operator<<(void* value) noexcept { return AppendFormat("%p", value); }
+
+		TThis& operator<<(EndLine) noexcept { return *this << '\n'; }
+
+	private:
+		template<typename T>
+		TThis& AppendFormat(const char* format, T value) noexcept
+		{
+			const size_t pos = length;
+			returnValueIf(*this, pos >= lastIndex);
+
+			const auto written = snprintf(&buffer[pos], lastIndex + 1 - pos, format, value);
+
+			Assert(written >= 0);
+			length = std::min(lastIndex, pos + written);
+
+			return *this;
+		}
+
+	private:
+		char* buffer;
+		size_t lastIndex;
+		size_t length;
+	};
+
+} // namespace hbe
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+	class BufferStringBuilderTest : public TestCollection
+	{
+	public:
+		BufferStringBuilderTest() : TestCollection("BufferStringBuilderTest") {}
+
+	protected:
+		void Prepare() override;
+	};
+} // namespace hbe
+
+#endif //__UNIT_TEST__
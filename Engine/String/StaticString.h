@@ -31,6 +31,8 @@ namespace hbe
 		[[nodiscard]] const char* c_str() const noexcept;
 
 		[[nodiscard]] auto GetID() const noexcept { return id; }
+		[[nodiscard]] size_t GetHash() const noexcept { return id.GetHash(); }
+		[[nodiscard]] size_t GetLength() const noexcept { return id.GetLength(); }
 		[[nodiscard]] bool IsNull() const noexcept { return id.ptr == nullptr; }
 		[[nodiscard]] operator const char*() const noexcept { return c_str(); }
 		bool operator<(const StaticString& rhs) const noexcept { return id.ptr < rhs.id.ptr; }
@@ -55,7 +57,7 @@ namespace std
 	{
 		std::size_t operator()(const hbe::StaticString& obj) const
 		{
-			return reinterpret_cast<std::size_t>(obj.GetID().ptr);
+			return obj.GetHash();
 		}
 	};
 } // namespace std
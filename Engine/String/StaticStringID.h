@@ -2,11 +2,19 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <ostream>
 
 namespace hbe
 {
+	/// @brief Header stored right before the text of every static string in the table.
+	struct StaticStringHeader final
+	{
+		size_t hash;
+		size_t length;
+	};
+
 	/// @brief A lightweight identifier for static strings stored in the global string table.
 	struct StaticStringID final
 	{
@@ -15,6 +23,17 @@ namespace hbe
 
 		StaticStringID() : ptr(Default) {}
 
+		// The hash is calculated once when the string is registered. It's 0 for the null ID.
+		[[nodiscard]] size_t GetHash() const
+		{
+			return ptr == nullptr ? 0 : reinterpret_cast<const StaticStringHeader*>(ptr)[-1].hash;
+		}
+
+		[[nodiscard]] size_t GetLength() const
+		{
+			return ptr == nullptr ? 0 : reinterpret_cast<const StaticStringHeader*>(ptr)[-1].length;
+		}
+
 		bool operator==(const StaticStringID& rhs) const { return ptr == rhs.ptr; }
 
 		bool operator<(const StaticStringID& rhs) const { return ptr < rhs.ptr; }
@@ -27,6 +46,6 @@ namespace std
 	template<>
 	struct hash<hbe::StaticStringID> final
 	{
-		std::size_t operator()(const hbe::StaticStringID& obj) const { return reinterpret_cast<std::size_t>(obj.ptr); }
+		std::size_t operator()(const hbe::StaticStringID& obj) const { return obj.GetHash(); }
 	};
 } // namespace std
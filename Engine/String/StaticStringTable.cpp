@@ -2,79 +2,61 @@
 
 #include "StaticStringTable.h"
 
-#include <iostream>
-#include <mutex>
-#include "../Engine/Engine.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
 #include "Config/EngineConfig.h"
+#include "Core/CommonMacros.h"
 #include "Core/Debug.h"
 #include "Log/Logger.h"
-#include "Memory/AllocatorScope.h"
+#include "OSAL/Intrinsic.h"
+#include "OSAL/OSMemory.h"
 #include "StringUtil.h"
 
 
 namespace hbe
 {
 
-	namespace
+	StaticStringTable& StaticStringTable::GetInstance()
 	{
+		static StaticStringTable instance;
+		return instance;
+	}
 
-		struct Bank final
+	StaticStringTable::StaticStringTable()
+	{
+		for (auto& shard : shards)
 		{
-			size_t cursor;
-			size_t capacity;
-			uint8_t* buffer;
-
-			Bank(size_t capacity) : cursor(0), capacity(capacity) { buffer = (uint8_t*) malloc(capacity); }
-
-			Bank(const Bank& rhs) = delete;
+			shard.slots.store(nullptr, std::memory_order_relaxed);
+			shard.count = 0;
+			shard.bank = nullptr;
+		}
 
-			Bank(Bank&& rhs) : cursor(rhs.cursor), capacity(rhs.capacity), buffer(rhs.buffer)
-			{
-				rhs.cursor = 0;
-				rhs.capacity = 0;
-				rhs.buffer = nullptr;
-			}
+		RegisterPredefinedStrings();
+	}
 
-			~Bank()
+	StaticStringTable::~StaticStringTable()
+	{
+		for (auto& shard : shards)
+		{
+			auto* slots = shard.slots.exchange(nullptr, std::memory_order_relaxed);
+			while (slots != nullptr)
 			{
-				if (buffer == nullptr)
-				{
-					return;
-				}
-
-				free(buffer);
+				auto* retired = slots->retired;
+				free(slots->entries);
+				free(slots);
+				slots = retired;
 			}
 
-			bool IsAvailable(size_t n) const { return (cursor + n) < capacity; }
-
-			uint8_t* Allocate(size_t n)
+			while (shard.bank != nullptr)
 			{
-				auto ptr = &buffer[cursor];
-				cursor += n;
-				Assert(cursor <= capacity);
-
-				return ptr;
+				auto* prev = shard.bank->prev;
+				free(shard.bank);
+				shard.bank = prev;
 			}
-		};
-
-		std::vector<Bank> banks;
-		size_t bankIndex = 0;
-		std::mutex memLock;
-
-	} // namespace
-
-	StaticStringTable& StaticStringTable::GetInstance()
-	{
-		static StaticStringTable instance;
-		return instance;
-	}
-
-	StaticStringTable::StaticStringTable() { RegisterPredefinedStrings(); }
 
-	StaticStringTable::~StaticStringTable()
-	{
-		banks.clear();
-		banks.shrink_to_fit();
+			shard.count = 0;
+		}
 	}
 
 	StaticString StaticStringTable::GetName() const
@@ -86,62 +68,48 @@ namespace hbe
 
 	StaticStringID StaticStringTable::Register(const char* text)
 	{
-		StaticStringID id;
+		return Register(std::string_view(text));
+	}
 
-		auto tableID = GetTableID(text);
+	StaticStringID StaticStringTable::Register(const std::string_view& str)
+	{
+		const auto hash = StringUtil::CalculateHash(str);
+		const auto mixed = MixHash(hash);
+		const auto probe = mixed >> ShardBits;
 
-		static_assert(!std::is_signed<decltype(tableID)>());
-		Assert(tableID < NumTables);
+		auto& shard = shards[mixed & (NumShards - 1)];
 
+		auto* slots = shard.slots.load(std::memory_order_acquire);
+		if (likely(slots != nullptr))
 		{
-			std::lock_guard lock(tableLock);
-
-			auto& table = tables[tableID];
-			std::string_view tmp(text);
-
-			auto found = std::find(table.begin(), table.end(), tmp);
-			if (found != table.end())
+			if (auto* entry = Find(*slots, probe, hash, str))
 			{
-				id.ptr = reinterpret_cast<const uint8_t*>(found->data());
-				return id;
+				return ToID(entry);
 			}
-
-			std::string_view sv = Store(tmp);
-			table.emplace_back(sv);
-
-			id.ptr = reinterpret_cast<const uint8_t*>(sv.data());
 		}
 
-		return id;
-	}
-
-	StaticStringID StaticStringTable::Register(const std::string_view& str)
-	{
-		StaticStringID id;
-
-		auto tableID = GetTableID(str);
-
-		static_assert(!std::is_signed<decltype(tableID)>());
-		Assert(tableID < NumTables);
+		std::lock_guard lock(shard.lock);
 
+		// Another thread may have added it, or grown the table, while this one was waiting for the lock.
+		slots = shard.slots.load(std::memory_order_relaxed);
+		if (slots != nullptr)
 		{
-			std::lock_guard lock(tableLock);
-
-			auto& table = tables[tableID];
-			auto found = std::find(table.begin(), table.end(), str);
-			if (found != table.end())
+			if (auto* entry = Find(*slots, probe, hash, str))
 			{
-				id.ptr = reinterpret_cast<const uint8_t*>(found->data());
-				return id;
+				return ToID(entry);
 			}
+		}
 
-			auto sv = Store(str);
-			table.emplace_back(sv);
-
-			id.ptr = reinterpret_cast<const uint8_t*>(sv.data());
+		if (slots == nullptr || (shard.count + 1) * 2 > slots->capacity)
+		{
+			slots = Grow(shard);
 		}
 
-		return id;
+		auto* entry = Store(shard, hash, str);
+		Insert(*slots, probe, entry);
+		++shard.count;
+
+		return ToID(entry);
 	}
 
 	const char* StaticStringTable::Get(StaticStringID id) const
@@ -159,45 +127,50 @@ namespace hbe
 		auto log = Logger::Get(GetName(), ELogLevel::Verbose);
 
 		log.Out("= StringTable ==============================");
-		log.Out([](auto& ls) { ls << "Number of Banks = " << banks.size(); });
 
+		size_t numBanks = 0;
+		size_t usedBytes = 0;
+		for (auto& shard : shards)
 		{
-			size_t index = 0;
-			for (auto& bank : banks)
+			for (auto* bank = shard.bank; bank != nullptr; bank = bank->prev)
 			{
-				log.Out([index, &bank](auto& ls) { ls << index << " : " << bank.cursor << " / " << bank.capacity; });
-
-				++index;
+				++numBanks;
+				usedBytes += bank->cursor;
 			}
 		}
 
-		TIndex tableID = 0;
+		log.Out([&](auto& ls) { ls << "Number of Banks = " << numBanks << ", Used = " << usedBytes << " bytes"; });
 
-		for (auto& table : tables)
+		TIndex shardID = 0;
+		for (auto& shard : shards)
 		{
-			if (table.size() <= 0)
+			const auto* slots = shard.slots.load(std::memory_order_acquire);
+			if (slots != nullptr)
 			{
-				continue;
+				log.Out([&](auto& ls)
+				{
+					ls << "Shard ID = " << shardID << "/" << NumShards << ", Number of Elements = " << shard.count
+					   << ", Capacity = " << slots->capacity;
+				});
 			}
 
-			log.Out([&](auto& ls)
-			{ ls << "Table ID = " << tableID << "/" << NumTables << ", Number of Elements = " << table.size(); });
-
-			++tableID;
+			++shardID;
 		}
 
 		size_t count = 0;
-		tableID = 0;
-
-		for (auto& table : tables)
+		for (auto& shard : shards)
 		{
-			for (auto& item : table)
+			const auto* slots = shard.slots.load(std::memory_order_acquire);
+			continueIf(slots == nullptr);
+
+			for (size_t i = 0; i < slots->capacity; ++i)
 			{
-				StaticStringID id;
-				log.Out([&](auto& ls) { ls << count++ << " : [" << item << "] 0x" << (void*) id.ptr; });
-			}
+				const auto* entry = slots->entries[i].load(std::memory_order_acquire);
+				continueIf(entry == nullptr);
 
-			++tableID;
+				const auto id = ToID(entry);
+				log.Out([&](auto& ls) { ls << count++ << " : [" << Get(id) << "] 0x" << (void*) id.ptr; });
+			}
 		}
 
 		log.Out([count](auto& ls) { ls << "Number of elements = " << count; });
@@ -219,59 +192,263 @@ namespace hbe
 		(void) Register("HardbopEngine");
 	}
 
-	StaticStringTable::TIndex StaticStringTable::GetTableID(const char* text) const
+	size_t StaticStringTable::MixHash(size_t hash)
+	{
+		// The finalizer of MurmurHash3. The string hash is weak in the low bits.
+		uint64_t x = hash;
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ULL;
+		x ^= x >> 33;
+
+		return static_cast<size_t>(x);
+	}
+
+	const StaticStringTable::TEntry* StaticStringTable::Find(const Slots& slots, size_t probe, size_t hash,
+		const std::string_view& str)
 	{
-		auto hashValue = StringUtil::CalculateHash(text);
-		auto tableId = static_cast<TIndex>(hashValue % NumTables);
+		// The table is at most half full, so it always reaches an empty slot.
+		const auto mask = slots.capacity - 1;
+		for (auto index = probe & mask;; index = (index + 1) & mask)
+		{
+			const auto* entry = slots.entries[index].load(std::memory_order_acquire);
+			returnValueIf(nullptr, entry == nullptr);
+
+			continueIf(entry->hash != hash || entry->length != str.length());
 
-		return tableId;
+			const auto* text = reinterpret_cast<const char*>(entry + 1);
+			returnValueIf(entry, std::equal(str.begin(), str.end(), text));
+		}
 	}
 
-	StaticStringTable::TIndex StaticStringTable::GetTableID(const std::string_view& str) const
+	void StaticStringTable::Insert(Slots& slots, size_t probe, const TEntry* entry)
 	{
-		auto hashValue = StringUtil::CalculateHash(str);
-		auto tableId = static_cast<TIndex>(hashValue % NumTables);
+		const auto mask = slots.capacity - 1;
+		auto index = probe & mask;
 
-		return tableId;
+		while (slots.entries[index].load(std::memory_order_relaxed) != nullptr)
+		{
+			index = (index + 1) & mask;
+		}
+
+		// Publish the entry after its text has been written.
+		slots.entries[index].store(entry, std::memory_order_release);
 	}
 
-	std::string_view StaticStringTable::Store(const char* text)
+	StaticStringTable::Slots* StaticStringTable::Grow(Shard& shard)
 	{
-		std::string_view sv(text);
-		return Store(sv);
+		auto* old = shard.slots.load(std::memory_order_relaxed);
+		const auto capacity = old == nullptr ? InitialCapacity : old->capacity * 2;
+
+		auto* slots = static_cast<Slots*>(malloc(sizeof(Slots)));
+		auto* entries = static_cast<std::atomic<const TEntry*>*>(malloc(sizeof(std::atomic<const TEntry*>) * capacity));
+		FatalAssert(slots != nullptr && entries != nullptr, "Out of memory for the static string table.");
+
+		for (size_t i = 0; i < capacity; ++i)
+		{
+			new (&entries[i]) std::atomic<const TEntry*>(nullptr);
+		}
+
+		slots->capacity = capacity;
+		slots->retired = old;
+		slots->entries = entries;
+
+		if (old != nullptr)
+		{
+			for (size_t i = 0; i < old->capacity; ++i)
+			{
+				const auto* entry = old->entries[i].load(std::memory_order_relaxed);
+				continueIf(entry == nullptr);
+
+				Insert(*slots, MixHash(entry->hash) >> ShardBits, entry);
+			}
+		}
+
+		shard.slots.store(slots, std::memory_order_release);
+
+		return slots;
 	}
 
-	std::string_view StaticStringTable::Store(const std::string_view& str)
+	const StaticStringTable::TEntry* StaticStringTable::Store(Shard& shard, size_t hash, const std::string_view& str)
 	{
 		const auto strLen = str.length();
+		const auto size = OS::GetAligned(sizeof(TEntry) + strLen + 1, alignof(TEntry));
 
-		auto ptr = (char*) Allocate(strLen + 1);
-		std::copy(str.begin(), str.end(), ptr);
-		ptr[strLen] = '\0';
+		auto* bank = shard.bank;
+		if (bank == nullptr || bank->cursor + size > bank->capacity)
+		{
+			const auto capacity = std::max(size, BankSize);
 
-		return std::string_view(ptr, strLen);
+			bank = static_cast<Bank*>(malloc(sizeof(Bank) + capacity));
+			FatalAssert(bank != nullptr, "Out of memory for the static string table.");
+
+			bank->prev = shard.bank;
+			bank->cursor = 0;
+			bank->capacity = capacity;
+			shard.bank = bank;
+		}
+
+		auto* ptr = reinterpret_cast<uint8_t*>(bank + 1) + bank->cursor;
+		bank->cursor += size;
+
+		auto* entry = new (ptr) TEntry{hash, strLen};
+		auto* text = reinterpret_cast<char*>(entry + 1);
+		std::copy(str.begin(), str.end(), text);
+		text[strLen] = '\0';
+
+		return entry;
 	}
 
-	void* StaticStringTable::Allocate(size_t n)
+	StaticStringID StaticStringTable::ToID(const TEntry* entry)
 	{
-		constexpr size_t capacity = 1024UL * 1024;
+		StaticStringID id;
+		id.ptr = reinterpret_cast<const uint8_t*>(entry + 1);
 
-		std::lock_guard lock(memLock);
-		while (banks.size() <= bankIndex)
+		return id;
+	}
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include "Core/ScopedTime.h"
+#include "HSTL/HVector.h"
+
+namespace hbe
+{
+
+	void StaticStringTableTest::Prepare()
+	{
+		AddTest("Stored Hash", [this](auto& ls)
 		{
-			banks.emplace_back(capacity);
-		}
+			const char* texts[] = {"", "StoredHash", "StoredHash/Longer/Path/To/An/Asset.png"};
 
-		if (!banks[bankIndex].IsAvailable(n))
+			for (auto text : texts)
+			{
+				StaticString str(text);
+				if (str.GetHash() != StringUtil::CalculateHash(text) || str.GetLength() != std::string_view(text).length())
+				{
+					ls << "The stored hash or length of [" << text << "] is wrong." << lferr;
+				}
+
+				if (std::hash<StaticString>()(str) != str.GetHash())
+				{
+					ls << "std::hash should reuse the stored hash of [" << text << "]." << lferr;
+				}
+			}
+
+			if (StaticStringID().GetHash() != 0)
+			{
+				ls << "The hash of the null ID should be 0." << lferr;
+			}
+		});
+
+		AddTest("Concurrent Intern", [this](auto& ls)
 		{
-			banks.emplace_back(std::max(n, capacity));
-			++bankIndex;
-		}
+			constexpr int NumThreads = 4;
+			constexpr size_t NumNames = 100000;
+
+			HVector<std::string> names;
+			names.reserve(NumNames);
+			for (size_t i = 0; i < NumNames; ++i)
+			{
+				char buffer[64];
+				snprintf(buffer, sizeof(buffer), "InternBenchmark/Asset_%zu.mesh", i);
+				names.emplace_back(buffer);
+			}
+
+			// Every thread registers all names from a different starting point, so new names collide among threads.
+			auto Elapsed = [](auto&& func) -> float
+			{
+				time::TDuration duration;
+				{
+					time::ScopedTime timer(duration);
+
+					HVector<std::thread> threads;
+					for (int t = 0; t < NumThreads; ++t)
+					{
+						threads.emplace_back(func, t);
+					}
+
+					for (auto& thread : threads)
+					{
+						thread.join();
+					}
+				}
+
+				return time::ToFloat(duration);
+			};
+
+			HVector<HVector<StaticStringID>> ids(NumThreads, HVector<StaticStringID>(NumNames));
+			auto& table = StaticStringTable::GetInstance();
+
+			auto Intern = [&](int t)
+			{
+				auto& threadIds = ids[t];
+				for (size_t i = 0; i < NumNames; ++i)
+				{
+					const auto index = (i + t * NumNames / NumThreads) % NumNames;
+					threadIds[index] = table.Register(names[index]);
+				}
+			};
 
-		auto& bank = banks[bankIndex];
-		auto ptr = bank.Allocate(n);
+			std::mutex lock;
+			std::unordered_set<std::string> lockedSet;
 
-		return ptr;
+			auto LockedIntern = [&](int t)
+			{
+				for (size_t i = 0; i < NumNames; ++i)
+				{
+					const auto index = (i + t * NumNames / NumThreads) % NumNames;
+
+					std::lock_guard guard(lock);
+					auto found = lockedSet.find(names[index]);
+					if (found == lockedSet.end())
+					{
+						lockedSet.emplace(names[index]);
+					}
+				}
+			};
+
+			const float insertSec = Elapsed(Intern);
+			const float lockedInsertSec = Elapsed(LockedIntern);
+			const float lookupSec = Elapsed(Intern);
+			const float lockedLookupSec = Elapsed(LockedIntern);
+
+			for (size_t i = 0; i < NumNames; ++i)
+			{
+				const auto id = ids[0][i];
+				if (names[i] != table.Get(id))
+				{
+					ls << "Name " << i << " is registered as [" << table.Get(id) << "]" << lferr;
+					return;
+				}
+
+				for (int t = 1; t < NumThreads; ++t)
+				{
+					if (!(ids[t][i] == id))
+					{
+						ls << "Name " << i << " has different IDs on threads 0 and " << t << lferr;
+						return;
+					}
+				}
+			}
+
+			ls << NumThreads << " threads x " << NumNames << " names: insert = " << insertSec
+			   << " sec (locked set = " << lockedInsertSec << " sec), lookup = " << lookupSec
+			   << " sec (locked set = " << lockedLookupSec << " sec)" << lf;
+
+			if (lookupSec > lockedLookupSec)
+			{
+				ls << "Looking up registered strings is slower than a locked set. " << lookupSec << " sec > "
+				   << lockedLookupSec << " sec" << lfwarn;
+			}
+		});
 	}
 
 } // namespace hbe
+#endif //__UNIT_TEST__
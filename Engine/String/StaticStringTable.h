@@ -2,9 +2,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
-#include <vector>
 #include <mutex>
 #include <string_view>
 #include "Config/EngineConfig.h"
@@ -15,50 +16,50 @@ namespace hbe
 {
 
 	/// @brief A global table for storing and managing interned static strings.
+	/// @details Strings are spread over shards by hash. Each shard is an open-addressing table of entry pointers,
+	/// which is looked up without a lock, so registering an existing string is wait-free. Adding a new string takes
+	/// the lock of its shard only. A shard table is replaced by one twice as large when it gets half full, and the
+	/// old tables are kept until the string table is destroyed, as readers may still be probing them.
 	class StaticStringTable final
 	{
 	public:
 		using TIndex = size_t;
-		static constexpr size_t NumTables = Config::StaticStringNumHashBuckets;
+		static constexpr size_t NumShards = Config::StaticStringNumHashBuckets;
+		static_assert(std::has_single_bit(NumShards));
 
 	private:
-		template<typename T>
-		class Allocator final
+		static constexpr size_t ShardBits = std::countr_zero(NumShards);
+		static constexpr size_t InitialCapacity = 64;
+		static constexpr size_t BankSize = Config::StaticStringBufferSize / NumShards;
+
+		// A StaticStringHeader followed by the zero-terminated text.
+		using TEntry = StaticStringHeader;
+
+		struct Slots final
 		{
-		public:
-			using value_type = T;
-
-			template<class U>
-			struct rebind
-			{
-				using other = Allocator<U>;
-			};
-
-		public:
-			Allocator() = default;
-			~Allocator() = default;
-
-			T* allocate(std::size_t n) { return (T*) Allocate(n * sizeof(T)); }
-			void deallocate(T*, std::size_t) {}
-
-			template<class U>
-			bool operator==(const Allocator<U>& rhs) const
-			{
-				return true;
-			}
-
-			template<class U>
-			bool operator!=(const Allocator<U>& rhs) const
-			{
-				return false;
-			}
+			size_t capacity;
+			Slots* retired;
+			std::atomic<const TEntry*>* entries;
 		};
 
-		using TTable = std::vector<std::string_view>;
+		struct Bank final
+		{
+			Bank* prev;
+			size_t cursor;
+			size_t capacity;
+		};
 
-	private:
-		mutable std::mutex tableLock;
-		TTable tables[NumTables];
+		struct alignas(Config::CacheLineSize) Shard final
+		{
+			std::atomic<Slots*> slots;
+
+			// The others are guarded by the lock.
+			std::mutex lock;
+			size_t count;
+			Bank* bank;
+		};
+
+		Shard shards[NumShards];
 
 	public:
 		static StaticStringTable& GetInstance();
@@ -77,13 +78,33 @@ namespace hbe
 
 	private:
 		void RegisterPredefinedStrings();
-		TIndex GetTableID(const char* text) const;
-		TIndex GetTableID(const std::string_view& str) const;
 
-		std::string_view Store(const char* text);
-		std::string_view Store(const std::string_view& str);
+		// Spread the bits of the string hash. The low bits select the shard, and the others the first slot.
+		[[nodiscard]] static size_t MixHash(size_t hash);
+		[[nodiscard]] static const TEntry* Find(const Slots& slots, size_t probe, size_t hash,
+			const std::string_view& str);
+		static void Insert(Slots& slots, size_t probe, const TEntry* entry);
+		[[nodiscard]] static Slots* Grow(Shard& shard);
+		[[nodiscard]] static const TEntry* Store(Shard& shard, size_t hash, const std::string_view& str);
+		[[nodiscard]] static StaticStringID ToID(const TEntry* entry);
+	};
+
+} // namespace hbe
+
+#ifdef __UNIT_TEST__
+#include "Test/TestCollection.h"
+
+namespace hbe
+{
+
+	class StaticStringTableTest : public TestCollection
+	{
+	public:
+		StaticStringTableTest() : TestCollection("StaticStringTableTest") {}
 
-		static void* Allocate(size_t n);
+	protected:
+		void Prepare() override;
 	};
 
 } // namespace hbe
+#endif //__UNIT_TEST__
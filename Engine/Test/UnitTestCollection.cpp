@@ -6,18 +6,30 @@
 
 #include "RendererTest.h"
 #include "Container/Array.h"
+#include "Container/AtomicRingQueue.h"
 #include "Container/AtomicStackView.h"
 #include "Container/BoundedPriorityQueue.h"
 #include "Container/LinkedList.h"
 #include "Container/Vector.h"
 #include "Container/Map.h"
+#include "Container/ConcurrentHashMap.h"
+#include "Container/FlatMap.h"
 #include "Container/HashMap.h"
+#include "Container/SwissHashMap.h"
 #include "Container/Deque.h"
 #include "Container/Queue.h"
 #include "Container/RingQueue.h"
+#include "Container/WorkStealingDeque.h"
 #include "Core/ComponentSystem.h"
+#include "Core/Coroutine.h"
+#include "Core/MainThreadTaskQueue.h"
+#include "Core/TaskGraph.h"
 #include "Core/TaskSystem.h"
 #include "HSTL/HUnorderedMap.h"
+#include "Log/BinaryLogWriter.h"
+#include "Log/LogCategory.h"
+#include "Log/LogFileWriter.h"
+#include "Log/LogRing.h"
 #include "Math/AABB.h"
 #include "Math/ImportanceResampling.h"
 #include "Math/MathUtil.h"
@@ -37,10 +49,12 @@
 #include "Memory/MonotonicAllocator.h"
 #include "Memory/MultiPoolAllocator.h"
 #include "Memory/Optional.h"
+#include "Memory/PageMap.h"
 #include "Memory/PoolAllocator.h"
 #include "Memory/StackAllocator.h"
 #include "Memory/SystemAllocator.h"
 #include "Memory/ThreadSafeMultiPoolAllocator.h"
+#include "OSAL/OSBatchIO.h"
 #include "OSAL/OSDebug.h"
 #include "OSAL/OSInputOutput.h"
 #include "OSAL/OSThread.h"
@@ -49,8 +63,14 @@
 #include "Resource/Buffer.h"
 #include "Resource/BufferInputStream.h"
 #include "Resource/BufferOutputStream.h"
+#include "Resource/Compression.h"
+#include "Resource/ResourceArchive.h"
+#include "Resource/ResourceManager.h"
+#include "Resource/Serialization.h"
+#include "String/BufferStringBuilder.h"
 #include "String/InlineStringBuilder.h"
 #include "String/StaticString.h"
+#include "String/StaticStringTable.h"
 #include "String/StringBuilder.h"
 #include "String/StringUtil.h"
 #include "TestEnv.h"
@@ -74,11 +94,13 @@ void RunTests()
 		testEnv.AddTestCollection<InlineMonotonicAllocatorTest>();
 		testEnv.AddTestCollection<StackAllocatorTest>();
 		testEnv.AddTestCollection<PoolAllocatorTest>();
+		testEnv.AddTestCollection<PageMapTest>();
 		testEnv.AddTestCollection<MonotonicAllocatorTest>();
 		testEnv.AddTestCollection<MultiPoolAllocatorTest>();
 		testEnv.AddTestCollection<ThreadSafeMultiPoolAllocatorTest>();
 		testEnv.AddTestCollection<OSDebugTest>();
 		testEnv.AddTestCollection<OSInputOutputTest>();
+		testEnv.AddTestCollection<BatchIOTest>();
 		testEnv.AddTestCollection<OSThreadTest>();
 		testEnv.AddTestCollection<WindowTest>();
 		testEnv.AddTestCollection<OSMemoryTest>();
@@ -86,23 +108,38 @@ void RunTests()
 		testEnv.AddTestCollection<BufferTest>();
 		testEnv.AddTestCollection<BufferInputStreamTest>();
 		testEnv.AddTestCollection<BufferOutputStreamTest>();
+		testEnv.AddTestCollection<CompressionTest>();
+		testEnv.AddTestCollection<ResourceArchiveTest>();
+		testEnv.AddTestCollection<ResourceManagerTest>();
+		testEnv.AddTestCollection<SerializationTest>();
 		testEnv.AddTestCollection<HUnorderedMapTest>();
 		testEnv.AddTestCollection<ArrayTest>();
 		testEnv.AddTestCollection<BoundedPriorityQueueTest>();
 		testEnv.AddTestCollection<AtomicStackViewTest>();
+		testEnv.AddTestCollection<AtomicRingQueueTest>();
 		testEnv.AddTestCollection<LinkedListTest>();
 		testEnv.AddTestCollection<VectorTest>();
+		testEnv.AddTestCollection<FlatMapTest>();
 		testEnv.AddTestCollection<MapTest>();
 		testEnv.AddTestCollection<HashMapTest>();
+		testEnv.AddTestCollection<ConcurrentHashMapTest>();
+		testEnv.AddTestCollection<SwissHashMapTest>();
 		testEnv.AddTestCollection<DequeTest>();
 		testEnv.AddTestCollection<QueueTest>();
 		testEnv.AddTestCollection<RingQueueTest>();
+		testEnv.AddTestCollection<WorkStealingDequeTest>();
 		testEnv.AddTestCollection<OptionalTest>();
 		testEnv.AddTestCollection<StaticStringTest>();
+		testEnv.AddTestCollection<StaticStringTableTest>();
 		testEnv.AddTestCollection<StringTest>();
 		testEnv.AddTestCollection<InlineStringBuilderTest>();
+		testEnv.AddTestCollection<BufferStringBuilderTest>();
 		testEnv.AddTestCollection<StringBuilderTest>();
 		testEnv.AddTestCollection<StringUtilTest>();
+		testEnv.AddTestCollection<LogRingTest>();
+		testEnv.AddTestCollection<LogCategoryTest>();
+		testEnv.AddTestCollection<BinaryLogWriterTest>();
+		testEnv.AddTestCollection<LogFileWriterTest>();
 
 		testEnv.AddTestCollection<MathUtilTest>();
 		testEnv.AddTestCollection<Vector2Test>();
@@ -120,8 +157,11 @@ void RunTests()
 		testEnv.AddTestCollection<TransformTest>();
 
 		testEnv.AddTestCollection<ComponentSystemTest>();
+		testEnv.AddTestCollection<MainThreadTaskQueueTest>();
 		testEnv.AddTestCollection<TaskStreamAffinityTest>();
 		testEnv.AddTestCollection<TaskSystemTest>();
+		testEnv.AddTestCollection<TaskGraphTest>();
+		testEnv.AddTestCollection<CoroutineTest>();
 		testEnv.AddTestCollection<RHICapabilitiesTest>();
 
 		testEnv.Start();
@@ -0,0 +1,52 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+// Converts a binary log written with Log.Binary back into the text log.
+// Usage: LogDecoder <binary log> [text log]
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "Log/BinaryLog.h"
+
+int main(int argc, char* argv[])
+{
+	using namespace hbe;
+
+	if (argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "Usage: %s <binary log> [text log]\n", argv[0]);
+		return 1;
+	}
+
+	std::ifstream input(argv[1], std::ios::binary);
+	if (!input)
+	{
+		fprintf(stderr, "Failed to open %s\n", argv[1]);
+		return 1;
+	}
+
+	std::ofstream outFile;
+	if (argc == 3)
+	{
+		outFile.open(argv[2]);
+		if (!outFile)
+		{
+			fprintf(stderr, "Failed to open %s\n", argv[2]);
+			return 1;
+		}
+	}
+
+	std::ostream& output = argc == 3 ? outFile : std::cout;
+
+	BinaryLog::Decoder decoder;
+	const bool isDone = decoder.Decode(input, output);
+	output.flush();
+
+	if (!isDone)
+	{
+		fprintf(stderr, "%s after %zu records: %s\n", argv[1], decoder.GetNumRecords(), decoder.GetError().c_str());
+		return 1;
+	}
+
+	return 0;
+}
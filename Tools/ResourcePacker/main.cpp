@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Hansol Park (mooming.go@gmail.com). All rights reserved.
+
+// Packs the files in a directory into an archive read by ResourceArchive, and back.
+// Usage: ResourcePacker pack <archive> <directory> [--lz]
+//        ResourcePacker unpack <archive> [output directory]
+//        ResourcePacker list <archive>
+// An entry is named after the path of its file as given, e.g. "Resources/Textures/A.png", which is the path the engine
+// loads it by. With --lz, the entries are compressed unless they don't get smaller.
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Resource/ArchiveFormat.h"
+#include "Resource/LZCodec.h"
+
+namespace
+{
+	namespace fs = std::filesystem;
+	using namespace hbe;
+
+	bool ReadFile(const fs::path& path, std::vector<uint8_t>& outData)
+	{
+		std::ifstream input(path, std::ios::binary);
+		if (!input)
+		{
+			return false;
+		}
+
+		outData.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+		return !input.bad();
+	}
+
+	int Pack(const char* archivePath, const char* directory, ArchiveFormat::ECompression compression)
+	{
+		std::error_code error;
+		std::vector<fs::path> paths;
+
+		for (auto& entry : fs::recursive_directory_iterator(directory, error))
+		{
+			if (entry.is_regular_file())
+			{
+				paths.push_back(entry.path());
+			}
+		}
+
+		if (error)
+		{
+			fprintf(stderr, "Failed to list %s: %s\n", directory, error.message().c_str());
+			return 1;
+		}
+
+		// The same order on every run, so the archive is reproducible.
+		std::sort(paths.begin(), paths.end());
+
+		std::ofstream output(archivePath, std::ios::binary | std::ios::trunc);
+		if (!output)
+		{
+			fprintf(stderr, "Failed to open %s\n", archivePath);
+			return 1;
+		}
+
+		ArchiveFormat::Writer writer(output);
+		std::vector<uint8_t> data;
+		size_t totalSize = 0;
+
+		for (auto& path : paths)
+		{
+			const auto name = path.generic_string();
+			if (!ReadFile(path, data))
+			{
+				fprintf(stderr, "Failed to read %s\n", name.c_str());
+				return 1;
+			}
+
+			if (!writer.Add(name, data.data(), data.size(), compression))
+			{
+				fprintf(stderr, "%s\n", writer.GetError().c_str());
+				return 1;
+			}
+
+			totalSize += data.size();
+		}
+
+		if (!writer.Finish())
+		{
+			fprintf(stderr, "%s\n", writer.GetError().c_str());
+			return 1;
+		}
+
+		output.close();
+		std::error_code sizeError;
+		const auto archiveSize = fs::file_size(archivePath, sizeError);
+
+		printf("Packed %zu files (%zu bytes) into %s (%llu bytes)\n", writer.GetNumEntries(), totalSize, archivePath,
+			static_cast<unsigned long long>(sizeError ? 0 : archiveSize));
+		return 0;
+	}
+
+	bool OpenArchive(const char* archivePath, std::vector<uint8_t>& outData, ArchiveFormat::View& outView)
+	{
+		if (!ReadFile(archivePath, outData))
+		{
+			fprintf(stderr, "Failed to read %s\n", archivePath);
+			return false;
+		}
+
+		if (!outView.Open(outData.data(), outData.size()))
+		{
+			fprintf(stderr, "%s isn't a valid archive.\n", archivePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	int Unpack(const char* archivePath, const char* outputDirectory)
+	{
+		std::vector<uint8_t> data;
+		ArchiveFormat::View view;
+		if (!OpenArchive(archivePath, data, view))
+		{
+			return 1;
+		}
+
+		for (uint32_t i = 0; i < view.GetNumEntries(); ++i)
+		{
+			auto& entry = view.GetEntry(i);
+			const fs::path name(view.GetName(entry));
+
+			if (name.is_absolute() || std::find(name.begin(), name.end(), "..") != name.end())
+			{
+				fprintf(stderr, "Skipped %s, which is out of the output directory.\n", name.generic_string().c_str());
+				continue;
+			}
+
+			const uint8_t* entryData = view.GetData(entry);
+			std::vector<uint8_t> decompressed;
+
+			if (entry.compression == ArchiveFormat::ECompression::LZ)
+			{
+				LZCodec::FrameView frame;
+				if (!frame.Open(entryData, entry.size) || frame.GetOriginalSize() != entry.originalSize)
+				{
+					fprintf(stderr, "Skipped %s, which is corrupted.\n", name.generic_string().c_str());
+					continue;
+				}
+
+				decompressed.resize(entry.originalSize);
+				if (!frame.Decompress(decompressed.data()))
+				{
+					fprintf(stderr, "Skipped %s, which is corrupted.\n", name.generic_string().c_str());
+					continue;
+				}
+
+				entryData = decompressed.data();
+			}
+			else if (entry.compression != ArchiveFormat::ECompression::Stored)
+			{
+				fprintf(stderr, "Skipped %s, which is compressed in an unknown way.\n", name.generic_string().c_str());
+				continue;
+			}
+
+			const auto path = fs::path(outputDirectory) / name;
+			std::error_code error;
+			fs::create_directories(path.parent_path(), error);
+
+			std::ofstream output(path, std::ios::binary | std::ios::trunc);
+			output.write(reinterpret_cast<const char*>(entryData), static_cast<std::streamsize>(entry.originalSize));
+
+			if (!output)
+			{
+				fprintf(stderr, "Failed to write %s\n", path.generic_string().c_str());
+				return 1;
+			}
+		}
+
+		printf("Unpacked %u entries of %s into %s\n", view.GetNumEntries(), archivePath, outputDirectory);
+		return 0;
+	}
+
+	int List(const char* archivePath)
+	{
+		std::vector<uint8_t> data;
+		ArchiveFormat::View view;
+		if (!OpenArchive(archivePath, data, view))
+		{
+			return 1;
+		}
+
+		for (uint32_t i = 0; i < view.GetNumEntries(); ++i)
+		{
+			auto& entry = view.GetEntry(i);
+			const auto name = view.GetName(entry);
+
+			printf("%016llx %12llu %12llu %.*s\n", static_cast<unsigned long long>(entry.hash),
+				static_cast<unsigned long long>(entry.originalSize), static_cast<unsigned long long>(entry.size),
+				static_cast<int>(name.size()), name.data());
+		}
+
+		return 0;
+	}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	const std::string_view command = argc > 1 ? argv[1] : "";
+
+	if (command == "pack" && (argc == 4 || (argc == 5 && std::string_view(argv[4]) == "--lz")))
+	{
+		return Pack(argv[2], argv[3], argc == 5 ? ArchiveFormat::ECompression::LZ : ArchiveFormat::ECompression::Stored);
+	}
+
+	if (command == "unpack" && (argc == 3 || argc == 4))
+	{
+		return Unpack(argv[2], argc == 4 ? argv[3] : ".");
+	}
+
+	if (command == "list" && argc == 3)
+	{
+		return List(argv[2]);
+	}
+
+	fprintf(stderr,
+		"Usage: %s pack <archive> <directory> [--lz]\n"
+		"       %s unpack <archive> [output directory]\n"
+		"       %s list <archive>\n",
+		argv[0], argv[0], argv[0]);
+
+	return 1;
+}